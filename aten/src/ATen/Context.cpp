@@ -67,6 +67,22 @@ void Context::setBenchmarkCuDNN(bool b) {
   benchmark_cudnn = b;
 }
 
+bool Context::benchmarkCPUConv() const {
+  return benchmark_cpu_conv;
+}
+
+void Context::setBenchmarkCPUConv(bool b) {
+  benchmark_cpu_conv = b;
+}
+
+bool Context::fastMathCPU() const {
+  return fast_math_cpu;
+}
+
+void Context::setFastMathCPU(bool b) {
+  fast_math_cpu = b;
+}
+
 bool Context::hasMKL() const {
 #if AT_MKL_ENABLED()
   return true;
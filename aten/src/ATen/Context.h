@@ -106,6 +106,15 @@ class CAFFE2_API Context {
   void setBenchmarkCuDNN(bool);
   bool deterministicCuDNN() const;
   void setDeterministicCuDNN(bool);
+  // Time every eligible CPU convolution backend on the first call for a shape
+  // and use the fastest, see ATen/native/ConvAutotune.h
+  bool benchmarkCPUConv() const;
+  void setBenchmarkCPUConv(bool);
+  // Compute exp, log, tanh, erf and sigmoid of float tensors in the CPU
+  // activation and softmax kernels with the faster, less accurate
+  // approximations of ATen/cpu/vec256/fast_math.h
+  bool fastMathCPU() const;
+  void setFastMathCPU(bool);
   at::QEngine qEngine() const;
   void setQEngine(at::QEngine e);
   const std::vector<at::QEngine>& supportedQEngines() const;
@@ -132,6 +141,8 @@ class CAFFE2_API Context {
   bool enabled_cudnn = true;
   bool deterministic_cudnn = false;
   bool benchmark_cudnn = false;
+  bool benchmark_cpu_conv = false;
+  bool fast_math_cpu = false;
   bool enabled_mkldnn = true;
   #ifdef C10_MOBILE
   bool release_original_weights = true;
@@ -71,6 +71,8 @@ UPTOb( Tensor, pow                             , (Scalar        A, const Tensor
 UPTOc( Tensor, softplus                        , (const Tensor &A, Scalar        B, Scalar        C) )
 UPTOa( Tensor, gelu                            , (const Tensor &A) )
 UPTOf( Tensor, layer_norm                      , (const Tensor &A, IntArrayRef   B, const Tensor &C, const Tensor &         D, double        E, bool    F) )
+UPTOi( Tensor, batch_norm                      , (const Tensor &A, const Tensor &B, const Tensor &C, const Tensor &         D, const Tensor &E, bool    F, double G, double H, bool I) )
+UPTOi( Tensor, instance_norm                   , (const Tensor &A, const Tensor &B, const Tensor &C, const Tensor &         D, const Tensor &E, bool    F, double G, double H, bool I) )
 UPTOf( Tensor, group_norm                      , (const Tensor &A, int64_t       B, const Tensor &C, const Tensor &         D, double        E, bool    F) )
 UPTOa( Tensor, frobenius_norm                  , (const Tensor &A) )
 UPTOc( Tensor, frobenius_norm                  , (const Tensor &A, IntArrayRef   B, bool          C) )
@@ -91,6 +93,7 @@ UPTOc( Tensor, multilabel_margin_loss          , (const Tensor &A, const Tensor
 UPTOc( Tensor, soft_margin_loss                , (const Tensor &A, const Tensor &B, int64_t       C) )
 UPTOh( Tensor, triplet_margin_loss             , (const Tensor &A, const Tensor &B, const Tensor &C, double                 D, double        E, double  F, bool G, int64_t H) )
 UPTOf( Tensor, multi_margin_loss               , (const Tensor &A, const Tensor &B, Scalar        C, Scalar                 D, const Tensor &E, int64_t F) )
+UPTOd( Tensor, binary_cross_entropy            , (const Tensor &A, const Tensor &B, const Tensor &C, int64_t                D) )
 UPTOe( Tensor, binary_cross_entropy_with_logits, (const Tensor &A, const Tensor &B, const Tensor &C, const Tensor &         D, int64_t       E) )
 UPTOc( Tensor, dist                            , (const Tensor &A, const Tensor &B, Scalar        C) )
 UPTOb( Tensor, pdist                           , (const Tensor &A, double        B) )
@@ -116,6 +119,8 @@ UPTOc( Tensor, cumsum     , (const Tensor &A, Dimname                   B, c10::
 UPTOb( Tensor, sum        , (const Tensor &A, c10::optional<ScalarType> B) )
 UPTOd( Tensor, sum        , (const Tensor &A, IntArrayRef               B, bool                      C, c10::optional<ScalarType> D) )
 UPTOd( Tensor, sum        , (const Tensor &A, DimnameList               B, bool                      C, c10::optional<ScalarType> D) )
+UPTOb( Tensor, mean       , (const Tensor &A, c10::optional<ScalarType> B) )
+UPTOd( Tensor, mean       , (const Tensor &A, IntArrayRef               B, bool                      C, c10::optional<ScalarType> D) )
 
 // fp32_append_dtype
 // The wrapper for templating wraps the REDISPATCH_FUNC, so must match REDISPATCH_SIGNATURE.
@@ -0,0 +1,350 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// Note [Fast math approximations]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Vec256<float>::exp(), log(), tanh() and erf() call Sleef functions that are
+// accurate to 1 ULP and handle every corner case of IEEE arithmetic. The
+// functions below trade some of that accuracy for throughput: they are short
+// polynomial (and for erf, rational) approximations evaluated with a handful
+// of multiply-adds, plus the cheap range reduction that the polynomials need.
+// They are used by the CPU activation and softmax kernels when
+// at::globalContext().fastMathCPU() is set (torch.backends.cpu.fast_math).
+//
+// Maximum errors over all float inputs, measured against double precision
+// with the AVX2 and scalar versions below:
+//
+//   fast_exp      2.3 ULP (relative error 1.8e-7)
+//   fast_log      4.1 ULP (relative error 3.1e-7)
+//   fast_tanh     2.6 ULP (relative error 2.1e-7)
+//   fast_sigmoid  3.4 ULP (relative error 2.4e-7)
+//   fast_erf      7.2 ULP (relative error 4.3e-7)
+//
+// The error of erf close to +-1 becomes an absolute error of gelu, which is
+// at most 1.3e-6 (at x = -5.5) against 1.6e-7 with Sleef. Since gelu itself
+// is tiny there, its relative error reaches about 9 for x in [-6, -5], and
+// 0.5 for x in [-5, -4.5].
+//
+// The corner cases that the kernels rely on are kept: exp(-inf) is 0,
+// exp(inf) is inf, log(0) is -inf, log of a negative number is NaN, tanh,
+// sigmoid and erf saturate at their limits and NaN propagates. Results of exp
+// in the denormal range are computed with less precision.
+//
+// Types other than float have no approximation, the fast functions are the
+// accurate ones for them.
+//
+// benchmarks/fast_math measures the speed and the accuracy of the kernels
+// with and without the approximations.
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+template <typename scalar_t>
+inline scalar_t fast_exp(scalar_t x) {
+  return std::exp(x);
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> fast_exp(const Vec256<scalar_t>& x) {
+  return x.exp();
+}
+
+template <typename scalar_t>
+inline scalar_t fast_log(scalar_t x) {
+  return std::log(x);
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> fast_log(const Vec256<scalar_t>& x) {
+  return x.log();
+}
+
+template <typename scalar_t>
+inline scalar_t fast_tanh(scalar_t x) {
+  return std::tanh(x);
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> fast_tanh(const Vec256<scalar_t>& x) {
+  return x.tanh();
+}
+
+template <typename scalar_t>
+inline scalar_t fast_sigmoid(scalar_t x) {
+  return scalar_t(1) / (scalar_t(1) + std::exp(-x));
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> fast_sigmoid(const Vec256<scalar_t>& x) {
+  return (Vec256<scalar_t>(scalar_t(1)) + x.neg().exp()).reciprocal();
+}
+
+template <typename scalar_t>
+inline scalar_t fast_erf(scalar_t x) {
+  return std::erf(x);
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> fast_erf(const Vec256<scalar_t>& x) {
+  return x.erf();
+}
+
+// The scalar versions run on the elements that don't fill a whole vector, so
+// they follow the vectorized ones step by step.
+
+// 2^m for an integral m in [-126, 127]
+inline float fast_pow2n(float m) {
+  const int32_t bits = (static_cast<int32_t>(m) + 127) << 23;
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+// exp(x) = 2^n * exp(r) with n = round(x / ln 2) and |r| <= ln(2) / 2, where
+// exp(r) is a degree 5 minimax polynomial. ln 2 is split in a part that
+// multiplies n exactly and a correction, so that r has no cancellation
+// error. 2^n is built from two halves so that n can go from -150 (the
+// denormals) to 128 (the overflow to inf).
+inline float fast_exp(float x) {
+  if (std::isnan(x)) {
+    return x;
+  }
+  x = std::min(std::max(x, -104.f), 88.7228394f);
+  const float n = std::nearbyint(x * 1.44269504f);
+  float r = x - n * 0.693359375f;
+  r = r + n * 2.12194440e-4f;
+  const float q =
+      ((8.3125249e-3f * r + 4.1890113e-2f) * r + 1.6667114e-1f) * r +
+      4.9999232e-1f;
+  const float p = q * (r * r) + r + 1.f;
+  const float m = std::floor(n * 0.5f);
+  return p * fast_pow2n(m) * fast_pow2n(n - m);
+}
+
+// log(x) = e * ln 2 + log(1 + f) with x = (1 + f) * 2^e and
+// sqrt(1/2) <= 1 + f < sqrt(2). log(1 + f) = 2 * atanh(s) with
+// s = f / (2 + f), which is odd in s and approximated by
+// 2s + s^3 * P(s^2) with a degree 1 minimax polynomial P.
+inline float fast_log(float x) {
+  if (!(x > 0.f)) {
+    return x == 0.f ? -std::numeric_limits<float>::infinity()
+                    : std::numeric_limits<float>::quiet_NaN();
+  }
+  if (x == std::numeric_limits<float>::infinity()) {
+    return x;
+  }
+  float e = -126.f;
+  if (x < std::numeric_limits<float>::min()) {
+    x *= 8388608.f;
+    e -= 23.f;
+  }
+  int32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  e += static_cast<float>(bits >> 23);
+  bits = (bits & 0x007fffff) | 0x3f000000;
+  float m;
+  std::memcpy(&m, &bits, sizeof(m));
+  if (m < 0.707106781f) {
+    m += m;
+    e -= 1.f;
+  }
+  const float f = m - 1.f;
+  const float s = f / (f + 2.f);
+  const float z = s * s;
+  const float log_m = (s * z) * (4.1201995e-1f * z + 6.6655622e-1f) + (s + s);
+  return e * 0.693359375f + (e * -2.12194440e-4f + log_m);
+}
+
+// tanh(x) = x + x^3 * P(x^2) with a degree 3 minimax polynomial P for
+// |x| < 0.625, and 1 - 2 / (exp(2|x|) + 1) with the sign of x beyond, where
+// it doesn't cancel.
+inline float fast_tanh(float x) {
+  const float a = std::abs(x);
+  if (a < 0.625f) {
+    const float y = x * x;
+    const float p =
+        ((1.5195373e-2f * y - 5.1947905e-2f) * y + 1.3308175e-1f) * y -
+        3.3332341e-1f;
+    return (x * y) * p + x;
+  }
+  const float t = 1.f - 2.f / (fast_exp(a + a) + 1.f);
+  return std::copysign(t, x);
+}
+
+inline float fast_sigmoid(float x) {
+  return 1.f / (1.f + fast_exp(-x));
+}
+
+// erf(x) = x * P(x^2) / Q(x^2) with a degree 6 and a degree 4 polynomial
+// that minimize the relative error for |x| <= 4. erf(x) rounds to +-1 for
+// |x| >= 3.92, it has to be exact there so that 1 + erf(x) is 0 in gelu.
+inline float fast_erf(float x) {
+  if (std::abs(x) >= 3.92f) {
+    return std::copysign(1.f, x);
+  }
+  const float y = x * x;
+  const float p =
+      (((((1.91110414e-8f * y - 1.94232520e-6f) * y + 1.47287384e-4f) * y +
+         3.99059427e-3f) *
+            y +
+        5.15249391e-2f) *
+           y +
+       2.07125670e-1f) *
+          y +
+      1.12837909f;
+  const float q =
+      (((1.02111927e-3f * y + 1.49581087e-2f) * y + 1.17970922e-1f) * y +
+       5.16891594e-1f) *
+          y +
+      1.f;
+  return x * p / q;
+}
+
+#if (defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2)) && !defined(_MSC_VER)
+
+// The integer instructions on __m256i need AVX2, the ones below only convert
+// between floats and integers, which AVX has.
+
+inline Vec256<float> fast_pow2n(const Vec256<float>& m) {
+  const __m256 biased = _mm256_mul_ps(
+      _mm256_add_ps(m, _mm256_set1_ps(127.f)), _mm256_set1_ps(8388608.f));
+  return _mm256_castsi256_ps(_mm256_cvtps_epi32(biased));
+}
+
+inline Vec256<float> fast_exp(const Vec256<float>& x) {
+  // clamp() propagates NaN
+  const Vec256<float> v =
+      clamp(x, Vec256<float>(-104.f), Vec256<float>(88.7228394f));
+  const Vec256<float> n = (v * Vec256<float>(1.44269504f)).round();
+  Vec256<float> r = fmadd(n, Vec256<float>(-0.693359375f), v);
+  r = fmadd(n, Vec256<float>(2.12194440e-4f), r);
+  Vec256<float> q = fmadd(
+      Vec256<float>(8.3125249e-3f), r, Vec256<float>(4.1890113e-2f));
+  q = fmadd(q, r, Vec256<float>(1.6667114e-1f));
+  q = fmadd(q, r, Vec256<float>(4.9999232e-1f));
+  const Vec256<float> p = fmadd(q, r * r, r) + Vec256<float>(1.f);
+  const Vec256<float> m = (n * Vec256<float>(0.5f)).floor();
+  return p * fast_pow2n(m) * fast_pow2n(n - m);
+}
+
+inline Vec256<float> fast_log(const Vec256<float>& x) {
+  const __m256 denormal = _mm256_cmp_ps(
+      x, _mm256_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ);
+  const __m256 v =
+      _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(8388608.f)), denormal);
+  // The exponent bits read as an integer are the biased exponent times 2^23
+  const __m256 exponent_bits =
+      _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(0x7f800000)));
+  Vec256<float> e = fmadd(
+      Vec256<float>(_mm256_cvtepi32_ps(_mm256_castps_si256(exponent_bits))),
+      Vec256<float>(1.f / 8388608.f),
+      Vec256<float>(-126.f));
+  e = e - Vec256<float>(_mm256_and_ps(denormal, _mm256_set1_ps(23.f)));
+  Vec256<float> m = _mm256_or_ps(
+      _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(0x007fffff))),
+      _mm256_set1_ps(0.5f));
+  const Vec256<float> small = m < Vec256<float>(0.707106781f);
+  m = Vec256<float>::blendv(m, m + m, small);
+  e = e - (small & Vec256<float>(1.f));
+  const Vec256<float> f = m - Vec256<float>(1.f);
+  const Vec256<float> s = f / (f + Vec256<float>(2.f));
+  const Vec256<float> z = s * s;
+  const Vec256<float> log_m = fmadd(
+      s * z,
+      fmadd(Vec256<float>(4.1201995e-1f), z, Vec256<float>(6.6655622e-1f)),
+      s + s);
+  Vec256<float> result = fmadd(
+      e,
+      Vec256<float>(0.693359375f),
+      fmadd(e, Vec256<float>(-2.12194440e-4f), log_m));
+  result = Vec256<float>::blendv(
+      result,
+      Vec256<float>(-std::numeric_limits<float>::infinity()),
+      x == Vec256<float>(0.f));
+  // Not greater or equal is true for NaN too
+  result = Vec256<float>::blendv(
+      result,
+      Vec256<float>(std::numeric_limits<float>::quiet_NaN()),
+      _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_NGE_UQ));
+  return Vec256<float>::blendv(
+      result,
+      x,
+      x == Vec256<float>(std::numeric_limits<float>::infinity()));
+}
+
+inline Vec256<float> fast_tanh(const Vec256<float>& x) {
+  const Vec256<float> y = x * x;
+  Vec256<float> p = fmadd(
+      Vec256<float>(1.5195373e-2f), y, Vec256<float>(-5.1947905e-2f));
+  p = fmadd(p, y, Vec256<float>(1.3308175e-1f));
+  p = fmadd(p, y, Vec256<float>(-3.3332341e-1f));
+  const Vec256<float> small = fmadd(x * y, p, x);
+  const Vec256<float> a = x.abs();
+  const Vec256<float> t = Vec256<float>(1.f) -
+      Vec256<float>(2.f) / (fast_exp(a + a) + Vec256<float>(1.f));
+  const Vec256<float> large = t | (x & Vec256<float>(-0.f));
+  return Vec256<float>::blendv(large, small, a < Vec256<float>(0.625f));
+}
+
+inline Vec256<float> fast_sigmoid(const Vec256<float>& x) {
+  return (Vec256<float>(1.f) + fast_exp(x.neg())).reciprocal();
+}
+
+inline Vec256<float> fast_erf(const Vec256<float>& x) {
+  const Vec256<float> v = clamp(x, Vec256<float>(-4.f), Vec256<float>(4.f));
+  const Vec256<float> y = v * v;
+  Vec256<float> p = fmadd(
+      Vec256<float>(1.91110414e-8f), y, Vec256<float>(-1.94232520e-6f));
+  p = fmadd(p, y, Vec256<float>(1.47287384e-4f));
+  p = fmadd(p, y, Vec256<float>(3.99059427e-3f));
+  p = fmadd(p, y, Vec256<float>(5.15249391e-2f));
+  p = fmadd(p, y, Vec256<float>(2.07125670e-1f));
+  p = fmadd(p, y, Vec256<float>(1.12837909f));
+  Vec256<float> q = fmadd(
+      Vec256<float>(1.02111927e-3f), y, Vec256<float>(1.49581087e-2f));
+  q = fmadd(q, y, Vec256<float>(1.17970922e-1f));
+  q = fmadd(q, y, Vec256<float>(5.16891594e-1f));
+  q = fmadd(q, y, Vec256<float>(1.f));
+  const Vec256<float> one = Vec256<float>(1.f) | (x & Vec256<float>(-0.f));
+  return Vec256<float>::blendv(
+      v * p / q, one, x.abs() >= Vec256<float>(3.92f));
+}
+
+#else
+
+inline Vec256<float> fast_exp(const Vec256<float>& x) {
+  return x.map(fast_exp);
+}
+
+inline Vec256<float> fast_log(const Vec256<float>& x) {
+  return x.map(fast_log);
+}
+
+inline Vec256<float> fast_tanh(const Vec256<float>& x) {
+  return x.map(fast_tanh);
+}
+
+inline Vec256<float> fast_sigmoid(const Vec256<float>& x) {
+  return x.map(fast_sigmoid);
+}
+
+inline Vec256<float> fast_erf(const Vec256<float>& x) {
+  return x.map(fast_erf);
+}
+
+#endif
+
+} // namespace
+} // namespace vec256
+} // namespace at
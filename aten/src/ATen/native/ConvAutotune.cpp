@@ -0,0 +1,126 @@
+#include <ATen/native/ConvAutotune.h>
+
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace at { namespace native {
+
+namespace {
+
+constexpr CPUConvBackend all_backends[] = {
+  CPUConvBackend::Mkldnn,
+  CPUConvBackend::Xnnpack,
+  CPUConvBackend::Winograd3x3Depthwise,
+  CPUConvBackend::SlowConv3d,
+  CPUConvBackend::Nnpack,
+  CPUConvBackend::Native,
+};
+
+std::mutex& cache_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::string, CPUConvBackend>& cache() {
+  static std::unordered_map<std::string, CPUConvBackend> cache;
+  return cache;
+}
+
+} // namespace
+
+const char* cpu_conv_backend_name(CPUConvBackend backend) {
+  switch (backend) {
+    case CPUConvBackend::Mkldnn:
+      return "mkldnn";
+    case CPUConvBackend::Xnnpack:
+      return "xnnpack";
+    case CPUConvBackend::Winograd3x3Depthwise:
+      return "winograd3x3_depthwise";
+    case CPUConvBackend::SlowConv3d:
+      return "slow_conv3d";
+    case CPUConvBackend::Nnpack:
+      return "nnpack";
+    case CPUConvBackend::Native:
+      return "native";
+  }
+  return "unknown";
+}
+
+c10::optional<CPUConvBackend> cpu_conv_autotune_lookup(const std::string& key) {
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  auto it = cache().find(key);
+  if (it == cache().end()) {
+    return c10::nullopt;
+  }
+  return it->second;
+}
+
+void cpu_conv_autotune_insert(const std::string& key, CPUConvBackend backend) {
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  cache()[key] = backend;
+}
+
+size_t cpu_conv_autotune_size() {
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  return cache().size();
+}
+
+void cpu_conv_autotune_clear() {
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  cache().clear();
+}
+
+void cpu_conv_autotune_save(const std::string& path) {
+  std::vector<std::pair<std::string, CPUConvBackend>> entries;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex());
+    entries.assign(cache().begin(), cache().end());
+  }
+  // Sorted so that the same choices always produce the same file
+  std::sort(entries.begin(), entries.end());
+
+  std::ofstream file(path);
+  TORCH_CHECK(file, "cannot open ", path, " to save the CPU convolution autotuning cache");
+  for (const auto& entry : entries) {
+    file << entry.first << '\t' << cpu_conv_backend_name(entry.second) << '\n';
+  }
+  TORCH_CHECK(file, "failed to write the CPU convolution autotuning cache to ", path);
+}
+
+void cpu_conv_autotune_load(const std::string& path) {
+  std::ifstream file(path);
+  TORCH_CHECK(file, "cannot open ", path, " to load the CPU convolution autotuning cache");
+
+  std::vector<std::pair<std::string, CPUConvBackend>> entries;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    auto tab = line.rfind('\t');
+    TORCH_CHECK(tab != std::string::npos,
+                "invalid line in the CPU convolution autotuning cache ", path, ": ", line);
+    const auto name = line.substr(tab + 1);
+    auto backend = std::find_if(
+        std::begin(all_backends), std::end(all_backends),
+        [&](CPUConvBackend b) { return name == cpu_conv_backend_name(b); });
+    if (backend == std::end(all_backends)) {
+      // Written by a build with more backends, tune these again
+      TORCH_WARN("unknown backend ", name, " in the CPU convolution autotuning cache ", path);
+      continue;
+    }
+    entries.emplace_back(line.substr(0, tab), *backend);
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  for (auto& entry : entries) {
+    cache()[std::move(entry.first)] = entry.second;
+  }
+}
+
+}} // namespace at::native
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <c10/macros/Export.h>
+#include <c10/util/Optional.h>
+
+#include <cstdint>
+#include <string>
+
+namespace at { namespace native {
+
+// CPU convolution implementations, in the order the default heuristics try
+// them. With at::globalContext().benchmarkCPUConv() set, the first call for a
+// given convolution times every eligible one and the fastest is cached for the
+// later calls.
+enum class CPUConvBackend : uint8_t {
+  Mkldnn,
+  Xnnpack,
+  Winograd3x3Depthwise,
+  SlowConv3d,
+  Nnpack,
+  Native,
+};
+
+CAFFE2_API const char* cpu_conv_backend_name(CPUConvBackend backend);
+
+// Process-wide cache of the fastest backend by convolution key. The key
+// describes the shapes, parameters, dtype, memory format and number of threads
+// of a convolution, see Convolution.cpp.
+CAFFE2_API c10::optional<CPUConvBackend> cpu_conv_autotune_lookup(const std::string& key);
+CAFFE2_API void cpu_conv_autotune_insert(const std::string& key, CPUConvBackend backend);
+CAFFE2_API size_t cpu_conv_autotune_size();
+CAFFE2_API void cpu_conv_autotune_clear();
+
+// Writes the cache to a text file with one "<key>\t<backend>" line per entry,
+// so that other processes can start with the same choices.
+CAFFE2_API void cpu_conv_autotune_save(const std::string& path);
+// Adds the entries of a file written by cpu_conv_autotune_save(), replacing
+// the cached backend of existing keys.
+CAFFE2_API void cpu_conv_autotune_load(const std::string& path);
+
+}} // namespace at::native
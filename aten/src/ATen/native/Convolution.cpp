@@ -1,8 +1,14 @@
+#include <algorithm>
+#include <chrono>
 #include <limits>
+#include <sstream>
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/core/grad_mode.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
 #include <ATen/native/utils/ParamUtils.h>
+#include <ATen/native/ConvAutotune.h>
 #include <ATen/native/ConvUtils.h>
 #include <ATen/native/xnnpack/Engine.h>
 
@@ -46,6 +52,7 @@ struct ConvParams {
   bool use_miopen(const at::Tensor& input, const at::Tensor& weight, bool bias_defined) const;
   bool use_mkldnn(const at::Tensor& input) const;
   bool use_nnpack(const at::Tensor& input) const;
+  bool can_use_nnpack(const at::Tensor& input) const;
   bool use_xnnpack(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
   bool is_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
 };
@@ -237,17 +244,23 @@ auto ConvParams::use_mkldnn(const at::Tensor& input) const -> bool {
 }
 
 auto ConvParams::use_nnpack(const at::Tensor& input) const -> bool {
+  return can_use_nnpack(input)
+#if !defined(C10_MOBILE) && !defined(CAFFE2_FB_LIMITED_MOBILE_CAPABILITY)
+         && input.size(0) >= 16 // ensure large enough batch size to ensure perf, tuneable
+#endif
+     ;
+}
+
+// Whether NNPACK supports the convolution, use_nnpack also decides whether it
+// is likely to be fast
+auto ConvParams::can_use_nnpack(const at::Tensor& input) const -> bool {
 #if AT_NNPACK_ENABLED()
   return at::_nnpack_available() &&
          input.options().backend() == at::Backend::CPU &&
          input.scalar_type() == kFloat && // only on CPU Float Tensors
          !is_dilated() && // or dilation
          !transposed &&   // or transposed tensors
-         input.ndimension() == 4 // must be in NCHW format
-#if !defined(C10_MOBILE) && !defined(CAFFE2_FB_LIMITED_MOBILE_CAPABILITY)
-         && input.size(0) >= 16 // ensure large enough batch size to ensure perf, tuneable
-#endif
-     ;
+         input.ndimension() == 4; // must be in NCHW format
 #endif
   return false;
 }
@@ -588,6 +601,197 @@ at::Tensor convolution_overrideable(
   AT_ERROR("You are likely triggering this with tensor backend other than CPU/CUDA/MKLDNN, if this is intended, please use TORCH_LIBRARY_IMPL to override this function ");
 }
 
+// Runs the convolution one group at a time with _convolution_nogroup, for
+// the implementations that don't support groups
+static at::Tensor convolution_per_group(
+    const Tensor& input_r, const Tensor& weight_r, const Tensor& bias_r,
+    const ConvParams& params) {
+  if (params.groups == 1) {
+    // slow_conv2d convolves channels last inputs without converting them
+    auto memory_format = input_r.is_cpu() && input_r.dim() == 4 &&
+        !params.transposed && !params.is_dilated() ?
+        input_r.suggest_memory_format() : at::MemoryFormat::Contiguous;
+    return at::_convolution_nogroup(
+        input_r.contiguous(memory_format), weight_r, bias_r, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
+  }
+  auto input = input_r.contiguous();
+  auto weight = weight_r;
+  auto bias = bias_r;
+  std::vector<Tensor> outputs(params.groups);
+  for (int g = 0; g < params.groups; ++g) {
+    auto input_g = subtensor(input, 1, params.groups, g);
+    auto weight_g = subtensor(weight, 0, params.groups, g);
+    auto bias_g = subtensor(bias, 0, params.groups, g);
+    outputs[g] = at::_convolution_nogroup(
+        input_g, weight_g, bias_g, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
+  }
+  return at::cat(outputs, 1);
+}
+
+static at::Tensor cpu_convolution(
+    CPUConvBackend backend,
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const ConvParams& params) {
+  switch (backend) {
+    case CPUConvBackend::Mkldnn:
+#if AT_MKLDNN_ENABLED()
+      TORCH_CHECK(input.options().type_equal(weight.options()),
+               "Input type (", input.toString(), ") and weight type (", weight.toString(),
+               ") should be the same");
+      TORCH_CHECK(!bias.defined() || (input.options().type_equal(bias.options())),
+               "Input type (", input.toString(), ") and bias type (", bias.toString(),
+               ") should be the same");
+      if (!input.is_mkldnn()) {
+        return at::mkldnn_convolution(input.contiguous(), weight.contiguous(), bias.defined() ? bias.contiguous() : bias,
+                                      params.padding, params.stride, params.dilation, params.groups);
+      }
+      // do not call contiguous on mkldnn tensor
+      return at::mkldnn_convolution(input, weight, bias,
+                                    params.padding, params.stride, params.dilation, params.groups);
+#else
+      break;
+#endif
+    case CPUConvBackend::Xnnpack:
+      // Using prepacked conv is preferred, but XNNPACK is still the fastest
+      // option for NHWC.
+      return xnnpack::convolution2d(
+          input,
+          weight,
+          bias,
+          params.padding,
+          params.stride,
+          params.dilation,
+          params.groups);
+    case CPUConvBackend::Winograd3x3Depthwise:
+      return convolution_depthwise3x3_winograd_stub(
+          input.device().type(),
+          input,
+          weight,
+          bias,
+          params.stride,
+          params.padding,
+          params.groups);
+    case CPUConvBackend::SlowConv3d:
+      // fast path for grouped conv3d
+      return at::slow_conv3d(
+          input,
+          weight,
+          weight.sizes().slice(2),
+          bias,
+          params.stride,
+          params.padding);
+    case CPUConvBackend::Nnpack:
+#if AT_NNPACK_ENABLED()
+      return at::_nnpack_spatial_convolution(
+          input.contiguous(), weight, bias, params.padding, params.stride);
+#else
+      break;
+#endif
+    case CPUConvBackend::Native:
+      return convolution_per_group(input, weight, bias, params);
+  }
+  AT_ERROR("CPU convolution backend ", cpu_conv_backend_name(backend), " is not available");
+}
+
+// The backends that support the convolution, in the order of
+// CPUConvBackend
+static std::vector<CPUConvBackend> cpu_conv_candidates(
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const ConvParams& params) {
+  std::vector<CPUConvBackend> candidates;
+  if (params.use_mkldnn(input)) {
+    candidates.push_back(CPUConvBackend::Mkldnn);
+  }
+  if (params.use_xnnpack(input, weight, bias)) {
+    candidates.push_back(CPUConvBackend::Xnnpack);
+  }
+  if (params.use_cpu_depthwise3x3_winograd(input, weight, bias)) {
+    candidates.push_back(CPUConvBackend::Winograd3x3Depthwise);
+  }
+  if (!params.transposed && (input.ndimension() == 5) && !params.is_dilated()) {
+    candidates.push_back(CPUConvBackend::SlowConv3d);
+  }
+  if (params.groups == 1 && params.can_use_nnpack(input)) {
+    candidates.push_back(CPUConvBackend::Nnpack);
+  }
+  candidates.push_back(CPUConvBackend::Native);
+  return candidates;
+}
+
+static std::string cpu_conv_autotune_key(
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const ConvParams& params) {
+  std::ostringstream key;
+  key << input.scalar_type()
+      << " " << input.suggest_memory_format()
+      << " threads=" << at::get_num_threads()
+      << " input=" << input.sizes()
+      << " weight=" << weight.sizes()
+      << " bias=" << bias.defined()
+      << " stride=" << IntArrayRef{params.stride}
+      << " padding=" << IntArrayRef{params.padding}
+      << " dilation=" << IntArrayRef{params.dilation}
+      << " transposed=" << params.transposed
+      << " output_padding=" << IntArrayRef{params.output_padding}
+      << " groups=" << params.groups;
+  return key.str();
+}
+
+// Number of timed runs of each backend, after a warm up run. The fastest run
+// counts.
+constexpr int cpu_conv_autotune_runs = 3;
+
+static CPUConvBackend cpu_conv_autotune(
+    const std::vector<CPUConvBackend>& candidates, CPUConvBackend default_backend,
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const ConvParams& params) {
+  // The runs are only timed, keep them out of the autograd graph
+  at::NoGradGuard no_grad;
+  auto best_backend = default_backend;
+  auto best_time = std::chrono::steady_clock::duration::max();
+  for (auto backend : candidates) {
+    try {
+      cpu_convolution(backend, input, weight, bias, params);
+      for (int i = 0; i < cpu_conv_autotune_runs; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        cpu_convolution(backend, input, weight, bias, params);
+        auto time = std::chrono::steady_clock::now() - start;
+        if (time < best_time) {
+          best_time = time;
+          best_backend = backend;
+        }
+      }
+    } catch (const c10::Error& e) {
+      // Backends may reject parameters their eligibility check doesn't cover
+    }
+  }
+  return best_backend;
+}
+
+static CPUConvBackend select_cpu_conv_backend(
+    const Tensor& input, const Tensor& weight, const Tensor& bias,
+    const ConvParams& params) {
+  auto candidates = cpu_conv_candidates(input, weight, bias, params);
+  // The Native backend uses NNPACK by itself when use_nnpack decides it is
+  // worth it
+  auto default_backend = candidates.front() == CPUConvBackend::Nnpack ?
+      CPUConvBackend::Native : candidates.front();
+  if (!at::globalContext().benchmarkCPUConv() || candidates.size() == 1 ||
+      input.is_mkldnn() || weight.is_mkldnn()) {
+    return default_backend;
+  }
+
+  auto key = cpu_conv_autotune_key(input, weight, bias, params);
+  auto cached = cpu_conv_autotune_lookup(key);
+  // A cache loaded from a file may name a backend this build doesn't have
+  if (cached && std::find(candidates.begin(), candidates.end(), *cached) != candidates.end()) {
+    return *cached;
+  }
+  auto backend = cpu_conv_autotune(candidates, default_backend, input, weight, bias, params);
+  cpu_conv_autotune_insert(key, backend);
+  return backend;
+}
+
 at::Tensor _convolution(
     const Tensor& input_r, const Tensor& weight_r, const Tensor& bias_r,
     IntArrayRef stride_, IntArrayRef padding_, IntArrayRef dilation_,
@@ -712,71 +916,11 @@ at::Tensor _convolution(
           input.contiguous(), weight, bias,
           params.padding, params.stride, params.dilation, params.groups, params.benchmark, params.deterministic);
     }
-  } else if (params.use_mkldnn(input)) {
-#if AT_MKLDNN_ENABLED()
-    TORCH_CHECK(input.options().type_equal(weight.options()),
-             "Input type (", input.toString(), ") and weight type (", weight.toString(),
-             ") should be the same");
-    TORCH_CHECK(!bias.defined() || (input.options().type_equal(bias.options())),
-             "Input type (", input.toString(), ") and bias type (", bias.toString(),
-             ") should be the same");
-    if (!input_is_mkldnn) {
-      output = at::mkldnn_convolution(input.contiguous(), weight.contiguous(), bias.defined() ? bias.contiguous() : bias,
-                                      params.padding, params.stride, params.dilation, params.groups);
-    } else {
-      // do not call contiguous on mkldnn tensor
-      output = at::mkldnn_convolution(input, weight, bias,
-                                      params.padding, params.stride, params.dilation, params.groups);
-    }
-#endif
-  } else if (params.use_xnnpack(input, weight, bias)) {
-    // Using prepacked conv is preferred, but XNNPACK is still the fastest
-    // option for NHWC.
-    output = xnnpack::convolution2d(
-        input,
-        weight,
-        bias,
-        params.padding,
-        params.stride,
-        params.dilation,
-        params.groups);
-  } else if (params.use_cpu_depthwise3x3_winograd(input, weight, bias)) {
-    output = convolution_depthwise3x3_winograd_stub(
-        input.device().type(),
-        input,
-        weight,
-        bias,
-        params.stride,
-        params.padding,
-        params.groups);
-  } else if (
-        !params.transposed && (input.ndimension() == 5) &&
-        (input.device().type() == c10::DeviceType::CPU) &&
-        !params.is_dilated()) {
-      // fast path for grouped conv3d
-      output = at::slow_conv3d(
-          input,
-          weight,
-          weight.sizes().slice(2),
-          bias,
-          params.stride,
-          params.padding);
-  } else if (input.device().type() == c10::DeviceType::CPU || input.device().type() == c10::DeviceType::CUDA) {
-    if (params.groups == 1) {
-      output = at::_convolution_nogroup(
-          input.contiguous(), weight, bias, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
-    } else {
-      std::vector<Tensor> outputs(params.groups);
-      input = input.contiguous();
-      for (int g = 0; g < params.groups; ++g) {
-        auto input_g = subtensor(input, 1, params.groups, g);
-        auto weight_g = subtensor(weight, 0, params.groups, g);
-        auto bias_g = subtensor(bias, 0, params.groups, g);
-        outputs[g] = at::_convolution_nogroup(
-            input_g, weight_g, bias_g, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
-      }
-      output = at::cat(outputs, 1);
-    }
+  } else if (input.device().type() == c10::DeviceType::CPU) {
+    output = cpu_convolution(
+        select_cpu_conv_backend(input, weight, bias, params), input, weight, bias, params);
+  } else if (input.device().type() == c10::DeviceType::CUDA) {
+    output = convolution_per_group(input, weight, bias, params);
   } else {
     // Only reach here when input is backend with out-of-source implementation.
     output = at::convolution_overrideable(input, weight, bias, params.stride, params.padding, params.dilation, params.transposed, params.output_padding, params.groups);
@@ -831,7 +975,7 @@ at::Tensor _convolution_nogroup(
         if (params.use_nnpack(input)) {
 #if AT_NNPACK_ENABLED()
           return at::_nnpack_spatial_convolution(
-              input, weight, bias, padding, stride);
+              input.contiguous(), weight, bias, padding, stride);
 #endif
         } else {
           /* CPU implementation has specialized MM kernels
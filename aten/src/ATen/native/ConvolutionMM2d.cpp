@@ -7,6 +7,10 @@
 #include <ATen/div_rtn.h>
 #include <ATen/native/Unfold2d.h>
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
 namespace at {
 namespace native {
 
@@ -367,6 +371,490 @@ static void slow_conv2d_backward_parameters_out_cpu_template(
   }
 }
 
+
+// Channels last inputs are convolved in place, without converting them to
+// contiguous. Each output pixel is a row of a (batch * output_height *
+// output_width, n_output_plane) matrix, computed as the product of a row of
+// (kernel_height * kernel_width * n_input_plane) input values and the weight
+// permuted to the same order. Since the channels of a pixel are contiguous in
+// the input, a 1x1 convolution with unit stride and no padding needs no
+// unfolding at all, and other kernels are unfolded a tile of rows at a time
+// instead of a full column buffer per frame.
+
+static inline bool slow_conv2d_use_channels_last(const Tensor& input) {
+  return input.suggest_memory_format() == at::MemoryFormat::ChannelsLast;
+}
+
+// Number of elements of the column buffer of a tile.
+constexpr int64_t kChannelsLastTileElements = 1 << 18;
+
+static inline int64_t channels_last_tile_rows(int64_t row_size) {
+  return std::min<int64_t>(
+      std::max<int64_t>(kChannelsLastTileElements / row_size, 16), 512);
+}
+
+// Whether the input pixels differ from the output pixels, 1x1 convolutions
+// with unit stride and no padding multiply the input directly.
+static inline bool channels_last_needs_unfold(
+    int64_t kernel_height,
+    int64_t kernel_width,
+    int64_t stride_height,
+    int64_t stride_width,
+    int64_t pad_height,
+    int64_t pad_width) {
+  return kernel_height != 1 || kernel_width != 1 || stride_height != 1 ||
+      stride_width != 1 || pad_height != 0 || pad_width != 0;
+}
+
+// View of a channels last tensor as a (batch * height * width, channels)
+// matrix.
+static inline Tensor view_channels_last_2d(const Tensor& tensor) {
+  return tensor.permute({0, 2, 3, 1}).view({-1, tensor.size(1)});
+}
+
+// The weight as a (n_output_plane, kernel_height * kernel_width *
+// n_input_plane) matrix, in the order of the unfolded channels last rows.
+static Tensor view_weight_channels_last_2d(
+    const Tensor& weight,
+    int64_t n_input_plane,
+    int64_t kernel_height,
+    int64_t kernel_width) {
+  const int64_t n_output_plane = weight.size(0);
+  return weight
+      .reshape({n_output_plane, n_input_plane, kernel_height, kernel_width})
+      .permute({0, 2, 3, 1})
+      .contiguous()
+      .view({n_output_plane, -1});
+}
+
+// Unfolds the output pixels [row_begin, row_end) of a channels last input
+// into the rows of columns.
+template <typename scalar_t>
+static void unfolded2d_channels_last_copy(
+    const scalar_t* input,
+    scalar_t* columns,
+    int64_t row_begin,
+    int64_t row_end,
+    int64_t n_input_plane,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t output_height,
+    int64_t output_width,
+    int64_t kernel_height,
+    int64_t kernel_width,
+    int64_t stride_height,
+    int64_t stride_width,
+    int64_t pad_height,
+    int64_t pad_width) {
+  for (int64_t row = row_begin; row < row_end; row++) {
+    const int64_t n = row / (output_height * output_width);
+    const int64_t oh = (row / output_width) % output_height;
+    const int64_t ow = row % output_width;
+    const scalar_t* input_n =
+        input + n * input_height * input_width * n_input_plane;
+    scalar_t* dst = columns +
+        (row - row_begin) * kernel_height * kernel_width * n_input_plane;
+    for (int64_t kh = 0; kh < kernel_height; kh++) {
+      const int64_t ih = oh * stride_height - pad_height + kh;
+      for (int64_t kw = 0; kw < kernel_width; kw++) {
+        const int64_t iw = ow * stride_width - pad_width + kw;
+        if (ih >= 0 && ih < input_height && iw >= 0 && iw < input_width) {
+          std::memcpy(
+              dst,
+              input_n + (ih * input_width + iw) * n_input_plane,
+              n_input_plane * sizeof(scalar_t));
+        } else {
+          std::fill_n(dst, n_input_plane, scalar_t(0));
+        }
+        dst += n_input_plane;
+      }
+    }
+  }
+}
+
+// Adds the rows of columns for the output pixels [row_begin, row_end) to the
+// input positions they were unfolded from, the reverse of
+// unfolded2d_channels_last_copy.
+template <typename scalar_t>
+static void unfolded2d_channels_last_acc(
+    const scalar_t* columns,
+    scalar_t* input,
+    int64_t row_begin,
+    int64_t row_end,
+    int64_t n_input_plane,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t output_height,
+    int64_t output_width,
+    int64_t kernel_height,
+    int64_t kernel_width,
+    int64_t stride_height,
+    int64_t stride_width,
+    int64_t pad_height,
+    int64_t pad_width) {
+  for (int64_t row = row_begin; row < row_end; row++) {
+    const int64_t n = row / (output_height * output_width);
+    const int64_t oh = (row / output_width) % output_height;
+    const int64_t ow = row % output_width;
+    scalar_t* input_n = input + n * input_height * input_width * n_input_plane;
+    const scalar_t* src = columns +
+        (row - row_begin) * kernel_height * kernel_width * n_input_plane;
+    for (int64_t kh = 0; kh < kernel_height; kh++) {
+      const int64_t ih = oh * stride_height - pad_height + kh;
+      for (int64_t kw = 0; kw < kernel_width; kw++) {
+        const int64_t iw = ow * stride_width - pad_width + kw;
+        if (ih >= 0 && ih < input_height && iw >= 0 && iw < input_width) {
+          scalar_t* dst = input_n + (ih * input_width + iw) * n_input_plane;
+          for (int64_t c = 0; c < n_input_plane; c++) {
+            dst[c] += src[c];
+          }
+        }
+        src += n_input_plane;
+      }
+    }
+  }
+}
+
+static void slow_conv2d_channels_last_unfold(
+    const Tensor& input,
+    Tensor& columns,
+    int64_t row_begin,
+    int64_t row_end,
+    int64_t output_height,
+    int64_t output_width,
+    int64_t kernel_height,
+    int64_t kernel_width,
+    int64_t stride_height,
+    int64_t stride_width,
+    int64_t pad_height,
+    int64_t pad_width) {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16,
+      input.scalar_type(),
+      "slow_conv2d_channels_last_unfold",
+      [&] {
+        unfolded2d_channels_last_copy<scalar_t>(
+            input.data_ptr<scalar_t>(),
+            columns.data_ptr<scalar_t>(),
+            row_begin,
+            row_end,
+            input.size(1),
+            input.size(2),
+            input.size(3),
+            output_height,
+            output_width,
+            kernel_height,
+            kernel_width,
+            stride_height,
+            stride_width,
+            pad_height,
+            pad_width);
+      });
+}
+
+static void slow_conv2d_channels_last_forward_out(
+    Tensor& output,
+    const Tensor& input_,
+    const Tensor& weight,
+    const Tensor& bias,
+    int64_t kernel_height,
+    int64_t kernel_width,
+    int64_t stride_height,
+    int64_t stride_width,
+    int64_t pad_height,
+    int64_t pad_width) {
+  const Tensor input = input_.contiguous(at::MemoryFormat::ChannelsLast);
+  const int64_t batch_size = input.size(0);
+  const int64_t n_input_plane = input.size(1);
+  const int64_t input_height = input.size(2);
+  const int64_t input_width = input.size(3);
+  const int64_t n_output_plane = weight.size(0);
+  const int64_t output_height =
+      (input_height + 2 * pad_height - kernel_height) / stride_height + 1;
+  const int64_t output_width =
+      (input_width + 2 * pad_width - kernel_width) / stride_width + 1;
+
+  output.resize_(
+      {batch_size, n_output_plane, output_height, output_width},
+      at::MemoryFormat::ChannelsLast);
+
+  const Tensor weight_2d = view_weight_channels_last_2d(
+      weight, n_input_plane, kernel_height, kernel_width);
+  const Tensor tweight = weight_2d.t();
+  const int64_t row_size = weight_2d.size(1);
+  const bool unfold = channels_last_needs_unfold(
+      kernel_height, kernel_width, stride_height, stride_width, pad_height, pad_width);
+  const Tensor input_2d = view_channels_last_2d(input);
+  Tensor output_2d = view_channels_last_2d(output);
+  const int64_t num_rows = output_2d.size(0);
+  const int64_t tile_rows = channels_last_tile_rows(row_size);
+
+  at::parallel_for(0, num_rows, tile_rows, [&](int64_t start, int64_t end) {
+    NoGradGuard no_grad;
+    AutoNonVariableTypeMode non_variable_type_mode;
+    Tensor columns;
+    if (unfold) {
+      columns = at::empty(
+          {std::min(tile_rows, end - start), row_size}, input.options());
+    }
+    for (int64_t row = start; row < end; row += tile_rows) {
+      const int64_t row_end = std::min(row + tile_rows, end);
+      Tensor output_tile = output_2d.slice(0, row, row_end);
+      Tensor input_tile;
+      if (unfold) {
+        slow_conv2d_channels_last_unfold(
+            input,
+            columns,
+            row,
+            row_end,
+            output_height,
+            output_width,
+            kernel_height,
+            kernel_width,
+            stride_height,
+            stride_width,
+            pad_height,
+            pad_width);
+        input_tile = columns.slice(0, 0, row_end - row);
+      } else {
+        input_tile = input_2d.slice(0, row, row_end);
+      }
+      if (bias.defined()) {
+        output_tile.copy_(bias.expand_as(output_tile));
+        output_tile.addmm_(input_tile, tweight);
+      } else {
+        at::mm_out(output_tile, input_tile, tweight);
+      }
+    }
+  });
+}
+
+static void slow_conv2d_channels_last_backward_input_out(
+    Tensor& grad_input,
+    const Tensor& grad_output_,
+    const Tensor& input,
+    const Tensor& weight,
+    int64_t kernel_height,
+    int64_t kernel_width,
+    int64_t stride_height,
+    int64_t stride_width,
+    int64_t pad_height,
+    int64_t pad_width) {
+  const Tensor grad_output =
+      grad_output_.contiguous(at::MemoryFormat::ChannelsLast);
+  const int64_t batch_size = input.size(0);
+  const int64_t n_input_plane = input.size(1);
+  const int64_t input_height = input.size(2);
+  const int64_t input_width = input.size(3);
+  const int64_t output_height = grad_output.size(2);
+  const int64_t output_width = grad_output.size(3);
+
+  grad_input.resize_(input.sizes(), at::MemoryFormat::ChannelsLast);
+
+  const Tensor weight_2d = view_weight_channels_last_2d(
+      weight, n_input_plane, kernel_height, kernel_width);
+  const int64_t row_size = weight_2d.size(1);
+  const bool unfold = channels_last_needs_unfold(
+      kernel_height, kernel_width, stride_height, stride_width, pad_height, pad_width);
+  const Tensor grad_output_2d = view_channels_last_2d(grad_output);
+  Tensor grad_input_2d = view_channels_last_2d(grad_input);
+  const int64_t tile_rows = channels_last_tile_rows(row_size);
+
+  if (!unfold) {
+    // Every input pixel gets the gradient of exactly one output pixel
+    at::parallel_for(
+        0, grad_output_2d.size(0), tile_rows, [&](int64_t start, int64_t end) {
+          NoGradGuard no_grad;
+          AutoNonVariableTypeMode non_variable_type_mode;
+          Tensor grad_input_tile = grad_input_2d.slice(0, start, end);
+          at::mm_out(
+              grad_input_tile, grad_output_2d.slice(0, start, end), weight_2d);
+        });
+    return;
+  }
+
+  // Output pixels of a frame overlap in the input, frames don't
+  grad_input.zero_();
+  const int64_t frame_rows = output_height * output_width;
+  at::parallel_for(0, batch_size, 0, [&](int64_t start, int64_t end) {
+    NoGradGuard no_grad;
+    AutoNonVariableTypeMode non_variable_type_mode;
+    Tensor columns = at::empty(
+        {std::min(tile_rows, frame_rows), row_size}, grad_output.options());
+    for (int64_t row = start * frame_rows; row < end * frame_rows;
+         row += tile_rows) {
+      const int64_t row_end = std::min(row + tile_rows, end * frame_rows);
+      Tensor columns_tile = columns.slice(0, 0, row_end - row);
+      at::mm_out(
+          columns_tile, grad_output_2d.slice(0, row, row_end), weight_2d);
+      AT_DISPATCH_FLOATING_TYPES_AND(
+          at::ScalarType::BFloat16,
+          grad_input.scalar_type(),
+          "slow_conv2d_channels_last_backward_input",
+          [&] {
+            unfolded2d_channels_last_acc<scalar_t>(
+                columns.data_ptr<scalar_t>(),
+                grad_input.data_ptr<scalar_t>(),
+                row,
+                row_end,
+                n_input_plane,
+                input_height,
+                input_width,
+                output_height,
+                output_width,
+                kernel_height,
+                kernel_width,
+                stride_height,
+                stride_width,
+                pad_height,
+                pad_width);
+          });
+    }
+  });
+}
+
+static void slow_conv2d_channels_last_backward_parameters_out(
+    Tensor& grad_weight,
+    Tensor& grad_bias,
+    const Tensor& input_,
+    const Tensor& grad_output_,
+    int64_t kernel_height,
+    int64_t kernel_width,
+    int64_t stride_height,
+    int64_t stride_width,
+    int64_t pad_height,
+    int64_t pad_width) {
+  const Tensor input = input_.contiguous(at::MemoryFormat::ChannelsLast);
+  const Tensor grad_output =
+      grad_output_.contiguous(at::MemoryFormat::ChannelsLast);
+  const Tensor grad_output_2d = view_channels_last_2d(grad_output);
+
+  if (grad_bias.defined()) {
+    grad_bias.copy_(grad_output_2d.sum(0));
+  }
+  if (!grad_weight.defined()) {
+    return;
+  }
+
+  const int64_t n_input_plane = input.size(1);
+  const int64_t n_output_plane = grad_output.size(1);
+  const int64_t output_height = grad_output.size(2);
+  const int64_t output_width = grad_output.size(3);
+  const int64_t row_size = kernel_height * kernel_width * n_input_plane;
+  const bool unfold = channels_last_needs_unfold(
+      kernel_height, kernel_width, stride_height, stride_width, pad_height, pad_width);
+
+  Tensor grad_weight_2d;
+  if (!unfold) {
+    grad_weight_2d = grad_output_2d.t().mm(view_channels_last_2d(input));
+  } else {
+    // Each thread sums the tiles of its rows, the partial sums are added at
+    // the end
+    grad_weight_2d = at::zeros({n_output_plane, row_size}, grad_output.options());
+    const int64_t tile_rows = channels_last_tile_rows(row_size);
+    std::mutex mutex;
+    at::parallel_for(
+        0, grad_output_2d.size(0), tile_rows, [&](int64_t start, int64_t end) {
+          NoGradGuard no_grad;
+          AutoNonVariableTypeMode non_variable_type_mode;
+          Tensor columns = at::empty(
+              {std::min(tile_rows, end - start), row_size}, input.options());
+          Tensor partial = at::zeros_like(grad_weight_2d);
+          for (int64_t row = start; row < end; row += tile_rows) {
+            const int64_t row_end = std::min(row + tile_rows, end);
+            slow_conv2d_channels_last_unfold(
+                input,
+                columns,
+                row,
+                row_end,
+                output_height,
+                output_width,
+                kernel_height,
+                kernel_width,
+                stride_height,
+                stride_width,
+                pad_height,
+                pad_width);
+            partial.addmm_(
+                grad_output_2d.slice(0, row, row_end).t(),
+                columns.slice(0, 0, row_end - row));
+          }
+          std::lock_guard<std::mutex> lock(mutex);
+          grad_weight_2d.add_(partial);
+        });
+  }
+  grad_weight
+      .view({n_output_plane, n_input_plane, kernel_height, kernel_width})
+      .copy_(grad_weight_2d
+                 .view({n_output_plane, kernel_height, kernel_width, n_input_plane})
+                 .permute({0, 3, 1, 2}));
+}
+
+static void slow_conv2d_channels_last_backward_out_cpu(
+    Tensor& grad_input,
+    Tensor& grad_weight,
+    Tensor& grad_bias,
+    const Tensor& grad_output,
+    const Tensor& input,
+    const Tensor& weight,
+    IntArrayRef kernel_size,
+    IntArrayRef stride,
+    IntArrayRef padding) {
+  const int64_t kernel_height = kernel_size[0];
+  const int64_t kernel_width = kernel_size[1];
+  const int64_t pad_height = padding[0];
+  const int64_t pad_width = padding[1];
+  const int64_t stride_height = stride[0];
+  const int64_t stride_width = stride[1];
+
+  slow_conv2d_shape_check(
+      input,
+      grad_output,
+      view_weight_2d(weight),
+      Tensor(),
+      kernel_height,
+      kernel_width,
+      stride_height,
+      stride_width,
+      pad_height,
+      pad_width,
+      false);
+
+  if (grad_input.defined()) {
+    slow_conv2d_channels_last_backward_input_out(
+        grad_input,
+        grad_output,
+        input,
+        weight,
+        kernel_height,
+        kernel_width,
+        stride_height,
+        stride_width,
+        pad_height,
+        pad_width);
+  }
+
+  if (grad_weight.defined()) {
+    grad_weight.resize_(weight.sizes(), weight.suggest_memory_format());
+  }
+  if (grad_bias.defined()) {
+    grad_bias.resize_({grad_output.size(1)});
+  }
+  if (grad_weight.defined() || grad_bias.defined()) {
+    slow_conv2d_channels_last_backward_parameters_out(
+        grad_weight,
+        grad_bias,
+        input,
+        grad_output,
+        kernel_height,
+        kernel_width,
+        stride_height,
+        stride_width,
+        pad_height,
+        pad_width);
+  }
+}
+
 } // namespace
 
 std::tuple<Tensor&, Tensor&, Tensor&> slow_conv2d_forward_out_cpu(
@@ -401,6 +889,23 @@ std::tuple<Tensor&, Tensor&, Tensor&> slow_conv2d_forward_out_cpu(
       pad_width,
       false);
 
+  if (slow_conv2d_use_channels_last(self)) {
+    slow_conv2d_channels_last_forward_out(
+        output,
+        self,
+        weight_,
+        bias,
+        kernel_height,
+        kernel_width,
+        stride_height,
+        stride_width,
+        pad_height,
+        pad_width);
+    // The backward unfolds the input again, tile by tile
+    finput.resize_({0});
+    return std::tuple<Tensor&, Tensor&, Tensor&>(output, finput, fgrad_input);
+  }
+
   const Tensor input = self.contiguous();
   const int64_t ndim = input.dim();
   const int64_t dim_planes = 1;
@@ -489,6 +994,21 @@ std::tuple<Tensor&, Tensor&, Tensor&> slow_conv2d_backward_out_cpu(
     IntArrayRef padding,
     const Tensor& finput,
     const Tensor& fgrad_input) {
+  if (slow_conv2d_use_channels_last(self)) {
+    slow_conv2d_channels_last_backward_out_cpu(
+        grad_input,
+        grad_weight,
+        grad_bias,
+        grad_output,
+        self,
+        weight,
+        kernel_size,
+        stride,
+        padding);
+    return std::tuple<Tensor&, Tensor&, Tensor&>(
+        grad_input, grad_weight, grad_bias);
+  }
+
   if (grad_input.defined()) {
     slow_conv2d_backward_out_cpu_template(
         grad_input,
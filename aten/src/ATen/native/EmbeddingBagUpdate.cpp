@@ -0,0 +1,366 @@
+// Fused embedding_bag backward + sparse optimizer updates.
+//
+// Training an embedding_bag with a sparse optimizer normally materializes a
+// sparse gradient with one row per lookup, coalesces it and then runs the
+// optimizer over the coalesced rows. The functions below do all of that in one
+// pass: lookups are grouped by row, each unique row's gradient is accumulated
+// in a small fp32 buffer and the optimizer update is applied to the row right
+// away. Rows are independent, so the pass is parallel across unique rows.
+//
+// Weights (and row-wise Adagrad moments) can be stored in float, half or
+// bfloat16. Updates are computed in fp32; with stochastic rounding the fp32
+// result is rounded to the storage type up or down with probability
+// proportional to its distance from the two neighbours, so small updates are
+// not lost to round-to-nearest on average.
+
+#include <ATen/ATen.h>
+#include <ATen/CPUGeneratorImpl.h>
+#include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <ATen/TensorUtils.h>
+#include <ATen/Utils.h>
+#include <ATen/core/PhiloxRNGEngine.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+constexpr int64_t MODE_SUM = 0;
+constexpr int64_t MODE_MEAN = 1;
+
+// Uniform float in [0, 1) from 32 random bits
+inline float uniform_from_bits(uint32_t bits) {
+  return (bits >> 8) * (1.0f / (1 << 24));
+}
+
+template <typename scalar_t>
+inline scalar_t round_stochastic(float x, uint32_t /*random_bits*/) {
+  return static_cast<scalar_t>(x);
+}
+
+template <>
+inline BFloat16 round_stochastic<BFloat16>(float x, uint32_t random_bits) {
+  if (!std::isfinite(x)) {
+    return BFloat16(x);
+  }
+  // bfloat16 is the upper half of a float. Adding 16 random bits before
+  // truncating rounds the magnitude up with probability equal to the
+  // truncated fraction.
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  bits += random_bits & 0xFFFF;
+  return BFloat16(static_cast<uint16_t>(bits >> 16), BFloat16::from_bits());
+}
+
+template <>
+inline Half round_stochastic<Half>(float x, uint32_t random_bits) {
+  const Half nearest(x);
+  const float nearest_f = nearest;
+  if (!std::isfinite(x) || !std::isfinite(nearest_f) || nearest_f == x) {
+    return nearest;
+  }
+  // x lies between its nearest half and the neighbour one ulp further in the
+  // direction of x
+  const uint16_t sign = nearest.x & 0x8000;
+  const uint16_t magnitude = nearest.x & 0x7FFF;
+  const bool round_away_from_zero = std::abs(nearest_f) < std::abs(x);
+  if (!round_away_from_zero && magnitude == 0) {
+    return nearest;
+  }
+  const Half other(
+      static_cast<uint16_t>(
+          sign | (round_away_from_zero ? magnitude + 1 : magnitude - 1)),
+      Half::from_bits());
+  const float other_f = other;
+  const float p = (x - nearest_f) / (other_f - nearest_f);
+  return uniform_from_bits(random_bits) < p ? other : nearest;
+}
+
+void check_embedding_bag_update_inputs(
+    const char* fn,
+    const Tensor& weight,
+    const Tensor& grad,
+    const Tensor& indices,
+    const Tensor& offsets,
+    int64_t mode,
+    const Tensor& per_sample_weights,
+    bool include_last_offset) {
+  auto weight_arg = TensorArg(weight, "weight", 1);
+  checkScalarTypes(fn, weight_arg, {kFloat, kHalf, kBFloat16});
+  checkDim(fn, weight_arg, 2);
+  TORCH_CHECK(weight.is_contiguous(), fn, ": weight must be contiguous");
+  auto indices_arg = TensorArg(indices, "indices", 3);
+  checkScalarType(fn, indices_arg, kLong);
+  checkDim(fn, indices_arg, 1);
+  auto offsets_arg = TensorArg(offsets, "offsets", 4);
+  checkScalarType(fn, offsets_arg, kLong);
+  checkDim(fn, offsets_arg, 1);
+  auto grad_arg = TensorArg(grad, "grad", 2);
+  checkScalarTypes(fn, grad_arg, {kFloat, kHalf, kBFloat16});
+  checkDim(fn, grad_arg, 2);
+  TORCH_CHECK(
+      grad.size(1) == weight.size(1),
+      fn, ": grad has ", grad.size(1), " columns but weight has ",
+      weight.size(1));
+  TORCH_CHECK(
+      offsets.size(0) == grad.size(0) + (include_last_offset ? 1 : 0),
+      fn, ": expected ", grad.size(0) + (include_last_offset ? 1 : 0),
+      " offsets for a grad of ", grad.size(0), " bags, got ", offsets.size(0));
+  TORCH_CHECK(
+      mode == MODE_SUM || mode == MODE_MEAN,
+      fn, ": only the 'sum' and 'mean' modes are supported");
+  if (per_sample_weights.defined()) {
+    TORCH_CHECK(
+        mode == MODE_SUM,
+        fn, ": per_sample_weights only supported with mode='sum'");
+    TORCH_CHECK(
+        per_sample_weights.dim() == 1 &&
+            per_sample_weights.numel() == indices.numel(),
+        fn, ": per_sample_weights must be 1-D with one weight per index");
+  }
+}
+
+// Lookups of a batch grouped by row: order[starts[i]:starts[i + 1]] are the
+// positions in `indices` that reference the i-th unique row
+struct RowGroups {
+  Tensor sorted_indices;
+  Tensor order;
+  std::vector<int64_t> starts;
+};
+
+RowGroups group_by_row(const Tensor& indices, int64_t num_rows) {
+  RowGroups groups;
+  std::tie(groups.sorted_indices, groups.order) = indices.sort();
+  const auto* sorted_data = groups.sorted_indices.data_ptr<int64_t>();
+  const int64_t numel = indices.numel();
+  if (numel > 0) {
+    TORCH_CHECK(
+        sorted_data[0] >= 0 && sorted_data[numel - 1] < num_rows,
+        "embedding_bag update: indices must be in [0, ", num_rows, ")");
+  }
+  for (int64_t i = 0; i < numel; ++i) {
+    if (i == 0 || sorted_data[i] != sorted_data[i - 1]) {
+      groups.starts.push_back(i);
+    }
+  }
+  groups.starts.push_back(numel);
+  return groups;
+}
+
+// Bag of every position in `indices`
+std::vector<int64_t> compute_bag_of_index(
+    const Tensor& offsets,
+    int64_t num_bags,
+    int64_t num_indices) {
+  std::vector<int64_t> bag_of_index(num_indices);
+  const auto* offsets_data = offsets.data_ptr<int64_t>();
+  const int64_t num_offsets = offsets.size(0);
+  for (int64_t bag = 0; bag < num_bags; ++bag) {
+    const int64_t begin = offsets_data[bag];
+    const int64_t end =
+        bag + 1 < num_offsets ? offsets_data[bag + 1] : num_indices;
+    TORCH_CHECK(
+        begin >= 0 && begin <= end && end <= num_indices &&
+            (bag > 0 || begin == 0),
+        "embedding_bag update: offsets must start at 0, be non-decreasing "
+        "and not exceed the number of indices ", num_indices);
+    std::fill(
+        bag_of_index.begin() + begin, bag_of_index.begin() + end, bag);
+  }
+  return bag_of_index;
+}
+
+template <typename weight_t, typename momentum_t>
+void embedding_bag_update_kernel(
+    Tensor& weight,
+    momentum_t* momentum_data,
+    const Tensor& grad_,
+    const Tensor& indices_,
+    const Tensor& offsets_,
+    int64_t mode,
+    const Tensor& per_sample_weights_,
+    double lr,
+    double eps,
+    double weight_decay,
+    bool stochastic_rounding) {
+  const auto grad = grad_.contiguous().to(kFloat);
+  const auto indices = indices_.contiguous();
+  const auto offsets = offsets_.contiguous();
+  Tensor per_sample_weights;
+  const float* per_sample_weights_data = nullptr;
+  if (per_sample_weights_.defined()) {
+    per_sample_weights = per_sample_weights_.contiguous().to(kFloat);
+    per_sample_weights_data = per_sample_weights.data_ptr<float>();
+  }
+
+  const int64_t dim = weight.size(1);
+  const int64_t num_bags = grad.size(0);
+  const int64_t num_indices = indices.numel();
+  const auto bag_of_index =
+      compute_bag_of_index(offsets, num_bags, num_indices);
+  const auto groups = group_by_row(indices, weight.size(0));
+  const int64_t num_groups = groups.starts.size() - 1;
+
+  uint64_t seed = 0;
+  if (stochastic_rounding) {
+    auto* generator = get_generator_or_default<CPUGeneratorImpl>(
+        c10::nullopt, detail::getDefaultCPUGenerator());
+    // See Note [Acquire lock when using random generators]
+    std::lock_guard<std::mutex> lock(generator->mutex_);
+    seed = generator->random64();
+  }
+
+  const auto* offsets_data = offsets.data_ptr<int64_t>();
+  const int64_t num_offsets = offsets.size(0);
+  const auto* grad_data = grad.data_ptr<float>();
+  const auto* sorted_data = groups.sorted_indices.data_ptr<int64_t>();
+  const auto* order_data = groups.order.data_ptr<int64_t>();
+  auto* weight_data = weight.data_ptr<weight_t>();
+  const float lr_f = lr;
+  const float eps_f = eps;
+  const float weight_decay_f = weight_decay;
+
+  const int64_t grain_size =
+      std::max<int64_t>(1, internal::GRAIN_SIZE / std::max<int64_t>(4 * dim, 1));
+  at::parallel_for(0, num_groups, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<float> row_grad(dim);
+    for (int64_t group = begin; group < end; ++group) {
+      const int64_t row = sorted_data[groups.starts[group]];
+
+      std::fill(row_grad.begin(), row_grad.end(), 0.f);
+      for (int64_t j = groups.starts[group]; j < groups.starts[group + 1];
+           ++j) {
+        const int64_t index_pos = order_data[j];
+        const int64_t bag = bag_of_index[index_pos];
+        float scale = per_sample_weights_data
+            ? per_sample_weights_data[index_pos]
+            : 1.f;
+        if (mode == MODE_MEAN) {
+          const int64_t bag_end =
+              bag + 1 < num_offsets ? offsets_data[bag + 1] : num_indices;
+          scale /= bag_end - offsets_data[bag];
+        }
+        const float* grad_row = grad_data + bag * dim;
+        for (int64_t k = 0; k < dim; ++k) {
+          row_grad[k] += scale * grad_row[k];
+        }
+      }
+
+      weight_t* weight_row = weight_data + row * dim;
+      if (weight_decay_f != 0) {
+        for (int64_t k = 0; k < dim; ++k) {
+          row_grad[k] += weight_decay_f * static_cast<float>(weight_row[k]);
+        }
+      }
+
+      // Random numbers depend on the row only, so the result does not depend
+      // on the number of threads
+      philox_engine engine(seed, row);
+      float step = lr_f;
+      if (momentum_data) {
+        float sum_sq = 0;
+        for (int64_t k = 0; k < dim; ++k) {
+          sum_sq += row_grad[k] * row_grad[k];
+        }
+        const float momentum =
+            static_cast<float>(momentum_data[row]) + sum_sq / dim;
+        momentum_data[row] = stochastic_rounding
+            ? round_stochastic<momentum_t>(momentum, engine())
+            : static_cast<momentum_t>(momentum);
+        step = lr_f / (std::sqrt(momentum) + eps_f);
+      }
+
+      if (stochastic_rounding) {
+        for (int64_t k = 0; k < dim; ++k) {
+          weight_row[k] = round_stochastic<weight_t>(
+              static_cast<float>(weight_row[k]) - step * row_grad[k],
+              engine());
+        }
+      } else {
+        for (int64_t k = 0; k < dim; ++k) {
+          weight_row[k] = static_cast<weight_t>(
+              static_cast<float>(weight_row[k]) - step * row_grad[k]);
+        }
+      }
+    }
+  });
+}
+
+} // namespace
+
+void _embedding_bag_rowwise_adagrad_update_cpu(
+    Tensor& weight,
+    Tensor& momentum,
+    const Tensor& grad,
+    const Tensor& indices,
+    const Tensor& offsets,
+    int64_t mode,
+    const Tensor& per_sample_weights,
+    bool include_last_offset,
+    double lr,
+    double eps,
+    double weight_decay,
+    bool stochastic_rounding) {
+  static const char* fn = "_embedding_bag_rowwise_adagrad_update";
+  check_embedding_bag_update_inputs(
+      fn, weight, grad, indices, offsets, mode, per_sample_weights,
+      include_last_offset);
+  auto momentum_arg = TensorArg(momentum, "momentum", 2);
+  checkScalarTypes(fn, momentum_arg, {kFloat, kHalf, kBFloat16});
+  TORCH_CHECK(
+      momentum.dim() == 1 && momentum.size(0) == weight.size(0) &&
+          momentum.is_contiguous(),
+      fn, ": momentum must be a contiguous 1-D tensor with one entry per row "
+      "of weight");
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      kHalf, kBFloat16, weight.scalar_type(),
+      "_embedding_bag_rowwise_adagrad_update", [&] {
+        using weight_t = scalar_t;
+        AT_DISPATCH_FLOATING_TYPES_AND2(
+            kHalf, kBFloat16, momentum.scalar_type(),
+            "_embedding_bag_rowwise_adagrad_update", [&] {
+              embedding_bag_update_kernel<weight_t, scalar_t>(
+                  weight, momentum.data_ptr<scalar_t>(), grad, indices,
+                  offsets, mode, per_sample_weights, lr, eps, weight_decay,
+                  stochastic_rounding);
+            });
+      });
+}
+
+void _embedding_bag_sgd_update_cpu(
+    Tensor& weight,
+    const Tensor& grad,
+    const Tensor& indices,
+    const Tensor& offsets,
+    int64_t mode,
+    const Tensor& per_sample_weights,
+    bool include_last_offset,
+    double lr,
+    double weight_decay,
+    bool stochastic_rounding) {
+  static const char* fn = "_embedding_bag_sgd_update";
+  check_embedding_bag_update_inputs(
+      fn, weight, grad, indices, offsets, mode, per_sample_weights,
+      include_last_offset);
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      kHalf, kBFloat16, weight.scalar_type(), "_embedding_bag_sgd_update", [&] {
+        embedding_bag_update_kernel<scalar_t, float>(
+            weight, /*momentum_data=*/nullptr, grad, indices, offsets, mode,
+            per_sample_weights, lr, /*eps=*/0, weight_decay,
+            stochastic_rounding);
+      });
+}
+
+} // namespace native
+} // namespace at
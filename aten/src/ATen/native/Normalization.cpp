@@ -16,7 +16,9 @@ static const int MIOPEN_DIM_MAX = 5;
 
 namespace at { namespace native {
 
-DEFINE_DISPATCH(batch_norm_cpu_inference_contiguous_stub);
+DEFINE_DISPATCH(batch_norm_cpu_stub);
+DEFINE_DISPATCH(batch_norm_cpu_collect_stats_stub);
+DEFINE_DISPATCH(batch_norm_cpu_backward_stub);
 
 namespace {
   void check_dims_match_num_input_features(const char* arg_name, int64_t expected, int64_t actual){
@@ -59,87 +61,28 @@ struct Var {
   }
 };
 
-template<typename scalar_t>
-void batch_norm_cpu_inference_collect_linear_and_constant_terms(
-    scalar_t* alpha, scalar_t* beta, int64_t n_channel,
-    const Tensor& weight /* optional */, const Tensor& bias /* optional */,
-    const Tensor& mean, const Tensor& variance, double eps) {
-
-  const scalar_t* weight_data = weight.defined() ? weight.data_ptr<scalar_t>() : nullptr;
-  const scalar_t* bias_data = bias.defined() ? bias.data_ptr<scalar_t>() : nullptr;
-  const scalar_t* mean_data = mean.data_ptr<scalar_t>();
-  const scalar_t* var_data = variance.data_ptr<scalar_t>();
-
-  /// Collect the linear and constant terms regarding the input.
-  /// output(n, c, h, w)
-  ///     = (input(n, c, h, w) - mean(c)) / sqrt(var(c) + eps) * weight(c)
-  ///         + bias(c)
-  ///     = input(n, c, h, w) * inv_var(c) * weight(c)
-  ///         - mean(c) * inv_var(c) * weight(c) + bias(c),
-  /// where inv_var(c) = 1 / sqrt(var(c) + eps).
-  /// So the linear term, alpha(c) = inv_var(c) * weight(c),
-  ///   the constant term beta(c) = bias(c) - mean(c) * inv_var(c) * weight(c)
-  /// Note that this is only a good idea if (input_size >> c), in degenerate
-  /// cases where image_size == 1 && batch_size == 1, it is slow.
-  for (int64_t c = 0; c < n_channel; c++) {
-    scalar_t inv_var = 1 / std::sqrt(var_data[c] + static_cast<scalar_t>(eps));
-    scalar_t weight_v = weight_data ? weight_data[c] : 1;
-    scalar_t bias_v = bias_data ? bias_data[c] : 0;
-    alpha[c] = inv_var * weight_v;
-    beta[c] = bias_v - mean_data[c] * inv_var * weight_v;
-  }
+// Memory format that the batch_norm_cpu stubs see the input in.
+static inline MemoryFormat batch_norm_cpu_memory_format(const Tensor& input) {
+  return input.is_contiguous() ? MemoryFormat::Contiguous : input.suggest_memory_format();
 }
 
-/// A fast path for CPU inference when all tensors are channels last contiguous.
-/// This code achieves machine bandwidth peak without AVX support.
-/// If this changes for future architectures, we can move it to the cpu/
-/// directory.
-template<typename scalar_t>
-void batch_norm_cpu_inference_channels_last(Tensor& output, const Tensor& input,
-    const Tensor& weight /* optional */, const Tensor& bias /* optional */,
-    const Tensor& mean, const Tensor& variance, double eps) {
-
-  int64_t n_batch = input.size(0);
-  int64_t n_channel = input.size(1);
-  int64_t image_size = input.numel() / n_batch / n_channel;
-
-  scalar_t* output_data = output.data_ptr<scalar_t>();
-  const scalar_t* input_data = input.data_ptr<scalar_t>();
-
-  Tensor alpha = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  Tensor beta = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
-  scalar_t* beta_data = beta.data_ptr<scalar_t>();
-
-  batch_norm_cpu_inference_collect_linear_and_constant_terms<scalar_t>(
-      alpha_data, beta_data, n_channel, weight, bias, mean, variance, eps);
-
-  // Apply the linear terms to the input,
-  // output(n, c, h, w) = input(n, c, h, w) * alpha(c) + beta(c)
-  // No need to use parallel_for as this function is supposed to be
-  // memory-limited.
-  // Keep the loop struture simple to make sure compiler vectorization kicks in.
-  if (n_channel != 1) {
-    for (int64_t n = 0; n < n_batch; ++n) {
-      for (int64_t i = 0; i < image_size; ++i) {
-        for (int64_t c = 0; c < n_channel; ++c) {
-          // Keep all the offset calculation within the inner loop for
-          // simplicity. Compilers are very good at hoisting the common part
-          // outside.
-          int64_t offset = n * image_size * n_channel + i * n_channel + c;
-          output_data[offset] = input_data[offset] * alpha_data[c] + beta_data[c];
-        }
-      }
-    }
-  } else {
-    // n_channel == 1
-    for (int64_t n = 0; n < n_batch; ++n) {
-      for (int64_t i = 0; i < image_size; ++i) {
-        int64_t offset = n * image_size + i;
-        output_data[offset] = input_data[offset] * alpha_data[0] + beta_data[0];
-      }
-    }
-  }
+static inline bool is_contiguous_or_undefined(const Tensor& t) {
+  return !t.defined() || t.is_contiguous();
+}
+
+// The vectorized kernels of batch_norm.h handle non-empty inputs that are
+// contiguous in the contiguous or in the channels last memory format.
+static inline bool batch_norm_use_cpu_kernel(const Tensor& input,
+    const Tensor& weight, const Tensor& bias, const Tensor& running_mean,
+    const Tensor& running_var, const Tensor& save_mean, const Tensor& save_invstd) {
+  return input.numel() > 0
+      && input.is_contiguous(batch_norm_cpu_memory_format(input))
+      && is_contiguous_or_undefined(weight)
+      && is_contiguous_or_undefined(bias)
+      && is_contiguous_or_undefined(running_mean)
+      && is_contiguous_or_undefined(running_var)
+      && is_contiguous_or_undefined(save_mean)
+      && is_contiguous_or_undefined(save_invstd);
 }
 
 template<typename scalar_t>
@@ -149,29 +92,11 @@ std::tuple<Tensor,Tensor,Tensor> batch_norm_cpu_transform_input_template(
     const Tensor& running_mean /* optional */, const Tensor& running_var /* optional */,
     bool train, double eps) {
 
-  // Check if we should use the fast path for contiguous memory format
-  if (!train && input.is_contiguous()
-      && (!weight.defined() || weight.is_contiguous())
-      && (!bias.defined() || bias.is_contiguous())
-      && running_mean.is_contiguous()
-      && running_var.is_contiguous()) {
-
-    Tensor output = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-    batch_norm_cpu_inference_contiguous_stub(kCPU, output, input, weight,
-        bias, running_mean, running_var, eps);
-    return std::make_tuple(output, save_mean, save_invstd);
-  }
-
-  // Check if we should use the fast path for channel last memory format
-  if (!train && input.is_contiguous(at::MemoryFormat::ChannelsLast)
-      && (!weight.defined() || weight.is_contiguous())
-      && (!bias.defined() || bias.is_contiguous())
-      && running_mean.is_contiguous()
-      && running_var.is_contiguous()) {
-
-    Tensor output = at::empty_like(input, at::MemoryFormat::ChannelsLast);
-    batch_norm_cpu_inference_channels_last<scalar_t>(
-      output, input, weight, bias, running_mean, running_var, eps);
+  if (batch_norm_use_cpu_kernel(input, weight, bias, running_mean, running_var,
+                                save_mean, save_invstd)) {
+    Tensor output = at::empty_like(input, batch_norm_cpu_memory_format(input));
+    batch_norm_cpu_stub(kCPU, output, input, weight, bias, save_mean, save_invstd,
+        running_mean, running_var, train, eps);
     return std::make_tuple(output, save_mean, save_invstd);
   }
 
@@ -230,6 +155,26 @@ std::tuple<Tensor,Tensor> batch_norm_cpu_update_stats_template(
   auto running_mean_a = conditional_accessor_1d<scalar_t>(running_mean);
   auto running_var_a = conditional_accessor_1d<scalar_t>(running_var);
 
+  if (batch_norm_use_cpu_kernel(input, {}, {}, {}, {}, {}, {})) {
+    Tensor var_sum = at::empty({n_input}, input.options());
+    batch_norm_cpu_collect_stats_stub(kCPU, save_mean, var_sum, input);
+    auto var_sum_a = var_sum.accessor<scalar_t, 1>();
+    for (int64_t f = 0; f < n_input; ++f) {
+      accscalar_t var_sum_f = var_sum_a[f];
+      save_var_transform_a[f] = VarTransform<accscalar_t>{}(var_sum_f / n, eps);
+
+      // update running averages
+      if (running_mean.defined()) {
+        running_mean_a[f] = momentum * save_mean_a[f] + (1 - momentum) * running_mean_a[f];
+      }
+      if (running_var.defined()) {
+        accscalar_t unbiased_var = var_sum_f / (n - 1);
+        running_var_a[f] = momentum * unbiased_var + (1 - momentum) * running_var_a[f];
+      }
+    }
+    return std::make_tuple(save_mean, save_var_transform);
+  }
+
   parallel_for(0, n_input, 1, [&](int64_t b_begin, int64_t b_end) {
     for (int64_t f = b_begin; f < b_end; ++f) {
       Tensor in = input.select(1, f);
@@ -279,9 +224,6 @@ std::tuple<Tensor, Tensor, Tensor> batch_norm_backward_cpu_template(const Tensor
   Tensor grad_input;
   Tensor grad_weight;
   Tensor grad_bias;
-  if (grad_input_mask[0]) {
-    grad_input = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  }
   if (grad_input_mask[1]) {
     grad_weight = at::empty_like(weight, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
   }
@@ -289,6 +231,22 @@ std::tuple<Tensor, Tensor, Tensor> batch_norm_backward_cpu_template(const Tensor
     grad_bias = at::empty_like(weight, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
   }
 
+  if (batch_norm_use_cpu_kernel(input, weight, {}, running_mean, running_var,
+                                save_mean, save_invstd)) {
+    auto memory_format = batch_norm_cpu_memory_format(input);
+    if (grad_input_mask[0]) {
+      grad_input = at::empty_like(input, memory_format);
+    }
+    batch_norm_cpu_backward_stub(kCPU, grad_input, grad_weight, grad_bias,
+        grad_out_.contiguous(memory_format), input, weight, running_mean, running_var,
+        save_mean, save_invstd, train, eps);
+    return std::make_tuple(grad_input, grad_weight, grad_bias);
+  }
+
+  if (grad_input_mask[0]) {
+    grad_input = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  }
+
   auto weight_a = conditional_accessor_1d<scalar_t>(weight);
   auto grad_weight_a = conditional_accessor_1d<scalar_t>(grad_weight);
   auto grad_bias_a = conditional_accessor_1d<scalar_t>(grad_bias);
@@ -529,52 +487,6 @@ Tensor instance_norm(
   return out.view(input.sizes());
 }
 
-Tensor group_norm(const Tensor& input, int64_t num_groups,
-    const Tensor& weight /* optional */, const Tensor& bias /* optional */,
-    double eps, bool cudnn_enabled) {
-
-    auto input_shape = input.sizes();
-    int64_t b = input.size(0);
-    int64_t c = input.size(1);
-
-    TORCH_CHECK(c % num_groups == 0,
-             "Expected number of channels in input to be divisible by ",
-             "num_groups, but got input of shape ", input.sizes(), " and "
-             "num_groups=", num_groups);
-
-    TORCH_CHECK(!weight.defined() || (weight.dim() == 1 && weight.numel() == c),
-             "Expected weight to be a vector of size equal to the number of ",
-             "channels in input, but got weight of shape ", weight.sizes(),
-             " and input of shape ", input.sizes());
-    TORCH_CHECK(!bias.defined() || (bias.dim() == 1 && bias.numel() == c),
-             "Expected bias to be a vector of size equal to the number of ",
-             "channels in input, but got bias of shape ", weight.sizes(),
-             " and input of shape ", input.sizes());
-
-    // Apply group norm
-    // view(..., -1) does not work for empty tensor
-    auto input_reshaped = input.contiguous().view({1, b * num_groups, b ? -1 : 1});
-
-    auto out = at::batch_norm(input_reshaped, {}, {}, {}, {}, true, 0, eps,
-                              cudnn_enabled);
-    out = out.view(input_shape);
-
-    if (!weight.defined() && !bias.defined()) {
-      return out;
-    }
-
-    std::vector<int64_t> affine_param_shape(input.dim(), 1);
-    affine_param_shape[1] = c;
-
-    if (weight.defined() && bias.defined()) {
-      return bias.view(affine_param_shape).addcmul(out, weight.view(affine_param_shape), 1);
-    } else if (weight.defined()) {
-      return out.mul(weight.view(affine_param_shape));
-    } else {
-      return out.add(bias.view(affine_param_shape));
-    }
-}
-
 std::tuple<Tensor, Tensor> batch_norm_update_stats_cpu(
         const Tensor& self, const Tensor& running_mean, const Tensor& running_var, double momentum) {
   return AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "batch_norm_update_stats_cpu", [&] {
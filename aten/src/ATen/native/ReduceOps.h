@@ -36,5 +36,10 @@ DECLARE_DISPATCH(reduce_fn_flag, norm_stub);
 using cum_fn = void (*)(Tensor&, const Tensor&, int64_t);
 DECLARE_DISPATCH(cum_fn, cumsum_stub);
 DECLARE_DISPATCH(cum_fn, cumprod_stub);
+DECLARE_DISPATCH(cum_fn, logcumsumexp_stub);
+
+using cum_with_indices_fn = void (*)(const Tensor&, Tensor&, Tensor&, int64_t);
+DECLARE_DISPATCH(cum_with_indices_fn, cummax_stub);
+DECLARE_DISPATCH(cum_with_indices_fn, cummin_stub);
 
 }} // namespace at::native
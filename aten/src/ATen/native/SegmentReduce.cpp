@@ -0,0 +1,145 @@
+#include <ATen/native/SegmentReduce.h>
+
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/WrapDimUtils.h>
+
+#include <limits>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(segment_reduce_stub);
+DEFINE_DISPATCH(segment_reduce_backward_stub);
+
+static SegmentReductionType get_reduction_enum(const std::string& reduce) {
+  if (reduce == "sum") {
+    return SEGMENT_SUM;
+  } else if (reduce == "mean") {
+    return SEGMENT_MEAN;
+  } else if (reduce == "max") {
+    return SEGMENT_MAX;
+  } else if (reduce == "min") {
+    return SEGMENT_MIN;
+  }
+  AT_ERROR("segment_reduce: unsupported reduction '", reduce,
+           "', expected one of 'sum', 'mean', 'max' or 'min'");
+}
+
+static void check_offsets(const Tensor& offsets, int64_t axis_size) {
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+  const int64_t num_segments = offsets.numel() - 1;
+  TORCH_CHECK(offsets_data[0] == 0,
+              "segment_reduce: expected the first segment to start at 0, got ", offsets_data[0]);
+  for (int64_t s = 0; s < num_segments; s++) {
+    TORCH_CHECK(offsets_data[s + 1] >= offsets_data[s],
+                "segment_reduce: expected nondecreasing offsets, got offset ", offsets_data[s + 1],
+                " after offset ", offsets_data[s]);
+  }
+  TORCH_CHECK(offsets_data[num_segments] == axis_size,
+              "segment_reduce: expected the segments to cover the ", axis_size,
+              " elements of data along axis, got ", offsets_data[num_segments]);
+}
+
+Tensor segment_reduce(
+    const Tensor& data,
+    std::string reduce,
+    const Tensor& lengths,
+    const Tensor& offsets,
+    int64_t axis) {
+  const auto reduction = get_reduction_enum(reduce);
+  TORCH_CHECK(data.dim() > 0, "segment_reduce: expected data to have at least one dimension");
+  axis = maybe_wrap_dim(axis, data.dim());
+  TORCH_CHECK(lengths.defined() != offsets.defined(),
+              "segment_reduce: expected exactly one of lengths and offsets");
+  const Tensor& segments = lengths.defined() ? lengths : offsets;
+  TORCH_CHECK(segments.dim() == 1 && segments.scalar_type() == kLong,
+              "segment_reduce: expected ", lengths.defined() ? "lengths" : "offsets",
+              " to be a 1-D int64 tensor, got a ", segments.dim(), "-D ",
+              segments.scalar_type(), " tensor");
+  TORCH_CHECK(segments.device() == data.device(),
+              "segment_reduce: expected ", lengths.defined() ? "lengths" : "offsets",
+              " to be on device ", data.device(), ", got ", segments.device());
+
+  if (offsets.defined()) {
+    TORCH_CHECK(offsets.numel() > 0, "segment_reduce: expected at least one offset");
+    return at::_segment_reduce(data, offsets, reduction, axis);
+  }
+  const auto lengths_offsets = at::cat({at::zeros({1}, lengths.options()), lengths.cumsum(0)});
+  return at::_segment_reduce(data, lengths_offsets, reduction, axis);
+}
+
+Tensor unsorted_segment_reduce(
+    const Tensor& data,
+    const Tensor& segment_ids,
+    int64_t num_segments,
+    std::string reduce,
+    int64_t axis) {
+  TORCH_CHECK(data.dim() > 0, "unsorted_segment_reduce: expected data to have at least one dimension");
+  axis = maybe_wrap_dim(axis, data.dim());
+  TORCH_CHECK(segment_ids.dim() == 1 && segment_ids.scalar_type() == kLong,
+              "unsorted_segment_reduce: expected segment_ids to be a 1-D int64 tensor");
+  TORCH_CHECK(segment_ids.numel() == data.size(axis),
+              "unsorted_segment_reduce: expected a segment id for each of the ", data.size(axis),
+              " elements of data along axis ", axis, ", got ", segment_ids.numel());
+  TORCH_CHECK(num_segments >= 0, "unsorted_segment_reduce: expected a nonnegative num_segments");
+  const int64_t n = segment_ids.numel();
+  if (n > 0) {
+    TORCH_CHECK(segment_ids.min().item<int64_t>() >= 0 &&
+                segment_ids.max().item<int64_t>() < num_segments,
+                "unsorted_segment_reduce: segment ids out of range [0, ", num_segments, ")");
+  }
+
+  // The number of elements in each segment
+  const auto lengths = at::bincount(segment_ids, {}, num_segments);
+  const bool sorted = n < 2 ||
+      segment_ids.narrow(0, 1, n - 1).ge(segment_ids.narrow(0, 0, n - 1)).all().item<bool>();
+  if (sorted) {
+    // The segments are already consecutive, no need to permute data
+    return at::segment_reduce(data, reduce, lengths, {}, axis);
+  }
+  // Sort by (segment id, position) so that the elements of a segment are
+  // reduced in their original order
+  TORCH_CHECK(num_segments <= std::numeric_limits<int64_t>::max() / n,
+              "unsorted_segment_reduce: too many segments");
+  const auto keys = segment_ids * n + at::arange(n, segment_ids.options());
+  const auto order = std::get<1>(keys.sort());
+  return at::segment_reduce(data.index_select(axis, order), reduce, lengths, {}, axis);
+}
+
+Tensor _segment_reduce_cpu(const Tensor& data, const Tensor& offsets, int64_t reduction, int64_t axis) {
+  TORCH_CHECK(reduction >= SEGMENT_SUM && reduction <= SEGMENT_MIN,
+              "_segment_reduce: unsupported reduction ", reduction);
+  TORCH_CHECK(data.dim() > 0, "segment_reduce: expected data to have at least one dimension");
+  TORCH_CHECK(offsets.dim() == 1 && offsets.numel() > 0 && offsets.scalar_type() == kLong,
+              "segment_reduce: expected offsets to be a non-empty 1-D int64 tensor");
+  axis = maybe_wrap_dim(axis, data.dim());
+  const auto offsets_ = offsets.contiguous();
+  check_offsets(offsets_, data.size(axis));
+
+  auto output_sizes = data.sizes().vec();
+  output_sizes[axis] = offsets_.numel() - 1;
+  auto output = at::empty(output_sizes, data.options());
+  segment_reduce_stub(
+      kCPU, output, data.contiguous(), offsets_,
+      static_cast<SegmentReductionType>(reduction), axis);
+  return output;
+}
+
+Tensor _segment_reduce_backward_cpu(
+    const Tensor& grad,
+    const Tensor& output,
+    const Tensor& data,
+    const Tensor& offsets,
+    int64_t reduction,
+    int64_t axis) {
+  TORCH_CHECK(reduction >= SEGMENT_SUM && reduction <= SEGMENT_MIN,
+              "_segment_reduce_backward: unsupported reduction ", reduction);
+  axis = maybe_wrap_dim(axis, data.dim());
+  auto grad_input = at::empty(data.sizes(), data.options());
+  segment_reduce_backward_stub(
+      kCPU, grad_input, grad.contiguous(), output.contiguous(), data.contiguous(),
+      offsets.contiguous(), static_cast<SegmentReductionType>(reduction), axis);
+  return grad_input;
+}
+
+}} // namespace at::native
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Values of the `reduction` argument of _segment_reduce
+enum SegmentReductionType { SEGMENT_SUM = 0, SEGMENT_MEAN, SEGMENT_MAX, SEGMENT_MIN };
+
+// output has the shape of data with size(axis) replaced by the number of
+// segments. data and output are contiguous, and offsets is a contiguous
+// int64 tensor of num_segments + 1 nondecreasing offsets along axis.
+using segment_reduce_fn = void(*)(Tensor& output, const Tensor& data, const Tensor& offsets, SegmentReductionType reduction, int64_t axis);
+// grad_input, grad, output and data are contiguous
+using segment_reduce_backward_fn = void(*)(Tensor& grad_input, const Tensor& grad, const Tensor& output, const Tensor& data, const Tensor& offsets, SegmentReductionType reduction, int64_t axis);
+
+DECLARE_DISPATCH(segment_reduce_fn, segment_reduce_stub);
+DECLARE_DISPATCH(segment_reduce_backward_fn, segment_reduce_backward_stub);
+
+}} // namespace at::native
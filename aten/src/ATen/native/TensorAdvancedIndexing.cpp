@@ -58,6 +58,7 @@
 #include <ATen/native/BinaryOps.h>
 #include <ATen/native/Copy.h>
 #include <ATen/Parallel.h>
+#include <ATen/MemoryOverlap.h>
 
 #include <algorithm>
 #include <functional>
@@ -71,6 +72,7 @@ DEFINE_DISPATCH(index_put_stub);
 DEFINE_DISPATCH(index_put_accum_stub);
 DEFINE_DISPATCH(masked_fill_stub);
 REGISTER_NO_CPU_DISPATCH(index_put_accum_stub, index_put_accum_fn);
+DEFINE_DISPATCH(index_put_accum_rows_stub);
 DEFINE_DISPATCH(masked_select_serial_stub);
 DEFINE_DISPATCH(masked_select_stub);
 
@@ -78,6 +80,7 @@ DEFINE_DISPATCH(gather_stub);
 DEFINE_DISPATCH(scatter_stub);
 DEFINE_DISPATCH(scatter_fill_stub);
 DEFINE_DISPATCH(scatter_add_stub);
+DEFINE_DISPATCH(index_add_stub);
 
 static bool all_strides_match(TensorList tensors) {
   TORCH_CHECK(tensors.size() >= 1);
@@ -282,6 +285,14 @@ Tensor & _index_put_impl_(Tensor & self, TensorList indices, const Tensor & valu
       return self;
   }
   auto info = make_info(self, indices);
+  if (accumulate && self.device().type() == kCPU && value.device() == self.device() &&
+      has_internal_overlap(self) == MemOverlap::NO) {
+    TORCH_CHECK(is_expandable_to(value.sizes(), info.src.sizes()), "shape mismatch: value tensor of shape ", value.sizes(),
+               " cannot be broadcast to indexing result of shape ", info.src.sizes());
+    if (index_put_accum_rows_stub(kCPU, info, value)) {
+      return self;
+    }
+  }
   auto iter = make_index_put_iterator(info, value);
   index_put_stub(iter.device_type(), iter, info.indexed_sizes, info.indexed_strides, accumulate);
   return self;
@@ -363,6 +374,13 @@ Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const T
     if (numel == 0) {
       return self;
     }
+    auto source_sizes = self.sizes().vec();
+    source_sizes[dim] = numel;
+    if (source.sizes().equals(source_sizes)) {
+      index_add_stub(self.device().type(), self, dim, index_contig, source);
+      return self;
+    }
+    // Otherwise source slices are broadcast to the slices of self
     auto selfSlice = self.select(dim, 0);
     auto sourceSlice = source.select(dim, 0);
     auto self_stride_bytes = self.stride(dim) * elementSize(self.scalar_type());
@@ -383,17 +401,7 @@ Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const T
   }
   else {
     TORCH_CHECK(source.dim() <= 1, "source.dim() (", source.dim(), ") must one or zero for given self.dim() (", self.dim(), ")");
-
-    AT_DISPATCH_ALL_TYPES(self.scalar_type(), "index_add_", [&] {
-      auto self_stride = self.dim() == 0 ? 1 : self.stride(dim);
-      auto source_stride = source.dim() == 0 ? 1 : source.stride(dim);
-      for (auto i = 0; i < numel; i++) {
-        auto self_i = index_data[i];
-        TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self.numel()), "index out of range in self");
-        scalar_t *self_ip = self.data<scalar_t>() + self_i * self_stride;
-        *self_ip += *(source.data<scalar_t>() + i * source_stride);
-      }
-    });
+    index_add_stub(self.device().type(), self, dim, index_contig, source);
   }
   return self;
 }
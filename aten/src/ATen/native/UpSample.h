@@ -56,6 +56,14 @@ DECLARE_DISPATCH(upsampling_1d, upsample_nearest1d_backward_kernel);
 DECLARE_DISPATCH(upsampling_2d, upsample_nearest2d_backward_kernel);
 DECLARE_DISPATCH(upsampling_3d, upsample_nearest3d_backward_kernel);
 
+using upsampling_2d_interp = void(*)(Tensor& output, const Tensor& input, bool align_corners, scale_t scales_h, scale_t scales_w);
+DECLARE_DISPATCH(upsampling_2d_interp, upsample_bilinear2d_kernel);
+DECLARE_DISPATCH(upsampling_2d_interp, upsample_bicubic2d_kernel);
+DECLARE_DISPATCH(upsampling_2d_interp, _upsample_bilinear2d_aa_kernel);
+DECLARE_DISPATCH(upsampling_2d_interp, _upsample_bicubic2d_aa_kernel);
+DECLARE_DISPATCH(upsampling_2d_interp, _upsample_bilinear2d_aa_backward_kernel);
+DECLARE_DISPATCH(upsampling_2d_interp, _upsample_bicubic2d_aa_backward_kernel);
+
 static inline void upsample_1d_shape_check(
     const Tensor& input,
     const Tensor& grad_output,
@@ -7,12 +7,38 @@ namespace at {
 
 namespace native {
 
-using batch_norm_fn = void (*)(Tensor&, const Tensor&, const Tensor&,
-    const Tensor&, const Tensor&, const Tensor&, double);
-
-DECLARE_DISPATCH(batch_norm_fn, batch_norm_cpu_inference_contiguous_stub);
+// The kernels below require input (and grad_output, output and grad_input)
+// to be contiguous either in the contiguous or in the channels last memory
+// format, with output and grad_input in the same format as input, and the
+// defined 1-d tensors to be contiguous.
+
+// output = (input - mean) * invstd * weight + bias, with mean and invstd from
+// save_mean and save_invstd when train is true, and from running_mean and
+// running_var otherwise.
+using batch_norm_fn = void (*)(Tensor& /* output */, const Tensor& /* input */,
+    const Tensor& /* weight */, const Tensor& /* bias */,
+    const Tensor& /* save_mean */, const Tensor& /* save_invstd */,
+    const Tensor& /* running_mean */, const Tensor& /* running_var */,
+    bool /* train */, double /* eps */);
+
+// Per channel mean and sum of the squared deviations from the mean of input.
+using batch_norm_collect_stats_fn = void (*)(Tensor& /* mean */,
+    Tensor& /* var_sum */, const Tensor& /* input */);
+
+// Any of grad_input, grad_weight and grad_bias may be undefined, in which
+// case it is not computed.
+using batch_norm_backward_fn = void (*)(Tensor& /* grad_input */,
+    Tensor& /* grad_weight */, Tensor& /* grad_bias */,
+    const Tensor& /* grad_output */, const Tensor& /* input */,
+    const Tensor& /* weight */,
+    const Tensor& /* running_mean */, const Tensor& /* running_var */,
+    const Tensor& /* save_mean */, const Tensor& /* save_invstd */,
+    bool /* train */, double /* eps */);
+
+DECLARE_DISPATCH(batch_norm_fn, batch_norm_cpu_stub);
+DECLARE_DISPATCH(batch_norm_collect_stats_fn, batch_norm_cpu_collect_stats_stub);
+DECLARE_DISPATCH(batch_norm_backward_fn, batch_norm_cpu_backward_stub);
 
 } // namespace native
 
 } // namespace at
-
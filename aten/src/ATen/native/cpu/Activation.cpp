@@ -8,6 +8,7 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Config.h>
+#include <ATen/cpu/vec256/fast_math.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
@@ -22,7 +23,7 @@ namespace native {
 
 namespace {
 
-template <typename scalar_t>
+template <typename scalar_t, bool fast_math>
 inline void _vec_log_sigmoid(Tensor& output, Tensor& buffer, const Tensor& input) {
   using Vec = Vec256<scalar_t>;
   scalar_t* output_data = output.data_ptr<scalar_t>();
@@ -34,16 +35,26 @@ inline void _vec_log_sigmoid(Tensor& output, Tensor& buffer, const Tensor& input
     for (; d < size - (size % Vec::size()); d += Vec::size()) {
       Vec data_vec = Vec::loadu(input_data + begin+ d);
       Vec max_vec = vec256::maximum(data_vec.neg(), Vec(scalar_t(0)));
-      Vec buffer_vec =  max_vec.neg().exp() + (data_vec.neg() - max_vec).exp();
-      Vec output_vec = (max_vec + buffer_vec.log()).neg();
+      Vec buffer_vec = fast_math
+          ? vec256::fast_exp(max_vec.neg()) +
+              vec256::fast_exp(data_vec.neg() - max_vec)
+          : max_vec.neg().exp() + (data_vec.neg() - max_vec).exp();
+      Vec output_vec =
+          (max_vec + (fast_math ? vec256::fast_log(buffer_vec) : buffer_vec.log()))
+              .neg();
       buffer_vec.store(buffer_data + begin + d);
       output_vec.store(output_data + begin + d);
     }
     if (size - d > 0) {
       Vec data_vec = Vec::loadu(input_data + begin + d, size - d);
       Vec max_vec = vec256::maximum(data_vec.neg(), Vec(scalar_t(0)));
-      Vec buffer_vec =  max_vec.neg().exp() + (data_vec.neg() - max_vec).exp();
-      Vec output_vec = (max_vec + buffer_vec.log()).neg();
+      Vec buffer_vec = fast_math
+          ? vec256::fast_exp(max_vec.neg()) +
+              vec256::fast_exp(data_vec.neg() - max_vec)
+          : max_vec.neg().exp() + (data_vec.neg() - max_vec).exp();
+      Vec output_vec =
+          (max_vec + (fast_math ? vec256::fast_log(buffer_vec) : buffer_vec.log()))
+              .neg();
       buffer_vec.store(buffer_data + begin + d, size - d);
       output_vec.store(output_data + begin + d, size - d);
     }
@@ -51,8 +62,12 @@ inline void _vec_log_sigmoid(Tensor& output, Tensor& buffer, const Tensor& input
 }
 
 static void log_sigmoid_cpu_kernel(Tensor& output, Tensor& buffer, const Tensor& input) {
+  if (at::globalContext().fastMathCPU() && input.scalar_type() == kFloat) {
+    _vec_log_sigmoid<float, true>(output, buffer, input);
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "log_sigmoid_cpu", [&] {
-    _vec_log_sigmoid<scalar_t>(output, buffer, input);
+    _vec_log_sigmoid<scalar_t, false>(output, buffer, input);
   });
 }
 
@@ -256,7 +271,22 @@ void elu_backward_kernel(TensorIterator& it, Scalar alpha, Scalar scale, Scalar
 // y = 0.5x * (1 + tanh(sqrt(2/Pi) * (x + 0.044715x^3)))
 // and the fast tanh impl from Eigen.
 void GeluKernelImpl(TensorIterator& it) {
-  if (at::hasMKL() && it.is_contiguous()) {
+  if (at::globalContext().fastMathCPU() && it.dtype() == kFloat) {
+    using Vec = vec256::Vec256<float>;
+    const Vec kAlphaVec(M_SQRT1_2);
+    const Vec kOneVec(1);
+    const Vec kPointFiveVec(0.5);
+    cpu_kernel_vec(
+        it,
+        [](float x) {
+          constexpr float kAlpha = M_SQRT1_2;
+          return x * 0.5f * (1.f + vec256::fast_erf(x * kAlpha));
+        },
+        [&](Vec x_vec) {
+          return x_vec * kPointFiveVec *
+              (kOneVec + vec256::fast_erf(x_vec * kAlphaVec));
+        });
+  } else if (at::hasMKL() && it.is_contiguous()) {
     AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluKernelImpl", [&]() {
       GeluMKLKernelImpl<scalar_t>(&it);
     });
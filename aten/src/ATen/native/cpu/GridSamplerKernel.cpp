@@ -5,6 +5,7 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/GridSampler.h>
 #include <ATen/native/cpu/GridSamplerKernel.h>
+#include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vml.h>
 #include <c10/util/C++17.h>
 
@@ -161,6 +162,18 @@ namespace at { namespace native { namespace {
  *  Now you should be able tp understand everything about the implementation of
  *  2D forward kernel shown at the beginning of this note.
  *
+ *  The 3D kernels follow the same structure, with `ApplyGridSample` taking x, y
+ *  and z vectors, and `grid_sample_3d_grid_slice_iterator` iterating over a
+ *  range of rows (i.e., (d, h) pairs) of a grid slice, so that the work within
+ *  a batch sample can be split among threads as well. Two more things are
+ *  specific to 3D:
+ *    + If the input is in channels last memory format, we take a different
+ *      path that vectorizes over the (contiguous) channels instead of over the
+ *      output locations. See the channels last section below.
+ *    + The backward pass accumulates into grad_input without atomics, through
+ *      per-thread partial buffers when the rows of a batch sample are split
+ *      among threads. See `grid_sample_3d_backward_parallel`.
+ *
  **/
 
 
@@ -762,6 +775,338 @@ struct ApplyGridSample<scalar_t, 2, GridSamplerInterpolation::Nearest,
   }
 };
 
+template<typename scalar_t, GridSamplerPadding padding, bool align_corners>
+struct ApplyGridSample<scalar_t, 3, GridSamplerInterpolation::Bilinear,
+                       padding, align_corners> {
+  using Vec = Vec256<scalar_t>;
+  using integer_t = int_same_size_t<scalar_t>;
+  using iVec = Vec256<integer_t>;
+
+  const int64_t inp_D;
+  const int64_t inp_H;
+  const int64_t inp_W;
+  const int64_t inp_sD;
+  const int64_t inp_sH;
+  const int64_t inp_sW;
+  const int64_t C;
+  const int64_t inp_sC;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_D;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_H;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_W;
+  const bool must_in_bound = padding != GridSamplerPadding::Zeros;
+
+  ApplyGridSample(const TensorAccessor<scalar_t, 5>& input)
+    : inp_D(input.size(2))
+    , inp_H(input.size(3))
+    , inp_W(input.size(4))
+    , inp_sD(input.stride(2))
+    , inp_sH(input.stride(3))
+    , inp_sW(input.stride(4))
+    , C(input.size(1))
+    , inp_sC(input.stride(1))
+    , compute_D(input.size(2))
+    , compute_H(input.size(3))
+    , compute_W(input.size(4)) {}
+
+  // The 8 corners are indexed as k = dz * 4 + dy * 2 + dx, i.e., in the order
+  // tnw, tne, tsw, tse, bnw, bne, bsw, bse, where t(op) and b(ottom) are the
+  // two sides along z, n(orth) and s(outh) along y, w(est) and e(ast) along x.
+  struct InterpParams {
+    Vec t, b, n, s, w, e;     // distances to 6 sides
+    Vec weights[8];           // interpolation weights wrt 8 corners
+    Vec masks[8];             // in_bound masks
+    iVec i_z_t, i_y_n, i_x_w;
+  };
+
+  inline InterpParams compute_interp_params(const Vec& x, const Vec& y, const Vec& z) const {
+    InterpParams p;
+    auto x_w = x.floor();
+    auto y_n = y.floor();
+    auto z_t = z.floor();
+
+    // get distances to each side
+    p.w = x - x_w;
+    p.e = Vec(1) - p.w;
+    p.n = y - y_n;
+    p.s = Vec(1) - p.n;
+    p.t = z - z_t;
+    p.b = Vec(1) - p.t;
+
+    // get interpolation weights for each neighbor
+    // e.g., for the tnw corner, the weight is
+    // `dist_to_bottom * dist_to_south * dist_to_east`.
+    auto bs = p.b * p.s;
+    auto bn = p.b * p.n;
+    auto ts = p.t * p.s;
+    auto tn = p.t * p.n;
+    p.weights[0] = bs * p.e;
+    p.weights[1] = bs * p.w;
+    p.weights[2] = bn * p.e;
+    p.weights[3] = bn * p.w;
+    p.weights[4] = ts * p.e;
+    p.weights[5] = ts * p.w;
+    p.weights[6] = tn * p.e;
+    p.weights[7] = tn * p.w;
+
+    p.i_x_w = convert_to_int_of_same_size(x_w);
+    p.i_y_n = convert_to_int_of_same_size(y_n);
+    p.i_z_t = convert_to_int_of_same_size(z_t);
+    auto i_x_e = p.i_x_w + iVec(1);
+    auto i_y_s = p.i_y_n + iVec(1);
+    auto i_z_b = p.i_z_t + iVec(1);
+
+    // See the 2d version on the choice of comparisons
+    auto w_mask = must_in_bound ? iVec(-1)  // true = all ones
+                                : (p.i_x_w > iVec(-1)) & (p.i_x_w < iVec(inp_W));
+    auto n_mask = must_in_bound ? iVec(-1)  // true = all ones
+                                : (p.i_y_n > iVec(-1)) & (p.i_y_n < iVec(inp_H));
+    auto t_mask = must_in_bound ? iVec(-1)  // true = all ones
+                                : (p.i_z_t > iVec(-1)) & (p.i_z_t < iVec(inp_D));
+    auto e_mask = must_in_bound ? (i_x_e < iVec(inp_W))
+                                : (i_x_e > iVec(-1)) & (i_x_e < iVec(inp_W));
+    auto s_mask = must_in_bound ? (i_y_s < iVec(inp_H))
+                                : (i_y_s > iVec(-1)) & (i_y_s < iVec(inp_H));
+    auto b_mask = must_in_bound ? (i_z_b < iVec(inp_D))
+                                : (i_z_b > iVec(-1)) & (i_z_b < iVec(inp_D));
+    auto tn_mask = t_mask & n_mask;
+    auto ts_mask = t_mask & s_mask;
+    auto bn_mask = b_mask & n_mask;
+    auto bs_mask = b_mask & s_mask;
+    p.masks[0] = cast<scalar_t>(tn_mask & w_mask);
+    p.masks[1] = cast<scalar_t>(tn_mask & e_mask);
+    p.masks[2] = cast<scalar_t>(ts_mask & w_mask);
+    p.masks[3] = cast<scalar_t>(ts_mask & e_mask);
+    p.masks[4] = cast<scalar_t>(bn_mask & w_mask);
+    p.masks[5] = cast<scalar_t>(bn_mask & e_mask);
+    p.masks[6] = cast<scalar_t>(bs_mask & w_mask);
+    p.masks[7] = cast<scalar_t>(bs_mask & e_mask);
+    return p;
+  }
+
+  inline void forward(TensorAccessor<scalar_t, 4>& out_slice,
+                      const TensorAccessor<scalar_t, 4>& inp_slice,
+                      int64_t offset, const Vec& grid_x, const Vec& grid_y,
+                      const Vec& grid_z, int64_t len) const {
+    auto x = compute_W.apply(grid_x);
+    auto y = compute_H.apply(grid_y);
+    auto z = compute_D.apply(grid_z);
+
+    auto p = compute_interp_params(x, y, z);
+
+    iVec i_offsets[8];
+    i_offsets[0] = p.i_z_t * iVec(inp_sD) + p.i_y_n * iVec(inp_sH) + p.i_x_w * iVec(inp_sW);
+    for (int k = 1; k < 8; k++) {
+      i_offsets[k] = i_offsets[0] + iVec((k >> 2) * inp_sD + ((k >> 1) & 1) * inp_sH + (k & 1) * inp_sW);
+    }
+
+    #ifndef _MSC_VER
+    # pragma unroll
+    #endif
+    for (int64_t c = 0; c < C; ++c) {
+      auto inp_slice_C_ptr = inp_slice[c].data();
+      auto interpolated = Vec(0);
+      for (int k = 0; k < 8; k++) {
+        // mask_gather zeros out the mask, so we need to make copies
+        Vec mask_copy = p.masks[k];
+        auto val = mask_gather<sizeof(scalar_t)>(Vec(0), inp_slice_C_ptr, i_offsets[k], mask_copy);
+        interpolated = interpolated + val * p.weights[k];
+      }
+      interpolated.store(out_slice[c].data() + offset, len);
+    }
+  }
+
+  inline void backward(TensorAccessor<scalar_t, 4>& gInp_slice,
+                       TensorAccessor<scalar_t, 4>& gGrid_slice,
+                       const TensorAccessor<scalar_t, 4>& gOut_slice,
+                       const TensorAccessor<scalar_t, 4>& inp_slice,
+                       int64_t offset, const Vec& grid_x, const Vec& grid_y,
+                       const Vec& grid_z, int64_t len) const {
+    Vec x, y, z, gx_mult, gy_mult, gz_mult;
+    std::tie(x, gx_mult) = compute_W.apply_get_grad(grid_x);
+    std::tie(y, gy_mult) = compute_H.apply_get_grad(grid_y);
+    std::tie(z, gz_mult) = compute_D.apply_get_grad(grid_z);
+
+    auto p = compute_interp_params(x, y, z);
+
+    iVec i_offsets[8];
+    i_offsets[0] = p.i_z_t * iVec(inp_sD) + p.i_y_n * iVec(inp_sH) + p.i_x_w * iVec(inp_sW);
+    for (int k = 1; k < 8; k++) {
+      i_offsets[k] = i_offsets[0] + iVec((k >> 2) * inp_sD + ((k >> 1) & 1) * inp_sH + (k & 1) * inp_sW);
+    }
+
+    // See the 2d version on why we go through temporary arrays to scatter
+    // the gradient of the input. gInp is contiguous.
+    auto i_gInp_offset = (p.i_z_t * iVec(inp_H) + p.i_y_n) * iVec(inp_W) + p.i_x_w;
+    integer_t i_gInp_offset_arr[8][iVec::size()];
+    integer_t i_mask_arr[8][iVec::size()];
+    for (int k = 0; k < 8; k++) {
+      (i_gInp_offset + iVec((k >> 2) * inp_H * inp_W + ((k >> 1) & 1) * inp_W + (k & 1)))
+        .store(i_gInp_offset_arr[k]);
+      p.masks[k].store(i_mask_arr[k]);
+    }
+
+    scalar_t gInp_corner_arr[Vec::size()];
+
+    auto gx = Vec(0), gy = Vec(0), gz = Vec(0);
+    #ifndef _MSC_VER
+    # pragma unroll
+    #endif
+    for (int64_t c = 0; c < C; ++c) {
+      auto inp_slice_C_ptr = inp_slice[c].data();
+      auto gInp_slice_C_ptr = gInp_slice[c].data();
+      auto gOut = Vec::loadu(gOut_slice[c].data() + offset, len);
+
+      Vec vals[8];
+      for (int k = 0; k < 8; k++) {
+        (p.weights[k] * gOut).store(gInp_corner_arr);
+        mask_scatter_add(gInp_corner_arr, gInp_slice_C_ptr, i_gInp_offset_arr[k], i_mask_arr[k], len);
+
+        // mask_gather zeros out the mask, so we need to make copies
+        Vec mask_copy = p.masks[k];
+        vals[k] = mask_gather<sizeof(scalar_t)>(Vec(0), inp_slice_C_ptr, i_offsets[k], mask_copy);
+      }
+
+      gx = gx + ((vals[1] - vals[0]) * p.s * p.b + (vals[3] - vals[2]) * p.n * p.b +
+                 (vals[5] - vals[4]) * p.s * p.t + (vals[7] - vals[6]) * p.n * p.t) * gOut;
+      gy = gy + ((vals[2] - vals[0]) * p.e * p.b + (vals[3] - vals[1]) * p.w * p.b +
+                 (vals[6] - vals[4]) * p.e * p.t + (vals[7] - vals[5]) * p.w * p.t) * gOut;
+      gz = gz + ((vals[4] - vals[0]) * p.e * p.s + (vals[5] - vals[1]) * p.w * p.s +
+                 (vals[6] - vals[2]) * p.e * p.n + (vals[7] - vals[3]) * p.w * p.n) * gOut;
+    }
+
+    gx = gx * gx_mult;
+    gy = gy * gy_mult;
+    gz = gz * gz_mult;
+
+    // There is no interleave3, so write the gradients through arrays
+    scalar_t gx_arr[Vec::size()];
+    scalar_t gy_arr[Vec::size()];
+    scalar_t gz_arr[Vec::size()];
+    gx.store(gx_arr);
+    gy.store(gy_arr);
+    gz.store(gz_arr);
+    auto gGrid_ptr = gGrid_slice.data() + offset * 3;
+    for (int64_t i = 0; i < len; i++) {
+      gGrid_ptr[i * 3] = gx_arr[i];
+      gGrid_ptr[i * 3 + 1] = gy_arr[i];
+      gGrid_ptr[i * 3 + 2] = gz_arr[i];
+    }
+  }
+};
+
+// Rounds half away from zero like std::round, which the 3D nearest mode has
+// always used (and ::round on CUDA), whereas Vec::round() rounds half to even.
+// `x - x.trunc()` and its double are exact, so this has no rounding error.
+template<typename scalar_t>
+static inline Vec256<scalar_t> round_half_away_from_zero(const Vec256<scalar_t>& x) {
+  auto trunc_x = x.trunc();
+  return trunc_x + ((x - trunc_x) * Vec256<scalar_t>(2)).trunc();
+}
+
+template<typename scalar_t, GridSamplerPadding padding, bool align_corners>
+struct ApplyGridSample<scalar_t, 3, GridSamplerInterpolation::Nearest,
+                       padding, align_corners> {
+  using Vec = Vec256<scalar_t>;
+  using integer_t = int_same_size_t<scalar_t>;
+  using iVec = Vec256<integer_t>;
+
+  const int64_t inp_D;
+  const int64_t inp_H;
+  const int64_t inp_W;
+  const int64_t inp_sD;
+  const int64_t inp_sH;
+  const int64_t inp_sW;
+  const int64_t C;
+  const int64_t inp_sC;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_D;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_H;
+  const ComputeLocation<scalar_t, padding, align_corners> compute_W;
+  const bool must_in_bound = padding != GridSamplerPadding::Zeros;
+
+  ApplyGridSample(const TensorAccessor<scalar_t, 5>& input)
+    : inp_D(input.size(2))
+    , inp_H(input.size(3))
+    , inp_W(input.size(4))
+    , inp_sD(input.stride(2))
+    , inp_sH(input.stride(3))
+    , inp_sW(input.stride(4))
+    , C(input.size(1))
+    , inp_sC(input.stride(1))
+    , compute_D(input.size(2))
+    , compute_H(input.size(3))
+    , compute_W(input.size(4)) {}
+
+  inline std::tuple<iVec, iVec, iVec, iVec>  // z, y, x and in_bound mask
+  compute_nearest(const Vec& x, const Vec& y, const Vec& z) const {
+    auto i_x_nearest = convert_to_int_of_same_size(round_half_away_from_zero(x));
+    auto i_y_nearest = convert_to_int_of_same_size(round_half_away_from_zero(y));
+    auto i_z_nearest = convert_to_int_of_same_size(round_half_away_from_zero(z));
+
+    auto i_mask = must_in_bound ? iVec(-1)
+                                : (i_x_nearest > iVec(-1)) & (i_x_nearest < iVec(inp_W)) &
+                                  (i_y_nearest > iVec(-1)) & (i_y_nearest < iVec(inp_H)) &
+                                  (i_z_nearest > iVec(-1)) & (i_z_nearest < iVec(inp_D));
+    return std::make_tuple(i_z_nearest, i_y_nearest, i_x_nearest, i_mask);
+  }
+
+  inline void forward(TensorAccessor<scalar_t, 4>& out_slice,
+                      const TensorAccessor<scalar_t, 4>& inp_slice,
+                      int64_t offset, const Vec& grid_x, const Vec& grid_y,
+                      const Vec& grid_z, int64_t len) const {
+    iVec i_z_nearest, i_y_nearest, i_x_nearest, i_mask;
+    std::tie(i_z_nearest, i_y_nearest, i_x_nearest, i_mask) = compute_nearest(
+      compute_W.apply(grid_x), compute_H.apply(grid_y), compute_D.apply(grid_z));
+    auto mask = cast<scalar_t>(i_mask);
+
+    auto i_offset = i_z_nearest * iVec(inp_sD) + i_y_nearest * iVec(inp_sH) +
+                    i_x_nearest * iVec(inp_sW);
+
+    auto out_ptr = out_slice.data() + offset;
+    auto out_sC = out_slice.stride(0);
+    auto inp_slice_ptr = inp_slice.data();
+    #ifndef _MSC_VER
+    # pragma unroll
+    #endif
+    for (int c = 0; c < C; ++c, out_ptr += out_sC, inp_slice_ptr += inp_sC) {
+      // mask_gather zeros out the mask, so we need to make a copy
+      auto mask_copy = mask;
+      auto inp_val = mask_gather<sizeof(scalar_t)>(Vec(0), inp_slice_ptr, i_offset, mask_copy);
+      inp_val.store(static_cast<void*>(out_ptr), len);
+    }
+  }
+
+  inline void backward(TensorAccessor<scalar_t, 4>& gInp_slice,
+                       TensorAccessor<scalar_t, 4>& gGrid_slice,
+                       const TensorAccessor<scalar_t, 4>& gOut_slice,
+                       const TensorAccessor<scalar_t, 4>& inp_slice,
+                       int64_t offset, const Vec& grid_x, const Vec& grid_y,
+                       const Vec& grid_z, int64_t len) const {
+    iVec i_z_nearest, i_y_nearest, i_x_nearest, i_mask;
+    std::tie(i_z_nearest, i_y_nearest, i_x_nearest, i_mask) = compute_nearest(
+      compute_W.apply(grid_x), compute_H.apply(grid_y), compute_D.apply(grid_z));
+
+    // gInp is contiguous
+    auto i_gInp_offset = (i_z_nearest * iVec(inp_H) + i_y_nearest) * iVec(inp_W) + i_x_nearest;
+
+    integer_t mask_arr[iVec::size()];
+    i_mask.store(mask_arr);
+    integer_t gInp_offset_arr[iVec::size()];
+    i_gInp_offset.store(gInp_offset_arr);
+
+    #ifndef _MSC_VER
+    # pragma unroll
+    #endif
+    for (int64_t c = 0; c < C; ++c) {
+      mask_scatter_add(gOut_slice[c].data() + offset, gInp_slice[c].data(),
+                       gInp_offset_arr, mask_arr, len);
+    }
+
+    // grid has zero 0 gradient in Nearest mode
+    auto gGrid_ptr = gGrid_slice.data() + offset * 3;
+    std::memset(gGrid_ptr, 0, sizeof(scalar_t) * len * 3);
+  }
+};
+
 // ~~~~~~~~~~~~~~~~~~ grid_sample_2d_grid_slice_iterator ~~~~~~~~~~~~~~~~~~~~~~
 // Function to apply a vectorized function on a grid slice tensor (without batch
 // dimension).
@@ -883,6 +1228,83 @@ static inline void grid_sample_2d_grid_slice_iterator(
   }
 }
 
+// ~~~~~~~~~~~~~~~~~~ grid_sample_3d_grid_slice_iterator ~~~~~~~~~~~~~~~~~~~~~~
+// Function to apply a vectorized function on the rows [row_begin, row_end) of
+// a grid slice tensor (without batch dimension), where row `r` is the W slice
+// at `d = r / out_H` and `h = r % out_H`. Splitting the slice into rows allows
+// parallelizing within a batch slice.
+// See NOTE [ Grid Sample CPU Kernels ] for details.
+
+template<typename scalar_t, typename ApplyFn>
+static inline void grid_sample_3d_grid_slice_iterator(
+    const TensorAccessor<scalar_t, 4>& grid_slice, int64_t row_begin,
+    int64_t row_end, const ApplyFn &apply_fn) {
+  int64_t out_H = grid_slice.size(1);
+  int64_t out_W = grid_slice.size(2);
+  int64_t grid_sD = grid_slice.stride(0);
+  int64_t grid_sH = grid_slice.stride(1);
+  int64_t grid_sW = grid_slice.stride(2);
+  int64_t grid_sCoor = grid_slice.stride(3);
+  auto grid_ptr = grid_slice.data();
+
+  using Vec = Vec256<scalar_t>;
+  using iVec = Vec256<int_same_size_t<scalar_t>>;
+  constexpr int64_t step = Vec::size();
+
+  // Function to apply along a W dimension with stride `grid_sW` (or the
+  // flattened D x H x W if they can be flattened). If W is contiguous, e.g.,
+  // grid is from a conv net output of shape [N, 3, D, H, W], we load the x, y
+  // and z vectors from each of the three slices. Otherwise, e.g., for a
+  // contiguous grid of shape [N, D, H, W, 3], we use at::vec256::gather to
+  // load them.
+  auto line_fn = [&](const scalar_t *grid_ptr_x, int64_t out_base_offset,
+                     int64_t total_size) {
+    auto grid_ptr_y = grid_ptr_x + grid_sCoor;
+    auto grid_ptr_z = grid_ptr_y + grid_sCoor;
+    if (grid_sW == 1 || total_size == 1) {
+      for (int64_t i = 0; i < total_size; i += step) {
+        auto len = std::min(step, total_size - i);
+        auto x = Vec::loadu(grid_ptr_x + i, len);
+        auto y = Vec::loadu(grid_ptr_y + i, len);
+        auto z = Vec::loadu(grid_ptr_z + i, len);
+        // make sure that x, y and z are valid grid sample locations
+        if (len < step) {
+          x = Vec::set(Vec(0), x, len);
+          y = Vec::set(Vec(0), y, len);
+          z = Vec::set(Vec(0), z, len);
+        }
+        apply_fn(x, y, z, out_base_offset + i, len);
+      }
+    } else {
+      auto i_offsets = iVec::arange(0, grid_sW);
+      auto i_offsets_delta = iVec(grid_sW * step);
+      for (int64_t i = 0; i < total_size; i += step) {
+        auto len = std::min(step, total_size - i);
+        if (len < step) {
+          // prevents illegal memory access, sets the exceeding offsets to zero
+          i_offsets = iVec::set(iVec(0), i_offsets, len);
+        }
+        apply_fn(vec256::gather<sizeof(scalar_t)>(grid_ptr_x, i_offsets),
+                 vec256::gather<sizeof(scalar_t)>(grid_ptr_y, i_offsets),
+                 vec256::gather<sizeof(scalar_t)>(grid_ptr_z, i_offsets),
+                 out_base_offset + i, len);
+        i_offsets = i_offsets + i_offsets_delta;
+      }
+    }
+  };
+
+  if (grid_sH == out_W * grid_sW && grid_sD == out_H * grid_sH) {
+    // If [D, H, W] can be flattened, apply line_fn once over all the rows.
+    line_fn(grid_ptr + row_begin * out_W * grid_sW, row_begin * out_W,
+            (row_end - row_begin) * out_W);
+  } else {
+    for (int64_t r = row_begin; r < row_end; r++) {
+      line_fn(grid_ptr + (r / out_H) * grid_sD + (r % out_H) * grid_sH,
+              r * out_W, out_W);
+    }
+  }
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Grid Sample Kernels ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Use the structs & functions defined above to calculate grid sample forward
 // and backward.
@@ -1025,10 +1447,494 @@ grid_sampler_2d_backward_cpu_kernel_impl(const Tensor& grad_output_,
   return std::make_tuple(grad_input, grad_grid);
 }
 
+// ~~~~~~~~~~~~~~~~~~~~~ Channels Last 3D Grid Sample ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// When the input is in channels last memory format, the C values of each input
+// location are contiguous. So instead of vectorizing over the output locations
+// (which gathers one value per channel and per corner), we compute the
+// interpolation location and weights of one output location at a time, and
+// vectorize the interpolation over C.
+
+template<typename scalar_t>
+struct GridSample3dChannelsLastLocation {
+  int64_t x, y, z;        // tnw corner, or nearest location
+  scalar_t t, b, n, s, w, e;  // distances to 6 sides (Bilinear only)
+};
+
+template<typename scalar_t>
+static inline GridSample3dChannelsLastLocation<scalar_t>
+grid_sample_3d_channels_last_location(scalar_t ix, scalar_t iy, scalar_t iz,
+                                      GridSamplerInterpolation interpolation_mode) {
+  GridSample3dChannelsLastLocation<scalar_t> loc;
+  if (interpolation_mode == GridSamplerInterpolation::Bilinear) {
+    loc.x = static_cast<int64_t>(std::floor(ix));
+    loc.y = static_cast<int64_t>(std::floor(iy));
+    loc.z = static_cast<int64_t>(std::floor(iz));
+    loc.w = ix - loc.x;
+    loc.e = 1 - loc.w;
+    loc.n = iy - loc.y;
+    loc.s = 1 - loc.n;
+    loc.t = iz - loc.z;
+    loc.b = 1 - loc.t;
+  } else {
+    loc.x = static_cast<int64_t>(std::round(ix));
+    loc.y = static_cast<int64_t>(std::round(iy));
+    loc.z = static_cast<int64_t>(std::round(iz));
+  }
+  return loc;
+}
+
+// Processes the rows [row_begin, row_end) of batch slice `n`, where row `r` is
+// the W slice at `d = r / out_H` and `h = r % out_H` of the output.
+template<typename scalar_t>
+static void grid_sample_3d_channels_last_forward(
+    TensorAccessor<scalar_t, 4>& out_slice,
+    const TensorAccessor<scalar_t, 4>& inp_slice,
+    const TensorAccessor<scalar_t, 4>& grid_slice,
+    int64_t row_begin, int64_t row_end,
+    GridSamplerInterpolation interpolation_mode,
+    GridSamplerPadding padding_mode, bool align_corners) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t step = Vec::size();
+  int64_t C = inp_slice.size(0);
+  int64_t inp_D = inp_slice.size(1);
+  int64_t inp_H = inp_slice.size(2);
+  int64_t inp_W = inp_slice.size(3);
+  int64_t out_H = grid_slice.size(1);
+  int64_t out_W = grid_slice.size(2);
+  auto inp_ptr = inp_slice.data();
+
+  for (int64_t r = row_begin; r < row_end; r++) {
+    auto d = r / out_H;
+    auto h = r % out_H;
+    for (int64_t w = 0; w < out_W; w++) {
+      auto grid_ptr = &grid_slice[d][h][w][0];
+      auto grid_sCoor = grid_slice.stride(3);
+      auto ix = grid_sampler_compute_source_index(grid_ptr[0], inp_W, padding_mode, align_corners);
+      auto iy = grid_sampler_compute_source_index(grid_ptr[grid_sCoor], inp_H, padding_mode, align_corners);
+      auto iz = grid_sampler_compute_source_index(grid_ptr[2 * grid_sCoor], inp_D, padding_mode, align_corners);
+      auto loc = grid_sample_3d_channels_last_location(ix, iy, iz, interpolation_mode);
+      // the output is in channels last memory format as well
+      auto out_ptr = &out_slice[0][d][h][w];
+
+      if (interpolation_mode == GridSamplerInterpolation::Bilinear) {
+        // The 8 corners are indexed as k = dz * 4 + dy * 2 + dx, see
+        // ApplyGridSample<scalar_t, 3, GridSamplerInterpolation::Bilinear>
+        const scalar_t* corner_ptrs[8];
+        scalar_t weights[8];
+        int num_corners = 0;
+        for (int k = 0; k < 8; k++) {
+          auto x = loc.x + (k & 1);
+          auto y = loc.y + ((k >> 1) & 1);
+          auto z = loc.z + (k >> 2);
+          if (within_bounds_3d(z, y, x, inp_D, inp_H, inp_W)) {
+            corner_ptrs[num_corners] = inp_ptr + z * inp_slice.stride(1) +
+                                       y * inp_slice.stride(2) + x * inp_slice.stride(3);
+            weights[num_corners] = ((k & 1) ? loc.w : loc.e) *
+                                   (((k >> 1) & 1) ? loc.n : loc.s) *
+                                   ((k >> 2) ? loc.t : loc.b);
+            num_corners++;
+          }
+        }
+        for (int64_t c = 0; c < C; c += step) {
+          auto len = std::min(step, C - c);
+          auto interpolated = Vec(0);
+          for (int k = 0; k < num_corners; k++) {
+            interpolated = vec256::fmadd(Vec::loadu(corner_ptrs[k] + c, len),
+                                         Vec(weights[k]), interpolated);
+          }
+          interpolated.store(out_ptr + c, len);
+        }
+      } else if (within_bounds_3d(loc.z, loc.y, loc.x, inp_D, inp_H, inp_W)) {
+        std::memcpy(out_ptr, &inp_slice[0][loc.z][loc.y][loc.x], C * sizeof(scalar_t));
+      } else {
+        std::memset(out_ptr, 0, C * sizeof(scalar_t));
+      }
+    }
+  }
+}
+
+// Same as above, accumulating the gradient of the input into `gInp_slice`,
+// which has the same strides as the input.
+template<typename scalar_t>
+static void grid_sample_3d_channels_last_backward(
+    TensorAccessor<scalar_t, 4>& gInp_slice,
+    TensorAccessor<scalar_t, 4>& gGrid_slice,
+    const TensorAccessor<scalar_t, 4>& gOut_slice,
+    const TensorAccessor<scalar_t, 4>& inp_slice,
+    const TensorAccessor<scalar_t, 4>& grid_slice,
+    int64_t row_begin, int64_t row_end,
+    GridSamplerInterpolation interpolation_mode,
+    GridSamplerPadding padding_mode, bool align_corners) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t step = Vec::size();
+  int64_t C = inp_slice.size(0);
+  int64_t inp_D = inp_slice.size(1);
+  int64_t inp_H = inp_slice.size(2);
+  int64_t inp_W = inp_slice.size(3);
+  int64_t out_H = grid_slice.size(1);
+  int64_t out_W = grid_slice.size(2);
+  auto inp_ptr = inp_slice.data();
+  auto gInp_ptr = gInp_slice.data();
+
+  for (int64_t r = row_begin; r < row_end; r++) {
+    auto d = r / out_H;
+    auto h = r % out_H;
+    for (int64_t w = 0; w < out_W; w++) {
+      auto grid_ptr = &grid_slice[d][h][w][0];
+      auto grid_sCoor = grid_slice.stride(3);
+      scalar_t gx_mult, gy_mult, gz_mult;
+      auto ix = grid_sampler_compute_source_index_set_grad(
+        grid_ptr[0], inp_W, padding_mode, align_corners, &gx_mult);
+      auto iy = grid_sampler_compute_source_index_set_grad(
+        grid_ptr[grid_sCoor], inp_H, padding_mode, align_corners, &gy_mult);
+      auto iz = grid_sampler_compute_source_index_set_grad(
+        grid_ptr[2 * grid_sCoor], inp_D, padding_mode, align_corners, &gz_mult);
+      auto loc = grid_sample_3d_channels_last_location(ix, iy, iz, interpolation_mode);
+      // grad_output is in channels last memory format as well
+      auto gOut_ptr = &gOut_slice[0][d][h][w];
+      // gGrid is contiguous
+      auto gGrid_ptr = &gGrid_slice[d][h][w][0];
+
+      if (interpolation_mode == GridSamplerInterpolation::Bilinear) {
+        // dot products of gOut with the input values at each corner
+        scalar_t dots[8];
+        for (int k = 0; k < 8; k++) {
+          auto x = loc.x + (k & 1);
+          auto y = loc.y + ((k >> 1) & 1);
+          auto z = loc.z + (k >> 2);
+          dots[k] = 0;
+          if (!within_bounds_3d(z, y, x, inp_D, inp_H, inp_W)) {
+            continue;
+          }
+          auto offset = z * inp_slice.stride(1) + y * inp_slice.stride(2) +
+                        x * inp_slice.stride(3);
+          auto corner_inp_ptr = inp_ptr + offset;
+          auto corner_gInp_ptr = gInp_ptr + offset;
+          auto weight = Vec(((k & 1) ? loc.w : loc.e) *
+                            (((k >> 1) & 1) ? loc.n : loc.s) *
+                            ((k >> 2) ? loc.t : loc.b));
+          auto dot = Vec(0);
+          for (int64_t c = 0; c < C; c += step) {
+            auto len = std::min(step, C - c);
+            auto gOut = Vec::loadu(gOut_ptr + c, len);
+            vec256::fmadd(gOut, weight, Vec::loadu(corner_gInp_ptr + c, len))
+              .store(corner_gInp_ptr + c, len);
+            dot = vec256::fmadd(Vec::loadu(corner_inp_ptr + c, len), gOut, dot);
+          }
+          dots[k] = vec256::vec_reduce_all<scalar_t>(
+            [](Vec& x, Vec& y) { return x + y; }, dot, Vec::size());
+        }
+        auto t = loc.t, b = loc.b, n = loc.n, s = loc.s, w_ = loc.w, e = loc.e;
+        gGrid_ptr[0] = gx_mult * ((dots[1] - dots[0]) * s * b + (dots[3] - dots[2]) * n * b +
+                                  (dots[5] - dots[4]) * s * t + (dots[7] - dots[6]) * n * t);
+        gGrid_ptr[1] = gy_mult * ((dots[2] - dots[0]) * e * b + (dots[3] - dots[1]) * w_ * b +
+                                  (dots[6] - dots[4]) * e * t + (dots[7] - dots[5]) * w_ * t);
+        gGrid_ptr[2] = gz_mult * ((dots[4] - dots[0]) * e * s + (dots[5] - dots[1]) * w_ * s +
+                                  (dots[6] - dots[2]) * e * n + (dots[7] - dots[3]) * w_ * n);
+      } else {
+        if (within_bounds_3d(loc.z, loc.y, loc.x, inp_D, inp_H, inp_W)) {
+          auto corner_gInp_ptr = &gInp_slice[0][loc.z][loc.y][loc.x];
+          for (int64_t c = 0; c < C; c += step) {
+            auto len = std::min(step, C - c);
+            (Vec::loadu(corner_gInp_ptr + c, len) + Vec::loadu(gOut_ptr + c, len))
+              .store(corner_gInp_ptr + c, len);
+          }
+        }
+        // grid has zero 0 gradient in Nearest mode
+        gGrid_ptr[0] = gGrid_ptr[1] = gGrid_ptr[2] = 0;
+      }
+    }
+  }
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~ 3D Grid Sample Parallelism ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The forward pass is parallelized over all rows (i.e., (n, d, h) of the
+// output), as the output locations are written independently.
+// `grid_sample_3d_parallel_rows` runs `fn(n, row_begin, row_end)` over them.
+//
+// In the backward pass, different output locations may scatter gradient into
+// the same input locations. `grid_sample_3d_backward_parallel` runs
+// `fn(n, row_begin, row_end, gInp_slice_ptr)`, which accumulates the gradient
+// of input slice `n` from the given rows into `gInp_slice_ptr`, as follows:
+//   + If there are at least as many batch slices as threads, the threads split
+//     the batch slices, so that each of them writes its own slices of
+//     grad_input.
+//   + Otherwise, e.g., for a single large volume, the rows of each batch slice
+//     are split into at most one chunk per thread. The first chunk accumulates
+//     directly into grad_input, every other chunk into its own
+//     zero-initialized copy of the slice, and the copies are summed into
+//     grad_input afterwards. So no atomics are needed, and only as many copies
+//     as there are chunks are allocated.
+// grad_input is expected to be dense, so that each batch slice is a contiguous
+// block of memory, whatever the memory format.
+
+template<typename Fn>
+static inline void grid_sample_3d_parallel_rows(int64_t N, int64_t num_rows,
+                                                int64_t grain_size,
+                                                const Fn& fn) {
+  parallel_for(0, N * num_rows, grain_size, [&](int64_t begin, int64_t end) {
+    while (begin < end) {
+      auto n = begin / num_rows;
+      auto row_begin = begin - n * num_rows;
+      auto row_end = std::min(end - n * num_rows, num_rows);
+      fn(n, row_begin, row_end);
+      begin += row_end - row_begin;
+    }
+  });
+}
+
+template<typename scalar_t, typename Fn>
+static void grid_sample_3d_backward_parallel(const Tensor& grad_input,
+                                             int64_t num_rows,
+                                             int64_t grain_size,
+                                             const Fn& fn) {
+  int64_t N = grad_input.size(0);
+  if (N == 0 || num_rows == 0) {
+    return;
+  }
+  int64_t slice_size = grad_input.numel() / N;
+  auto gInp_ptr = grad_input.data_ptr<scalar_t>();
+  int max_threads = at::get_num_threads();
+
+  if (N >= max_threads || at::in_parallel_region() || slice_size == 0) {
+    parallel_for(0, N, at::divup(grain_size, num_rows), [&](int64_t begin, int64_t end) {
+      for (int64_t n = begin; n < end; n++) {
+        fn(n, 0, num_rows, gInp_ptr + n * slice_size);
+      }
+    });
+    return;
+  }
+
+  auto num_chunks = std::min(static_cast<int64_t>(max_threads),
+                             at::divup(num_rows, std::max(grain_size, static_cast<int64_t>(1))));
+  auto chunk_size = at::divup(num_rows, num_chunks);
+  num_chunks = at::divup(num_rows, chunk_size);
+  if (num_chunks == 1) {
+    for (int64_t n = 0; n < N; n++) {
+      fn(n, 0, num_rows, gInp_ptr + n * slice_size);
+    }
+    return;
+  }
+
+  auto buffer = at::zeros({num_chunks - 1, slice_size}, grad_input.options());
+  auto buffer_ptr = buffer.data_ptr<scalar_t>();
+
+  for (int64_t n = 0; n < N; n++) {
+    auto gInp_slice_ptr = gInp_ptr + n * slice_size;
+    parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t k = begin; k < end; k++) {
+        auto row_begin = k * chunk_size;
+        auto row_end = std::min(row_begin + chunk_size, num_rows);
+        fn(n, row_begin, row_end, k == 0 ? gInp_slice_ptr
+                                         : buffer_ptr + (k - 1) * slice_size);
+      }
+    });
+    // sum the copies into grad_input, and zero them for the next batch slice
+    parallel_for(0, slice_size, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      for (int64_t k = 1; k < num_chunks; k++) {
+        auto partial_ptr = buffer_ptr + (k - 1) * slice_size;
+        vec256::map2(
+          [](Vec256<scalar_t> x, Vec256<scalar_t> y) { return x + y; },
+          gInp_slice_ptr + begin, gInp_slice_ptr + begin, partial_ptr + begin,
+          end - begin);
+        if (n + 1 < N) {
+          std::fill(partial_ptr + begin, partial_ptr + end, scalar_t(0));
+        }
+      }
+    });
+  }
+}
+
+// Whether to take the channels last path of the 3D kernels.
+static inline bool grid_sampler_3d_use_channels_last(const Tensor& input) {
+  return input.is_contiguous(at::MemoryFormat::ChannelsLast3d) &&
+         !input.is_contiguous();
+}
+
+Tensor grid_sampler_3d_cpu_kernel_impl(const Tensor& input, const Tensor& grid,
+                                       int64_t interpolation_mode,
+                                       int64_t padding_mode, bool align_corners) {
+  auto N = input.size(0);
+  auto C = input.size(1);
+  auto D = grid.size(1);
+  auto H = grid.size(2);
+  auto W = grid.size(3);
+  auto channels_last = grid_sampler_3d_use_channels_last(input);
+  auto memory_format = channels_last ? at::MemoryFormat::ChannelsLast3d
+                                     : at::MemoryFormat::Contiguous;
+  auto output = at::empty({N, C, D, H, W}, input.options(), memory_format);
+  auto num_rows = D * H;
+  auto grain_size = at::divup(at::internal::GRAIN_SIZE,
+                              std::max(W, static_cast<int64_t>(1)) * 6 /* 3d * 2 tensors */);
+
+#define HANDLE_CASE(interp, padding, align_corners)                            \
+  case padding: {                                                              \
+    ApplyGridSample<scalar_t, 3, interp, padding, align_corners>               \
+    grid_sample(inp_acc);                                                      \
+    grid_sample_3d_parallel_rows(N, num_rows, grain_size,                      \
+        [&](int64_t n, int64_t row_begin, int64_t row_end) {                   \
+      auto out_slice = out_acc[n];                                             \
+      auto inp_slice = inp_acc[n];                                             \
+      grid_sample_3d_grid_slice_iterator(                                      \
+        grid_acc[n], row_begin, row_end,                                       \
+        [&](const Vec256<scalar_t>& grid_x, const Vec256<scalar_t>& grid_y,    \
+            const Vec256<scalar_t>& grid_z, int64_t spatial_offset,            \
+            int64_t len) {                                                     \
+          grid_sample.forward(out_slice, inp_slice, spatial_offset,            \
+                              grid_x, grid_y, grid_z, len);                    \
+        });                                                                    \
+    });                                                                        \
+    return;                                                                    \
+  }
+
+#define HANDLE_INTERP(interp, align_corners)                                   \
+  case interp: {                                                               \
+    switch (static_cast<GridSamplerPadding>(padding_mode)) {                   \
+      HANDLE_CASE(interp, GridSamplerPadding::Zeros, align_corners);           \
+      HANDLE_CASE(interp, GridSamplerPadding::Border, align_corners);          \
+      HANDLE_CASE(interp, GridSamplerPadding::Reflection, align_corners);      \
+    }                                                                          \
+    return;                                                                    \
+  }
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "grid_sampler_3d_cpu_kernel_impl", [&] {
+    auto out_acc = output.accessor<scalar_t, 5>();
+    auto inp_acc = input.accessor<scalar_t, 5>();
+    auto grid_acc = grid.accessor<scalar_t, 5>();
+    if (channels_last) {
+      grid_sample_3d_parallel_rows(N, num_rows, grain_size,
+          [&](int64_t n, int64_t row_begin, int64_t row_end) {
+        auto out_slice = out_acc[n];
+        grid_sample_3d_channels_last_forward(
+          out_slice, inp_acc[n], grid_acc[n], row_begin, row_end,
+          static_cast<GridSamplerInterpolation>(interpolation_mode),
+          static_cast<GridSamplerPadding>(padding_mode), align_corners);
+      });
+      return;
+    }
+    if (align_corners) {
+      switch (static_cast<GridSamplerInterpolation>(interpolation_mode)) {
+        HANDLE_INTERP(GridSamplerInterpolation::Bilinear, true);
+        HANDLE_INTERP(GridSamplerInterpolation::Nearest, true);
+      }
+    } else {
+      switch (static_cast<GridSamplerInterpolation>(interpolation_mode)) {
+        HANDLE_INTERP(GridSamplerInterpolation::Bilinear, false);
+        HANDLE_INTERP(GridSamplerInterpolation::Nearest, false);
+      }
+    }
+  });
+#undef HANDLE_CASE
+#undef HANDLE_INTERP
+
+  return output;
+}
+
+std::tuple<Tensor, Tensor>
+grid_sampler_3d_backward_cpu_kernel_impl(const Tensor& grad_output_,
+                                         const Tensor& input,
+                                         const Tensor& grid,
+                                         int64_t interpolation_mode,
+                                         int64_t padding_mode,
+                                         bool align_corners) {
+  // grad_output should be in the same memory format as the output most of
+  // time, i.e., the memory format of the input. Ensuring it can greatly
+  // simplify this code.
+  auto channels_last = grid_sampler_3d_use_channels_last(input);
+  auto memory_format = channels_last ? at::MemoryFormat::ChannelsLast3d
+                                     : at::MemoryFormat::Contiguous;
+  auto grad_output = grad_output_.contiguous(memory_format);
+
+  auto grad_input = at::zeros_like(input, memory_format);
+  auto grad_grid = at::empty_like(grid, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto D = grid.size(1);
+  auto H = grid.size(2);
+  auto W = grid.size(3);
+  auto num_rows = D * H;
+  auto grain_size = at::divup(at::internal::GRAIN_SIZE,
+                              std::max(W, static_cast<int64_t>(1)) * 15 /* 3d * 5 tensors */);
+
+#define HANDLE_CASE(interp, padding, align_corners)                              \
+  case padding: {                                                                \
+    ApplyGridSample<scalar_t, 3, interp, padding, align_corners>                 \
+    grid_sample(inp_acc);                                                        \
+    grid_sample_3d_backward_parallel<scalar_t>(grad_input, num_rows, grain_size, \
+        [&](int64_t n, int64_t row_begin, int64_t row_end,                       \
+            scalar_t* gInp_slice_ptr) {                                          \
+      TensorAccessor<scalar_t, 4> gInp_slice(gInp_slice_ptr, gInp_sizes,         \
+                                             gInp_strides);                      \
+      auto gGrid_slice = gGrid_acc[n];                                           \
+      auto gOut_slice = gOut_acc[n];                                             \
+      auto inp_slice = inp_acc[n];                                               \
+      grid_sample_3d_grid_slice_iterator(                                        \
+        grid_acc[n], row_begin, row_end,                                         \
+        [&](const Vec256<scalar_t>& grid_x, const Vec256<scalar_t>& grid_y,      \
+            const Vec256<scalar_t>& grid_z, int64_t spatial_offset,              \
+            int64_t len) {                                                       \
+          grid_sample.backward(gInp_slice, gGrid_slice, gOut_slice, inp_slice,   \
+                               spatial_offset, grid_x, grid_y, grid_z, len);     \
+        });                                                                      \
+    });                                                                          \
+    return;                                                                      \
+  }
+
+#define HANDLE_INTERP(interp, align_corners)                                \
+  case interp: {                                                            \
+    switch (static_cast<GridSamplerPadding>(padding_mode)) {                \
+      HANDLE_CASE(interp, GridSamplerPadding::Zeros, align_corners);        \
+      HANDLE_CASE(interp, GridSamplerPadding::Border, align_corners);       \
+      HANDLE_CASE(interp, GridSamplerPadding::Reflection, align_corners);   \
+    }                                                                       \
+    return;                                                                 \
+  }
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "grid_sampler_3d_backward_cpu_kernel_impl", [&] {
+    auto gInp_acc = grad_input.accessor<scalar_t, 5>();
+    auto gGrid_acc = grad_grid.accessor<scalar_t, 5>();
+    auto inp_acc = input.accessor<scalar_t, 5>();
+    auto grid_acc = grid.accessor<scalar_t, 5>();
+    auto gOut_acc = grad_output.accessor<scalar_t, 5>();
+    // sizes and strides of a batch slice of grad_input
+    auto gInp_sizes = gInp_acc.sizes().data() + 1;
+    auto gInp_strides = gInp_acc.strides().data() + 1;
+    if (channels_last) {
+      grid_sample_3d_backward_parallel<scalar_t>(grad_input, num_rows, grain_size,
+          [&](int64_t n, int64_t row_begin, int64_t row_end,
+              scalar_t* gInp_slice_ptr) {
+        TensorAccessor<scalar_t, 4> gInp_slice(gInp_slice_ptr, gInp_sizes, gInp_strides);
+        auto gGrid_slice = gGrid_acc[n];
+        grid_sample_3d_channels_last_backward(
+          gInp_slice, gGrid_slice, gOut_acc[n], inp_acc[n], grid_acc[n],
+          row_begin, row_end,
+          static_cast<GridSamplerInterpolation>(interpolation_mode),
+          static_cast<GridSamplerPadding>(padding_mode), align_corners);
+      });
+      return;
+    }
+    if (align_corners) {
+      switch (static_cast<GridSamplerInterpolation>(interpolation_mode)) {
+        HANDLE_INTERP(GridSamplerInterpolation::Bilinear, true);
+        HANDLE_INTERP(GridSamplerInterpolation::Nearest, true);
+      }
+    } else {
+      switch (static_cast<GridSamplerInterpolation>(interpolation_mode)) {
+        HANDLE_INTERP(GridSamplerInterpolation::Bilinear, false);
+        HANDLE_INTERP(GridSamplerInterpolation::Nearest, false);
+      }
+    }
+  });
+#undef HANDLE_CASE
+#undef HANDLE_INTERP
+
+  return std::make_tuple(grad_input, grad_grid);
+}
+
 }
 
 REGISTER_DISPATCH(grid_sampler_2d_cpu_kernel, &grid_sampler_2d_cpu_kernel_impl);
 REGISTER_DISPATCH(grid_sampler_2d_backward_cpu_kernel, &grid_sampler_2d_backward_cpu_kernel_impl);
+REGISTER_DISPATCH(grid_sampler_3d_cpu_kernel, &grid_sampler_3d_cpu_kernel_impl);
+REGISTER_DISPATCH(grid_sampler_3d_backward_cpu_kernel, &grid_sampler_3d_backward_cpu_kernel_impl);
 
 
 }}  // namespace at::native
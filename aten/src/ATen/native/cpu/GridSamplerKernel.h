@@ -15,4 +15,9 @@ using backward_2d_fn = std::tuple<Tensor, Tensor>(*)(const Tensor &, const Tenso
 DECLARE_DISPATCH(forward_2d_fn, grid_sampler_2d_cpu_kernel);
 DECLARE_DISPATCH(backward_2d_fn, grid_sampler_2d_backward_cpu_kernel);
 
+using forward_3d_fn = Tensor(*)(const Tensor &, const Tensor &, int64_t, int64_t, bool);
+using backward_3d_fn = std::tuple<Tensor, Tensor>(*)(const Tensor &, const Tensor &, const Tensor &, int64_t, int64_t, bool);
+DECLARE_DISPATCH(forward_3d_fn, grid_sampler_3d_cpu_kernel);
+DECLARE_DISPATCH(backward_3d_fn, grid_sampler_3d_backward_cpu_kernel);
+
 }}  // namespace at::native
@@ -0,0 +1,135 @@
+#pragma once
+
+// Deterministic parallel accumulation into rows selected by an index. This is
+// the engine behind index_add_, scatter_add_ with an expanded index and
+// index_put_ with accumulate=True on CPU.
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace at { namespace native { namespace {
+
+// dst[0:n] += src[0:n]
+template <typename scalar_t>
+inline void accumulate_row(scalar_t* dst, const scalar_t* src, int64_t n) {
+  using Vec = vec256::Vec256<scalar_t>;
+  int64_t d = 0;
+  for (; d < n - (n % Vec::size()); d += Vec::size()) {
+    Vec out = Vec::loadu(dst + d) + Vec::loadu(src + d);
+    out.store(dst + d);
+  }
+  for (; d < n; d++) {
+    dst[d] += src[d];
+  }
+}
+
+template <>
+inline void accumulate_row<bool>(bool* dst, const bool* src, int64_t n) {
+  for (int64_t d = 0; d < n; d++) {
+    dst[d] = dst[d] || src[d];
+  }
+}
+
+// For every outer slice o and every source row i in increasing order, adds
+//
+//   src + o * src_outer_stride + i * src_row_stride
+//
+// to the row starting at
+//
+//   dst_row(i) + o * dst_outer_stride
+//
+// Rows are `row_size` contiguous elements. keys[i], in [0, num_keys),
+// identifies the destination row of source row i: source rows with the same
+// key must have the same destination row, and rows with different keys must
+// not overlap.
+//
+// Source rows are bucketed by key so that every destination row is owned by a
+// single thread, which adds its source rows in their original order. The
+// result is thus exactly the one of the serial loop, whatever the number of
+// threads, and no atomics are needed.
+template <typename scalar_t, typename dst_row_fn>
+void cpu_index_accumulate(
+    const dst_row_fn& dst_row,
+    const int64_t* keys,
+    int64_t num_keys,
+    int64_t num_src_rows,
+    const scalar_t* src,
+    int64_t src_row_stride,
+    int64_t row_size,
+    int64_t num_outer = 1,
+    int64_t dst_outer_stride = 0,
+    int64_t src_outer_stride = 0) {
+  if (num_src_rows == 0 || row_size == 0 || num_outer == 0) {
+    return;
+  }
+
+  if (num_outer * num_src_rows * row_size < internal::GRAIN_SIZE ||
+      at::get_num_threads() == 1) {
+    for (int64_t o = 0; o < num_outer; o++) {
+      for (int64_t i = 0; i < num_src_rows; i++) {
+        accumulate_row(
+            dst_row(i) + o * dst_outer_stride,
+            src + o * src_outer_stride + i * src_row_stride,
+            row_size);
+      }
+    }
+    return;
+  }
+
+  // `order` holds the source rows grouped by key, and bucket_starts[b] is the
+  // position in `order` of the first row of the b-th non-empty bucket. A
+  // counting sort is linear but needs a counter per key, so use a stable
+  // comparison sort when there are many more keys than rows.
+  std::vector<int64_t> order(num_src_rows);
+  std::vector<int64_t> bucket_starts;
+  if (num_keys <= 4 * num_src_rows) {
+    std::vector<int64_t> offsets(num_keys + 1, 0);
+    for (int64_t i = 0; i < num_src_rows; i++) {
+      offsets[keys[i] + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for (int64_t k = 0; k < num_keys; k++) {
+      if (offsets[k + 1] != offsets[k]) {
+        bucket_starts.push_back(offsets[k]);
+      }
+    }
+    for (int64_t i = 0; i < num_src_rows; i++) {
+      order[offsets[keys[i]]++] = i;
+    }
+  } else {
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return keys[a] < keys[b];
+    });
+    for (int64_t j = 0; j < num_src_rows; j++) {
+      if (j == 0 || keys[order[j]] != keys[order[j - 1]]) {
+        bucket_starts.push_back(j);
+      }
+    }
+  }
+  const int64_t num_buckets = bucket_starts.size();
+  bucket_starts.push_back(num_src_rows);
+
+  const int64_t bucket_numel = divup(num_src_rows, num_buckets) * row_size;
+  const int64_t grain_size =
+      std::max<int64_t>(1, internal::GRAIN_SIZE / bucket_numel);
+  at::parallel_for(0, num_outer * num_buckets, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t item = begin; item < end; item++) {
+      const int64_t o = item / num_buckets;
+      const int64_t bucket = item % num_buckets;
+      const int64_t first = bucket_starts[bucket];
+      const int64_t last = bucket_starts[bucket + 1];
+      scalar_t* dst = dst_row(order[first]) + o * dst_outer_stride;
+      const scalar_t* src_outer = src + o * src_outer_stride;
+      for (int64_t j = first; j < last; j++) {
+        accumulate_row(dst, src_outer + order[j] * src_row_stride, row_size);
+      }
+    }
+  });
+}
+
+}}}  // namespace at::native::<anonymous>
@@ -1,12 +1,15 @@
 #include <ATen/native/TensorAdvancedIndexing.h>
 
 #include <cmath>
+#include <functional>
 #include <iostream>
+#include <numeric>
 #include <ATen/Dispatch.h>
+#include <ATen/native/IndexingUtils.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/vec256.h>
-#include <ATen/native/cpu/AtomicAddFloat.h>
+#include <ATen/native/cpu/IndexAccumulate.h>
 
 namespace at { namespace native {
 namespace {
@@ -111,18 +114,12 @@ void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
     iter.dtype(), "index_put", [&] {
     if (accumulate) {
-      bool use_parallel_for = ((iter.numel() >= internal::GRAIN_SIZE) && (at::get_num_threads() > 1));
-      if (iter.dtype() == at::ScalarType::Float && use_parallel_for) {
-        cpu_index_kernel<float>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
-          cpu_atomic_add_float((float*)(dst + offset), *(float*)src);
-        });
-      } else {
-        // TODO: investigate parallelization of the accumulate kernel. Unlike the non-accumulate case,
-        // this needs to be thread-safe.
-        cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
-          *(scalar_t*)(dst + offset) += *(scalar_t*)src;
-        }, /*serial_execution=*/true);
-      }
+      // Unlike the non-accumulate case, this needs to be thread-safe. Large
+      // inputs are handled by index_put_accum_rows_kernel, which partitions
+      // the destination rows between threads.
+      cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
+        *(scalar_t*)(dst + offset) += *(scalar_t*)src;
+      }, /*serial_execution=*/true);
     } else {
       cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
         *(scalar_t*)(dst + offset) = *(scalar_t*)src;
@@ -131,6 +128,154 @@ void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
   });
 }
 
+// If dims [begin, end) of `t` can be viewed as a single dimension, returns
+// its size and stride.
+static c10::optional<std::pair<int64_t, int64_t>> collapse_dims(const Tensor& t, int64_t begin, int64_t end) {
+  int64_t size = 1;
+  int64_t stride = 0;
+  for (int64_t d = end - 1; d >= begin; d--) {
+    if (t.size(d) == 1) {
+      continue;
+    }
+    if (size == 1) {
+      stride = t.stride(d);
+    } else if (t.stride(d) != stride * size) {
+      return c10::nullopt;
+    }
+    size *= t.size(d);
+  }
+  return std::make_pair(size, stride);
+}
+
+// index_put_ with accumulate=True, as an accumulation of the rows of `value`
+// into the rows of self selected by the indices. A row spans the
+// non-indexed dimensions after the indexed ones, and the non-indexed
+// dimensions before them are the outer dimension.
+bool index_put_accum_rows_kernel(const AdvancedIndex& info, const Tensor& value) {
+  // self, with the indexed dimensions replaced by the shape of the indices
+  const Tensor& src = info.src;
+  if (src.numel() < internal::GRAIN_SIZE) {
+    // Not worth bucketing the indices
+    return false;
+  }
+  const int64_t index_begin = info.dims_before;
+  const int64_t index_end = src.dim() - info.dims_after;
+  const auto outer = collapse_dims(src, 0, index_begin);
+  const auto row = collapse_dims(src, index_end, src.dim());
+  if (!outer || !row || (row->first > 1 && row->second != 1)) {
+    return false;
+  }
+  // Different index values must select different rows
+  for (size_t j = 0; j < info.indexed_sizes.size(); j++) {
+    if (info.indexed_sizes[j] > 1 && info.indexed_strides[j] == 0) {
+      return false;
+    }
+  }
+
+  int64_t num_rows = 1;
+  for (int64_t d = index_begin; d < index_end; d++) {
+    num_rows *= src.size(d);
+  }
+  std::vector<Tensor> indices;
+  std::vector<const int64_t*> index_data;
+  for (const auto& index : info.indices) {
+    indices.push_back(index.contiguous());
+    index_data.push_back(indices.back().data_ptr<int64_t>());
+  }
+  // keys[i] is the linear index of the row selected by the i-th indices, and
+  // offsets[i] its offset in bytes
+  std::vector<int64_t> keys(num_rows);
+  std::vector<int64_t> offsets(num_rows);
+  int64_t num_keys = 1;
+  for (auto size : info.indexed_sizes) {
+    num_keys *= size;
+  }
+  for (int64_t i = 0; i < num_rows; i++) {
+    int64_t key = 0;
+    int64_t offset = 0;
+    for (size_t j = 0; j < index_data.size(); j++) {
+      int64_t idx = index_data[j][i];
+      int64_t size = info.indexed_sizes[j];
+      if (idx < -size || idx >= size) {
+        TORCH_CHECK_INDEX(false, "index ", idx, " is out of bounds for dimension ", j, " with size ", size);
+      }
+      if (idx < 0) {
+        idx += size;
+      }
+      key = key * size + idx;
+      offset += idx * info.indexed_strides[j];
+    }
+    keys[i] = key;
+    offsets[i] = offset;
+  }
+
+  // [outer, num_rows, row]
+  auto value_ = value.expand(src.sizes()).to(src.scalar_type()).contiguous();
+  if (value_.is_alias_of(src)) {
+    value_ = value_.clone();
+  }
+  const int64_t row_size = row->first;
+  char* self_data = static_cast<char*>(src.data_ptr());
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+    src.scalar_type(), "index_put_accum_rows", [&] {
+    cpu_index_accumulate<scalar_t>(
+      [&](int64_t i) { return reinterpret_cast<scalar_t*>(self_data + offsets[i]); },
+      keys.data(), num_keys, num_rows,
+      value_.data_ptr<scalar_t>(), /*src_row_stride=*/row_size, row_size,
+      /*num_outer=*/outer->first, /*dst_outer_stride=*/outer->second,
+      /*src_outer_stride=*/num_rows * row_size);
+  });
+  return true;
+}
+
+// index has been made contiguous, and if self.dim() > 1, source has the shape
+// of self except along dim.
+void index_add_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, const Tensor& source) {
+  const int64_t num_indices = index.numel();
+  const int64_t* index_data = index.data_ptr<int64_t>();
+  const int64_t self_dim_size = self.dim() == 0 ? 1 : self.size(dim);
+  for (int64_t i = 0; i < num_indices; i++) {
+    TORCH_CHECK_INDEX((index_data[i] >= 0) && (index_data[i] < self_dim_size), "index out of range in self");
+  }
+  auto source_ = source.is_alias_of(self) ? source.clone() : source;
+
+  if (self.dim() <= 1) {
+    AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+      self.scalar_type(), "index_add_cpu_", [&] {
+      auto self_data = self.data_ptr<scalar_t>();
+      auto self_stride = self.dim() == 0 ? 1 : self.stride(0);
+      auto source_stride = source_.dim() == 0 ? 1 : source_.stride(0);
+      cpu_index_accumulate<scalar_t>(
+        [&](int64_t i) { return self_data + index_data[i] * self_stride; },
+        index_data, self_dim_size, num_indices,
+        source_.data_ptr<scalar_t>(), source_stride, /*row_size=*/1);
+    });
+    return;
+  }
+
+  // View self and source as contiguous [outer, size(dim), inner] tensors
+  auto self_contig = self.contiguous();
+  auto source_contig = source_.contiguous();
+  const auto sizes = self.sizes();
+  const int64_t outer = std::accumulate(
+      sizes.begin(), sizes.begin() + dim, (int64_t)1, std::multiplies<int64_t>());
+  const int64_t inner = std::accumulate(
+      sizes.begin() + dim + 1, sizes.end(), (int64_t)1, std::multiplies<int64_t>());
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+    self.scalar_type(), "index_add_cpu_", [&] {
+    auto self_data = self_contig.data_ptr<scalar_t>();
+    cpu_index_accumulate<scalar_t>(
+      [&](int64_t i) { return self_data + index_data[i] * inner; },
+      index_data, self_dim_size, num_indices,
+      source_contig.data_ptr<scalar_t>(), /*src_row_stride=*/inner, /*row_size=*/inner,
+      outer, /*dst_outer_stride=*/self_dim_size * inner,
+      /*src_outer_stride=*/num_indices * inner);
+  });
+  if (!self_contig.is_same(self)) {
+    self.copy_(self_contig);
+  }
+}
+
 template <typename scalar_t, typename mask_t>
 void cpu_masked_fill_kernel(TensorIterator& iter, scalar_t value) {
   auto is_mask_bool = std::is_same<mask_t, bool>::value;
@@ -245,6 +390,8 @@ void masked_select_kernel(TensorIterator& iter) {
 
 REGISTER_DISPATCH(index_stub, &index_kernel);
 REGISTER_DISPATCH(index_put_stub, &index_put_kernel);
+REGISTER_DISPATCH(index_put_accum_rows_stub, &index_put_accum_rows_kernel);
+REGISTER_DISPATCH(index_add_stub, &index_add_cpu_kernel);
 REGISTER_DISPATCH(masked_fill_stub, &masked_fill_kernel);
 REGISTER_DISPATCH(masked_select_serial_stub, &masked_select_serial_kernel);
 REGISTER_DISPATCH(masked_select_stub, &masked_select_kernel);
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <ATen/AccumulateType.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/SharedReduceOps.h>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+// Vectorized reductions shared by the CPU normalization kernels. The partial
+// moments are WelfordData in the accumulate type, so that the partial moments
+// of different threads or blocks can be merged with WelfordOps::combine.
+
+namespace at { namespace native { namespace {
+
+// The Vec256 lanes of the reductions over contiguous arrays are accumulated in
+// T over chunks of this many elements, and added to the accumulate type after
+// every chunk, so that the error doesn't grow with the length of the array.
+constexpr int64_t kAccumulateChunkSize = 256;
+
+template <typename T>
+using MomentsAcc = WelfordData<acc_type<T, false>, int64_t, acc_type<T, false>>;
+
+template <typename T>
+using MomentsOps = WelfordOps<
+    T,
+    acc_type<T, false>,
+    int64_t,
+    acc_type<T, false>,
+    std::tuple<acc_type<T, false>, acc_type<T, false>>>;
+
+template <typename T>
+inline MomentsAcc<T> moments_combine(const MomentsAcc<T>& a, const MomentsAcc<T>& b) {
+  return MomentsOps<T>(false, false).combine(a, b);
+}
+
+template <typename T>
+inline MomentsAcc<T> make_moments(
+    acc_type<T, false> mean, acc_type<T, false> m2, int64_t n) {
+  MomentsAcc<T> acc;
+  acc.mean = mean;
+  acc.m2 = m2;
+  acc.n = n;
+  acc.nf = static_cast<acc_type<T, false>>(n);
+  return acc;
+}
+
+// Moments of the contiguous array X[0, N). Each lane of a Vec256 runs Welford
+// over every Vec256::size()-th element of a chunk, and the lanes of every chunk
+// and the tail are merged in the accumulate type.
+template <typename T>
+inline MomentsAcc<T> moments_contiguous(const T* X, int64_t N) {
+  using Vec = vec256::Vec256<T>;
+  using acc_t = acc_type<T, false>;
+  const int64_t loop_size = N - (N % Vec::size());
+  MomentsAcc<T> acc;
+  for (int64_t chunk = 0; chunk < loop_size; chunk += kAccumulateChunkSize) {
+    const T* X_ptr = X + chunk;
+    const int64_t num_vecs =
+        std::min(kAccumulateChunkSize, loop_size - chunk) / Vec::size();
+    Vec mean_vec(0);
+    Vec m2_vec(0);
+    for (int64_t i = 0; i < num_vecs; ++i) {
+      const Vec x = Vec::loadu(X_ptr + i * Vec::size());
+      const Vec delta = x - mean_vec;
+      mean_vec = mean_vec + delta * Vec(T(1) / static_cast<T>(i + 1));
+      m2_vec = m2_vec + delta * (x - mean_vec);
+    }
+    T mean_arr[Vec::size()];
+    T m2_arr[Vec::size()];
+    mean_vec.store(mean_arr);
+    m2_vec.store(m2_arr);
+    for (int64_t j = 0; j < Vec::size(); ++j) {
+      acc = moments_combine<T>(
+          acc, make_moments<T>(mean_arr[j], m2_arr[j], num_vecs));
+    }
+  }
+  acc_t tail_mean = 0;
+  acc_t tail_m2 = 0;
+  int64_t tail_n = 0;
+  for (int64_t i = loop_size; i < N; ++i) {
+    const acc_t delta = static_cast<acc_t>(X[i]) - tail_mean;
+    tail_n++;
+    tail_mean += delta / tail_n;
+    tail_m2 += delta * (static_cast<acc_t>(X[i]) - tail_mean);
+  }
+  return moments_combine<T>(acc, make_moments<T>(tail_mean, tail_m2, tail_n));
+}
+
+// Returns sum(Y[i]) and sum((X[i] - x_offset) * Y[i]) over the contiguous
+// arrays X[0, N) and Y[0, N), in the accumulate type. The lanes of every chunk
+// are summed in T as in moments_contiguous.
+template <typename T>
+inline std::pair<acc_type<T, false>, acc_type<T, false>> sum_and_dot_contiguous(
+    const T* Y,
+    const T* X,
+    T x_offset,
+    int64_t N) {
+  using Vec = vec256::Vec256<T>;
+  using acc_t = acc_type<T, false>;
+  const int64_t loop_size = N - (N % Vec::size());
+  const Vec offset_vec(x_offset);
+  acc_t sum = 0;
+  acc_t dot = 0;
+  for (int64_t chunk = 0; chunk < loop_size; chunk += kAccumulateChunkSize) {
+    const int64_t chunk_end = std::min(loop_size, chunk + kAccumulateChunkSize);
+    Vec sum_vec(0);
+    Vec dot_vec(0);
+    for (int64_t i = chunk; i < chunk_end; i += Vec::size()) {
+      const Vec y = Vec::loadu(Y + i);
+      sum_vec = sum_vec + y;
+      dot_vec = dot_vec + (Vec::loadu(X + i) - offset_vec) * y;
+    }
+    T sum_arr[Vec::size()];
+    T dot_arr[Vec::size()];
+    sum_vec.store(sum_arr);
+    dot_vec.store(dot_arr);
+    for (int64_t j = 0; j < Vec::size(); ++j) {
+      sum += sum_arr[j];
+      dot += dot_arr[j];
+    }
+  }
+  for (int64_t i = loop_size; i < N; ++i) {
+    sum += Y[i];
+    dot += static_cast<acc_t>(X[i] - x_offset) * Y[i];
+  }
+  return std::make_pair(sum, dot);
+}
+
+// Per column moments of the rows [0, num_rows) of the row major matrix X with
+// C columns, e.g., a channels last tensor viewed as [N * HxW, C]. mean[C] and
+// m2[C] are overwritten; every column has num_rows values. They are updated in
+// the accumulate type, since a column may have many more values than fit in
+// the precision of T. The columns are independent, so the inner loop is
+// vectorized by the compiler.
+template <typename T>
+inline void moments_columns(
+    const T* X,
+    int64_t num_rows,
+    int64_t C,
+    acc_type<T, false>* mean,
+    acc_type<T, false>* m2) {
+  using acc_t = acc_type<T, false>;
+  std::fill(mean, mean + C, acc_t(0));
+  std::fill(m2, m2 + C, acc_t(0));
+  for (int64_t i = 0; i < num_rows; ++i) {
+    const T* X_ptr = X + i * C;
+    const acc_t c = acc_t(1) / static_cast<acc_t>(i + 1);
+    for (int64_t j = 0; j < C; ++j) {
+      const acc_t x = static_cast<acc_t>(X_ptr[j]);
+      const acc_t delta = x - mean[j];
+      mean[j] += delta * c;
+      m2[j] += delta * (x - mean[j]);
+    }
+  }
+}
+
+}}}  // namespace at::native::<anonymous>
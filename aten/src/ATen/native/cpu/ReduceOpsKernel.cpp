@@ -1,8 +1,16 @@
 #include <numeric>
 #include <iterator>
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include <ATen/Dispatch.h>
+#include <ATen/NumericUtils.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/ReduceOps.h>
 #include <ATen/native/ReduceOpsUtils.h>
@@ -18,12 +26,131 @@ namespace at { namespace native { namespace {
 
 using namespace vec256;
 
+// Calls f(data, dim_strides) on every slice of self along dim, where data[t]
+// points at the first element of the slice of the t-th operand (the outputs
+// followed by self) and dim_strides[t] is its stride along dim, in elements.
+// Blocked scans visit the slices one after the other, each of them being
+// scanned in parallel.
+template <typename func_t>
+static inline void cpu_scan_slices(
+    TensorList outputs,
+    const Tensor& self,
+    int64_t dim,
+    bool blocked,
+    const func_t& f) {
+  auto iter = TensorIterator();
+  iter.dont_compute_common_dtype();
+  iter.dont_resize_outputs();
+  iter.declare_static_shape(self.sizes(), /*squash_dim=*/dim);
+  SmallVector<int64_t, 3> dim_strides;
+  for (const auto& output : outputs) {
+    iter.add_output(output);
+    dim_strides.push_back(ensure_nonempty_stride(output, dim));
+  }
+  iter.add_input(self);
+  dim_strides.push_back(ensure_nonempty_stride(self, dim));
+  iter.build();
+
+  const int ntensors = iter.ntensors();
+  auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+    SmallVector<char*, 3> slice_data(data, data + ntensors);
+    for (int64_t i = 0; i < n; ++i) {
+      f(slice_data.data(), dim_strides.data());
+      for (int t = 0; t < ntensors; ++t) {
+        slice_data[t] += strides[t];
+      }
+    }
+  };
+
+  if (blocked) {
+    iter.serial_for_each(loop, {0, iter.numel()});
+  } else {
+    iter.for_each(loop);
+  }
+}
+
+// With few slices along a long dimension, parallelizing over the slices
+// leaves most threads idle: the scan of each slice is split into blocks
+// instead.
+static inline bool use_blocked_scan(const Tensor& self, int64_t dim) {
+  const int64_t self_dim_size = ensure_nonempty_size(self, dim);
+  const int64_t num_threads = at::get_num_threads();
+  return num_threads > 1 && !at::in_parallel_region() &&
+      self_dim_size >= 2 * internal::GRAIN_SIZE &&
+      self.numel() / self_dim_size < num_threads;
+}
+
+// Two-pass scan of n elements split into one block per thread:
+//   1. reduce_block(begin, end) reduces each block but the last one,
+//   2. combine(a, b) turns the block reductions into the carry of each block,
+//      the reduction of all the elements before it,
+//   3. scan_block(begin, end, carry) scans each block starting from its carry,
+//      which is nullptr for the first block.
+template <typename acc_t, typename reduce_t, typename combine_t, typename scan_t>
+static inline void blocked_scan(
+    int64_t n,
+    const reduce_t& reduce_block,
+    const combine_t& combine,
+    const scan_t& scan_block) {
+  const int64_t num_blocks = std::min<int64_t>(
+      at::get_num_threads(), divup(n, internal::GRAIN_SIZE));
+  const int64_t block_size = divup(n, num_blocks);
+
+  // carries[b] starts as the reduction of block b - 1
+  std::vector<acc_t> carries(num_blocks);
+  at::parallel_for(1, num_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; ++b) {
+      carries[b] = reduce_block(
+          std::min(n, (b - 1) * block_size), std::min(n, b * block_size));
+    }
+  });
+  for (int64_t b = 2; b < num_blocks; ++b) {
+    carries[b] = combine(carries[b - 1], carries[b]);
+  }
+  at::parallel_for(0, num_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; ++b) {
+      scan_block(
+          std::min(n, b * block_size),
+          std::min(n, (b + 1) * block_size),
+          b == 0 ? nullptr : &carries[b]);
+    }
+  });
+}
+
+// Reduction of n elements of data for the first pass of blocked_scan. The
+// block is reduced with Vec256 when it is contiguous and accumulates in its
+// own type; types with a wider accumulate type keep the scalar loop so that
+// the block totals are as accurate as the sequential scan.
+template <typename scalar_t, typename acc_t, typename op_t, typename vec_op_t>
+static inline typename std::enable_if<std::is_same<scalar_t, acc_t>::value, acc_t>::type
+block_reduce(const scalar_t* data, int64_t n, int64_t stride, acc_t ident,
+             const op_t& op, const vec_op_t& vec_op) {
+  if (stride == 1 && n > 0) {
+    return vec256::reduce_all<scalar_t>(vec_op, const_cast<scalar_t*>(data), n);
+  }
+  acc_t acc = ident;
+  for (int64_t i = 0; i < n; ++i) {
+    acc = op(acc, data[i * stride]);
+  }
+  return acc;
+}
+
+template <typename scalar_t, typename acc_t, typename op_t, typename vec_op_t>
+static inline typename std::enable_if<!std::is_same<scalar_t, acc_t>::value, acc_t>::type
+block_reduce(const scalar_t* data, int64_t n, int64_t stride, acc_t ident,
+             const op_t& op, const vec_op_t& /*vec_op*/) {
+  acc_t acc = ident;
+  for (int64_t i = 0; i < n; ++i) {
+    acc = op(acc, static_cast<acc_t>(data[i * stride]));
+  }
+  return acc;
+}
+
 template <typename scalar_t, typename func_t>
 static inline void cpu_cum_base_kernel(Tensor& result,
     const Tensor& self,
     int64_t dim,
-    const func_t& f,
-    scalar_t init_val) {
+    const func_t& f) {
   if (result.sizes() != self.sizes()) {
     result.resize_as_(self);
   }
@@ -36,70 +163,213 @@ static inline void cpu_cum_base_kernel(Tensor& result,
     return;
   }
 
-  auto iter = TensorIterator();
-  iter.dont_compute_common_dtype();
-  iter.dont_resize_outputs();
-  iter.declare_static_shape(self.sizes(), /*squash_dim=*/dim);
-  iter.add_output(result);
-  iter.add_input(self);
-  iter.build();
-
-  auto result_dim_stride = ensure_nonempty_stride(result, dim);
-  auto self_dim_stride = ensure_nonempty_stride(self, dim);
+  const bool blocked = use_blocked_scan(self, dim);
+  cpu_scan_slices({result}, self, dim, blocked, [&](char** data, const int64_t* dim_strides) {
+    f(
+      (scalar_t*)data[0], dim_strides[0],
+      (const scalar_t*)data[1], dim_strides[1], blocked
+    );
+  });
+}
 
-  auto loop = [&](char** data, const int64_t* strides, int64_t n) {
-    auto* result_data_bytes = data[0];
-    const auto* self_data_bytes = data[1];
+// Scan of self along dim with the associative op, accumulated in acc_t
+// starting from init_val; vec_op is op on Vec256<scalar_t>.
+template <typename scalar_t, typename acc_t, typename op_t, typename vec_op_t>
+static inline void cpu_cum_op_kernel(Tensor& result, const Tensor& self, int64_t dim,
+    acc_t init_val, const op_t& op, const vec_op_t& vec_op) {
+  int64_t self_dim_size = ensure_nonempty_size(self, dim);
 
-    for (int64_t i = 0; i < n; ++i) {
-      f(
-        (scalar_t*)result_data_bytes, result_dim_stride,
-        (scalar_t*)self_data_bytes, self_dim_stride, init_val
-      );
-      result_data_bytes += strides[0];
-      self_data_bytes += strides[1];
+  cpu_cum_base_kernel<scalar_t>(result, self, dim, [&] (
+    scalar_t* result_data, int64_t result_dim_stride,
+    const scalar_t* self_data, int64_t self_dim_stride, bool blocked) {
+      auto scan = [&](int64_t begin, int64_t end, const acc_t* carry) {
+        acc_t cum_number = carry ? *carry : init_val;
+        for (int64_t i = begin; i < end; ++i) {
+          cum_number = op(cum_number, static_cast<acc_t>(self_data[i * self_dim_stride]));
+          result_data[i * result_dim_stride] = (scalar_t)cum_number;
+        }
+      };
+      if (!blocked) {
+        scan(0, self_dim_size, nullptr);
+        return;
+      }
+      blocked_scan<acc_t>(
+        self_dim_size,
+        [&](int64_t begin, int64_t end) {
+          return block_reduce(self_data + begin * self_dim_stride, end - begin,
+                              self_dim_stride, init_val, op, vec_op);
+        },
+        op, scan);
     }
-  };
-
-  iter.for_each(loop);
+  );
 }
 
 static void cumsum_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
-  int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES_AND_C10_COMPLEX(self.scalar_type(), "cumsum_out_cpu", [&] {
-    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
-      scalar_t* result_data, auto result_dim_stride,
-      const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
-        auto cum_number = (at::acc_type<scalar_t, false>)init_val;
-        for (int64_t i = 0; i < self_dim_size; ++i) {
-          cum_number += self_data[i * self_dim_stride];
-          result_data[i * result_dim_stride] = (scalar_t)cum_number;
-        }
-      }, /*init_val=*/ 0
-    );
+    using acc_t = at::acc_type<scalar_t, false>;
+    cpu_cum_op_kernel<scalar_t>(result, self, wrap_dim, /*init_val=*/acc_t(0),
+      [](acc_t a, acc_t b) { return a + b; },
+      [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return a + b; });
   });
 }
 
 static void cumprod_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
-  int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES_AND_C10_COMPLEX(self.scalar_type(), "cumprod_out_cpu", [&] {
+    using acc_t = at::acc_type<scalar_t, false>;
+    cpu_cum_op_kernel<scalar_t>(result, self, wrap_dim, /*init_val=*/acc_t(1),
+      [](acc_t a, acc_t b) { return a * b; },
+      [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return a * b; });
+  });
+}
+
+// log(exp(x) + exp(y)), which is -inf when both are -inf
+template <typename scalar_t>
+static inline scalar_t log_add_exp(scalar_t x, scalar_t y) {
+  const scalar_t min = std::isnan(y) ? y : std::min(x, y);
+  const scalar_t max = std::isnan(y) ? y : std::max(x, y);
+  if (min != max || std::isfinite(min)) {
+    return max + std::log1p(std::exp(min - max));
+  }
+  // Both are the same infinity
+  return x;
+}
+
+// log(sum(exp(data))) of a block, shifted by the block maximum so that exp
+// can't overflow
+template <typename scalar_t, typename acc_t>
+static inline acc_t logsumexp_block(const scalar_t* data, int64_t n, int64_t stride) {
+  using Vec = Vec256<scalar_t>;
+  if (stride != 1) {
+    acc_t acc = -std::numeric_limits<acc_t>::infinity();
+    for (int64_t i = 0; i < n; ++i) {
+      acc = log_add_exp<acc_t>(acc, data[i * stride]);
+    }
+    return acc;
+  }
+  auto* ptr = const_cast<scalar_t*>(data);
+  const scalar_t max = vec256::reduce_all<scalar_t>(
+      [](Vec x, Vec y) { return vec256::maximum(x, y); }, ptr, n);
+  if (!std::isfinite(max)) {
+    // nan, +inf or a block of -inf
+    return max;
+  }
+  const Vec max_vec(max);
+  const scalar_t sum = vec256::map_reduce_all<scalar_t>(
+      [&](Vec x) { return (x - max_vec).exp(); },
+      [](Vec x, Vec y) { return x + y; }, ptr, n);
+  return static_cast<acc_t>(max) + std::log(static_cast<acc_t>(sum));
+}
+
+static void logcumsumexp_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
+  auto wrap_dim = maybe_wrap_dim(dim, self.dim());
+  int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
+
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "logcumsumexp_out_cpu", [&] {
+    using acc_t = at::acc_type<scalar_t, false>;
     cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
-      scalar_t* result_data, auto result_dim_stride,
-      const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
-        auto cum_number = (at::acc_type<scalar_t, false>)init_val;
-        for (int64_t i = 0; i < self_dim_size; ++i) {
-          cum_number *= self_data[i * self_dim_stride];
-          result_data[i * result_dim_stride] = (scalar_t)cum_number;
+      scalar_t* result_data, int64_t result_dim_stride,
+      const scalar_t* self_data, int64_t self_dim_stride, bool blocked) {
+        auto scan = [&](int64_t begin, int64_t end, const acc_t* carry) {
+          acc_t cum_number = carry ? *carry : -std::numeric_limits<acc_t>::infinity();
+          for (int64_t i = begin; i < end; ++i) {
+            cum_number = log_add_exp<acc_t>(cum_number, self_data[i * self_dim_stride]);
+            result_data[i * result_dim_stride] = (scalar_t)cum_number;
+          }
+        };
+        if (!blocked) {
+          scan(0, self_dim_size, nullptr);
+          return;
         }
-      }, /*init_val=*/ 1
+        blocked_scan<acc_t>(
+          self_dim_size,
+          [&](int64_t begin, int64_t end) {
+            return logsumexp_block<scalar_t, acc_t>(
+                self_data + begin * self_dim_stride, end - begin, self_dim_stride);
+          },
+          [](acc_t a, acc_t b) { return log_add_exp<acc_t>(a, b); },
+          scan);
+      }
     );
   });
 }
 
+// Whether elem replaces the running value out of cummax (op is greater_equal)
+// or cummin (op is less_equal): nan sticks once it is reached, and ties move
+// the index to the last equal element.
+template <typename scalar_t, typename op_t>
+static inline bool cum_replaces(scalar_t elem, scalar_t out) {
+  return _isnan(elem) || (!_isnan(out) && op_t()(elem, out));
+}
+
+template <typename scalar_t, typename op_t>
+static void cummax_cummin_kernel_impl(const Tensor& self, Tensor& values, Tensor& indices, int64_t dim) {
+  // (value, index) pairs combine associatively, so they are scanned in blocks
+  // like the other ops
+  using state_t = std::pair<scalar_t, int64_t>;
+  const int64_t self_dim_size = ensure_nonempty_size(self, dim);
+  const bool blocked = use_blocked_scan(self, dim);
+
+  cpu_scan_slices({values, indices}, self, dim, blocked, [&](char** data, const int64_t* dim_strides) {
+    auto* values_data = (scalar_t*)data[0];
+    auto* indices_data = (int64_t*)data[1];
+    const auto* self_data = (const scalar_t*)data[2];
+    const int64_t values_stride = dim_strides[0];
+    const int64_t indices_stride = dim_strides[1];
+    const int64_t self_stride = dim_strides[2];
+
+    auto scan = [&](int64_t begin, int64_t end, const state_t* carry) {
+      if (begin == end) {
+        return;
+      }
+      state_t out = carry ? *carry : state_t(self_data[begin * self_stride], begin);
+      for (int64_t i = begin; i < end; ++i) {
+        const scalar_t elem = self_data[i * self_stride];
+        if (cum_replaces<scalar_t, op_t>(elem, out.first)) {
+          out = state_t(elem, i);
+        }
+        values_data[i * values_stride] = out.first;
+        indices_data[i * indices_stride] = out.second;
+      }
+    };
+    if (!blocked) {
+      scan(0, self_dim_size, nullptr);
+      return;
+    }
+    blocked_scan<state_t>(
+      self_dim_size,
+      [&](int64_t begin, int64_t end) {
+        state_t out(self_data[begin * self_stride], begin);
+        for (int64_t i = begin + 1; i < end; ++i) {
+          const scalar_t elem = self_data[i * self_stride];
+          if (cum_replaces<scalar_t, op_t>(elem, out.first)) {
+            out = state_t(elem, i);
+          }
+        }
+        return out;
+      },
+      [](const state_t& a, const state_t& b) {
+        return cum_replaces<scalar_t, op_t>(b.first, a.first) ? b : a;
+      },
+      scan);
+  });
+}
+
+static void cummax_cpu_kernel(const Tensor& self, Tensor& values, Tensor& indices, int64_t dim) {
+  AT_DISPATCH_ALL_TYPES_AND(ScalarType::Bool, self.scalar_type(), "cummax_cpu", [&] {
+    cummax_cummin_kernel_impl<scalar_t, std::greater_equal<scalar_t>>(self, values, indices, dim);
+  });
+}
+
+static void cummin_cpu_kernel(const Tensor& self, Tensor& values, Tensor& indices, int64_t dim) {
+  AT_DISPATCH_ALL_TYPES_AND(ScalarType::Bool, self.scalar_type(), "cummin_cpu", [&] {
+    cummax_cummin_kernel_impl<scalar_t, std::less_equal<scalar_t>>(self, values, indices, dim);
+  });
+}
+
 static void sum_kernel_impl(TensorIterator& iter) {
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(
       ScalarType::BFloat16, ScalarType::Half, ScalarType::Bool, iter.dtype(), "sum_cpu", [&] {
@@ -293,5 +563,8 @@ REGISTER_DISPATCH(argmax_stub, &argmax_kernel_impl);
 REGISTER_DISPATCH(argmin_stub, &argmin_kernel_impl);
 REGISTER_DISPATCH(cumprod_stub, &cumprod_cpu_kernel);
 REGISTER_DISPATCH(cumsum_stub, &cumsum_cpu_kernel);
+REGISTER_DISPATCH(logcumsumexp_stub, &logcumsumexp_cpu_kernel);
+REGISTER_DISPATCH(cummax_stub, &cummax_cpu_kernel);
+REGISTER_DISPATCH(cummin_stub, &cummin_cpu_kernel);
 
 }}  // namespace at::native
@@ -1,6 +1,8 @@
 #include <ATen/native/ScatterGatherShapeChecks.h>
 #include <ATen/native/DispatchStub.h>
 #include <ATen/native/TensorIterator.h>
+#include <ATen/native/cpu/IndexAccumulate.h>
+#include <ATen/MemoryOverlap.h>
 #include <ATen/Parallel.h>
 
 namespace at { namespace native {
@@ -185,13 +187,89 @@ void scatter_fill_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, Sca
   );
 }
 
+// Is `index` the expansion of a vector along `dim`, e.g.
+// index.unsqueeze(1).expand_as(src) for dim == 0, with self and src of the
+// same shape as `index` except along dim? Then scatter_add_ adds whole slices
+// of src to slices of self, like index_add_.
+static bool is_expanded_index(const Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  if (!self.is_contiguous() || index.dim() != self.dim()) {
+    return false;
+  }
+  for (int64_t d = 0; d < self.dim(); d++) {
+    if (d == dim) {
+      continue;
+    }
+    if (index.size(d) != self.size(d) || src.size(d) != self.size(d) ||
+        (index.size(d) > 1 && index.stride(d) != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void scatter_add_expanded_index_kernel(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  const int64_t num_indices = ensure_nonempty_size(index, dim);
+  const int64_t index_dim_stride = ensure_nonempty_stride(index, dim);
+  const int64_t self_dim_size = ensure_nonempty_size(self, dim);
+  const int64_t* index_data = index.data_ptr<int64_t>();
+  std::vector<int64_t> keys(num_indices);
+  for (int64_t i = 0; i < num_indices; i++) {
+    int64_t idx_dim = index_data[i * index_dim_stride];
+    TORCH_CHECK(idx_dim >= 0 && idx_dim < self_dim_size,
+      "index ", idx_dim,
+      " is out of bounds for dimension ", dim,
+      " with size ", self_dim_size
+    );
+    keys[i] = idx_dim;
+  }
+
+  // View self and src as contiguous [outer, size(dim), inner] tensors
+  auto src_contig = src.is_alias_of(self) ? src.clone(at::MemoryFormat::Contiguous) : src.contiguous();
+  int64_t outer = 1;
+  for (int64_t d = 0; d < dim; d++) {
+    outer *= self.size(d);
+  }
+  int64_t inner = 1;
+  for (int64_t d = dim + 1; d < self.dim(); d++) {
+    inner *= self.size(d);
+  }
+  const int64_t src_dim_size = ensure_nonempty_size(src, dim);
+
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(
+    ScalarType::Bool, ScalarType::Half, self.scalar_type(),
+    "scatter_add_", [&] {
+      auto self_data = self.data_ptr<scalar_t>();
+      cpu_index_accumulate<scalar_t>(
+        [&](int64_t i) { return self_data + keys[i] * inner; },
+        keys.data(), self_dim_size, num_indices,
+        src_contig.data_ptr<scalar_t>(), /*src_row_stride=*/inner, /*row_size=*/inner,
+        outer, /*dst_outer_stride=*/self_dim_size * inner,
+        /*src_outer_stride=*/src_dim_size * inner);
+    }
+  );
+}
+
 void scatter_add_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  if (index.numel() == 0) {
+    return;
+  }
+  dim = maybe_wrap_dim(dim, self.dim());
+  if (self.dim() > 0 && src.scalar_type() == self.scalar_type() &&
+      is_expanded_index(self, dim, index, src)) {
+    scatter_shape_check(self, dim, index, src);
+    scatter_add_expanded_index_kernel(self, dim, index, src);
+    return;
+  }
+
+  // Different positions of the iterator write to different elements of self,
+  // which are updated in the order of the index along dim, so the kernel can
+  // run in parallel unless the elements of self overlap.
   cpu_scatter_gather_base_kernel<>()(
     self, dim, index, src,
     "scatter_add_", [] (auto* lhs, const auto* rhs) {
       *lhs += *rhs;
     },
-    /*serial_exec=*/true
+    /*serial_exec=*/has_internal_overlap(self) != MemOverlap::NO
   );
 }
 
@@ -0,0 +1,184 @@
+#include <ATen/native/SegmentReduce.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at { namespace native {
+
+namespace {
+
+// data and output are viewed as [outer, size(axis), inner] tensors
+struct SegmentGeometry {
+  int64_t outer;
+  int64_t axis_size;
+  int64_t inner;
+  int64_t num_segments;
+};
+
+SegmentGeometry segment_geometry(const Tensor& data, const Tensor& offsets, int64_t axis) {
+  SegmentGeometry g;
+  g.outer = 1;
+  for (int64_t d = 0; d < axis; d++) {
+    g.outer *= data.size(d);
+  }
+  g.axis_size = data.size(axis);
+  g.inner = 1;
+  for (int64_t d = axis + 1; d < data.dim(); d++) {
+    g.inner *= data.size(d);
+  }
+  g.num_segments = offsets.numel() - 1;
+  return g;
+}
+
+// Number of segments handled by a task of parallel_for, so that a task reads
+// about GRAIN_SIZE elements of data
+int64_t segment_grain_size(const SegmentGeometry& g) {
+  const int64_t segment_numel =
+      std::max<int64_t>(1, g.axis_size / std::max<int64_t>(1, g.num_segments) * g.inner);
+  return std::max<int64_t>(1, internal::GRAIN_SIZE / segment_numel);
+}
+
+template <typename scalar_t, typename vec_op_t>
+inline void reduce_segment(
+    scalar_t* out,
+    scalar_t* in,
+    int64_t length,
+    int64_t inner,
+    const vec_op_t& vec_op) {
+  if (inner == 1) {
+    // The segment is contiguous
+    *out = vec256::reduce_all<scalar_t>(vec_op, in, length);
+    return;
+  }
+  // Combine the rows of the segment, vectorized along the row
+  std::copy(in, in + inner, out);
+  for (int64_t r = 1; r < length; r++) {
+    vec256::map2<scalar_t>(vec_op, out, out, in + r * inner, inner);
+  }
+}
+
+void segment_reduce_kernel(
+    Tensor& output,
+    const Tensor& data,
+    const Tensor& offsets,
+    SegmentReductionType reduction,
+    int64_t axis) {
+  const auto g = segment_geometry(data, offsets, axis);
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+
+  AT_DISPATCH_FLOATING_TYPES(data.scalar_type(), "segment_reduce_cpu", [&] {
+    using Vec = vec256::Vec256<scalar_t>;
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+    scalar_t* data_data = data.data_ptr<scalar_t>();
+    at::parallel_for(0, g.outer * g.num_segments, segment_grain_size(g), [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        const int64_t o = i / g.num_segments;
+        const int64_t s = i % g.num_segments;
+        const int64_t start = offsets_data[s];
+        const int64_t length = offsets_data[s + 1] - start;
+        scalar_t* out = output_data + i * g.inner;
+        scalar_t* in = data_data + (o * g.axis_size + start) * g.inner;
+        if (length == 0) {
+          std::fill(out, out + g.inner, scalar_t(0));
+          continue;
+        }
+        switch (reduction) {
+          case SEGMENT_SUM:
+          case SEGMENT_MEAN:
+            reduce_segment(out, in, length, g.inner, [](Vec& x, Vec& y) { return x + y; });
+            if (reduction == SEGMENT_MEAN) {
+              const Vec scale(scalar_t(1) / length);
+              vec256::map<scalar_t>([&](Vec x) { return x * scale; }, out, out, g.inner);
+            }
+            break;
+          case SEGMENT_MAX:
+            reduce_segment(out, in, length, g.inner, [](Vec& x, Vec& y) { return vec256::maximum(x, y); });
+            break;
+          case SEGMENT_MIN:
+            reduce_segment(out, in, length, g.inner, [](Vec& x, Vec& y) { return vec256::minimum(x, y); });
+            break;
+        }
+      }
+    });
+  });
+}
+
+template <typename scalar_t>
+inline bool is_selected(scalar_t x, scalar_t selected) {
+  return x == selected || (_isnan(x) && _isnan(selected));
+}
+
+void segment_reduce_backward_kernel(
+    Tensor& grad_input,
+    const Tensor& grad,
+    const Tensor& output,
+    const Tensor& data,
+    const Tensor& offsets,
+    SegmentReductionType reduction,
+    int64_t axis) {
+  const auto g = segment_geometry(data, offsets, axis);
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+
+  AT_DISPATCH_FLOATING_TYPES(data.scalar_type(), "segment_reduce_backward_cpu", [&] {
+    using Vec = vec256::Vec256<scalar_t>;
+    scalar_t* grad_input_data = grad_input.data_ptr<scalar_t>();
+    scalar_t* grad_data = grad.data_ptr<scalar_t>();
+    const scalar_t* output_data = output.data_ptr<scalar_t>();
+    const scalar_t* data_data = data.data_ptr<scalar_t>();
+    at::parallel_for(0, g.outer * g.num_segments, segment_grain_size(g), [&](int64_t begin, int64_t end) {
+      // Positions of the row whose gradient has been assigned, for max and min
+      std::vector<char> selected;
+      for (int64_t i = begin; i < end; i++) {
+        const int64_t o = i / g.num_segments;
+        const int64_t s = i % g.num_segments;
+        const int64_t start = offsets_data[s];
+        const int64_t length = offsets_data[s + 1] - start;
+        scalar_t* grad_out = grad_data + i * g.inner;
+        scalar_t* grad_in = grad_input_data + (o * g.axis_size + start) * g.inner;
+        switch (reduction) {
+          case SEGMENT_SUM:
+            for (int64_t r = 0; r < length; r++) {
+              std::copy(grad_out, grad_out + g.inner, grad_in + r * g.inner);
+            }
+            break;
+          case SEGMENT_MEAN: {
+            const Vec scale(scalar_t(1) / std::max<int64_t>(length, 1));
+            for (int64_t r = 0; r < length; r++) {
+              vec256::map<scalar_t>([&](Vec x) { return x * scale; }, grad_in + r * g.inner, grad_out, g.inner);
+            }
+            break;
+          }
+          case SEGMENT_MAX:
+          case SEGMENT_MIN: {
+            // The gradient goes to the first element equal to the result
+            std::fill(grad_in, grad_in + length * g.inner, scalar_t(0));
+            selected.assign(g.inner, 0);
+            const scalar_t* out = output_data + i * g.inner;
+            const scalar_t* in = data_data + (o * g.axis_size + start) * g.inner;
+            for (int64_t r = 0; r < length; r++) {
+              for (int64_t j = 0; j < g.inner; j++) {
+                if (!selected[j] && is_selected(in[r * g.inner + j], out[j])) {
+                  grad_in[r * g.inner + j] = grad_out[j];
+                  selected[j] = 1;
+                }
+              }
+            }
+            break;
+          }
+        }
+      }
+    });
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(segment_reduce_stub, &segment_reduce_kernel);
+REGISTER_DISPATCH(segment_reduce_backward_stub, &segment_reduce_backward_kernel);
+
+}} // namespace at::native
@@ -4,8 +4,10 @@
 #include <iterator>
 #include <numeric>
 
+#include <ATen/Context.h>
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/fast_math.h>
 #include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <c10/util/Optional.h>
@@ -18,11 +20,15 @@
 // computations per task. Each task works across dim_size elements. 16 should be
 // a very rough approximation of the number of computations per dim_size element
 // by counting simple computations (*, +, -) as 1 and exp or log as 4.
+//
+// The forward kernels take fast_math, which computes exp and log with the
+// approximations of ATen/cpu/vec256/fast_math.h, see
+// at::globalContext().fastMathCPU().
 
 namespace at { namespace native {
 namespace {
 
-template <typename scalar_t>
+template <typename scalar_t, bool fast_math>
 inline void _vec_log_softmax_lastdim(
     scalar_t* input_data_base,
     scalar_t* output_data_base,
@@ -58,7 +64,10 @@ inline void _vec_log_softmax_lastdim(
             scalar_t* input_data = input_data_base + i * dim_size;
             scalar_t max_input = max_input_arr[j];
             tmp_sum_scalar[j] = vec256::map_reduce_all<scalar_t>(
-                [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+                [max_input](Vec x) {
+                  return fast_math ? vec256::fast_exp(x - Vec(max_input))
+                                   : (x - Vec(max_input)).exp();
+                },
                 [](Vec x, Vec y) { return x + y; },
                 input_data,
                 dim_size);
@@ -66,7 +75,7 @@ inline void _vec_log_softmax_lastdim(
           // See [Note AVX-SSE transitions] for why this should call the
           // vectorized version (aside from perf improvements).
           vec256::map(
-              [](Vec x) { return x.log(); },
+              [](Vec x) { return fast_math ? vec256::fast_log(x) : x.log(); },
               tmp_sum_scalar,
               tmp_sum_scalar,
               loop_end);
@@ -92,7 +101,7 @@ inline void _vec_log_softmax_lastdim(
       });
 }
 
-template <typename scalar_t>
+template <typename scalar_t, bool fast_math>
 inline void _vec_softmax_lastdim(
     scalar_t* input_data_base,
     scalar_t* output_data_base,
@@ -116,7 +125,10 @@ inline void _vec_softmax_lastdim(
               input_data,
               dim_size);
           vec256::map(
-              [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+              [max_input](Vec x) {
+                return fast_math ? vec256::fast_exp(x - Vec(max_input))
+                                 : (x - Vec(max_input)).exp();
+              },
               output_data,
               input_data,
               dim_size);
@@ -184,7 +196,7 @@ inline void _vec_host_softmax_backward_lastdim(
       });
 }
 
-template <typename scalar_t, bool LogSoftMax>
+template <typename scalar_t, bool LogSoftMax, bool fast_math>
 struct vec_host_softmax_lastdim {
   static void apply(Tensor& output, const Tensor& input) {
     int64_t outer_size = 1;
@@ -194,10 +206,10 @@ struct vec_host_softmax_lastdim {
     scalar_t* input_data_base = input.data_ptr<scalar_t>();
     scalar_t* output_data_base = output.data_ptr<scalar_t>();
     if (LogSoftMax) {
-      _vec_log_softmax_lastdim(
+      _vec_log_softmax_lastdim<scalar_t, fast_math>(
           input_data_base, output_data_base, outer_size, dim_size);
     } else {
-      _vec_softmax_lastdim(
+      _vec_softmax_lastdim<scalar_t, fast_math>(
           input_data_base, output_data_base, outer_size, dim_size);
     }
   }
@@ -224,18 +236,27 @@ struct vec_host_softmax_backward_lastdim {
 };
 
 static void softmax_lastdim_kernel_impl(Tensor& result, const Tensor& self) {
+  // Only float has approximations
+  if (at::globalContext().fastMathCPU() && self.scalar_type() == kFloat) {
+    vec_host_softmax_lastdim<float, false, true>::apply(result, self);
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "softmax_lastdim_kernel_impl", [&] {
-    vec_host_softmax_lastdim<scalar_t, false>::apply(result, self);
+    vec_host_softmax_lastdim<scalar_t, false, false>::apply(result, self);
   });
 }
 
 static void log_softmax_lastdim_kernel_impl(
     Tensor& result,
     const Tensor& self) {
+  if (at::globalContext().fastMathCPU() && self.scalar_type() == kFloat) {
+    vec_host_softmax_lastdim<float, true, true>::apply(result, self);
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES_AND(
       at::ScalarType::BFloat16, self.scalar_type(),
       "log_softmax_lastdim_kernel_impl",
-      [&] { vec_host_softmax_lastdim<scalar_t, true>::apply(result, self); });
+      [&] { vec_host_softmax_lastdim<scalar_t, true, false>::apply(result, self); });
 }
 
 static void softmax_backward_lastdim_kernel_impl(
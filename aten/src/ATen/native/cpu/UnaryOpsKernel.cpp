@@ -1,6 +1,7 @@
 #include <cmath>
 #include <type_traits>
 #include <ATen/Config.h>
+#include <ATen/Context.h>
 #include <ATen/Dispatch.h>
 #include <ATen/CPUGeneratorImpl.h>
 #include <ATen/Utils.h>
@@ -8,6 +9,7 @@
 #include <ATen/Parallel.h>
 
 #include <ATen/cpu/vml.h>
+#include <ATen/cpu/vec256/fast_math.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/cpu/vec256/functional.h>
 
@@ -31,6 +33,13 @@ namespace {
 using namespace vec256;
 
 static void sigmoid_kernel(TensorIterator& iter) {
+  if (at::globalContext().fastMathCPU() && iter.dtype() == kFloat) {
+    cpu_kernel_vec(
+        iter,
+        [](float a) -> float { return fast_sigmoid(a); },
+        [](Vec256<float> a) { return fast_sigmoid(a); });
+    return;
+  }
   AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES_AND1(kBFloat16, iter.dtype(), "sigmoid_cpu", [&]() {
     cpu_kernel_vec(
         iter,
@@ -407,8 +416,8 @@ static void rsqrt_kernel(TensorIterator& iter) {
   }                                                                           \
   REGISTER_DISPATCH(op##_stub, &op##_kernel)
 
-#define IMPLEMENT_COMPLEX_KERNEL(dispatchtypes, op)                             \
-  static void op##_kernel(TensorIterator& iter) {                             \
+#define IMPLEMENT_COMPLEX_VML_KERNEL(dispatchtypes, op)                         \
+  static void op##_vml_kernel(TensorIterator& iter) {                         \
     TORCH_INTERNAL_ASSERT(iter.ntensors() == 2);                              \
     AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES_AND1(kBFloat16, iter.dtype(), op##_vml_cpu, [&]() {\
       iter.serial_for_each(                                                   \
@@ -435,8 +444,11 @@ static void rsqrt_kernel(TensorIterator& iter) {
           },                                                                  \
           {0, iter.numel()});                                                 \
     });                                                                       \
-  }                                                                           \
-  REGISTER_DISPATCH(op##_stub, &op##_kernel)
+  }
+
+#define IMPLEMENT_COMPLEX_KERNEL(dispatchtypes, op)                             \
+  IMPLEMENT_COMPLEX_VML_KERNEL(dispatchtypes, op)                             \
+  REGISTER_DISPATCH(op##_stub, &op##_vml_kernel)
 
 } // anonymous namespace
 
@@ -495,7 +507,20 @@ IMPLEMENT_COMPLEX_KERNEL(FLOATING, sin)
 // IMPLEMENT_FLOAT_KERNEL(FLOATING, sinh)
 IMPLEMENT_COMPLEX_KERNEL(FLOATING, sqrt)
 IMPLEMENT_COMPLEX_KERNEL(FLOATING, tan)
-IMPLEMENT_COMPLEX_KERNEL(FLOATING, tanh)
+IMPLEMENT_COMPLEX_VML_KERNEL(FLOATING, tanh)
+
+static void tanh_kernel(TensorIterator& iter) {
+  if (at::globalContext().fastMathCPU() && iter.dtype() == kFloat) {
+    cpu_kernel_vec(
+        iter,
+        [](float a) -> float { return fast_tanh(a); },
+        [](Vec256<float> a) { return fast_tanh(a); });
+    return;
+  }
+  tanh_vml_kernel(iter);
+}
+REGISTER_DISPATCH(tanh_stub, &tanh_kernel);
+
 IMPLEMENT_FLOAT_KERNEL(FLOATING, trunc)
 IMPLEMENT_FLOAT_KERNEL(FLOATING, lgamma)
 
@@ -3,6 +3,7 @@
 #include <ATen/Dispatch.h>
 #include <ATen/native/UpSample.h>
 #include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
 
 namespace at {
 namespace native {
@@ -324,6 +325,354 @@ void cpu_upsample_nearest_backward(
   }
 }
 
+// Half is interpolated in float: the weights and the intermediate rows of the
+// separable kernels below are kept in this type
+template <typename scalar_t>
+struct InterpolationType {
+  using type = scalar_t;
+};
+
+template <>
+struct InterpolationType<at::Half> {
+  using type = float;
+};
+
+// Indices and weights of the interpolation along one spatial axis, computed
+// once per call. Output index o is the sum over k in [0, size) of
+// weights[o * size + k] times the input at indices[o * size + k]. Outputs that
+// need fewer than size inputs are padded with zero weights.
+template <typename opmath_t>
+struct InterpolationAxis {
+  int64_t size = 0;
+  std::vector<int64_t> indices;
+  std::vector<opmath_t> weights;
+
+  void resize(int64_t output_size, int64_t interp_size) {
+    size = interp_size;
+    indices.assign(output_size * interp_size, 0);
+    weights.assign(output_size * interp_size, opmath_t(0));
+  }
+};
+
+template <typename opmath_t>
+InterpolationAxis<opmath_t> compute_linear_axis(
+    int64_t input_size,
+    int64_t output_size,
+    bool align_corners,
+    const c10::optional<double> scale) {
+  InterpolationAxis<opmath_t> axis;
+  axis.resize(output_size, 2);
+  const opmath_t real_scale = area_pixel_compute_scale<opmath_t>(
+      input_size, output_size, align_corners, scale);
+  for (int64_t o = 0; o < output_size; o++) {
+    const opmath_t real_index = area_pixel_compute_source_index<opmath_t>(
+        real_scale, o, align_corners, /*cubic=*/false);
+    // user provided scales can point past the last input
+    const int64_t index = std::min(static_cast<int64_t>(real_index), input_size - 1);
+    const int64_t offset = (index < input_size - 1) ? 1 : 0;
+    const opmath_t lambda = real_index - index;
+    axis.indices[o * 2] = index;
+    axis.indices[o * 2 + 1] = index + offset;
+    axis.weights[o * 2] = static_cast<opmath_t>(1.) - lambda;
+    axis.weights[o * 2 + 1] = lambda;
+  }
+  return axis;
+}
+
+template <typename opmath_t>
+InterpolationAxis<opmath_t> compute_cubic_axis(
+    int64_t input_size,
+    int64_t output_size,
+    bool align_corners,
+    const c10::optional<double> scale) {
+  InterpolationAxis<opmath_t> axis;
+  axis.resize(output_size, 4);
+  const opmath_t real_scale = area_pixel_compute_scale<opmath_t>(
+      input_size, output_size, align_corners, scale);
+  for (int64_t o = 0; o < output_size; o++) {
+    const opmath_t real_index = area_pixel_compute_source_index<opmath_t>(
+        real_scale, o, align_corners, /*cubic=*/true);
+    const int64_t index = std::floor(real_index);
+    get_cubic_upsample_coefficients<opmath_t>(
+        &axis.weights[o * 4], real_index - index);
+    for (int64_t k = 0; k < 4; k++) {
+      // the input is padded with its border values
+      axis.indices[o * 4 + k] = std::max(
+          std::min(index - 1 + k, input_size - 1), static_cast<int64_t>(0));
+    }
+  }
+  return axis;
+}
+
+template <typename opmath_t>
+static inline opmath_t antialias_linear_filter(opmath_t x) {
+  x = std::abs(x);
+  return x < 1 ? 1 - x : 0;
+}
+
+// Same as PIL, antialiasing uses the cubic convolution kernel with A = -0.5
+// instead of the A = -0.75 of bicubic upsampling
+template <typename opmath_t>
+static inline opmath_t antialias_cubic_filter(opmath_t x) {
+  const opmath_t A = -0.5;
+  x = std::abs(x);
+  if (x < 1) {
+    return cubic_convolution1<opmath_t>(x, A);
+  }
+  if (x < 2) {
+    return cubic_convolution2<opmath_t>(x, A);
+  }
+  return 0;
+}
+
+// When downsampling, the filter is stretched by the scale so that every input
+// pixel contributes to the output and the weights are normalized to sum to 1,
+// which is what PIL does. interp_size is the support of the filter when
+// upsampling: 2 for linear and 4 for cubic.
+template <typename opmath_t, typename filter_t>
+InterpolationAxis<opmath_t> compute_antialias_axis(
+    int64_t input_size,
+    int64_t output_size,
+    bool align_corners,
+    const c10::optional<double> scale,
+    int64_t interp_size,
+    const filter_t& filter) {
+  // a single output pixel still averages the whole input without align_corners
+  const opmath_t real_scale = align_corners
+      ? area_pixel_compute_scale<opmath_t>(input_size, output_size, align_corners, scale)
+      : compute_scales_value<opmath_t>(scale, input_size, output_size);
+  const opmath_t support = (real_scale >= 1.0)
+      ? (interp_size * 0.5) * real_scale
+      : interp_size * 0.5;
+  const opmath_t invscale = (real_scale >= 1.0) ? 1.0 / real_scale : 1.0;
+  // with align_corners the centers of the pixels are at integer coordinates
+  const opmath_t delta = align_corners ? 0.5 : 0.0;
+
+  std::vector<int64_t> xmin(output_size);
+  std::vector<int64_t> xsize(output_size);
+  int64_t max_size = 1;
+  for (int64_t o = 0; o < output_size; o++) {
+    const opmath_t center = real_scale * (o + 0.5 - delta);
+    xmin[o] = std::max(
+        static_cast<int64_t>(center - support + 0.5 + delta),
+        static_cast<int64_t>(0));
+    xsize[o] = std::max(
+        std::min(static_cast<int64_t>(center + support + 0.5 + delta), input_size) - xmin[o],
+        static_cast<int64_t>(1));
+    xmin[o] = std::min(xmin[o], input_size - xsize[o]);
+    max_size = std::max(max_size, xsize[o]);
+  }
+
+  InterpolationAxis<opmath_t> axis;
+  axis.resize(output_size, max_size);
+  for (int64_t o = 0; o < output_size; o++) {
+    const opmath_t center = real_scale * (o + 0.5 - delta);
+    int64_t* indices = &axis.indices[o * max_size];
+    opmath_t* weights = &axis.weights[o * max_size];
+    opmath_t total = 0;
+    for (int64_t j = 0; j < max_size; j++) {
+      indices[j] = xmin[o] + std::min(j, xsize[o] - 1);
+      if (j < xsize[o]) {
+        weights[j] = filter((xmin[o] + j - center + 0.5 - delta) * invscale);
+        total += weights[j];
+      }
+    }
+    if (total != 0) {
+      for (int64_t j = 0; j < xsize[o]; j++) {
+        weights[j] /= total;
+      }
+    }
+  }
+  return axis;
+}
+
+// dst[i] = sum over k in [0, n) of weights[k] * src[k][i], for i in [0, len)
+template <typename dst_t, typename src_t, typename opmath_t>
+static inline void interpolate_rows(
+    dst_t* dst,
+    const src_t* const* src,
+    const opmath_t* weights,
+    int64_t n,
+    int64_t len) {
+  for (int64_t i = 0; i < len; i++) {
+    opmath_t value = weights[0] * static_cast<opmath_t>(src[0][i]);
+    for (int64_t k = 1; k < n; k++) {
+      value += weights[k] * static_cast<opmath_t>(src[k][i]);
+    }
+    dst[i] = static_cast<dst_t>(value);
+  }
+}
+
+template <typename scalar_t>
+static inline void interpolate_rows(
+    scalar_t* dst,
+    const scalar_t* const* src,
+    const scalar_t* weights,
+    int64_t n,
+    int64_t len) {
+  using Vec = vec256::Vec256<scalar_t>;
+  for (int64_t i = 0; i < len; i += Vec::size()) {
+    const int64_t count = std::min(static_cast<int64_t>(Vec::size()), len - i);
+    Vec value = Vec(weights[0]) * Vec::loadu(src[0] + i, count);
+    for (int64_t k = 1; k < n; k++) {
+      value = vec256::fmadd(Vec(weights[k]), Vec::loadu(src[k] + i, count), value);
+    }
+    value.store(dst + i, count);
+  }
+}
+
+// Separable 2d interpolation: each output row is computed by interpolating
+// the input rows along the height into a buffer, vectorized over the width
+// (and the channels when channels last), and then interpolating the buffer
+// along the width. Parallel over the output rows.
+template <typename scalar_t, typename opmath_t>
+void cpu_upsample_separable(
+    Tensor& output_,
+    const Tensor& input_,
+    const InterpolationAxis<opmath_t>& axis_h,
+    const InterpolationAxis<opmath_t>& axis_w) {
+  TORCH_CHECK(input_.dtype() == output_.dtype(), "expected dtype ", input_.dtype(),
+              " for `output` but got dtype ", output_.dtype());
+  const bool channels_last = input_.is_contiguous(at::MemoryFormat::ChannelsLast) &&
+      !input_.is_contiguous();
+  const auto memory_format = channels_last ? at::MemoryFormat::ChannelsLast : at::MemoryFormat::Contiguous;
+  auto input = input_.contiguous(memory_format);
+  auto output = output_.contiguous(memory_format);
+
+  auto input_data = input.data_ptr<scalar_t>();
+  auto output_data = output.data_ptr<scalar_t>();
+  int64_t num_batches = input.size(0);
+  int64_t channels = input.size(1);
+  int64_t input_height = input.size(2);
+  int64_t input_width = input.size(3);
+  int64_t output_height = output.size(2);
+  int64_t output_width = output.size(3);
+  const int64_t* indices_h = axis_h.indices.data();
+  const int64_t* indices_w = axis_w.indices.data();
+  const opmath_t* weights_h = axis_h.weights.data();
+  const opmath_t* weights_w = axis_w.weights.data();
+  const int64_t size_h = axis_h.size;
+  const int64_t size_w = axis_w.size;
+
+  auto loop = [&](int64_t begin, int64_t end) {
+    // with channels last, every input "pixel" of a row is a vector of channels
+    const int64_t pixel = channels_last ? channels : 1;
+    const int64_t planes = channels_last ? num_batches : num_batches * channels;
+    std::vector<opmath_t> buffer(input_width * pixel);
+    std::vector<const scalar_t*> rows_h(size_h);
+    std::vector<const opmath_t*> rows_w(size_w);
+
+    int64_t p = 0;
+    int64_t oh = 0;
+    data_index_init(begin, p, planes, oh, output_height);
+    for (int64_t i = begin; i < end; i++) {
+      const scalar_t* in = input_data + p * input_height * input_width * pixel;
+      for (int64_t k = 0; k < size_h; k++) {
+        rows_h[k] = in + indices_h[oh * size_h + k] * input_width * pixel;
+      }
+      interpolate_rows(
+          buffer.data(), rows_h.data(), weights_h + oh * size_h, size_h,
+          input_width * pixel);
+
+      scalar_t* out = output_data + i * output_width * pixel;
+      if (channels_last) {
+        for (int64_t ow = 0; ow < output_width; ow++) {
+          for (int64_t k = 0; k < size_w; k++) {
+            rows_w[k] = buffer.data() + indices_w[ow * size_w + k] * pixel;
+          }
+          interpolate_rows(
+              out + ow * pixel, rows_w.data(), weights_w + ow * size_w, size_w,
+              pixel);
+        }
+      } else {
+        for (int64_t ow = 0; ow < output_width; ow++) {
+          const int64_t* iw = indices_w + ow * size_w;
+          const opmath_t* ww = weights_w + ow * size_w;
+          opmath_t value = ww[0] * buffer[iw[0]];
+          for (int64_t k = 1; k < size_w; k++) {
+            value += ww[k] * buffer[iw[k]];
+          }
+          out[ow] = static_cast<scalar_t>(value);
+        }
+      }
+      data_index_step(p, planes, oh, output_height);
+    }
+  };
+
+  const int64_t num_rows = (channels_last ? num_batches : num_batches * channels) * output_height;
+  const int64_t row_size = (channels_last ? channels : 1) * std::max(input_width, output_width);
+  at::parallel_for(0, num_rows, at::internal::GRAIN_SIZE / row_size, loop);
+
+  if (!output_.is_contiguous(memory_format)) {
+    output_.copy_(output);
+  }
+}
+
+// Transposed of cpu_upsample_separable: every grad_output row is scattered
+// along the width into a buffer, which is then added to the grad_input rows
+// along the height. Parallel over the channels.
+template <typename scalar_t, typename opmath_t>
+void cpu_upsample_separable_backward(
+    Tensor& grad_input_,
+    const Tensor& grad_output_,
+    const InterpolationAxis<opmath_t>& axis_h,
+    const InterpolationAxis<opmath_t>& axis_w) {
+  TORCH_CHECK(grad_input_.dtype() == grad_output_.dtype(), "expected dtype ", grad_output_.dtype(),
+              " for `grad_input` but got dtype ", grad_input_.dtype());
+
+  auto grad_output = grad_output_.contiguous();
+  auto grad_input = grad_input_.contiguous();
+
+  auto grad_output_data = grad_output.data_ptr<scalar_t>();
+  auto grad_input_data = grad_input.data_ptr<scalar_t>();
+  int64_t channels = grad_input.size(0) * grad_input.size(1);
+  int64_t input_height = grad_input.size(2);
+  int64_t input_width = grad_input.size(3);
+  int64_t output_height = grad_output.size(2);
+  int64_t output_width = grad_output.size(3);
+  int64_t input_slice_size = input_height * input_width;
+  int64_t output_slice_size = output_height * output_width;
+  const int64_t size_h = axis_h.size;
+  const int64_t size_w = axis_w.size;
+
+  auto loop = [&](int64_t begin, int64_t end) {
+    std::vector<opmath_t> buffer(input_width);
+    std::vector<opmath_t> plane(input_slice_size);
+    for (int64_t c = begin; c < end; c++) {
+      const scalar_t* grad_out = grad_output_data + c * output_slice_size;
+      scalar_t* grad_in = grad_input_data + c * input_slice_size;
+      for (int64_t i = 0; i < input_slice_size; i++) {
+        plane[i] = static_cast<opmath_t>(grad_in[i]);
+      }
+      for (int64_t oh = 0; oh < output_height; oh++) {
+        std::fill(buffer.begin(), buffer.end(), opmath_t(0));
+        for (int64_t ow = 0; ow < output_width; ow++) {
+          const opmath_t grad = grad_out[oh * output_width + ow];
+          for (int64_t k = 0; k < size_w; k++) {
+            buffer[axis_w.indices[ow * size_w + k]] += axis_w.weights[ow * size_w + k] * grad;
+          }
+        }
+        for (int64_t k = 0; k < size_h; k++) {
+          opmath_t* row = plane.data() + axis_h.indices[oh * size_h + k] * input_width;
+          const opmath_t weight = axis_h.weights[oh * size_h + k];
+          for (int64_t iw = 0; iw < input_width; iw++) {
+            row[iw] += weight * buffer[iw];
+          }
+        }
+      }
+      for (int64_t i = 0; i < input_slice_size; i++) {
+        grad_in[i] = static_cast<scalar_t>(plane[i]);
+      }
+    }
+  };
+
+  at::parallel_for(0, channels, at::internal::GRAIN_SIZE / output_slice_size / size_h, loop);
+
+  if (!grad_input_.is_contiguous()) {
+    grad_input_.copy_(grad_input);
+  }
+}
+
 using scale_t = std::vector<c10::optional<double>>;
 void upsample_nearest1d_kernel_impl(
     Tensor& output,
@@ -397,6 +746,109 @@ void upsample_nearest3d_backward_kernel_impl(
   });
 }
 
+void upsample_bilinear2d_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "upsample_bilinear2d", [&] {
+    using opmath_t = typename InterpolationType<scalar_t>::type;
+    cpu_upsample_separable<scalar_t, opmath_t>(
+        output,
+        input,
+        compute_linear_axis<opmath_t>(input.size(2), output.size(2), align_corners, scales_h),
+        compute_linear_axis<opmath_t>(input.size(3), output.size(3), align_corners, scales_w));
+  });
+}
+
+void upsample_bicubic2d_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "upsample_bicubic2d", [&] {
+    using opmath_t = typename InterpolationType<scalar_t>::type;
+    cpu_upsample_separable<scalar_t, opmath_t>(
+        output,
+        input,
+        compute_cubic_axis<opmath_t>(input.size(2), output.size(2), align_corners, scales_h),
+        compute_cubic_axis<opmath_t>(input.size(3), output.size(3), align_corners, scales_w));
+  });
+}
+
+void _upsample_bilinear2d_aa_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "_upsample_bilinear2d_aa", [&] {
+    using opmath_t = typename InterpolationType<scalar_t>::type;
+    cpu_upsample_separable<scalar_t, opmath_t>(
+        output,
+        input,
+        compute_antialias_axis<opmath_t>(
+            input.size(2), output.size(2), align_corners, scales_h, 2, antialias_linear_filter<opmath_t>),
+        compute_antialias_axis<opmath_t>(
+            input.size(3), output.size(3), align_corners, scales_w, 2, antialias_linear_filter<opmath_t>));
+  });
+}
+
+void _upsample_bicubic2d_aa_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "_upsample_bicubic2d_aa", [&] {
+    using opmath_t = typename InterpolationType<scalar_t>::type;
+    cpu_upsample_separable<scalar_t, opmath_t>(
+        output,
+        input,
+        compute_antialias_axis<opmath_t>(
+            input.size(2), output.size(2), align_corners, scales_h, 4, antialias_cubic_filter<opmath_t>),
+        compute_antialias_axis<opmath_t>(
+            input.size(3), output.size(3), align_corners, scales_w, 4, antialias_cubic_filter<opmath_t>));
+  });
+}
+
+void _upsample_bilinear2d_aa_backward_kernel_impl(
+    Tensor& grad_input,
+    const Tensor& grad_output,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(grad_output.scalar_type(), "_upsample_bilinear2d_aa_backward", [&] {
+    using opmath_t = typename InterpolationType<scalar_t>::type;
+    cpu_upsample_separable_backward<scalar_t, opmath_t>(
+        grad_input,
+        grad_output,
+        compute_antialias_axis<opmath_t>(
+            grad_input.size(2), grad_output.size(2), align_corners, scales_h, 2, antialias_linear_filter<opmath_t>),
+        compute_antialias_axis<opmath_t>(
+            grad_input.size(3), grad_output.size(3), align_corners, scales_w, 2, antialias_linear_filter<opmath_t>));
+  });
+}
+
+void _upsample_bicubic2d_aa_backward_kernel_impl(
+    Tensor& grad_input,
+    const Tensor& grad_output,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(grad_output.scalar_type(), "_upsample_bicubic2d_aa_backward", [&] {
+    using opmath_t = typename InterpolationType<scalar_t>::type;
+    cpu_upsample_separable_backward<scalar_t, opmath_t>(
+        grad_input,
+        grad_output,
+        compute_antialias_axis<opmath_t>(
+            grad_input.size(2), grad_output.size(2), align_corners, scales_h, 4, antialias_cubic_filter<opmath_t>),
+        compute_antialias_axis<opmath_t>(
+            grad_input.size(3), grad_output.size(3), align_corners, scales_w, 4, antialias_cubic_filter<opmath_t>));
+  });
+}
 
 } // anonymous namespace
 
@@ -406,6 +858,12 @@ REGISTER_DISPATCH(upsample_nearest3d_kernel, &upsample_nearest3d_kernel_impl);
 REGISTER_DISPATCH(upsample_nearest1d_backward_kernel, &upsample_nearest1d_backward_kernel_impl);
 REGISTER_DISPATCH(upsample_nearest2d_backward_kernel, &upsample_nearest2d_backward_kernel_impl);
 REGISTER_DISPATCH(upsample_nearest3d_backward_kernel, &upsample_nearest3d_backward_kernel_impl);
+REGISTER_DISPATCH(upsample_bilinear2d_kernel, &upsample_bilinear2d_kernel_impl);
+REGISTER_DISPATCH(upsample_bicubic2d_kernel, &upsample_bicubic2d_kernel_impl);
+REGISTER_DISPATCH(_upsample_bilinear2d_aa_kernel, &_upsample_bilinear2d_aa_kernel_impl);
+REGISTER_DISPATCH(_upsample_bicubic2d_aa_kernel, &_upsample_bicubic2d_aa_kernel_impl);
+REGISTER_DISPATCH(_upsample_bilinear2d_aa_backward_kernel, &_upsample_bilinear2d_aa_backward_kernel_impl);
+REGISTER_DISPATCH(_upsample_bicubic2d_aa_backward_kernel, &_upsample_bicubic2d_aa_backward_kernel_impl);
 
 } // namespace native
 } // namespace at
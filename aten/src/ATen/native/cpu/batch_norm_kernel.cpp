@@ -1,114 +1,473 @@
 #include <ATen/native/batch_norm.h>
 
 #include <ATen/ATen.h>
-#include <ATen/CPUApplyUtils.h>
+#include <ATen/AccumulateType.h>
 #include <ATen/Dispatch.h>
-#include <ATen/native/TensorIterator.h>
-#include <ATen/native/cpu/Loops.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/cpu/Moments.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
 
 namespace at { namespace native {
 namespace {
 
 using namespace vec256;
 
+// Note [Batch norm CPU memory formats]
+// The kernels view a contiguous input of shape [N, C, *] as N * C planes of
+// image_size elements, parallelize over the planes and vectorize within a
+// plane. A channels last input, or a contiguous input with image_size == 1, is
+// viewed as a row major [N * image_size, C] matrix instead: the kernels
+// parallelize over blocks of rows and vectorize over the channels, so that
+// all the accesses are still contiguous. The per channel reductions of both
+// are computed as partial results per plane or per block of rows in the
+// accumulate type, which are merged afterwards.
+
+inline bool batch_norm_use_channels_last_impl(const Tensor& input) {
+  return !input.is_contiguous() || input.numel() == input.size(0) * input.size(1);
+}
+
+// Splits n_rows rows into at most one block per thread.
+inline int64_t batch_norm_rows_per_block(int64_t n_rows) {
+  return divup(n_rows, std::min<int64_t>(at::get_num_threads(), n_rows));
+}
+
+template<typename scalar_t>
+void batch_norm_cpu_collect_mean_and_invstd(
+    scalar_t* mean, scalar_t* invstd, int64_t n_channel,
+    const Tensor& save_mean, const Tensor& save_invstd,
+    const Tensor& running_mean, const Tensor& running_var,
+    bool train, double eps) {
+  if (train) {
+    std::copy_n(save_mean.data_ptr<scalar_t>(), n_channel, mean);
+    std::copy_n(save_invstd.data_ptr<scalar_t>(), n_channel, invstd);
+  } else {
+    const scalar_t* running_mean_data = running_mean.data_ptr<scalar_t>();
+    const scalar_t* running_var_data = running_var.data_ptr<scalar_t>();
+    for (int64_t c = 0; c < n_channel; c++) {
+      mean[c] = running_mean_data[c];
+      invstd[c] = 1 / std::sqrt(running_var_data[c] + static_cast<scalar_t>(eps));
+    }
+  }
+}
+
 template<typename scalar_t>
-void batch_norm_cpu_inference_collect_linear_and_constant_terms(
-    TensorAccessor<scalar_t, 1> alpha, TensorAccessor<scalar_t, 1> beta, int64_t n_channel,
+void batch_norm_cpu_collect_linear_and_constant_terms(
+    scalar_t* alpha, scalar_t* beta, int64_t n_channel,
     const Tensor& weight /* optional */, const Tensor& bias /* optional */,
-    const Tensor& mean, const Tensor& variance, double eps) {
+    const Tensor& save_mean, const Tensor& save_invstd,
+    const Tensor& running_mean, const Tensor& running_var, bool train, double eps) {
 
   const scalar_t* weight_data = weight.defined() ? weight.data_ptr<scalar_t>() : nullptr;
   const scalar_t* bias_data = bias.defined() ? bias.data_ptr<scalar_t>() : nullptr;
-  auto mean_data = mean.accessor<scalar_t, 1>();
-  auto var_data = variance.accessor<scalar_t, 1>();
+  // beta holds the mean until it is overwritten below.
+  batch_norm_cpu_collect_mean_and_invstd<scalar_t>(beta, alpha, n_channel,
+      save_mean, save_invstd, running_mean, running_var, train, eps);
 
   /// Collect the linear and constant terms regarding the input.
   /// output(n, c, h, w)
-  ///     = (input(n, c, h, w) - mean(c)) / sqrt(var(c) + eps) * weight(c)
-  ///         + bias(c)
-  ///     = input(n, c, h, w) * inv_var(c) * weight(c)
-  ///         - mean(c) * inv_var(c) * weight(c) + bias(c),
-  /// where inv_var(c) = 1 / sqrt(var(c) + eps).
-  /// So the linear term, alpha(c) = inv_var(c) * weight(c),
-  ///   the constant term beta(c) = bias(c) - mean(c) * inv_var(c) * weight(c)
-  /// Note that this is only a good idea if (input_size >> c), in degenerate
-  /// cases where image_size == 1 && batch_size == 1, it is slow.
+  ///     = (input(n, c, h, w) - mean(c)) * invstd(c) * weight(c) + bias(c)
+  ///     = input(n, c, h, w) * invstd(c) * weight(c)
+  ///         - mean(c) * invstd(c) * weight(c) + bias(c),
+  /// where invstd(c) = 1 / sqrt(var(c) + eps) in evaluation mode.
+  /// So the linear term, alpha(c) = invstd(c) * weight(c),
+  ///   the constant term beta(c) = bias(c) - mean(c) * invstd(c) * weight(c)
   for (int64_t c = 0; c < n_channel; c++) {
-    scalar_t inv_var = 1 / std::sqrt(var_data[c] + static_cast<scalar_t>(eps));
     scalar_t weight_v = weight_data ? weight_data[c] : 1;
     scalar_t bias_v = bias_data ? bias_data[c] : 0;
-    alpha[c] = inv_var * weight_v;
-    beta[c] = bias_v - mean_data[c] * alpha[c];
+    alpha[c] = alpha[c] * weight_v;
+    beta[c] = bias_v - beta[c] * alpha[c];
   }
 }
 
-/// A fast path for CPU inference when all tensors are contiguous.
+/// output(n, c, i) = input(n, c, i) * alpha(c) + beta(c) on the planes of a
+/// contiguous input.
 template<typename scalar_t>
-void batch_norm_cpu_inference_contiguous_impl(Tensor& output,
-    const Tensor& input, const Tensor& weight, const Tensor& bias,
-    const Tensor& mean, const Tensor& variance, double eps) {
+void batch_norm_cpu_apply_contiguous(
+    scalar_t* output_data, const scalar_t* input_data,
+    const scalar_t* alpha_data, const scalar_t* beta_data,
+    int64_t n_batch, int64_t n_channel, int64_t image_size) {
+  using Vec = Vec256<scalar_t>;
+  const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / image_size);
+  at::parallel_for(0, n_batch * n_channel, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const int64_t c = i % n_channel;
+      const Vec alpha_vec(alpha_data[c]);
+      const Vec beta_vec(beta_data[c]);
+      vec256::map(
+          [alpha_vec, beta_vec](Vec x) { return x * alpha_vec + beta_vec; },
+          output_data + i * image_size,
+          input_data + i * image_size,
+          image_size);
+    }
+  });
+}
 
+/// output(r, c) = input(r, c) * alpha(c) + beta(c) on the rows of a channels
+/// last input.
+template<typename scalar_t>
+void batch_norm_cpu_apply_channels_last(
+    scalar_t* output_data, const scalar_t* input_data,
+    const scalar_t* alpha_data, const scalar_t* beta_data,
+    int64_t n_rows, int64_t n_channel) {
   using Vec = Vec256<scalar_t>;
+  const int64_t loop_size = n_channel - (n_channel % Vec::size());
+  const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / n_channel);
+  at::parallel_for(0, n_rows, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const scalar_t* input_ptr = input_data + i * n_channel;
+      scalar_t* output_ptr = output_data + i * n_channel;
+      int64_t d = 0;
+      for (; d < loop_size; d += Vec::size()) {
+        Vec data_vec = Vec::loadu(input_ptr + d);
+        Vec output_vec = data_vec * Vec::loadu(alpha_data + d) + Vec::loadu(beta_data + d);
+        output_vec.store(output_ptr + d);
+      }
+      if (n_channel - d > 0) {
+        const int64_t count = n_channel - d;
+        Vec data_vec = Vec::loadu(input_ptr + d, count);
+        Vec output_vec = data_vec * Vec::loadu(alpha_data + d, count)
+            + Vec::loadu(beta_data + d, count);
+        output_vec.store(output_ptr + d, count);
+      }
+    }
+  });
+}
+
+template<typename scalar_t>
+void batch_norm_cpu_impl(Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias,
+    const Tensor& save_mean, const Tensor& save_invstd,
+    const Tensor& running_mean, const Tensor& running_var, bool train, double eps) {
+
   int64_t n_batch = input.size(0);
   int64_t n_channel = input.size(1);
   int64_t image_size = input.numel() / n_batch / n_channel;
 
-  Tensor alpha = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  Tensor beta = at::empty_like(mean, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  auto alpha_data = alpha.accessor<scalar_t, 1>();
-  auto beta_data = beta.accessor<scalar_t, 1>();
+  Tensor alpha = at::empty({n_channel}, input.options());
+  Tensor beta = at::empty({n_channel}, input.options());
+  scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
+  scalar_t* beta_data = beta.data_ptr<scalar_t>();
 
-  batch_norm_cpu_inference_collect_linear_and_constant_terms<scalar_t>(
-     alpha_data, beta_data, n_channel, weight, bias, mean, variance, eps);
+  batch_norm_cpu_collect_linear_and_constant_terms<scalar_t>(
+      alpha_data, beta_data, n_channel, weight, bias,
+      save_mean, save_invstd, running_mean, running_var, train, eps);
 
   scalar_t* output_data = output.data_ptr<scalar_t>();
   const scalar_t* input_data = input.data_ptr<scalar_t>();
+  if (batch_norm_use_channels_last_impl(input)) {
+    batch_norm_cpu_apply_channels_last<scalar_t>(
+        output_data, input_data, alpha_data, beta_data,
+        n_batch * image_size, n_channel);
+  } else {
+    batch_norm_cpu_apply_contiguous<scalar_t>(
+        output_data, input_data, alpha_data, beta_data,
+        n_batch, n_channel, image_size);
+  }
+}
+
+template<typename scalar_t>
+void batch_norm_cpu_collect_stats_contiguous_impl(
+    Tensor& mean, Tensor& var_sum, const Tensor& input) {
+  int64_t n_batch = input.size(0);
+  int64_t n_channel = input.size(1);
+  int64_t image_size = input.numel() / n_batch / n_channel;
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
 
-  // Apply the linear terms to the input,
-  // output(n, c, h, w) = input(n, c, h, w) * alpha(c) + beta(c)
-  // No need to use parallel_for as this function is supposed to be
-  // memory-limited.
-  if (image_size != 1) {
-    const int64_t n_offset = n_channel * image_size;
-    const int64_t loop_size = image_size - (image_size % Vec::size());
-    for (int64_t n = 0; n < n_batch; n++) { 
-      for (int64_t c = 0; c < n_channel; c++) {
-        const Vec alpha_vec(alpha_data[c]);
-        const Vec beta_vec(beta_data[c]);
-        int64_t offset = n * n_offset + c * image_size;
-        int64_t d = 0;
-        for (; d < loop_size; d += Vec::size()) {
-          Vec data_vec = Vec::loadu(input_data + offset + d);
-          Vec output_vec = data_vec * alpha_vec + beta_vec;
-          output_vec.store(output_data + offset + d);
-        }
-        if (image_size - d > 0) {
-          Vec data_vec = Vec::loadu(input_data + offset + d, image_size - d);
-          Vec output_vec = data_vec * alpha_vec + beta_vec;
-          output_vec.store(output_data + offset + d, image_size - d);
+  // Moments of every (n, c) plane, merged over the batch afterwards.
+  std::vector<MomentsAcc<scalar_t>> plane_moments(n_batch * n_channel);
+  const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / image_size);
+  at::parallel_for(0, n_batch * n_channel, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      plane_moments[i] = moments_contiguous<scalar_t>(input_data + i * image_size, image_size);
+    }
+  });
+
+  scalar_t* mean_data = mean.data_ptr<scalar_t>();
+  scalar_t* var_sum_data = var_sum.data_ptr<scalar_t>();
+  for (int64_t c = 0; c < n_channel; c++) {
+    MomentsAcc<scalar_t> acc;
+    for (int64_t n = 0; n < n_batch; n++) {
+      acc = moments_combine<scalar_t>(acc, plane_moments[n * n_channel + c]);
+    }
+    mean_data[c] = acc.mean;
+    var_sum_data[c] = acc.m2;
+  }
+}
+
+template<typename scalar_t>
+void batch_norm_cpu_collect_stats_channels_last_impl(
+    Tensor& mean, Tensor& var_sum, const Tensor& input) {
+  using accscalar_t = acc_type<scalar_t, false>;
+  int64_t n_channel = input.size(1);
+  int64_t n_rows = input.numel() / n_channel;
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+
+  // Moments of the columns of every block of rows, merged over the blocks
+  // afterwards.
+  const int64_t block_size = batch_norm_rows_per_block(n_rows);
+  const int64_t n_blocks = divup(n_rows, block_size);
+  std::vector<accscalar_t> buffer(2 * n_blocks * n_channel);
+  accscalar_t* mean_buffer = buffer.data();
+  accscalar_t* m2_buffer = mean_buffer + n_blocks * n_channel;
+  at::parallel_for(0, n_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t k = begin; k < end; k++) {
+      const int64_t row_begin = k * block_size;
+      const int64_t rows = std::min(block_size, n_rows - row_begin);
+      moments_columns<scalar_t>(
+          input_data + row_begin * n_channel, rows, n_channel,
+          mean_buffer + k * n_channel, m2_buffer + k * n_channel);
+    }
+  });
+
+  scalar_t* mean_data = mean.data_ptr<scalar_t>();
+  scalar_t* var_sum_data = var_sum.data_ptr<scalar_t>();
+  for (int64_t c = 0; c < n_channel; c++) {
+    MomentsAcc<scalar_t> acc;
+    for (int64_t k = 0; k < n_blocks; k++) {
+      const int64_t rows = std::min(block_size, n_rows - k * block_size);
+      acc = moments_combine<scalar_t>(acc, make_moments<scalar_t>(
+          mean_buffer[k * n_channel + c], m2_buffer[k * n_channel + c], rows));
+    }
+    mean_data[c] = acc.mean;
+    var_sum_data[c] = acc.m2;
+  }
+}
+
+/// Per channel sum of grad_output and dot product of (input - mean) and
+/// grad_output, written to sum_data and dotp_data.
+template<typename scalar_t>
+void batch_norm_cpu_backward_reduce_contiguous(
+    acc_type<scalar_t, false>* sum_data, acc_type<scalar_t, false>* dotp_data,
+    const scalar_t* grad_output_data, const scalar_t* input_data,
+    const scalar_t* mean_data, int64_t n_batch, int64_t n_channel, int64_t image_size) {
+  using accscalar_t = acc_type<scalar_t, false>;
+
+  // Sums of every (n, c) plane, added over the batch afterwards.
+  std::vector<accscalar_t> plane_sums(2 * n_batch * n_channel);
+  accscalar_t* plane_sum = plane_sums.data();
+  accscalar_t* plane_dotp = plane_sum + n_batch * n_channel;
+  const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / image_size);
+  at::parallel_for(0, n_batch * n_channel, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      std::tie(plane_sum[i], plane_dotp[i]) = sum_and_dot_contiguous<scalar_t>(
+          grad_output_data + i * image_size, input_data + i * image_size,
+          mean_data[i % n_channel], image_size);
+    }
+  });
+
+  for (int64_t c = 0; c < n_channel; c++) {
+    accscalar_t sum = 0;
+    accscalar_t dotp = 0;
+    for (int64_t n = 0; n < n_batch; n++) {
+      sum += plane_sum[n * n_channel + c];
+      dotp += plane_dotp[n * n_channel + c];
+    }
+    sum_data[c] = sum;
+    dotp_data[c] = dotp;
+  }
+}
+
+template<typename scalar_t>
+void batch_norm_cpu_backward_reduce_channels_last(
+    acc_type<scalar_t, false>* sum_data, acc_type<scalar_t, false>* dotp_data,
+    const scalar_t* grad_output_data, const scalar_t* input_data,
+    const scalar_t* mean_data, int64_t n_rows, int64_t n_channel) {
+  using accscalar_t = acc_type<scalar_t, false>;
+
+  // Sums of the columns of every block of rows, added over the blocks
+  // afterwards. A block may have many more rows than fit in the precision of
+  // scalar_t, so they are accumulated in accscalar_t; the loop over the
+  // channels is vectorized by the compiler.
+  const int64_t block_size = batch_norm_rows_per_block(n_rows);
+  const int64_t n_blocks = divup(n_rows, block_size);
+  std::vector<accscalar_t> block_sums(2 * n_blocks * n_channel, 0);
+  accscalar_t* block_sum = block_sums.data();
+  accscalar_t* block_dotp = block_sum + n_blocks * n_channel;
+  at::parallel_for(0, n_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t k = begin; k < end; k++) {
+      accscalar_t* sum_ptr = block_sum + k * n_channel;
+      accscalar_t* dotp_ptr = block_dotp + k * n_channel;
+      const int64_t row_end = std::min(n_rows, (k + 1) * block_size);
+      for (int64_t i = k * block_size; i < row_end; i++) {
+        const scalar_t* dy = grad_output_data + i * n_channel;
+        const scalar_t* x = input_data + i * n_channel;
+        for (int64_t d = 0; d < n_channel; d++) {
+          const accscalar_t dy_val = dy[d];
+          sum_ptr[d] += dy_val;
+          dotp_ptr[d] += static_cast<accscalar_t>(x[d] - mean_data[d]) * dy_val;
         }
       }
     }
+  });
+
+  for (int64_t c = 0; c < n_channel; c++) {
+    sum_data[c] = 0;
+    dotp_data[c] = 0;
+    for (int64_t k = 0; k < n_blocks; k++) {
+      sum_data[c] += block_sum[k * n_channel + c];
+      dotp_data[c] += block_dotp[k * n_channel + c];
+    }
+  }
+}
+
+template<typename scalar_t>
+void batch_norm_cpu_backward_impl(Tensor& grad_input, Tensor& grad_weight, Tensor& grad_bias,
+    const Tensor& grad_output, const Tensor& input, const Tensor& weight,
+    const Tensor& running_mean, const Tensor& running_var,
+    const Tensor& save_mean, const Tensor& save_invstd, bool train, double eps) {
+
+  using accscalar_t = acc_type<scalar_t, false>;
+  int64_t n_batch = input.size(0);
+  int64_t n_channel = input.size(1);
+  int64_t image_size = input.numel() / n_batch / n_channel;
+  int64_t n = n_batch * image_size;
+  const bool channels_last = batch_norm_use_channels_last_impl(input);
+
+  const scalar_t* grad_output_data = grad_output.data_ptr<scalar_t>();
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  const scalar_t* weight_data = weight.defined() ? weight.data_ptr<scalar_t>() : nullptr;
+
+  Tensor stats = at::empty({5, n_channel}, input.options());
+  scalar_t* mean_data = stats.data_ptr<scalar_t>();
+  scalar_t* invstd_data = mean_data + n_channel;
+  batch_norm_cpu_collect_mean_and_invstd<scalar_t>(mean_data, invstd_data, n_channel,
+      save_mean, save_invstd, running_mean, running_var, train, eps);
+
+  std::vector<accscalar_t> sums(2 * n_channel);
+  accscalar_t* sum_data = sums.data();
+  accscalar_t* dotp_data = sum_data + n_channel;
+  if (channels_last) {
+    batch_norm_cpu_backward_reduce_channels_last<scalar_t>(sum_data, dotp_data,
+        grad_output_data, input_data, mean_data, n_batch * image_size, n_channel);
   } else {
-    // image_size == 1
-    for (int64_t n = 0; n < n_batch; ++n) {
-      for (int64_t c = 0; c < n_channel; ++c) {
-        int64_t offset = n * n_channel + c;
-        output_data[offset] = input_data[offset] * alpha_data[c] + beta_data[c];
-      }
+    batch_norm_cpu_backward_reduce_contiguous<scalar_t>(sum_data, dotp_data,
+        grad_output_data, input_data, mean_data, n_batch, n_channel, image_size);
+  }
+
+  if (grad_weight.defined()) {
+    scalar_t* grad_weight_data = grad_weight.data_ptr<scalar_t>();
+    for (int64_t c = 0; c < n_channel; c++) {
+      grad_weight_data[c] = dotp_data[c] * invstd_data[c];
+    }
+  }
+  if (grad_bias.defined()) {
+    scalar_t* grad_bias_data = grad_bias.data_ptr<scalar_t>();
+    for (int64_t c = 0; c < n_channel; c++) {
+      grad_bias_data[c] = sum_data[c];
+    }
+  }
+  if (!grad_input.defined()) {
+    return;
+  }
+
+  /// In training mode, with Q(X) = X - E[x] and Y = Q(X) / sigma,
+  ///   dL/dX = (Q(dL/dY) - dot(Y, dL/dY) * Y) / sigma * w
+  ///         = (dy - sum / n - (x - mean) * k) * invstd * w,
+  /// where k = dotp * invstd * invstd / n, which is linear in dy and x:
+  ///   dL/dX = a(c) * dy + b(c) * x + d(c), with a(c) = invstd(c) * w(c),
+  ///   b(c) = -a(c) * k(c) and d(c) = a(c) * (k(c) * mean(c) - sum(c) / n).
+  /// In evaluation mode dL/dX = dy * invstd * w, i.e., b(c) = d(c) = 0.
+  scalar_t* a_data = invstd_data + n_channel;
+  scalar_t* b_data = a_data + n_channel;
+  scalar_t* d_data = b_data + n_channel;
+  for (int64_t c = 0; c < n_channel; c++) {
+    const scalar_t w = weight_data ? weight_data[c] : 1;
+    a_data[c] = invstd_data[c] * w;
+    if (train) {
+      const scalar_t k = (scalar_t) dotp_data[c] * invstd_data[c] * invstd_data[c] / n;
+      const scalar_t grad_mean = sum_data[c] / n;
+      b_data[c] = -a_data[c] * k;
+      d_data[c] = a_data[c] * (k * mean_data[c] - grad_mean);
+    } else {
+      b_data[c] = 0;
+      d_data[c] = 0;
     }
   }
+
+  using Vec = Vec256<scalar_t>;
+  scalar_t* grad_input_data = grad_input.data_ptr<scalar_t>();
+  if (channels_last) {
+    const int64_t loop_size = n_channel - (n_channel % Vec::size());
+    const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / n_channel);
+    at::parallel_for(0, n_batch * image_size, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        const scalar_t* dy = grad_output_data + i * n_channel;
+        const scalar_t* x = input_data + i * n_channel;
+        scalar_t* dx = grad_input_data + i * n_channel;
+        int64_t c = 0;
+        for (; c < loop_size; c += Vec::size()) {
+          const Vec dx_vec = Vec::loadu(a_data + c) * Vec::loadu(dy + c)
+              + Vec::loadu(b_data + c) * Vec::loadu(x + c) + Vec::loadu(d_data + c);
+          dx_vec.store(dx + c);
+        }
+        for (; c < n_channel; c++) {
+          dx[c] = a_data[c] * dy[c] + b_data[c] * x[c] + d_data[c];
+        }
+      }
+    });
+  } else {
+    const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / image_size);
+    at::parallel_for(0, n_batch * n_channel, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        const int64_t c = i % n_channel;
+        const Vec a_vec(a_data[c]);
+        const Vec b_vec(b_data[c]);
+        const Vec d_vec(d_data[c]);
+        const scalar_t* dy = grad_output_data + i * image_size;
+        const scalar_t* x = input_data + i * image_size;
+        scalar_t* dx = grad_input_data + i * image_size;
+        int64_t j = 0;
+        for (; j < image_size - (image_size % Vec::size()); j += Vec::size()) {
+          const Vec dx_vec = a_vec * Vec::loadu(dy + j) + b_vec * Vec::loadu(x + j) + d_vec;
+          dx_vec.store(dx + j);
+        }
+        for (; j < image_size; j++) {
+          dx[j] = a_data[c] * dy[j] + b_data[c] * x[j] + d_data[c];
+        }
+      }
+    });
+  }
+}
+
+void batch_norm_cpu_kernel(Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, const Tensor& save_mean, const Tensor& save_invstd,
+    const Tensor& running_mean, const Tensor& running_var, bool train, double eps) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu", [&] {
+    batch_norm_cpu_impl<scalar_t>(output, input, weight, bias,
+        save_mean, save_invstd, running_mean, running_var, train, eps);
+  });
+}
+
+void batch_norm_cpu_collect_stats_kernel(
+    Tensor& mean, Tensor& var_sum, const Tensor& input) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_collect_stats", [&] {
+    if (batch_norm_use_channels_last_impl(input)) {
+      batch_norm_cpu_collect_stats_channels_last_impl<scalar_t>(mean, var_sum, input);
+    } else {
+      batch_norm_cpu_collect_stats_contiguous_impl<scalar_t>(mean, var_sum, input);
+    }
+  });
 }
 
-void batch_norm_cpu_inference_contiguous_kernel(Tensor& output, const Tensor& input,
-    const Tensor& weight, const Tensor& bias, const Tensor& mean, const Tensor& variance, double eps) {
-  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_inference_contiguous", [&] {
-    batch_norm_cpu_inference_contiguous_impl<scalar_t>(output, input, weight, bias, mean, variance, eps);
+void batch_norm_cpu_backward_kernel(Tensor& grad_input, Tensor& grad_weight, Tensor& grad_bias,
+    const Tensor& grad_output, const Tensor& input, const Tensor& weight,
+    const Tensor& running_mean, const Tensor& running_var, const Tensor& save_mean, const Tensor& save_invstd,
+    bool train, double eps) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_backward", [&] {
+    batch_norm_cpu_backward_impl<scalar_t>(grad_input, grad_weight, grad_bias,
+        grad_output, input, weight, running_mean, running_var, save_mean, save_invstd, train, eps);
   });
 }
 
 }// anonymous namespace
 
-REGISTER_DISPATCH(batch_norm_cpu_inference_contiguous_stub, &batch_norm_cpu_inference_contiguous_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_stub, &batch_norm_cpu_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_collect_stats_stub, &batch_norm_cpu_collect_stats_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_backward_stub, &batch_norm_cpu_backward_kernel);
 
 }} // namespace at::native
@@ -0,0 +1,443 @@
+#include <ATen/native/group_norm.h>
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <ATen/AccumulateType.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/cpu/Moments.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// A contiguous X is viewed as N * C planes of HxW elements, the D = C / group
+// channels of a group being D consecutive planes. A channels last X (or one
+// with HxW == 1) is viewed as N samples of [HxW, C] row major matrices, which
+// are reduced per channel over blocks of rows first and then per group, and
+// transformed row by row with per channel coefficients, vectorized over C.
+bool GroupNormUseChannelsLast(const Tensor& X, int64_t HxW) {
+  return !X.is_contiguous() || HxW == 1;
+}
+
+// Splits every sample of HxW rows into blocks so that there is about one block
+// per thread in total.
+int64_t GroupNormRowsPerBlock(int64_t N, int64_t HxW) {
+  const int64_t blocks_per_sample =
+      std::min(HxW, divup(at::get_num_threads(), N));
+  return divup(HxW, blocks_per_sample);
+}
+
+// Y[n, i, c] = X[n, i, c] * scale[n, c] + bias[n, c] on the rows of a channels
+// last X.
+template <typename T>
+void GroupNormApplyChannelsLast(
+    const T* X_data,
+    const T* scale_data,
+    const T* bias_data,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    T* Y_data) {
+  using Vec = vec256::Vec256<T>;
+  const int64_t loop_size = C - (C % Vec::size());
+  const int64_t grain_size =
+      std::max<int64_t>(1, internal::GRAIN_SIZE / C);
+  at::parallel_for(0, N * HxW, grain_size, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const T* X_ptr = X_data + i * C;
+      const T* scale_ptr = scale_data + (i / HxW) * C;
+      const T* bias_ptr = bias_data + (i / HxW) * C;
+      T* Y_ptr = Y_data + i * C;
+      int64_t j = 0;
+      for (; j < loop_size; j += Vec::size()) {
+        const Vec y = Vec::loadu(X_ptr + j) * Vec::loadu(scale_ptr + j) +
+            Vec::loadu(bias_ptr + j);
+        y.store(Y_ptr + j);
+      }
+      for (; j < C; ++j) {
+        Y_ptr[j] = X_ptr[j] * scale_ptr[j] + bias_ptr[j];
+      }
+    }
+  });
+}
+
+template <typename T>
+void GroupNormKernelImplInternal(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    T eps,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  using Vec = vec256::Vec256<T>;
+  DCHECK_EQ(X.numel(), N * C * HxW);
+  DCHECK(!gamma.defined() || gamma.numel() == C);
+  DCHECK(!beta.defined() || beta.numel() == C);
+  const int64_t G = group;
+  const int64_t D = C / G;
+  const T* X_data = X.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* Y_data = Y->data_ptr<T>();
+  T* mean_data = mean->data_ptr<T>();
+  T* rstd_data = rstd->data_ptr<T>();
+  const T s = T(1) / static_cast<T>(D * HxW);
+  const bool gamma_null = gamma_data == nullptr;
+  const bool beta_null = beta_data == nullptr;
+
+  if (!GroupNormUseChannelsLast(X, HxW)) {
+    // The D * HxW elements of a group are contiguous, so the moments and the
+    // transform of a group are computed together while it is in cache.
+    at::parallel_for(0, N * G, 1, [&](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        const T* X_ptr = X_data + i * D * HxW;
+        T* Y_ptr = Y_data + i * D * HxW;
+        const auto moments = moments_contiguous<T>(X_ptr, D * HxW);
+        const T mean_val = moments.mean;
+        const T var_val = std::max(static_cast<T>(moments.m2) * s, T(0));
+        const T rstd_val = T(1) / std::sqrt(var_val + eps);
+        const int64_t g = i % G;
+        for (int64_t j = 0; j < D; ++j) {
+          const int64_t c = g * D + j;
+          const T scale = rstd_val * (gamma_null ? T(1) : gamma_data[c]);
+          const T bias = -scale * mean_val + (beta_null ? T(0) : beta_data[c]);
+          const Vec scale_vec(scale);
+          const Vec bias_vec(bias);
+          vec256::map(
+              [scale_vec, bias_vec](Vec x) { return x * scale_vec + bias_vec; },
+              Y_ptr + j * HxW,
+              X_ptr + j * HxW,
+              HxW);
+        }
+        mean_data[i] = mean_val;
+        rstd_data[i] = rstd_val;
+      }
+    });
+    return;
+  }
+
+  // Moments of the channels over every block of rows.
+  const int64_t block_size = GroupNormRowsPerBlock(N, HxW);
+  const int64_t num_blocks = divup(HxW, block_size);
+  std::vector<acc_type<T, false>> buffer(N * num_blocks * 2 * C);
+  at::parallel_for(0, N * num_blocks, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t n = i / num_blocks;
+      const int64_t row_begin = (i % num_blocks) * block_size;
+      acc_type<T, false>* mean_ptr = buffer.data() + i * 2 * C;
+      moments_columns<T>(
+          X_data + (n * HxW + row_begin) * C,
+          std::min(block_size, HxW - row_begin),
+          C,
+          mean_ptr,
+          mean_ptr + C);
+    }
+  });
+
+  // Moments of the groups, and the per channel coefficients of every sample.
+  std::vector<T> scale(N * C);
+  std::vector<T> bias(N * C);
+  at::parallel_for(0, N * G, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t n = i / G;
+      const int64_t g = i % G;
+      MomentsAcc<T> moments;
+      for (int64_t k = 0; k < num_blocks; ++k) {
+        const acc_type<T, false>* mean_ptr =
+            buffer.data() + (n * num_blocks + k) * 2 * C;
+        const int64_t rows = std::min(block_size, HxW - k * block_size);
+        for (int64_t c = g * D; c < (g + 1) * D; ++c) {
+          moments = moments_combine<T>(
+              moments, make_moments<T>(mean_ptr[c], mean_ptr[C + c], rows));
+        }
+      }
+      const T mean_val = moments.mean;
+      const T var_val = std::max(static_cast<T>(moments.m2) * s, T(0));
+      const T rstd_val = T(1) / std::sqrt(var_val + eps);
+      T* scale_ptr = scale.data() + n * C;
+      T* bias_ptr = bias.data() + n * C;
+      for (int64_t c = g * D; c < (g + 1) * D; ++c) {
+        scale_ptr[c] = rstd_val * (gamma_null ? T(1) : gamma_data[c]);
+        bias_ptr[c] = -scale_ptr[c] * mean_val + (beta_null ? T(0) : beta_data[c]);
+      }
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
+  });
+
+  GroupNormApplyChannelsLast<T>(
+      X_data, scale.data(), bias.data(), N, C, HxW, Y_data);
+}
+
+void GroupNormKernelImpl(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    double eps,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "GroupNormKernelImpl", [&]() {
+    GroupNormKernelImplInternal<scalar_t>(
+        X,
+        gamma,
+        beta,
+        N,
+        C,
+        HxW,
+        group,
+        static_cast<scalar_t>(eps),
+        Y,
+        mean,
+        rstd);
+  });
+}
+
+// ds[n, c] = sum(dY[n, c] * X[n, c]) and db[n, c] = sum(dY[n, c]) over the
+// HxW elements of every channel.
+template <typename T>
+void GroupNormComputeInternalGradients(
+    const T* dY_data,
+    const T* X_data,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    bool channels_last,
+    acc_type<T, false>* ds,
+    acc_type<T, false>* db) {
+  using acc_t = acc_type<T, false>;
+  if (!channels_last) {
+    const int64_t grain_size =
+        std::max<int64_t>(1, internal::GRAIN_SIZE / HxW);
+    at::parallel_for(0, N * C, grain_size, [&](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        std::tie(db[i], ds[i]) = sum_and_dot_contiguous<T>(
+            dY_data + i * HxW, X_data + i * HxW, T(0), HxW);
+      }
+    });
+    return;
+  }
+
+  // The blocks are summed in the accumulate type, since a block may have many
+  // more rows than fit in the precision of T. The loop over the channels is
+  // vectorized by the compiler.
+  const int64_t block_size = GroupNormRowsPerBlock(N, HxW);
+  const int64_t num_blocks = divup(HxW, block_size);
+  std::vector<acc_t> buffer(N * num_blocks * 2 * C, acc_t(0));
+  at::parallel_for(0, N * num_blocks, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t n = i / num_blocks;
+      const int64_t row_begin = (i % num_blocks) * block_size;
+      const int64_t row_end = std::min(HxW, row_begin + block_size);
+      acc_t* ds_ptr = buffer.data() + i * 2 * C;
+      acc_t* db_ptr = ds_ptr + C;
+      for (int64_t r = row_begin; r < row_end; ++r) {
+        const T* dY_ptr = dY_data + (n * HxW + r) * C;
+        const T* X_ptr = X_data + (n * HxW + r) * C;
+        for (int64_t j = 0; j < C; ++j) {
+          const acc_t dy = dY_ptr[j];
+          ds_ptr[j] += dy * static_cast<acc_t>(X_ptr[j]);
+          db_ptr[j] += dy;
+        }
+      }
+    }
+  });
+  for (int64_t n = 0; n < N; ++n) {
+    for (int64_t c = 0; c < C; ++c) {
+      acc_t ds_val = 0;
+      acc_t db_val = 0;
+      for (int64_t k = 0; k < num_blocks; ++k) {
+        const acc_t* ds_ptr = buffer.data() + (n * num_blocks + k) * 2 * C;
+        ds_val += ds_ptr[c];
+        db_val += ds_ptr[C + c];
+      }
+      ds[n * C + c] = ds_val;
+      db[n * C + c] = db_val;
+    }
+  }
+}
+
+template <typename T>
+void GroupNormBackwardKernelImplInternal(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    Tensor* dX,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  using Vec = vec256::Vec256<T>;
+  using acc_t = acc_type<T, false>;
+  DCHECK_EQ(dY.numel(), N * C * HxW);
+  DCHECK_EQ(X.numel(), N * C * HxW);
+  DCHECK_EQ(mean.numel(), N * group);
+  DCHECK_EQ(rstd.numel(), N * group);
+  DCHECK(!gamma.defined() || gamma.numel() == C);
+  const int64_t G = group;
+  const int64_t D = C / G;
+  const T* dY_data = dY.data_ptr<T>();
+  const T* X_data = X.data_ptr<T>();
+  const T* mean_data = mean.data_ptr<T>();
+  const T* rstd_data = rstd.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  T* dX_data = dX->defined() ? dX->data_ptr<T>() : nullptr;
+  T* dgamma_data = dgamma->defined() ? dgamma->data_ptr<T>() : nullptr;
+  T* dbeta_data = dbeta->defined() ? dbeta->data_ptr<T>() : nullptr;
+  const bool channels_last = GroupNormUseChannelsLast(X, HxW);
+  const T s = T(1) / static_cast<T>(D * HxW);
+  const bool gamma_null = gamma_data == nullptr;
+
+  std::vector<acc_t> ds(N * C);
+  std::vector<acc_t> db(N * C);
+  GroupNormComputeInternalGradients<T>(
+      dY_data, X_data, N, C, HxW, channels_last, ds.data(), db.data());
+
+  if (dX_data != nullptr) {
+    // dX[n, c] = a[n, c] * dY[n, c] + b[n, c] * X[n, c] + d[n, c], with
+    // a = rstd * gamma and the per group terms b and d, see
+    // LayerNormBackwardKernelImplInternal.
+    std::vector<T> a(N * C);
+    std::vector<T> b(N * C);
+    std::vector<T> d(N * C);
+    for (int64_t i = 0; i < N * G; ++i) {
+      const int64_t n = i / G;
+      const int64_t g = i % G;
+      acc_t ds_val = 0;
+      acc_t db_val = 0;
+      for (int64_t c = g * D; c < (g + 1) * D; ++c) {
+        const acc_t gamma_v = gamma_null ? T(1) : gamma_data[c];
+        ds_val += ds[n * C + c] * gamma_v;
+        db_val += db[n * C + c] * gamma_v;
+      }
+      const acc_t rstd_val = rstd_data[i];
+      const acc_t c2 = (db_val * mean_data[i] - ds_val) * rstd_val *
+          rstd_val * rstd_val * s;
+      const acc_t c3 = -c2 * mean_data[i] - db_val * rstd_val * s;
+      for (int64_t c = g * D; c < (g + 1) * D; ++c) {
+        a[n * C + c] = rstd_val * (gamma_null ? T(1) : gamma_data[c]);
+        b[n * C + c] = c2;
+        d[n * C + c] = c3;
+      }
+    }
+    if (channels_last) {
+      const int64_t loop_size = C - (C % Vec::size());
+      const int64_t grain_size =
+          std::max<int64_t>(1, internal::GRAIN_SIZE / C);
+      at::parallel_for(0, N * HxW, grain_size, [&](int64_t start, int64_t end) {
+        for (int64_t i = start; i < end; ++i) {
+          const T* dY_ptr = dY_data + i * C;
+          const T* X_ptr = X_data + i * C;
+          const T* a_ptr = a.data() + (i / HxW) * C;
+          const T* b_ptr = b.data() + (i / HxW) * C;
+          const T* d_ptr = d.data() + (i / HxW) * C;
+          T* dX_ptr = dX_data + i * C;
+          int64_t j = 0;
+          for (; j < loop_size; j += Vec::size()) {
+            const Vec dx = Vec::loadu(a_ptr + j) * Vec::loadu(dY_ptr + j) +
+                Vec::loadu(b_ptr + j) * Vec::loadu(X_ptr + j) +
+                Vec::loadu(d_ptr + j);
+            dx.store(dX_ptr + j);
+          }
+          for (; j < C; ++j) {
+            dX_ptr[j] = a_ptr[j] * dY_ptr[j] + b_ptr[j] * X_ptr[j] + d_ptr[j];
+          }
+        }
+      });
+    } else {
+      const int64_t grain_size =
+          std::max<int64_t>(1, internal::GRAIN_SIZE / HxW);
+      at::parallel_for(0, N * C, grain_size, [&](int64_t start, int64_t end) {
+        for (int64_t i = start; i < end; ++i) {
+          const T* dY_ptr = dY_data + i * HxW;
+          const T* X_ptr = X_data + i * HxW;
+          T* dX_ptr = dX_data + i * HxW;
+          const Vec a_vec(a[i]);
+          const Vec b_vec(b[i]);
+          const Vec d_vec(d[i]);
+          int64_t j = 0;
+          for (; j < HxW - (HxW % Vec::size()); j += Vec::size()) {
+            const Vec dx = a_vec * Vec::loadu(dY_ptr + j) +
+                b_vec * Vec::loadu(X_ptr + j) + d_vec;
+            dx.store(dX_ptr + j);
+          }
+          for (; j < HxW; ++j) {
+            dX_ptr[j] = a[i] * dY_ptr[j] + b[i] * X_ptr[j] + d[i];
+          }
+        }
+      });
+    }
+  }
+
+  // dgamma[c] = sum((ds[n, c] - db[n, c] * mean[n, g]) * rstd[n, g]) and
+  // dbeta[c] = sum(db[n, c]) over the samples.
+  if (dgamma_data != nullptr) {
+    for (int64_t c = 0; c < C; ++c) {
+      const int64_t g = c / D;
+      acc_t dgamma_val = 0;
+      for (int64_t n = 0; n < N; ++n) {
+        dgamma_val += (ds[n * C + c] - db[n * C + c] * mean_data[n * G + g]) *
+            rstd_data[n * G + g];
+      }
+      dgamma_data[c] = dgamma_val;
+    }
+  }
+  if (dbeta_data != nullptr) {
+    for (int64_t c = 0; c < C; ++c) {
+      acc_t dbeta_val = 0;
+      for (int64_t n = 0; n < N; ++n) {
+        dbeta_val += db[n * C + c];
+      }
+      dbeta_data[c] = dbeta_val;
+    }
+  }
+}
+
+void GroupNormBackwardKernelImpl(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    Tensor* dX,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  AT_DISPATCH_FLOATING_TYPES(
+      X.scalar_type(), "GroupNormBackwardKernelImpl", [&]() {
+        GroupNormBackwardKernelImplInternal<scalar_t>(
+            dY, X, mean, rstd, gamma, N, C, HxW, group, dX, dgamma, dbeta);
+      });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(GroupNormKernel, &GroupNormKernelImpl);
+REGISTER_DISPATCH(GroupNormBackwardKernel, &GroupNormBackwardKernelImpl);
+
+} // namespace native
+} // namespace at
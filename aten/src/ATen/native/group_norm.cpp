@@ -0,0 +1,177 @@
+#include <ATen/native/group_norm.h>
+
+#include <array>
+#include <functional>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <ATen/Config.h>
+#include <ATen/NativeFunctions.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Memory format that GroupNormKernel and GroupNormBackwardKernel see X in.
+MemoryFormat group_norm_memory_format(const Tensor& X) {
+  return X.is_contiguous() ? MemoryFormat::Contiguous : X.suggest_memory_format();
+}
+
+} // namespace
+
+std::tuple<Tensor, Tensor, Tensor> native_group_norm(
+    const Tensor& X,
+    const Tensor& gamma /* optional */,
+    const Tensor& beta /* optional */,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    double eps) {
+  const Tensor X_contig = X.contiguous(X.suggest_memory_format());
+  const Tensor gamma_contig = gamma.defined() ? gamma.contiguous() : gamma;
+  const Tensor beta_contig = beta.defined() ? beta.contiguous() : beta;
+  Tensor Y = at::empty_like(X_contig, group_norm_memory_format(X_contig));
+  Tensor mean = at::empty({N, group}, X.options());
+  Tensor rstd = at::empty({N, group}, X.options());
+  if (N > 0) {
+    GroupNormKernel(
+        kCPU,
+        X_contig,
+        gamma_contig,
+        beta_contig,
+        N,
+        C,
+        HxW,
+        group,
+        eps,
+        &Y,
+        &mean,
+        &rstd);
+  }
+  return std::make_tuple(std::move(Y), std::move(mean), std::move(rstd));
+}
+
+std::tuple<Tensor, Tensor, Tensor> native_group_norm_backward(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    std::array<bool, 3> grad_input_mask) {
+  const Tensor X_contig = X.contiguous(X.suggest_memory_format());
+  const auto memory_format = group_norm_memory_format(X_contig);
+  const Tensor dY_contig = dY.contiguous(memory_format);
+  const Tensor gamma_contig = gamma.defined() ? gamma.contiguous() : gamma;
+  Tensor dX;
+  Tensor dgamma;
+  Tensor dbeta;
+  if (grad_input_mask[0]) {
+    dX = at::empty_like(X_contig, memory_format);
+  }
+  if (grad_input_mask[1]) {
+    dgamma = N > 0 ? at::empty({C}, X.options()) : at::zeros({C}, X.options());
+  }
+  if (grad_input_mask[2]) {
+    dbeta = N > 0 ? at::empty({C}, X.options()) : at::zeros({C}, X.options());
+  }
+  if (N > 0) {
+    GroupNormBackwardKernel(
+        kCPU,
+        dY_contig,
+        X_contig,
+        mean,
+        rstd,
+        gamma_contig,
+        N,
+        C,
+        HxW,
+        group,
+        &dX,
+        &dgamma,
+        &dbeta);
+  }
+  return std::make_tuple(std::move(dX), std::move(dgamma), std::move(dbeta));
+}
+
+Tensor group_norm(
+    const Tensor& input,
+    int64_t num_groups,
+    const Tensor& weight /* optional */,
+    const Tensor& bias /* optional */,
+    double eps,
+    bool cudnn_enabled) {
+  auto input_shape = input.sizes();
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+
+  TORCH_CHECK(
+      C % num_groups == 0,
+      "Expected number of channels in input to be divisible by ",
+      "num_groups, but got input of shape ",
+      input.sizes(),
+      " and "
+      "num_groups=",
+      num_groups);
+
+  TORCH_CHECK(
+      !weight.defined() || (weight.dim() == 1 && weight.numel() == C),
+      "Expected weight to be a vector of size equal to the number of ",
+      "channels in input, but got weight of shape ",
+      weight.sizes(),
+      " and input of shape ",
+      input.sizes());
+  TORCH_CHECK(
+      !bias.defined() || (bias.dim() == 1 && bias.numel() == C),
+      "Expected bias to be a vector of size equal to the number of ",
+      "channels in input, but got bias of shape ",
+      bias.sizes(),
+      " and input of shape ",
+      input.sizes());
+
+  if (input.device().is_cpu() && input.numel() > 0) {
+    const int64_t HxW = std::accumulate(
+        input_shape.cbegin() + 2,
+        input_shape.cend(),
+        1LL,
+        std::multiplies<int64_t>());
+    return std::get<0>(at::native_group_norm(
+        input, weight, bias, N, C, HxW, num_groups, eps));
+  }
+
+  // Apply group norm
+  // view(..., -1) does not work for empty tensor
+  auto input_reshaped = input.contiguous().view({1, N * num_groups, N ? -1 : 1});
+
+  auto out = at::batch_norm(input_reshaped, {}, {}, {}, {}, true, 0, eps,
+                            cudnn_enabled);
+  out = out.view(input_shape);
+
+  if (!weight.defined() && !bias.defined()) {
+    return out;
+  }
+
+  std::vector<int64_t> affine_param_shape(input.dim(), 1);
+  affine_param_shape[1] = C;
+
+  if (weight.defined() && bias.defined()) {
+    return bias.view(affine_param_shape).addcmul(out, weight.view(affine_param_shape), 1);
+  } else if (weight.defined()) {
+    return out.mul(weight.view(affine_param_shape));
+  } else {
+    return out.add(bias.view(affine_param_shape));
+  }
+}
+
+DEFINE_DISPATCH(GroupNormKernel);
+DEFINE_DISPATCH(GroupNormBackwardKernel);
+
+} // namespace native
+} // namespace at
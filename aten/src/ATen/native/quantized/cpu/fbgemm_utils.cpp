@@ -352,6 +352,15 @@ torch::jit::class_<LinearPackedParamsBase> register_linear_params() {
                 weight = std::move(std::get<0>(state));
                 bias = std::move(std::get<1>(state));
 
+                // NB: int4 weight is serialized as float, grouped as
+                // [out_features, in_features / group_size, group_size]. It
+                // doesn't depend on the quantized engine.
+                if (weight.scalar_type() == at::kFloat && weight.dim() == 3) {
+                  const int64_t group_size = weight.size(2);
+                  return PackedLinearWeightInt4::prepack(
+                      weight.flatten(1), std::move(bias), group_size);
+                }
+
 #ifdef USE_FBGEMM
                 if (at::globalContext().qEngine() == at::QEngine::FBGEMM) {
                   if (weight.scalar_type() == at::kQInt8) {
@@ -1,6 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
 #include <ATen/native/SortingUtils.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/UpSample.h>
@@ -958,6 +959,138 @@ void qmul_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
   });
 }
 
+// Overloads so that the ops of quantized::elementwise are written once for
+// single values and for vectors
+inline float qelementwise_minimum(float a, float b) {
+  return std::min(a, b);
+}
+
+inline float qelementwise_maximum(float a, float b) {
+  return std::max(a, b);
+}
+
+inline Vec256<float> qelementwise_minimum(
+    const Vec256<float>& a,
+    const Vec256<float>& b) {
+  return vec256::minimum(a, b);
+}
+
+inline Vec256<float> qelementwise_maximum(
+    const Vec256<float>& a,
+    const Vec256<float>& b) {
+  return vec256::maximum(a, b);
+}
+
+// Runs the steps of quantized::elementwise on a dequantized value, b is the
+// dequantized value of the second input for Add and Mul.
+template <typename T>
+T apply_qelementwise_steps(
+    T x,
+    const T& b,
+    const std::vector<QElementwiseStep>& steps) {
+  for (const auto& step : steps) {
+    switch (step.op) {
+      case QElementwiseOp::Add:
+        x = x + b;
+        break;
+      case QElementwiseOp::Mul:
+        x = x * b;
+        break;
+      case QElementwiseOp::Relu:
+        x = qelementwise_maximum(x, T(0.0f));
+        break;
+      case QElementwiseOp::Clamp:
+        x = qelementwise_minimum(
+            qelementwise_maximum(x, T(step.min)), T(step.max));
+        break;
+      case QElementwiseOp::Hardswish:
+        x = x *
+            qelementwise_minimum(
+                qelementwise_maximum(x + T(3.0f), T(0.0f)), T(6.0f)) /
+            T(6.0f);
+        break;
+    }
+    if (step.saturate) {
+      x = qelementwise_minimum(
+          qelementwise_maximum(x, T(step.lo)), T(step.hi));
+    }
+  }
+  return x;
+}
+
+// Dequantizes the inputs once, runs the whole chain of ops in float and
+// quantizes the result once, instead of making a pass over memory and
+// requantizing for each op.
+void qelementwise_kernel(
+    const Tensor& qa,
+    const Tensor& qb,
+    const std::vector<QElementwiseStep>& steps,
+    Tensor& qc) {
+  const float a_scale = qa.q_scale();
+  const int64_t a_zero_point = qa.q_zero_point();
+  const float c_scale = qc.q_scale();
+  const int64_t c_zero_point = qc.q_zero_point();
+  const float c_inv_scale = 1.0f / c_scale;
+
+  using fVec = Vec256<float>;
+  const fVec a_scale_vec(a_scale);
+  const fVec a_zero_point_vec((float)a_zero_point);
+  const fVec a_scale_neg_zp_premul_vec = a_scale_vec * a_zero_point_vec.neg();
+
+  AT_DISPATCH_QINT_TYPES(qa.scalar_type(), "qelementwise", [&]() {
+    using Vec = Vec256<scalar_t>;
+    if (!qb.defined()) {
+      auto iter = TensorIterator::unary_op(qc, qa);
+      cpu_kernel_vec(
+          iter,
+          [&](scalar_t a) -> scalar_t {
+            const float x =
+                at::native::dequantize_val(a_scale, a_zero_point, a);
+            return at::native::quantize_val<scalar_t>(
+                c_scale,
+                c_zero_point,
+                apply_qelementwise_steps(x, 0.0f, steps));
+          },
+          [&](Vec a) -> Vec {
+            auto x = a.dequantize(
+                a_scale_vec, a_zero_point_vec, a_scale_neg_zp_premul_vec);
+            const fVec zero_vec(0.0f);
+            for (int i = 0; i < Vec::float_num_vecs(); ++i) {
+              x[i] = apply_qelementwise_steps(x[i], zero_vec, steps);
+            }
+            return Vec::quantize(x, c_scale, c_zero_point, c_inv_scale);
+          });
+      return;
+    }
+
+    const float b_scale = qb.q_scale();
+    const int64_t b_zero_point = qb.q_zero_point();
+    const fVec b_scale_vec(b_scale);
+    const fVec b_zero_point_vec((float)b_zero_point);
+    const fVec b_scale_neg_zp_premul_vec =
+        b_scale_vec * b_zero_point_vec.neg();
+    auto iter = TensorIterator::binary_op(qc, qa, qb);
+    cpu_kernel_vec(
+        iter,
+        [&](scalar_t a, scalar_t b) -> scalar_t {
+          const float x = at::native::dequantize_val(a_scale, a_zero_point, a);
+          const float y = at::native::dequantize_val(b_scale, b_zero_point, b);
+          return at::native::quantize_val<scalar_t>(
+              c_scale, c_zero_point, apply_qelementwise_steps(x, y, steps));
+        },
+        [&](Vec a, Vec b) -> Vec {
+          auto x = a.dequantize(
+              a_scale_vec, a_zero_point_vec, a_scale_neg_zp_premul_vec);
+          const auto y = b.dequantize(
+              b_scale_vec, b_zero_point_vec, b_scale_neg_zp_premul_vec);
+          for (int i = 0; i < Vec::float_num_vecs(); ++i) {
+            x[i] = apply_qelementwise_steps(x[i], y[i], steps);
+          }
+          return Vec::quantize(x, c_scale, c_zero_point, c_inv_scale);
+        });
+  });
+}
+
 void qmaxpool_2d_nhwc_kernel(
     const Tensor& qx,
     int64_t iC, // input/output channels
@@ -2310,6 +2443,100 @@ void dequantize_tensor_per_channel_affine_cpu(
       });
 }
 
+// Unpacks 16 4-bit weights (8 bytes) to fp32 and removes their offset of 8.
+inline void unpack_int4x16(const uint8_t* src, float* dst) {
+#ifdef CPU_CAPABILITY_AVX2
+  const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  const __m128i lo = _mm_and_si128(bytes, mask);
+  const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+  // Interleaving the nibbles restores the order of the input features
+  const __m128i values = _mm_unpacklo_epi8(lo, hi);
+  const __m256 offset = _mm256_set1_ps(8.f);
+  _mm256_storeu_ps(
+      dst,
+      _mm256_sub_ps(
+          _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(values)), offset));
+  _mm256_storeu_ps(
+      dst + 8,
+      _mm256_sub_ps(
+          _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(values, 8))),
+          offset));
+#else
+  for (int i = 0; i < 8; ++i) {
+    dst[2 * i] = static_cast<float>(src[i] & 0x0F) - 8.f;
+    dst[2 * i + 1] = static_cast<float>(src[i] >> 4) - 8.f;
+  }
+#endif // CPU_CAPABILITY_AVX2
+}
+
+// output[M, N] = input[M, K] * weight[N, K]^T (+ bias), with the weight packed
+// by PackedLinearWeightInt4.
+void qlinear_int4_dynamic_kernel(
+    const Tensor& input,
+    const Tensor& packed_weight,
+    const Tensor& scales,
+    int64_t group_size,
+    const Tensor& bias,
+    bool relu,
+    Tensor& output) {
+  using Vec = Vec256<float>;
+  const int64_t M = input.size(0);
+  const int64_t K = input.size(1);
+  const int64_t N = packed_weight.size(0);
+  const int64_t num_groups = K / group_size;
+  const float* input_data = input.data_ptr<float>();
+  const uint8_t* weight_data = packed_weight.data_ptr<uint8_t>();
+  const float* scales_data = scales.data_ptr<float>();
+  const float* bias_data = bias.defined() ? bias.data_ptr<float>() : nullptr;
+  float* output_data = output.data_ptr<float>();
+
+  // Every output channel reads its row of the weight once: a group at a time
+  // is unpacked to fp32 and multiplied with the same input features of every
+  // row of the input. The scale of the group is applied to the partial sums,
+  // which are only reduced to a scalar at the end.
+  const int64_t grain_size =
+      std::max<int64_t>(1, internal::GRAIN_SIZE / std::max<int64_t>(M * K, 1));
+  at::parallel_for(0, N, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<float> weight_group(group_size);
+    std::vector<float> acc(M * Vec::size());
+    for (int64_t n = begin; n < end; ++n) {
+      std::fill(acc.begin(), acc.end(), 0.f);
+      const uint8_t* weight_row = weight_data + n * (K / 2);
+      for (int64_t g = 0; g < num_groups; ++g) {
+        const int64_t k_begin = g * group_size;
+        for (int64_t k = 0; k < group_size; k += 16) {
+          unpack_int4x16(
+              weight_row + (k_begin + k) / 2, weight_group.data() + k);
+        }
+        const Vec scale(scales_data[n * num_groups + g]);
+        for (int64_t m = 0; m < M; ++m) {
+          const float* input_row = input_data + m * K + k_begin;
+          Vec sum(0.f);
+          for (int64_t k = 0; k < group_size; k += Vec::size()) {
+            sum = vec256::fmadd(
+                Vec::loadu(weight_group.data() + k),
+                Vec::loadu(input_row + k),
+                sum);
+          }
+          float* acc_m = acc.data() + m * Vec::size();
+          vec256::fmadd(sum, scale, Vec::loadu(acc_m)).store(acc_m);
+        }
+      }
+      for (int64_t m = 0; m < M; ++m) {
+        float y = vec256::vec_reduce_all<float>(
+            [](Vec& a, Vec& b) { return a + b; },
+            Vec::loadu(acc.data() + m * Vec::size()),
+            Vec::size());
+        if (bias_data) {
+          y += bias_data[n];
+        }
+        output_data[m * N + n] = relu ? std::max(y, 0.f) : y;
+      }
+    }
+  });
+}
+
 } // namespace
 
 REGISTER_DISPATCH(qrelu_stub, &qrelu_kernel);
@@ -2327,6 +2554,7 @@ REGISTER_DISPATCH(qadd_scalar_relu_stub, &qadd_scalar_kernel<true>);
 REGISTER_DISPATCH(qadd_scalar_stub, &qadd_scalar_kernel<false>);
 REGISTER_DISPATCH(qmul_relu_stub, &qmul_kernel<true>);
 REGISTER_DISPATCH(qmul_stub, &qmul_kernel<false>);
+REGISTER_DISPATCH(qelementwise_stub, &qelementwise_kernel);
 REGISTER_DISPATCH(qmaxpool_2d_nhwc_stub, &qmaxpool_2d_nhwc_kernel);
 REGISTER_DISPATCH(
     qadaptive_avg_pool2d_nhwc_stub,
@@ -2358,6 +2586,7 @@ REGISTER_DISPATCH(
     dequantize_tensor_per_channel_affine_stub,
     &dequantize_tensor_per_channel_affine_cpu);
 REGISTER_DISPATCH(quantized_normalize_stub, &quantized_normalize_kernel);
+REGISTER_DISPATCH(qlinear_int4_dynamic_stub, &qlinear_int4_dynamic_kernel);
 
 } // namespace native
 } // namespace at
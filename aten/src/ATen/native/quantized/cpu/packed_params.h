@@ -25,3 +25,70 @@ struct LinearPackedParamsBase : public torch::jit::CustomClassHolder {
         "parameter type");
   }
 };
+
+// Linear weights quantized to 4 bits with a scale for each group of group_size
+// consecutive input features of an output channel (kPerChannelGroupSymmetric).
+// Two values are packed in a byte, the one with the even input feature index
+// in the low nibble, and are stored with an offset of 8 so that they cover
+// [-8, 7]. Only dynamic quantized linear is supported: the activations stay in
+// fp32 and the weights are unpacked on the fly, which halves the memory traffic
+// on the weights compared to int8 for memory bound inference.
+//
+// unpack() returns the dequantized weight grouped as
+// [out_features, in_features / group_size, group_size], which also tells it
+// apart from an fp16 weight when deserializing.
+struct CAFFE2_API PackedLinearWeightInt4 : public LinearPackedParamsBase {
+  PackedLinearWeightInt4(
+      at::Tensor w,
+      at::Tensor w_scales,
+      int64_t group_size,
+      c10::optional<at::Tensor> bias)
+      : w(std::move(w)),
+        w_scales(std::move(w_scales)),
+        group_size(group_size),
+        bias_(std::move(bias)) {}
+
+  // uint8 [out_features, in_features / 2]
+  at::Tensor w;
+  // float [out_features, in_features / group_size]
+  at::Tensor w_scales;
+  int64_t group_size;
+  c10::optional<at::Tensor> bias_;
+
+  at::Tensor apply(
+      at::Tensor input,
+      double output_scale,
+      int64_t output_zero_point) override {
+    TORCH_CHECK(
+        false, "4-bit linear weights only support dynamic quantized linear");
+  }
+  at::Tensor apply_relu(
+      at::Tensor input,
+      double output_scale,
+      int64_t output_zero_point) override {
+    TORCH_CHECK(
+        false, "4-bit linear weights only support dynamic quantized linear");
+  }
+
+  at::Tensor apply_dynamic(at::Tensor input) override;
+  at::Tensor apply_dynamic_relu(at::Tensor input) override;
+
+  std::tuple<at::Tensor, c10::optional<at::Tensor>> unpack() override;
+
+  c10::optional<at::Tensor> bias() override {
+    return bias_;
+  }
+
+  void set_bias(c10::optional<at::Tensor> bias) override {
+    bias_ = std::move(bias);
+  }
+
+  static c10::intrusive_ptr<LinearPackedParamsBase> prepack(
+      at::Tensor weight,
+      c10::optional<at::Tensor> bias,
+      int64_t group_size);
+
+ private:
+  template <bool ReluFused>
+  at::Tensor apply_dynamic_impl(at::Tensor input);
+};
@@ -0,0 +1,142 @@
+#include <ATen/ATen.h>
+#include <ATen/ExpandUtils.h>
+#include <torch/library.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
+
+#include <limits>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(qelementwise_stub);
+
+namespace {
+
+// Runs a chain of quantized elementwise ops in a single pass over memory,
+// e.g. quantized::add followed by quantized::hardswish and aten::relu. The
+// fusion pass for quantized TorchScript graphs produces it.
+//
+// ops are the names of the ops in the order they run on qa: add, mul, relu,
+// clamp and hardswish. add and mul take qb as their other input, there can
+// be at most one of them. clamp takes two values of args, its min and max.
+// scales and zero_points are the output quantization parameters of the ops
+// that requantize, add, mul and hardswish, in order; relu and clamp keep the
+// quantization of their input.
+//
+// The values between the ops aren't rounded to their quantization, so the
+// result may differ from running the ops one by one by rounding errors. They
+// are still saturated to the range of their quantization.
+Tensor qelementwise(
+    Tensor qa,
+    c10::optional<Tensor> qb,
+    c10::List<std::string> ops,
+    ArrayRef<double> args,
+    ArrayRef<double> scales,
+    IntArrayRef zero_points) {
+  TORCH_CHECK(
+      qa.qscheme() == kPerTensorAffine,
+      "quantized::elementwise only supports per tensor quantization.");
+  TORCH_CHECK(
+      scales.size() == zero_points.size(),
+      "quantized::elementwise expects as many scales as zero points.");
+  Tensor other;
+  if (qb.has_value()) {
+    other = *qb;
+    TORCH_CHECK(
+        other.qscheme() == qa.qscheme(),
+        "Both inputs to quantized::elementwise must have the same quantization scheme.");
+    TORCH_CHECK(
+        other.scalar_type() == qa.scalar_type(),
+        "Both inputs to quantized::elementwise must have the same data type.");
+  }
+
+  int64_t qmin = 0;
+  int64_t qmax = 0;
+  AT_DISPATCH_QINT_TYPES(qa.scalar_type(), "qelementwise", [&]() {
+    qmin = std::numeric_limits<underlying_t>::min();
+    qmax = std::numeric_limits<underlying_t>::max();
+  });
+
+  std::vector<QElementwiseStep> steps;
+  steps.reserve(ops.size());
+  size_t num_binary = 0;
+  size_t next_arg = 0;
+  size_t next_qparams = 0;
+  for (const std::string& op : ops) {
+    QElementwiseStep step{};
+    bool requantize = false;
+    if (op == "add" || op == "mul") {
+      step.op = op == "add" ? QElementwiseOp::Add : QElementwiseOp::Mul;
+      // Same checks as quantized::add and quantized::mul, the other sizes are
+      // checked when the inputs are broadcast
+      TORCH_CHECK(
+          op != "add" || !other.defined() || other.numel() == qa.numel(),
+          "Both inputs to the add of quantized::elementwise must have the same number of elements.");
+      requantize = true;
+      ++num_binary;
+    } else if (op == "relu") {
+      step.op = QElementwiseOp::Relu;
+    } else if (op == "clamp") {
+      TORCH_CHECK(
+          next_arg + 2 <= args.size(),
+          "quantized::elementwise: missing the bounds of clamp.");
+      step.op = QElementwiseOp::Clamp;
+      step.min = args[next_arg++];
+      step.max = args[next_arg++];
+    } else if (op == "hardswish") {
+      step.op = QElementwiseOp::Hardswish;
+      requantize = true;
+    } else {
+      TORCH_CHECK(false, "quantized::elementwise: unsupported op ", op);
+    }
+    if (requantize) {
+      TORCH_CHECK(
+          next_qparams < scales.size(),
+          "quantized::elementwise: missing the output quantization of ",
+          op);
+      const double scale = scales[next_qparams];
+      const int64_t zero_point = zero_points[next_qparams];
+      ++next_qparams;
+      step.saturate = true;
+      step.lo = (qmin - zero_point) * scale;
+      step.hi = (qmax - zero_point) * scale;
+    }
+    steps.push_back(step);
+  }
+  TORCH_CHECK(
+      num_binary == (qb.has_value() ? 1 : 0),
+      "quantized::elementwise needs one add or mul op when it has a second input, and none otherwise.");
+  TORCH_CHECK(
+      next_arg == args.size() && next_qparams == scales.size(),
+      "quantized::elementwise got more arguments than its ops take.");
+  // Quantizing the output saturates it to the quantization of the last op
+  // that requantizes
+  for (auto it = steps.rbegin(); it != steps.rend(); ++it) {
+    if (it->saturate) {
+      it->saturate = false;
+      break;
+    }
+  }
+
+  const double scale = scales.empty() ? qa.q_scale() : scales.back();
+  const int64_t zero_point =
+      zero_points.empty() ? qa.q_zero_point() : zero_points.back();
+  Tensor qc = at::_empty_affine_quantized(
+      other.defined() ? infer_size(qa.sizes(), other.sizes()) : qa.sizes().vec(),
+      at::device(kCPU)
+          .dtype(qa.scalar_type())
+          .memory_format(qa.suggest_memory_format()),
+      scale,
+      zero_point,
+      c10::nullopt);
+  qelementwise_stub(qa.device().type(), qa, other, steps, qc);
+  return qc;
+}
+
+TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
+  m.impl("elementwise", qelementwise);
+}
+
+} // namespace
+} // namespace native
+} // namespace at
@@ -5,6 +5,7 @@
 #include <ATen/native/quantized/cpu/packed_params.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <ATen/native/quantized/cpu/quant_utils.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
 #include <caffe2/utils/threadpool/ThreadPoolMobile.h>
 #include <torch/library.h>
 
@@ -393,8 +394,53 @@ void PackedLinearWeightFp16::set_bias(c10::optional<at::Tensor> bias) {
 
 #endif // USE_FBGEMM
 
+template <bool ReluFused>
+at::Tensor PackedLinearWeightInt4::apply_dynamic_impl(at::Tensor input) {
+  TORCH_CHECK(
+      input.dim() >= 2,
+      "The dimension of input tensor should be larger than or equal to 2");
+  const int64_t N = w.size(0);
+  const int64_t K = w.size(1) * 2;
+  TORCH_CHECK(
+      input.size(input.dim() - 1) == K,
+      "The last dimension of the input (",
+      input.size(input.dim() - 1),
+      ") should be equal to the number of input features of the weight: ",
+      K);
+  // C(output) = A(input) x B(weight), where C, A, B are M x N, M x K, K x N
+  // matrices, respectively.
+  const int64_t M = size_to_dim_(input.dim() - 1, input.sizes());
+  const at::Tensor input_contig = input.contiguous();
+
+  std::vector<int64_t> out_sizes = input.sizes().vec();
+  out_sizes.back() = N;
+  at::Tensor output = at::empty(out_sizes, input.options().dtype(at::kFloat));
+  at::Tensor output_2d = output.view({M, N});
+  at::native::qlinear_int4_dynamic_stub(
+      at::kCPU,
+      input_contig.view({M, K}),
+      w,
+      w_scales,
+      group_size,
+      bias_.has_value() ? bias_->contiguous() : at::Tensor(),
+      ReluFused,
+      output_2d);
+  return output;
+}
+
+at::Tensor PackedLinearWeightInt4::apply_dynamic(at::Tensor input) {
+  return apply_dynamic_impl</*ReluFused=*/false>(std::move(input));
+}
+
+at::Tensor PackedLinearWeightInt4::apply_dynamic_relu(at::Tensor input) {
+  return apply_dynamic_impl</*ReluFused=*/true>(std::move(input));
+}
+
 namespace at {
 namespace native {
+
+DEFINE_DISPATCH(qlinear_int4_dynamic_stub);
+
 namespace {
 
 template <bool ReluFused>
@@ -233,6 +233,58 @@ c10::intrusive_ptr<LinearPackedParamsBase> PackedLinearWeightFp16::prepack(
 }
 #endif // USE_FBGEMM
 
+c10::intrusive_ptr<LinearPackedParamsBase> PackedLinearWeightInt4::prepack(
+    at::Tensor weight,
+    c10::optional<at::Tensor> bias,
+    int64_t group_size) {
+  TORCH_CHECK(
+      weight.dim() == 2 && weight.scalar_type() == at::kFloat,
+      "quantized::linear_prepack_int4: expected a 2-D float weight, got a ",
+      weight.dim(),
+      "-D ",
+      weight.scalar_type(),
+      " tensor");
+  // The kernel unpacks and multiplies 16 values at a time
+  TORCH_CHECK(
+      group_size > 0 && group_size % 16 == 0,
+      "quantized::linear_prepack_int4: expected group_size to be a positive "
+      "multiple of 16, got ",
+      group_size);
+  const int64_t N = weight.size(0);
+  const int64_t K = weight.size(1);
+  TORCH_CHECK(
+      K % group_size == 0,
+      "quantized::linear_prepack_int4: expected the number of input features (",
+      K,
+      ") to be a multiple of group_size (",
+      group_size,
+      ")");
+  if (bias.has_value()) {
+    TORCH_CHECK(
+        bias->dim() == 1 && bias->size(0) == N &&
+            bias->scalar_type() == at::kFloat,
+        "quantized::linear_prepack_int4: expected bias to be a float vector "
+        "with ",
+        N,
+        " elements");
+  }
+
+  // Symmetric quantization of each group, its largest magnitude maps to 7
+  const auto groups = weight.contiguous().view({N, K / group_size, group_size});
+  auto scales = std::get<0>(groups.abs().max(-1)).div_(7);
+  scales.masked_fill_(scales == 0, 1);
+  const auto q = groups.div(scales.unsqueeze(-1))
+                     .round_()
+                     .clamp_(-8, 7)
+                     .add_(8)
+                     .to(at::kByte)
+                     .view({N, K});
+  const auto packed =
+      q.slice(1, 0, K, 2).add(q.slice(1, 1, K, 2).mul(16)).contiguous();
+  return c10::make_intrusive<PackedLinearWeightInt4>(
+      packed, scales.contiguous(), group_size, std::move(bias));
+}
+
 namespace at {
 namespace native {
 namespace {
@@ -289,6 +341,18 @@ class QLinearPackWeightFp16 final {
   }
 };
 
+class QLinearPackWeightInt4 final {
+ public:
+  static c10::intrusive_ptr<LinearPackedParamsBase> run(
+      at::Tensor weight,
+      c10::optional<Tensor> bias,
+      int64_t group_size) {
+    // Doesn't depend on the quantized engine, the kernel is part of ATen
+    return PackedLinearWeightInt4::prepack(
+        std::move(weight), std::move(bias), group_size);
+  }
+};
+
 class QLinearPackWeightInt8Legacy final {
  public:
   static Tensor run(at::Tensor weight, c10::optional<Tensor> bias) {
@@ -360,6 +424,7 @@ TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
 TORCH_LIBRARY_IMPL(quantized, CPU, m) {
   m.impl("linear_prepack_fp16", QLinearPackWeightFp16::run);
   m.impl("linear_prepack_fp16_legacy", QLinearPackWeightFp16Legacy::run);
+  m.impl("linear_prepack_int4", QLinearPackWeightInt4::run);
 }
 
 TORCH_LIBRARY_IMPL(_quantized, QuantizedCPU, m) {
@@ -74,6 +74,20 @@ std::tuple<at::Tensor, c10::optional<at::Tensor>> PackedLinearWeightFp16::
 }
 #endif // USE_FBGEMM
 
+std::tuple<at::Tensor, c10::optional<at::Tensor>> PackedLinearWeightInt4::
+    unpack() {
+  const int64_t N = w.size(0);
+  const int64_t K = w.size(1) * 2;
+  at::Tensor q = at::empty({N, K}, w.options());
+  q.slice(1, 0, K, 2).copy_(w.bitwise_and(15));
+  q.slice(1, 1, K, 2).copy_(w.__rshift__(4));
+  at::Tensor weight = q.to(at::kFloat)
+                          .sub_(8)
+                          .view({N, K / group_size, group_size})
+                          .mul_(w_scales.unsqueeze(-1));
+  return std::make_tuple(weight, bias_);
+}
+
 namespace at {
 namespace native {
 namespace {
@@ -101,6 +115,18 @@ class QLinearUnpackWeightFp16 final {
   }
 };
 
+class QLinearUnpackWeightInt4 final {
+ public:
+  static std::tuple<at::Tensor, c10::optional<Tensor>> run(
+      const c10::intrusive_ptr<LinearPackedParamsBase>& packed_weight) {
+    TORCH_CHECK(
+        dynamic_cast<PackedLinearWeightInt4*>(packed_weight.get()),
+        "quantized::linear_unpack_int4 expects weights packed by "
+        "quantized::linear_prepack_int4");
+    return packed_weight->unpack();
+  }
+};
+
 class QLinearUnpackWeightInt8Legacy final {
  public:
   static std::tuple<at::Tensor, c10::optional<Tensor>> run(
@@ -144,6 +170,7 @@ TORCH_LIBRARY_IMPL(quantized, CPU, m) {
 TORCH_LIBRARY_IMPL(quantized, CatchAll, m) {
   m.impl("linear_unpack", QLinearUnpackWeightInt8::run);
   m.impl("linear_unpack_fp16", QLinearUnpackWeightFp16::run);
+  m.impl("linear_unpack_int4", QLinearUnpackWeightInt4::run);
 }
 
 } // namespace
@@ -130,6 +130,38 @@ using qnormalize_fn = void (*)(
     double /* eps */,
     Tensor* /* Y */);
 
+using qlinear_int4_dynamic_fn = void (*)(
+    const Tensor& /* input */,
+    const Tensor& /* packed_weight */,
+    const Tensor& /* scales */,
+    int64_t /* group_size */,
+    const Tensor& /* bias */,
+    bool /* relu */,
+    Tensor& /* output */);
+
+// One op of a chain of quantized elementwise ops run by
+// quantized::elementwise. Add and Mul take the second input of the chain.
+enum class QElementwiseOp { Add, Mul, Relu, Clamp, Hardswish };
+
+struct QElementwiseStep {
+  QElementwiseOp op;
+  // Bounds of Clamp
+  float min;
+  float max;
+  // The ops that requantize their output saturate to the range of their
+  // output quantization, [lo, hi] in the dequantized domain. The last one
+  // doesn't need to, quantizing the output of the chain does that.
+  bool saturate;
+  float lo;
+  float hi;
+};
+
+using qelementwise_fn = void (*)(
+    const Tensor& /* qa */,
+    const Tensor& /* qb */,
+    const std::vector<QElementwiseStep>& /* steps */,
+    Tensor& /* qc */);
+
 // using qavg_pool2d_fn
 DECLARE_DISPATCH(qrelu_fn, qrelu_stub);
 DECLARE_DISPATCH(qrelu_fn, qrelu6_stub);
@@ -157,6 +189,8 @@ DECLARE_DISPATCH(qtopk_fn, qtopk_stub);
 DECLARE_DISPATCH(qbatch_norm_fn, qbatch_norm_stub);
 DECLARE_DISPATCH(qbatch_norm_fn, qbatch_norm_relu_stub);
 DECLARE_DISPATCH(qnormalize_fn, quantized_normalize_stub);
+DECLARE_DISPATCH(qlinear_int4_dynamic_fn, qlinear_int4_dynamic_stub);
+DECLARE_DISPATCH(qelementwise_fn, qelementwise_stub);
 
 } // namespace native
 } // namespace at
@@ -62,6 +62,7 @@ TORCH_LIBRARY(quantized, m) {
   m.def("conv3d_padding(__torch__.torch.classes.quantized.Conv3dPackedParamsBase packed_weights) -> int[]");
   m.def("conv3d_dilation(__torch__.torch.classes.quantized.Conv3dPackedParamsBase packed_weights) -> int[]");
   m.def("conv3d_groups(__torch__.torch.classes.quantized.Conv3dPackedParamsBase packed_weights) -> int");
+  m.def("elementwise(Tensor qa, Tensor? qb, str[] ops, float[] args, float[] scales, int[] zero_points) -> Tensor qc");
   m.def("hardswish(Tensor input, float output_scale, int output_zero_point) -> Tensor");
   m.def("group_norm(Tensor input, int num_groups, Tensor weight, Tensor bias, float eps, float output_scale, int output_zero_point) -> Tensor");
   m.def("instance_norm(Tensor input, Tensor weight, Tensor bias, float eps, float output_scale, int output_zero_point) -> Tensor");
@@ -80,6 +81,8 @@ TORCH_LIBRARY(quantized, m) {
       "linear_prepack(Tensor W, Tensor? B=None) -> __torch__.torch.classes.quantized.LinearPackedParamsBase W_prepack");
   m.def(
       "linear_prepack_fp16(Tensor W, Tensor? B=None) -> __torch__.torch.classes.quantized.LinearPackedParamsBase W_prepack");
+  m.def(
+      "linear_prepack_int4(Tensor W, Tensor? B=None, int group_size=128) -> __torch__.torch.classes.quantized.LinearPackedParamsBase W_prepack");
   m.def("linear_prepack_legacy(Tensor W, Tensor? B=None) -> Tensor W_prepack");
   m.def(
       "linear_prepack_fp16_legacy(Tensor W, Tensor? B=None) -> Tensor W_prepack");
@@ -87,6 +90,8 @@ TORCH_LIBRARY(quantized, m) {
       "linear_unpack(__torch__.torch.classes.quantized.LinearPackedParamsBase W_prepack) -> (Tensor W_origin, Tensor? B_origin)");
   m.def(
       "linear_unpack_fp16(__torch__.torch.classes.quantized.LinearPackedParamsBase W_prepack) -> (Tensor W_origin, Tensor? B_origin)");
+  m.def(
+      "linear_unpack_int4(__torch__.torch.classes.quantized.LinearPackedParamsBase W_prepack) -> (Tensor W_origin, Tensor? B_origin)");
   m.def(
       "linear_unpack.legacy(Tensor W_prepack) -> (Tensor W_origin, Tensor? B_origin)");
   m.def(
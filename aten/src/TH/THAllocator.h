@@ -90,6 +90,8 @@ class CAFFE2_API THRefcountedMapAllocator
 
   void incref();
   int decref();
+  // Number of references held by all processes that map the file
+  int refcount() const;
   void close() override;
 
   virtual ~THRefcountedMapAllocator() { close(); }
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+#
+# Measure the latency and throughput of sending tensors over RPC between two
+# processes on the same host, with the ProcessGroup agent (with and without the
+# shared memory transport) and the TensorPipe agent.
+#
+
+import argparse
+import json
+import os
+import time
+
+import numpy as np
+import torch
+import torch.distributed.rpc as rpc
+import torch.multiprocessing as mp
+
+
+def echo(tensor):
+    return tensor
+
+
+def consume(tensor):
+    return tensor.numel()
+
+
+def backend_options(backend, init_method):
+    if backend == "process_group":
+        return rpc.BackendType.PROCESS_GROUP, rpc.ProcessGroupRpcBackendOptions(
+            init_method=init_method)
+    if backend == "process_group_shm":
+        return rpc.BackendType.PROCESS_GROUP, rpc.ProcessGroupRpcBackendOptions(
+            init_method=init_method, shm_transport=True)
+    if backend == "tensorpipe":
+        return rpc.BackendType.TENSORPIPE, rpc.TensorPipeRpcBackendOptions(
+            init_method=init_method)
+    raise ValueError("Unknown backend: {}".format(backend))
+
+
+def measure(args, size_bytes):
+    tensor = torch.rand(size_bytes // 4)
+    if args.shared:
+        tensor.share_memory_()
+
+    # Latency: round trip of the tensor, sent back by the peer
+    for _ in range(args.warmup):
+        rpc.rpc_sync("worker1", echo, args=(tensor,))
+    latencies = []
+    for _ in range(args.iterations):
+        start = time.perf_counter()
+        rpc.rpc_sync("worker1", echo, args=(tensor,))
+        latencies.append(time.perf_counter() - start)
+    latencies_us = np.array(latencies) * 1e6
+
+    # Throughput: one way, with a window of outstanding requests
+    start = time.perf_counter()
+    futs = []
+    for i in range(args.iterations):
+        futs.append(rpc.rpc_async("worker1", consume, args=(tensor,)))
+        if len(futs) == args.window:
+            for fut in futs:
+                fut.wait()
+            futs = []
+    for fut in futs:
+        fut.wait()
+    elapsed = time.perf_counter() - start
+
+    return {
+        "size_bytes": size_bytes,
+        "latency_p50_us": float(np.percentile(latencies_us, 50)),
+        "latency_p90_us": float(np.percentile(latencies_us, 90)),
+        "latency_p99_us": float(np.percentile(latencies_us, 99)),
+        "throughput_mb_s": size_bytes * args.iterations / elapsed / 1e6,
+    }
+
+
+def run_worker(rank, args, backend):
+    if args.shared:
+        mp.set_sharing_strategy("file_system")
+    init_method = "tcp://{}:{}".format(args.master_addr, args.port)
+    backend_type, options = backend_options(backend, init_method)
+    rpc.init_rpc(
+        "worker{}".format(rank),
+        backend=backend_type,
+        rank=rank,
+        world_size=2,
+        rpc_backend_options=options,
+    )
+    if rank == 0:
+        results = [measure(args, size) for size in args.sizes]
+        with open(args.output_prefix + backend + ".json", "w") as f:
+            json.dump(results, f)
+    rpc.shutdown()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="RPC tensor transport benchmark")
+    parser.add_argument("--backends", type=str, nargs="+",
+                        default=["process_group", "process_group_shm", "tensorpipe"])
+    parser.add_argument("--sizes", type=int, nargs="+",
+                        default=[4 << 10, 64 << 10, 1 << 20, 16 << 20, 64 << 20],
+                        help="tensor sizes in bytes")
+    parser.add_argument("--iterations", type=int, default=100)
+    parser.add_argument("--warmup", type=int, default=10)
+    parser.add_argument("--window", type=int, default=8,
+                        help="outstanding requests in the throughput test")
+    parser.add_argument("--shared", action="store_true",
+                        help="send tensors already in shared memory")
+    parser.add_argument("--master-addr", type=str, default="localhost")
+    parser.add_argument("--master-port", type=int, default=29500)
+    parser.add_argument("--json", type=str, default=None,
+                        help="write the measurements to this file")
+    args = parser.parse_args()
+    args.output_prefix = "/tmp/rpc_tensor_transport_{}_".format(os.getpid())
+
+    print("{:<20} {:>12} {:>12} {:>12} {:>12} {:>14}".format(
+        "backend", "size", "p50 (us)", "p90 (us)", "p99 (us)", "MB/s"))
+    all_results = {}
+    for i, backend in enumerate(args.backends):
+        # A new port per backend, the previous one may still be in TIME_WAIT
+        args.port = args.master_port + i
+        mp.spawn(run_worker, args=(args, backend), nprocs=2, join=True)
+        with open(args.output_prefix + backend + ".json") as f:
+            results = json.load(f)
+        os.remove(args.output_prefix + backend + ".json")
+        all_results[backend] = results
+        for r in results:
+            print("{:<20} {:>12} {:>12.1f} {:>12.1f} {:>12.1f} {:>14.1f}".format(
+                backend, r["size_bytes"], r["latency_p50_us"],
+                r["latency_p90_us"], r["latency_p99_us"], r["throughput_mb_s"]))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(all_results, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
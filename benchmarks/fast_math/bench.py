@@ -0,0 +1,82 @@
+import argparse
+import time
+
+import torch
+import torch.nn.functional as F
+
+
+# The kernels that honour torch.backends.cpu.fast_math
+OPS = {
+    "softmax": lambda x: torch.softmax(x, -1),
+    "log_softmax": lambda x: torch.log_softmax(x, -1),
+    "sigmoid": torch.sigmoid,
+    "tanh": torch.tanh,
+    "gelu": F.gelu,
+    "logsigmoid": F.logsigmoid,
+}
+
+
+def bench(op, x, nreps):
+    # warm up
+    for _ in range(3):
+        op(x)
+    times = []
+    for _ in range(nreps):
+        start = time.perf_counter()
+        op(x)
+        times.append(time.perf_counter() - start)
+    return min(times)
+
+
+def accuracy(op, x):
+    r"""Returns the maximum absolute error, relative error and error in ULPs of
+    op on the float tensor x, against the result on double."""
+    expected = op(x.double())
+    result = op(x).double()
+    finite = torch.isfinite(expected)
+    expected = expected[finite]
+    error = (result[finite] - expected).abs()
+    tiny = torch.finfo(torch.float).tiny
+    relative = error / expected.abs().clamp(min=tiny)
+    # the spacing of floats around the expected values, the denormals have the
+    # spacing of the smallest normal floats
+    exponent = torch.floor(torch.log2(expected.abs().clamp(min=tiny)))
+    ulp = torch.pow(2., exponent - 23)
+    return error.max().item(), relative.max().item(), (error / ulp).max().item()
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare the speed and the accuracy of the CPU kernels "
+        "with and without torch.backends.cpu.fast_math."
+    )
+    parser.add_argument("--ops", nargs="+", default=list(OPS), choices=list(OPS))
+    parser.add_argument("--sizes", nargs="+", type=int, default=[128, 1024, 32768],
+                        help="Sizes of the last dimension, the inputs have 256 rows.")
+    parser.add_argument("--rows", type=int, default=256)
+    parser.add_argument("--threads", type=int, default=1)
+    parser.add_argument("--nreps", "-n", type=int, default=100)
+    parser.add_argument("--scale", type=float, default=5.,
+                        help="Standard deviation of the inputs.")
+    args = parser.parse_args()
+
+    torch.set_num_threads(args.threads)
+    torch.manual_seed(0)
+    print("{:<12} {:>8} {:>12} {:>12} {:>8} {:>10} {:>10} {:>8}".format(
+        "op", "size", "default us", "fast us", "speedup", "max abs", "max rel", "max ulp"))
+    for name in args.ops:
+        op = OPS[name]
+        for size in args.sizes:
+            x = torch.randn(args.rows, size) * args.scale
+            with torch.backends.cpu.flags(fast_math=False):
+                default_time = bench(op, x, args.nreps)
+            with torch.backends.cpu.flags(fast_math=True):
+                fast_time = bench(op, x, args.nreps)
+                abs_err, rel_err, ulp_err = accuracy(op, x)
+            print("{:<12} {:>8} {:>12.1f} {:>12.1f} {:>7.2f}x {:>10.2e} {:>10.2e} {:>8.1f}".format(
+                name, size, default_time * 1e6, fast_time * 1e6, default_time / fast_time,
+                abs_err, rel_err, ulp_err))
+
+
+if __name__ == "__main__":
+    main()
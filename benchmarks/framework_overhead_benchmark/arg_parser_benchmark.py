@@ -0,0 +1,70 @@
+from __future__ import absolute_import, division, print_function, unicode_literals
+import argparse
+import time
+
+import torch
+from utils import secs_to_us
+
+""" Argument parsing overhead benchmark script.
+Measures the latency of tiny ops called from Python with the positional fast
+path of PythonArgParser enabled and disabled, and reports the saving per op.
+Example run:
+python arg_parser_benchmark.py --num_iters 100000
+python arg_parser_benchmark.py --op add_tensor --op sum_dim
+"""
+
+x = torch.randn(1)
+y = torch.randn(1)
+m = torch.randn(2, 2)
+
+OPS = {
+    "add_tensor": lambda: torch.add(x, y),
+    "add_scalar": lambda: torch.add(x, 2),
+    "method_mul": lambda: x.mul(y),
+    "method_add_alpha": lambda: x.add(y, alpha=2),
+    "clamp": lambda: torch.clamp(x, 0., 1.),
+    "sum_dim": lambda: m.sum(0),
+    "sum_dim_keepdim": lambda: m.sum(0, True),
+    "transpose": lambda: m.transpose(0, 1),
+    "view": lambda: m.view(4),
+    "narrow": lambda: m.narrow(0, 0, 1),
+}
+
+
+def time_op(fn, num_warmup_iters, num_iters):
+    for _ in range(num_warmup_iters):
+        fn()
+    start = time.time()
+    for _ in range(num_iters):
+        fn()
+    end = time.time()
+    return secs_to_us(end - start) / num_iters
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--op", action="append", dest="ops", choices=sorted(OPS.keys()))
+    parser.add_argument("--num_warmup_iters", type=int, default=1000)
+    parser.add_argument("--num_iters", type=int, default=100000)
+    args = parser.parse_args()
+
+    ops = args.ops if args.ops else sorted(OPS.keys())
+    saved = torch._C._get_arg_parser_fast_path()
+    print("===================================")
+    print("{:<20}{:>14}{:>14}{:>14}".format("op", "slow (us)", "fast (us)", "saving (us)"))
+    try:
+        with torch.no_grad():
+            for op in ops:
+                latency = {}
+                for enabled in (False, True):
+                    torch._C._set_arg_parser_fast_path(enabled)
+                    latency[enabled] = time_op(OPS[op], args.num_warmup_iters, args.num_iters)
+                print("{:<20}{:>14.3f}{:>14.3f}{:>14.3f}".format(
+                    op, latency[False], latency[True], latency[False] - latency[True]))
+    finally:
+        torch._C._set_arg_parser_fast_path(saved)
+    print("===================================")
+
+
+if __name__ == "__main__":
+    main()
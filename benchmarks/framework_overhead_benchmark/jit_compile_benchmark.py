@@ -0,0 +1,108 @@
+from __future__ import absolute_import, division, print_function, unicode_literals
+import argparse
+import time
+
+import torch
+from utils import secs_to_ms
+
+""" TorchScript compilation benchmark script.
+Measures the time to script large generated functions, and to run the
+inlining, constant propagation, CSE and DCE passes on their graphs, which is
+dominated by the creation and destruction of IR nodes.
+Example run:
+python jit_compile_benchmark.py --size 2000
+python jit_compile_benchmark.py --graph calls --num_iters 3
+"""
+
+
+def straight_line_source(size):
+    lines = ["def straight_line(x, y):"]
+    for i in range(size):
+        lines.append("    x = x * {} + y - {}".format(i % 7 + 1, i % 5))
+        lines.append("    y = torch.relu(x) + y")
+    lines.append("    return x + y")
+    return "\n".join(lines)
+
+
+def branches_source(size):
+    lines = ["def branches(x, y, n: int):"]
+    for i in range(size):
+        lines.append("    if n > {}:".format(i))
+        lines.append("        x = x + y * {}".format(i % 3 + 1))
+        lines.append("    else:")
+        lines.append("        y = y - x")
+        lines.append("    for _ in range({}):".format(i % 3))
+        lines.append("        x = x * 2 + 1")
+    lines.append("    return x + y")
+    return "\n".join(lines)
+
+
+def calls_source(size):
+    lines = [
+        "def helper(x, y):",
+        "    z = x * 2 + y",
+        "    if bool(z.sum() > 0):",
+        "        z = z - 1",
+        "    return torch.relu(z) + 3 * 4",
+        "",
+        "def calls(x, y):",
+    ]
+    for _ in range(size):
+        lines.append("    x = helper(x, y)")
+        lines.append("    y = helper(y, x)")
+    lines.append("    return x + y")
+    return "\n".join(lines)
+
+
+GRAPHS = {
+    "straight_line": straight_line_source,
+    "branches": branches_source,
+    "calls": calls_source,
+}
+
+
+def run_passes(graph):
+    torch._C._jit_pass_inline(graph)
+    torch._C._jit_pass_constant_propagation(graph)
+    torch._C._jit_pass_cse(graph)
+    torch._C._jit_pass_dce(graph)
+
+
+def benchmark_graph(name, size, num_iters):
+    src = GRAPHS[name](size)
+    script_times = []
+    pass_times = []
+    num_nodes = 0
+    for _ in range(num_iters):
+        cu = torch.jit.CompilationUnit()
+        start = time.time()
+        cu.define(src)
+        script_times.append(time.time() - start)
+
+        graph = getattr(cu, name).graph.copy()
+        start = time.time()
+        run_passes(graph)
+        pass_times.append(time.time() - start)
+        num_nodes = len(list(graph.nodes()))
+    return min(script_times), min(pass_times), num_nodes
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--graph", action="append", dest="graphs", choices=sorted(GRAPHS.keys()))
+    parser.add_argument("--size", type=int, default=1000)
+    parser.add_argument("--num_iters", type=int, default=5)
+    args = parser.parse_args()
+
+    graphs = args.graphs if args.graphs else sorted(GRAPHS.keys())
+    print("===================================")
+    print("{:<16}{:>12}{:>16}{:>16}".format("graph", "nodes", "script (ms)", "passes (ms)"))
+    for name in graphs:
+        script_s, passes_s, num_nodes = benchmark_graph(name, args.size, args.num_iters)
+        print("{:<16}{:>12}{:>16.1f}{:>16.1f}".format(
+            name, num_nodes, secs_to_ms(script_s), secs_to_ms(passes_s)))
+    print("===================================")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,61 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""Microbenchmarks for the cumulative ops cumsum, cumprod, cummax and logcumsumexp."""
+
+# M slices of N elements, scanned along N. Long scans over few slices are
+# split into blocks scanned in parallel.
+cumulative_configs_short = op_bench.config_list(
+    attr_names=['M', 'N'],
+    attrs=[
+        [1, 1048576],
+        [512, 512],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+    },
+    tags=['short']
+)
+
+cumulative_configs_long = op_bench.cross_product_configs(
+    M=[1, 4, 256],
+    N=[65536, 16777216],
+    device=['cpu'],
+    tags=['long']
+)
+
+
+class CumulativeOpBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, device, op_func):
+        # Values close to 1 keep cumprod finite
+        self.input_one = 1 + torch.rand(M, N, device=device) / N
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one, 1)
+
+
+cumulative_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['cumsum', torch.cumsum],
+        ['cumprod', torch.cumprod],
+        ['cummax', torch.cummax],
+        ['logcumsumexp', torch.logcumsumexp],
+    ],
+)
+
+
+op_bench.generate_pt_tests_from_op_list(cumulative_ops_list,
+                                        cumulative_configs_short + cumulative_configs_long,
+                                        CumulativeOpBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
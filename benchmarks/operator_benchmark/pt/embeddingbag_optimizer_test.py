@@ -0,0 +1,72 @@
+import operator_benchmark as op_bench
+import torch
+import numpy
+
+"""Microbenchmarks for the EmbeddingBag training step: fused backward and
+optimizer update against a sparse gradient followed by optimizer.step()"""
+
+embeddingbag_optimizer_short_configs = op_bench.cross_product_configs(
+    embeddingbags=[100000],
+    dim=[64],
+    mode=['sum'],
+    input_size=[2048],
+    bag_size=[20],
+    optimizer=['rowwise_adagrad', 'sgd'],
+    dtype=[torch.float, torch.bfloat16],
+    fused=[True, False],
+    tags=['short']
+)
+
+embeddingbag_optimizer_long_configs = op_bench.cross_product_configs(
+    embeddingbags=[10000000],
+    dim=[64, 128],
+    mode=['sum', 'mean'],
+    input_size=[65536],
+    bag_size=[40],
+    optimizer=['rowwise_adagrad', 'sgd'],
+    dtype=[torch.float, torch.bfloat16],
+    fused=[True, False],
+    tags=['long']
+)
+
+
+class EmbeddingBagOptimizerBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, embeddingbags, dim, mode, input_size, bag_size, optimizer, dtype, fused):
+        # The unfused path goes through the sparse gradient of nn.EmbeddingBag,
+        # which only supports float weights
+        if not fused:
+            dtype = torch.float
+        self.weight = torch.randn(embeddingbags, dim).to(dtype).requires_grad_()
+        if optimizer == 'rowwise_adagrad':
+            self.optimizer = torch.optim.RowWiseAdagrad([self.weight], lr=0.01, momentum_dtype=dtype)
+        else:
+            self.optimizer = torch.optim.SGD([self.weight], lr=0.01)
+        numpy.random.seed((1 << 32) - 1)
+        self.input = torch.tensor(numpy.random.randint(0, embeddingbags, input_size)).long()
+        self.offsets = torch.arange(0, input_size, bag_size).long()
+        self.grad_output = torch.randn(self.offsets.numel(), dim)
+        self.mode = mode
+        self.fused = fused
+
+        self.set_module_name('embeddingbag_optimizer')
+
+    def forward(self):
+        if self.fused:
+            output = self.optimizer.embedding_bag(
+                self.weight, self.input, self.offsets, mode=self.mode)
+            output.backward(self.grad_output)
+        else:
+            self.optimizer.zero_grad()
+            output = torch.nn.functional.embedding_bag(
+                self.input, self.weight, self.offsets, mode=self.mode, sparse=True)
+            output.backward(self.grad_output)
+            self.optimizer.step()
+        return output
+
+
+op_bench.generate_pt_test(embeddingbag_optimizer_short_configs + embeddingbag_optimizer_long_configs,
+                          EmbeddingBagOptimizerBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
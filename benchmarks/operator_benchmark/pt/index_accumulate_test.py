@@ -0,0 +1,66 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+import numpy
+
+
+"""Microbenchmarks for index_add_, index_put_ with accumulate=True and scatter_add_
+with an expanded index, as used in the backward of embedding lookups."""
+
+# An example input from this configuration is M=1024, N=64, K=256: K rows of a
+# M x N tensor are gathered and then accumulated back.
+index_accumulate_configs_short = op_bench.config_list(
+    attr_names=["M", "N", "K"],
+    attrs=[
+        [1024, 64, 256],
+        [1024, 256, 4096],
+    ],
+    cross_product_configs={
+        'device': ['cpu', 'cuda'],
+    },
+    tags=["short"]
+)
+
+
+index_accumulate_configs_long = op_bench.cross_product_configs(
+    M=[64, 16384],
+    N=[16, 512],
+    K=[1024, 32768],
+    device=['cpu', 'cuda'],
+    tags=["long"]
+)
+
+
+index_accumulate_ops_list = op_bench.op_list(
+    attr_names=["op_name", "op_func"],
+    attrs=[
+        ["index_add_", lambda dest, index, src: dest.index_add_(0, index, src)],
+        ["index_put_accumulate", lambda dest, index, src: dest.index_put_((index,), src, accumulate=True)],
+        ["scatter_add_", lambda dest, index, src: dest.scatter_add_(0, index.unsqueeze(1).expand_as(src), src)],
+    ],
+)
+
+
+class IndexAccumulateBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, K, device, op_func):
+        self.dest = torch.zeros(M, N, device=device)
+        numpy.random.seed((1 << 32) - 1)
+        self.index = torch.tensor(numpy.random.randint(0, M, (K,)), device=device)
+        self.src = torch.rand(K, N, device=device)
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.dest, self.index, self.src)
+
+
+op_bench.generate_pt_tests_from_op_list(index_accumulate_ops_list,
+                                        index_accumulate_configs_short + index_accumulate_configs_long,
+                                        IndexAccumulateBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
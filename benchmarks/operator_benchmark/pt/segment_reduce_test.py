@@ -0,0 +1,79 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""Microbenchmarks for segment_reduce and unsorted_segment_reduce."""
+
+# An example input from this configuration is M=4096, N=64, num_segments=256:
+# a 4096 x 64 tensor reduced along dim 0 into 256 segments of random lengths.
+# N=1 benchmarks a 1-D tensor, where segments are contiguous.
+segment_reduce_configs_short = op_bench.config_list(
+    attr_names=["M", "N", "num_segments"],
+    attrs=[
+        [4096, 1, 256],
+        [4096, 64, 256],
+    ],
+    cross_product_configs={
+        'reduce': ['sum', 'max'],
+        'device': ['cpu'],
+    },
+    tags=["short"]
+)
+
+
+segment_reduce_configs_long = op_bench.cross_product_configs(
+    M=[65536, 1048576],
+    N=[1, 16, 128],
+    num_segments=[64, 16384],
+    reduce=['sum', 'mean', 'max'],
+    device=['cpu'],
+    tags=["long"]
+)
+
+
+def random_lengths(M, num_segments):
+    torch.manual_seed(0)
+    cuts = torch.randint(0, M + 1, (num_segments - 1,)).sort()[0]
+    bounds = torch.cat((torch.zeros(1, dtype=torch.long), cuts, torch.full((1,), M, dtype=torch.long)))
+    return bounds[1:] - bounds[:-1]
+
+
+class SegmentReduceBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, num_segments, reduce, device):
+        shape = (M,) if N == 1 else (M, N)
+        self.data = torch.rand(shape, device=device, requires_grad=self.auto_set())
+        self.lengths = random_lengths(M, num_segments).to(device)
+        self.reduce = reduce
+        self.set_module_name("segment_reduce")
+
+    def forward(self):
+        return torch.segment_reduce(self.data, self.reduce, lengths=self.lengths)
+
+
+class UnsortedSegmentReduceBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, num_segments, reduce, device):
+        shape = (M,) if N == 1 else (M, N)
+        self.data = torch.rand(shape, device=device)
+        self.segment_ids = torch.randint(0, num_segments, (M,), device=device)
+        self.num_segments = num_segments
+        self.reduce = reduce
+        self.set_module_name("unsorted_segment_reduce")
+
+    def forward(self):
+        return torch.unsorted_segment_reduce(self.data, self.segment_ids, self.num_segments, self.reduce)
+
+
+op_bench.generate_pt_test(segment_reduce_configs_short + segment_reduce_configs_long,
+                          SegmentReduceBenchmark)
+op_bench.generate_pt_test(segment_reduce_configs_short + segment_reduce_configs_long,
+                          UnsortedSegmentReduceBenchmark)
+op_bench.generate_pt_gradient_test(segment_reduce_configs_short, SegmentReduceBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -0,0 +1,63 @@
+import array
+
+import operator_benchmark as op_bench
+import torch
+
+"""Microbenchmarks for creating tensors from Python data with torch.tensor."""
+
+tensor_from_data_short_configs = op_bench.config_list(
+    attr_names=["M", "N"],
+    attrs=[
+        [1, 16],
+        [64, 64],
+        [512, 512],
+    ],
+    cross_product_configs={
+        'kind': ['float', 'int', 'bool'],
+        'container': ['list', 'tuple', 'array'],
+    },
+    tags=["short"],
+)
+
+tensor_from_data_long_configs = op_bench.cross_product_configs(
+    M=[1, 128, 1024],
+    N=[8, 1024],
+    kind=['float', 'int', 'bool'],
+    container=['list', 'tuple', 'array'],
+    tags=["long"]
+)
+
+_array_typecodes = {'float': 'd', 'int': 'q', 'bool': 'b'}
+
+
+def _make_value(kind, i):
+    if kind == 'float':
+        return i * 0.5
+    if kind == 'int':
+        return i
+    return i % 2 == 0
+
+
+class TensorFromDataBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, kind, container):
+        rows = [[_make_value(kind, i * N + j) for j in range(N)] for i in range(M)]
+        if container == 'list':
+            self.data = rows
+        elif container == 'tuple':
+            self.data = tuple(tuple(row) for row in rows)
+        else:
+            # array.array is one dimensional, and exposes its memory through
+            # the buffer protocol
+            self.data = array.array(_array_typecodes[kind], [v for row in rows for v in row])
+        self.set_module_name("tensor_from_" + container)
+
+    def forward(self):
+        return torch.tensor(self.data)
+
+
+op_bench.generate_pt_test(tensor_from_data_short_configs + tensor_from_data_long_configs,
+                          TensorFromDataBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -56,6 +56,15 @@ C10_DEFINE_bool(
     "Whether to measure increase in allocated memory while "
     "loading and running the net.");
 C10_DEFINE_string(net, "", "The given net to benchmark.");
+C10_DEFINE_string(
+    net_type,
+    "",
+    "If set, overrides the type of the given net, e.g. async_scheduling or "
+    "async_work_stealing.");
+C10_DEFINE_int(
+    num_workers,
+    0,
+    "If positive, overrides the number of worker threads of the given net.");
 C10_DEFINE_string(
     output,
     "",
@@ -422,6 +422,8 @@ int benchmark(
     int FLAGS_iter,
     bool FLAGS_measure_memory,
     const string& FLAGS_net,
+    const string& FLAGS_net_type,
+    int FLAGS_num_workers,
     const string& FLAGS_output,
     const string& FLAGS_output_folder,
     bool FLAGS_run_individual,
@@ -484,6 +486,12 @@ int benchmark(
   if (!net_def.has_name()) {
     net_def.set_name("benchmark");
   }
+  if (!FLAGS_net_type.empty()) {
+    net_def.set_type(FLAGS_net_type);
+  }
+  if (FLAGS_num_workers > 0) {
+    net_def.set_num_workers(FLAGS_num_workers);
+  }
   caffe2::NetBase* net = workspace->CreateNet(net_def);
   CHECK_NOTNULL(net);
   runNetwork(
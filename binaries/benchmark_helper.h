@@ -157,6 +157,8 @@ int benchmark(
     int FLAGS_iter,
     bool FLAGS_measure_memory,
     const string& FLAGS_net,
+    const string& FLAGS_net_type,
+    int FLAGS_num_workers,
     const string& FLAGS_output,
     const string& FLAGS_output_folder,
     bool FLAGS_run_individual,
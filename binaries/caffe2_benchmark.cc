@@ -20,6 +20,8 @@ int main(int argc, char** argv) {
       FLAGS_iter,
       FLAGS_measure_memory,
       FLAGS_net,
+      FLAGS_net_type,
+      FLAGS_num_workers,
       FLAGS_output,
       FLAGS_output_folder,
       FLAGS_run_individual,
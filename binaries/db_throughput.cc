@@ -14,11 +14,13 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <thread>
 #include <vector>
 
 #include "caffe2/core/db.h"
+#include "caffe2/core/db_readahead.h"
 #include "caffe2/core/init.h"
 #include "caffe2/core/timer.h"
 #include "caffe2/core/logging.h"
@@ -32,25 +34,76 @@ C10_DEFINE_int(
     num_read_threads,
     1,
     "The number of concurrent reading threads.");
+C10_DEFINE_int(
+    batch_size,
+    0,
+    "If positive, read the records in batches of this size with NextN().");
+C10_DEFINE_int(
+    readahead_threads,
+    0,
+    "If positive, read the db ahead in this many background threads, each "
+    "reading its own key range.");
+C10_DEFINE_int(
+    readahead_buffer,
+    256,
+    "The number of records each readahead thread keeps ready.");
 
 using caffe2::db::Cursor;
 using caffe2::db::DB;
 using caffe2::db::DBReader;
+using caffe2::db::Record;
 using caffe2::string;
 
+std::unique_ptr<Cursor> NewCursor(DB* db) {
+  if (FLAGS_readahead_threads <= 0) {
+    return db->NewCursor();
+  }
+  std::vector<std::unique_ptr<Cursor>> cursors;
+  if (FLAGS_readahead_threads == 1) {
+    cursors.push_back(db->NewCursor());
+  } else {
+    const auto keys = caffe2::db::SplitKeyRange(
+        db->NewCursor().get(), FLAGS_readahead_threads);
+    for (size_t i = 0; i <= keys.size(); ++i) {
+      cursors.push_back(caffe2::make_unique<caffe2::db::KeyRangeCursor>(
+          db->NewCursor(),
+          i > 0 ? keys[i - 1] : "",
+          i < keys.size() ? keys[i] : ""));
+    }
+  }
+  return caffe2::make_unique<caffe2::db::ReadaheadCursor>(
+      std::move(cursors), FLAGS_readahead_buffer);
+}
+
 void TestThroughputWithDB() {
   std::unique_ptr<DB> in_db(caffe2::db::CreateDB(
       FLAGS_input_db_type, FLAGS_input_db, caffe2::db::READ));
-  std::unique_ptr<Cursor> cursor(in_db->NewCursor());
+  std::unique_ptr<Cursor> cursor(NewCursor(in_db.get()));
+  std::vector<Record> records;
+  size_t total_bytes = 0;
   for (int iter_id = 0; iter_id < FLAGS_repeat; ++iter_id) {
     caffe2::Timer timer;
-    for (int i = 0; i < FLAGS_report_interval; ++i) {
-      string key = cursor->key();
-      string value = cursor->value();
-      //VLOG(1) << "Key " << key;
-      cursor->Next();
-      if (!cursor->Valid()) {
-        cursor->SeekToFirst();
+    if (FLAGS_batch_size > 0) {
+      for (int i = 0; i < FLAGS_report_interval;) {
+        records.clear();
+        i += static_cast<int>(cursor->NextN(
+            std::min(FLAGS_batch_size, FLAGS_report_interval - i), &records));
+        for (const auto& record : records) {
+          total_bytes += record.value().size();
+        }
+        if (!cursor->Valid()) {
+          cursor->SeekToFirst();
+        }
+      }
+    } else {
+      for (int i = 0; i < FLAGS_report_interval; ++i) {
+        string key = cursor->key();
+        string value = cursor->value();
+        total_bytes += value.size();
+        cursor->Next();
+        if (!cursor->Valid()) {
+          cursor->SeekToFirst();
+        }
       }
     }
     double elapsed_seconds = timer.Seconds();
@@ -60,6 +113,7 @@ void TestThroughputWithDB() {
         elapsed_seconds,
         FLAGS_report_interval / elapsed_seconds);
   }
+  VLOG(1) << "Read " << total_bytes << " bytes of values.";
 }
 
 void TestThroughputWithReaderWorker(const DBReader* reader, int thread_id) {
@@ -82,6 +136,9 @@ void TestThroughputWithReaderWorker(const DBReader* reader, int thread_id) {
 
 void TestThroughputWithReader() {
   caffe2::db::DBReader reader(FLAGS_input_db_type, FLAGS_input_db);
+  if (FLAGS_readahead_threads > 0) {
+    reader.EnableReadahead(FLAGS_readahead_threads, FLAGS_readahead_buffer);
+  }
   std::vector<std::unique_ptr<std::thread>> reading_threads(
       FLAGS_num_read_threads);
   for (int i = 0; i < reading_threads.size(); ++i) {
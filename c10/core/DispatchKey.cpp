@@ -42,6 +42,8 @@ const char* toString(DispatchKey t) {
       return "TESTING_ONLY_GenericMode";
     case DispatchKey::Autocast:
       return "Autocast";
+    case DispatchKey::AutocastCPU:
+      return "AutocastCPU";
     case DispatchKey::TESTING_ONLY_GenericWrapper:
       return "TESTING_ONLY_GenericWrapper";
     case DispatchKey::Profiler:
@@ -138,7 +138,10 @@ enum class DispatchKey : uint8_t {
 
   // Autocasting precedes VariableTypeId, to ensure casts are autograd-exposed
   // and inputs are saved for backward in the post-autocast type.
+  // Autocast handles CUDA tensors, AutocastCPU handles CPU tensors; each has
+  // its own policy lists and can be enabled independently.
   Autocast,
+  AutocastCPU,
 
   // Here are some reserved pre-autograd keys for user-defined backends, see
   // Note [Private use DispatchKey]
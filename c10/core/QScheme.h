@@ -10,19 +10,25 @@ namespace c10 {
  * to one correspondence with Quantizer
  * Please refer to ATen/quantized/Quantizer.h to see the Quantizers classes.
  * Keep this file in sync with torch/nn/_qscheme.py
+ *
+ * PER_CHANNEL_GROUP_SYMMETRIC has no Quantizer: it describes 4-bit weights with
+ * a scale for each group of consecutive elements of a channel, which only
+ * exist in packed form (see PackedLinearWeightInt4).
  */
 enum class QScheme : uint8_t {
   PER_TENSOR_AFFINE = 0,
   PER_CHANNEL_AFFINE = 1,
   PER_TENSOR_SYMMETRIC = 2,
   PER_CHANNEL_SYMMETRIC = 3,
-  COMPILE_TIME_NUM_QSCHEMES = 4,
+  PER_CHANNEL_GROUP_SYMMETRIC = 4,
+  COMPILE_TIME_NUM_QSCHEMES = 5,
 };
 
 constexpr auto kPerTensorAffine = QScheme::PER_TENSOR_AFFINE;
 constexpr auto kPerChannelAffine = QScheme::PER_CHANNEL_AFFINE;
 constexpr auto kPerTensorSymmetric = QScheme::PER_TENSOR_SYMMETRIC;
 constexpr auto kPerChannelSymmetric = QScheme::PER_CHANNEL_SYMMETRIC;
+constexpr auto kPerChannelGroupSymmetric = QScheme::PER_CHANNEL_GROUP_SYMMETRIC;
 constexpr int COMPILE_TIME_NUM_QSCHEMES =
   static_cast<int>(QScheme::COMPILE_TIME_NUM_QSCHEMES);
 
@@ -36,6 +42,8 @@ inline std::string toString(QScheme qscheme) {
       return "per_tensor_symmetric";
     case kPerChannelSymmetric:
       return "per_channel_symmetric";
+    case kPerChannelGroupSymmetric:
+      return "per_channel_group_symmetric";
     default:
       TORCH_CHECK(false, "Unrecognized qscheme: ", static_cast<int>(qscheme));
   }
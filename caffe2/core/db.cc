@@ -3,6 +3,7 @@
 #include <mutex>
 
 #include "caffe2/core/blob_serialization.h"
+#include "caffe2/core/db_readahead.h"
 #include "caffe2/core/logging.h"
 
 namespace caffe2 {
@@ -171,6 +172,33 @@ class MiniDB : public DB {
 REGISTER_CAFFE2_DB(MiniDB, MiniDB);
 REGISTER_CAFFE2_DB(minidb, MiniDB);
 
+void DBReader::EnableReadahead(int num_threads, int buffer_size) {
+  CAFFE_ENFORCE(cursor_ != nullptr, "Reader not initialized.");
+  CAFFE_ENFORCE_GT(num_threads, 0);
+  CAFFE_ENFORCE_GT(buffer_size, 0);
+  std::vector<std::unique_ptr<Cursor>> cursors;
+  if (num_threads == 1) {
+    cursors.push_back(std::move(cursor_));
+  } else {
+    CAFFE_ENFORCE(
+        cursor_->SupportsSeek(),
+        "Reading ",
+        db_type_,
+        " with several readahead threads requires a db that supports seeking.");
+    const auto keys = SplitKeyRange(cursor_.get(), num_threads);
+    cursor_.reset();
+    for (size_t i = 0; i <= keys.size(); ++i) {
+      cursors.push_back(make_unique<KeyRangeCursor>(
+          db_->NewCursor(),
+          i > 0 ? keys[i - 1] : "",
+          i < keys.size() ? keys[i] : ""));
+    }
+  }
+  cursor_ = make_unique<ReadaheadCursor>(std::move(cursors), buffer_size);
+  // Skip to the first record of this reader's shard
+  MoveToBeginning();
+}
+
 void DBReaderSerializer::Serialize(
     const void* pointer,
     TypeMeta typeMeta,
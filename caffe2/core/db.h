@@ -4,6 +4,7 @@
 #include <mutex>
 
 #include "c10/util/Registry.h"
+#include "c10/util/string_view.h"
 #include "caffe2/core/blob_serialization.h"
 #include "caffe2/proto/caffe2_pb.h"
 
@@ -16,6 +17,48 @@ namespace db {
  */
 enum Mode { READ, WRITE, NEW };
 
+/**
+ * A key-value pair returned by Cursor::NextN(). It either views memory owned
+ * by the database, when the cursor can hand that out without copying, or owns
+ * a copy of the key and the value.
+ */
+class CAFFE2_API Record {
+ public:
+  Record() {}
+  /**
+   * Points the record at memory that outlives it, e.g. the memory map of the
+   * database.
+   */
+  void SetView(c10::string_view key, c10::string_view value) {
+    owned_ = false;
+    key_view_ = key;
+    value_view_ = value;
+  }
+  /**
+   * Makes the record own its key and value.
+   */
+  void SetCopy(string key, string value) {
+    owned_ = true;
+    key_ = std::move(key);
+    value_ = std::move(value);
+  }
+  c10::string_view key() const {
+    return owned_ ? c10::string_view(key_) : key_view_;
+  }
+  c10::string_view value() const {
+    return owned_ ? c10::string_view(value_) : value_view_;
+  }
+
+ private:
+  // The views are only used when the record doesn't own its data, so that
+  // moving a record around never leaves them pointing at a moved-from string.
+  c10::string_view key_view_;
+  c10::string_view value_view_;
+  string key_;
+  string value_;
+  bool owned_{false};
+};
+
 /**
  * An abstract class for the cursor of the database while reading.
  */
@@ -51,6 +94,24 @@ class CAFFE2_API Cursor {
    * reached the end of the database, return false.
    */
   virtual bool Valid() = 0;
+  /**
+   * Reads up to n records starting at the current location, appends them to
+   * records and moves past them. Returns the number of records read, which is
+   * less than n only when the end of the database is reached.
+   *
+   * The records stay valid until the cursor is destroyed, even if they view
+   * the database. The default implementation copies key() and value(); dbs
+   * that can hand out their memory without copying (e.g. LMDB) override it.
+   */
+  virtual size_t NextN(size_t n, std::vector<Record>* records) {
+    size_t count = 0;
+    for (; count < n && Valid(); ++count) {
+      records->emplace_back();
+      records->back().SetCopy(key(), value());
+      Next();
+    }
+    return count;
+  }
 
   C10_DISABLE_COPY_AND_ASSIGN(Cursor);
 };
@@ -250,6 +311,17 @@ class CAFFE2_API DBReader {
     MoveToBeginning();
   }
 
+  /**
+   * Reads the db ahead in num_threads background threads, each keeping up to
+   * buffer_size records ready. With more than one thread the db is split into
+   * key ranges that are read in parallel and whose records are interleaved,
+   * which requires a db that supports seeking. Not thread safe.
+   *
+   * The readahead cursor can't seek, so the position of the reader isn't
+   * serialized any more.
+   */
+  void EnableReadahead(int num_threads, int buffer_size);
+
   /**
    * Returns the underlying cursor of the db reader.
    *
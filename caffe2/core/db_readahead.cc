@@ -0,0 +1,303 @@
+#include "caffe2/core/db_readahead.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+#include "caffe2/core/logging.h"
+
+namespace caffe2 {
+namespace db {
+
+namespace {
+
+// Compares the keys the way memcmp does, i.e. with the bytes taken as
+// unsigned, unlike c10::string_view::compare().
+int CompareBytewise(c10::string_view a, c10::string_view b) {
+  const size_t size = std::min(a.size(), b.size());
+  const int result = size > 0 ? std::memcmp(a.data(), b.data(), size) : 0;
+  if (result != 0) {
+    return result;
+  }
+  return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+}
+
+string ToString(c10::string_view view) {
+  return string(view.data(), view.size());
+}
+
+} // namespace
+
+KeyRangeCursor::KeyRangeCursor(
+    std::unique_ptr<Cursor> cursor,
+    string begin,
+    string end)
+    : cursor_(std::move(cursor)),
+      begin_(std::move(begin)),
+      end_(std::move(end)) {
+  CAFFE_ENFORCE(cursor_.get(), "Passed null cursor");
+  CAFFE_ENFORCE(
+      cursor_->SupportsSeek(),
+      "Reading a key range requires a cursor that supports seeking.");
+  SeekToFirst();
+}
+
+bool KeyRangeCursor::BeforeEnd(c10::string_view key) const {
+  return end_.empty() || CompareBytewise(key, end_) < 0;
+}
+
+void KeyRangeCursor::Seek(const string& key) {
+  if (CompareBytewise(key, begin_) < 0) {
+    SeekToFirst();
+    return;
+  }
+  cursor_->Seek(key);
+  valid_ = cursor_->Valid() && BeforeEnd(cursor_->key());
+}
+
+void KeyRangeCursor::SeekToFirst() {
+  if (begin_.empty()) {
+    cursor_->SeekToFirst();
+  } else {
+    cursor_->Seek(begin_);
+  }
+  valid_ = cursor_->Valid() && BeforeEnd(cursor_->key());
+}
+
+void KeyRangeCursor::Next() {
+  cursor_->Next();
+  valid_ = cursor_->Valid() && BeforeEnd(cursor_->key());
+}
+
+string KeyRangeCursor::key() {
+  return cursor_->key();
+}
+
+string KeyRangeCursor::value() {
+  return cursor_->value();
+}
+
+size_t KeyRangeCursor::NextN(size_t n, std::vector<Record>* records) {
+  if (!valid_) {
+    return 0;
+  }
+  const size_t first = records->size();
+  const size_t count = cursor_->NextN(n, records);
+  // The keys are sorted, so if the last record is in the range all of them
+  // are. Otherwise drop the ones past the end.
+  if (count > 0 && !BeforeEnd(records->back().key())) {
+    size_t last = first;
+    while (BeforeEnd((*records)[last].key())) {
+      ++last;
+    }
+    records->resize(last);
+    valid_ = false;
+    return last - first;
+  }
+  valid_ = cursor_->Valid() && BeforeEnd(cursor_->key());
+  return count;
+}
+
+std::vector<string> SplitKeyRange(Cursor* cursor, int num_shards) {
+  CAFFE_ENFORCE_GT(num_shards, 0);
+  size_t num_records = 0;
+  for (cursor->SeekToFirst(); cursor->Valid(); cursor->Next()) {
+    ++num_records;
+  }
+  std::vector<string> keys;
+  size_t position = 0;
+  cursor->SeekToFirst();
+  for (int shard = 1; shard < num_shards; ++shard) {
+    const size_t split = num_records * shard / num_shards;
+    // Don't produce empty ranges when there are fewer records than shards
+    if (split == position) {
+      continue;
+    }
+    for (; position < split; ++position) {
+      cursor->Next();
+    }
+    keys.push_back(cursor->key());
+  }
+  return keys;
+}
+
+// Reads one cursor in a background thread into a bounded buffer.
+class ReadaheadCursor::Shard {
+ public:
+  Shard(std::unique_ptr<Cursor> cursor, size_t buffer_size)
+      : cursor_(std::move(cursor)),
+        buffer_size_(buffer_size),
+        batch_size_(std::max<size_t>(buffer_size / 2, 1)) {
+    CAFFE_ENFORCE(cursor_.get(), "Passed null cursor");
+  }
+
+  ~Shard() {
+    Stop();
+  }
+
+  // Starts reading from the first record in the background.
+  void Start() {
+    Stop();
+    records_.clear();
+    done_ = false;
+    stop_ = false;
+    error_ = nullptr;
+    cursor_->SeekToFirst();
+    thread_ = std::thread([this] { Run(); });
+  }
+
+  void Stop() {
+    if (!thread_.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      stop_ = true;
+    }
+    not_full_.notify_one();
+    thread_.join();
+  }
+
+  // Waits for the next record. Returns false if the cursor has reached its
+  // end, and rethrows the error of the reading thread once the records read
+  // before the error have been consumed.
+  bool Pop(Record* record) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return !records_.empty() || done_; });
+    if (records_.empty()) {
+      if (error_) {
+        std::rethrow_exception(error_);
+      }
+      return false;
+    }
+    *record = std::move(records_.front());
+    records_.pop_front();
+    if (records_.size() + batch_size_ == buffer_size_) {
+      not_full_.notify_one();
+    }
+    return true;
+  }
+
+ private:
+  void Run() {
+    std::vector<Record> batch;
+    try {
+      for (;;) {
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          not_full_.wait(lock, [this] {
+            return stop_ || records_.size() + batch_size_ <= buffer_size_;
+          });
+          if (stop_) {
+            return;
+          }
+        }
+        // Read without holding the lock so that the consumer can go on
+        batch.clear();
+        const bool done = cursor_->NextN(batch_size_, &batch) < batch_size_;
+        {
+          std::lock_guard<std::mutex> guard(mutex_);
+          std::move(batch.begin(), batch.end(), std::back_inserter(records_));
+          done_ = done;
+        }
+        not_empty_.notify_one();
+        if (done) {
+          return;
+        }
+      }
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        error_ = std::current_exception();
+        done_ = true;
+      }
+      not_empty_.notify_one();
+    }
+  }
+
+  std::unique_ptr<Cursor> cursor_;
+  const size_t buffer_size_;
+  // Number of records read at once, the thread waits until there is room
+  // for a whole batch
+  const size_t batch_size_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<Record> records_;
+  bool done_{false};
+  bool stop_{false};
+  std::exception_ptr error_;
+};
+
+ReadaheadCursor::ReadaheadCursor(
+    std::vector<std::unique_ptr<Cursor>> cursors,
+    size_t buffer_size) {
+  CAFFE_ENFORCE(!cursors.empty(), "Need at least one cursor to read ahead");
+  CAFFE_ENFORCE_GT(buffer_size, 0);
+  for (auto& cursor : cursors) {
+    shards_.emplace_back(new Shard(std::move(cursor), buffer_size));
+  }
+  SeekToFirst();
+}
+
+// Out of line because Shard is incomplete in the header
+ReadaheadCursor::~ReadaheadCursor() {}
+
+void ReadaheadCursor::Seek(const string& /*key*/) {
+  CAFFE_THROW("ReadaheadCursor does not support seeking to a specific key.");
+}
+
+void ReadaheadCursor::SeekToFirst() {
+  active_.clear();
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    shards_[i]->Start();
+    active_.push_back(i);
+  }
+  next_ = 0;
+  Advance();
+}
+
+void ReadaheadCursor::Advance() {
+  while (!active_.empty()) {
+    next_ %= active_.size();
+    if (shards_[active_[next_]]->Pop(&current_)) {
+      ++next_;
+      valid_ = true;
+      return;
+    }
+    active_.erase(active_.begin() + next_);
+  }
+  valid_ = false;
+}
+
+void ReadaheadCursor::Next() {
+  Advance();
+}
+
+string ReadaheadCursor::key() {
+  CAFFE_ENFORCE(valid_, "Reading past the end of the db");
+  return ToString(current_.key());
+}
+
+string ReadaheadCursor::value() {
+  CAFFE_ENFORCE(valid_, "Reading past the end of the db");
+  return ToString(current_.value());
+}
+
+size_t ReadaheadCursor::NextN(size_t n, std::vector<Record>* records) {
+  size_t count = 0;
+  for (; count < n && valid_; ++count) {
+    records->push_back(std::move(current_));
+    Advance();
+  }
+  return count;
+}
+
+} // namespace db
+} // namespace caffe2
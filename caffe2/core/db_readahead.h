@@ -0,0 +1,89 @@
+#ifndef CAFFE2_CORE_DB_READAHEAD_H_
+#define CAFFE2_CORE_DB_READAHEAD_H_
+
+#include <vector>
+
+#include "caffe2/core/db.h"
+
+namespace caffe2 {
+namespace db {
+
+/**
+ * A cursor over the keys in [begin, end) of another cursor, which has to
+ * support seeking. An empty begin starts at the first key and an empty end
+ * goes on to the last key. Keys are compared bytewise, which is the order that
+ * LevelDB, LMDB and RocksDB keep them in by default.
+ */
+class CAFFE2_API KeyRangeCursor : public Cursor {
+ public:
+  KeyRangeCursor(std::unique_ptr<Cursor> cursor, string begin, string end);
+
+  void Seek(const string& key) override;
+  bool SupportsSeek() override { return true; }
+  void SeekToFirst() override;
+  void Next() override;
+  string key() override;
+  string value() override;
+  bool Valid() override { return valid_; }
+  size_t NextN(size_t n, std::vector<Record>* records) override;
+
+ private:
+  bool BeforeEnd(c10::string_view key) const;
+
+  std::unique_ptr<Cursor> cursor_;
+  string begin_;
+  string end_;
+  bool valid_{false};
+};
+
+/**
+ * Returns keys that split the db read by cursor into ranges with about the
+ * same number of records, at most num_shards of them: the ranges are
+ * [first key, keys[0]), [keys[0], keys[1]), ..., [keys.back(), last key].
+ * This walks over the whole db twice without reading the values.
+ */
+CAFFE2_API std::vector<string> SplitKeyRange(Cursor* cursor, int num_shards);
+
+/**
+ * Reads a set of cursors ahead in background threads, one per cursor, so that
+ * reading overlaps with whatever the consumer does with the records. Each
+ * thread keeps up to buffer_size records ready.
+ *
+ * The records of the cursors are interleaved: one from each cursor in turn,
+ * skipping the cursors that have reached their end. With a single cursor the
+ * records come in the same order as reading it directly. SeekToFirst()
+ * restarts all the cursors, seeking to a key is not supported.
+ */
+class CAFFE2_API ReadaheadCursor : public Cursor {
+ public:
+  ReadaheadCursor(
+      std::vector<std::unique_ptr<Cursor>> cursors,
+      size_t buffer_size);
+  ~ReadaheadCursor() override;
+
+  void Seek(const string& key) override;
+  void SeekToFirst() override;
+  void Next() override;
+  string key() override;
+  string value() override;
+  bool Valid() override { return valid_; }
+  size_t NextN(size_t n, std::vector<Record>* records) override;
+
+ private:
+  class Shard;
+
+  // Moves current_ to the next record of the next shard that has one.
+  void Advance();
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  // Shards that haven't reached their end, and the one to read from next
+  std::vector<size_t> active_;
+  size_t next_{0};
+  Record current_;
+  bool valid_{false};
+};
+
+} // namespace db
+} // namespace caffe2
+
+#endif // CAFFE2_CORE_DB_READAHEAD_H_
@@ -0,0 +1,319 @@
+#include "caffe2/core/net_async_work_stealing.h"
+
+#include <algorithm>
+
+#include "c10/util/numa.h"
+#include "c10/util/thread_name.h"
+#include "caffe2/core/timer.h"
+
+namespace caffe2 {
+
+namespace {
+
+// Pool and worker index of the current thread, used to push tasks created by
+// a worker to its own queue
+thread_local const WorkStealingThreadPool* current_pool = nullptr;
+thread_local size_t current_worker_id = 0;
+
+// Weight of the newest sample in the chain run time estimate
+constexpr float kChainTimeDecay = 0.125;
+// Per operator stats are copied out of the prof_dag counters every so many
+// runs
+constexpr int kOpStatsUpdateInterval = 16;
+
+} // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+    size_t pool_size,
+    int numa_node_id) {
+  CAFFE_ENFORCE_GT(pool_size, 0U, "Work stealing pool needs a worker");
+  queues_.reserve(pool_size);
+  for (size_t i = 0; i < pool_size; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  threads_.reserve(pool_size);
+  for (size_t i = 0; i < pool_size; ++i) {
+    threads_.emplace_back([this, i, numa_node_id]() {
+      c10::setThreadName("CaffeWSThread");
+      c10::NUMABind(numa_node_id);
+      current_pool = this;
+      current_worker_id = i;
+      mainLoop(i);
+    });
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkStealingThreadPool::run(std::function<void()> func) {
+  size_t queue_id;
+  if (current_pool == this) {
+    queue_id = current_worker_id;
+  } else {
+    queue_id = next_queue_++ % queues_.size();
+  }
+  {
+    auto& queue = *queues_[queue_id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(func));
+  }
+  // pending_ and idle_ are sequentially consistent: either this thread sees
+  // the idle worker, or the worker sees the new task before going to sleep
+  ++pending_;
+  if (idle_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.notify_one();
+  }
+}
+
+size_t WorkStealingThreadPool::size() const {
+  return threads_.size();
+}
+
+size_t WorkStealingThreadPool::numAvailable() const {
+  return idle_.load();
+}
+
+bool WorkStealingThreadPool::inThreadPool() const {
+  return current_pool == this;
+}
+
+bool WorkStealingThreadPool::popLocal(
+    size_t worker_id,
+    std::function<void()>& task) {
+  auto& queue = *queues_[worker_id];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingThreadPool::steal(
+    size_t worker_id,
+    std::function<void()>& task) {
+  const auto num_queues = queues_.size();
+  for (size_t i = 1; i < num_queues; ++i) {
+    auto& queue = *queues_[(worker_id + i) % num_queues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::mainLoop(size_t worker_id) {
+  std::function<void()> task;
+  while (true) {
+    if (popLocal(worker_id, task) || steal(worker_id, task)) {
+      --pending_;
+      try {
+        task();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "Exception in work stealing pool task: " << e.what();
+      } catch (...) {
+        LOG(ERROR) << "Exception in work stealing pool task";
+      }
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    ++idle_;
+    sleep_cv_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+    --idle_;
+    // Tasks still queued on shutdown are run before exiting
+    if (stop_ && pending_.load() == 0) {
+      return;
+    }
+  }
+}
+
+AsyncWorkStealingNet::AsyncWorkStealingNet(
+    const std::shared_ptr<const NetDef>& net_def,
+    Workspace* ws)
+    : AsyncSchedulingNet(net_def, ws) {
+  for (const auto* op : operators_) {
+    const auto& device_option = op->device_option();
+    CAFFE_ENFORCE(
+        IsCPUDeviceType(device_option.device_type()),
+        "async_work_stealing net only supports CPU operators, got ",
+        op->debug_def().type(),
+        " on device type ",
+        device_option.device_type());
+    CAFFE_ENFORCE(
+        !op->HasAsyncPart(),
+        "async_work_stealing net does not support operators with an async "
+        "part, got ",
+        op->debug_def().type());
+  }
+
+  // Kahn's algorithm, chains are processed in the order of their ids if the
+  // graph allows
+  std::vector<int> parent_count(tasksNum());
+  std::deque<int> ready;
+  for (auto task_id = 0; task_id < tasksNum(); ++task_id) {
+    parent_count[task_id] = parents(task_id).size();
+    if (parent_count[task_id] == 0) {
+      ready.push_back(task_id);
+    }
+  }
+  topo_order_.reserve(tasksNum());
+  while (!ready.empty()) {
+    auto task_id = ready.front();
+    ready.pop_front();
+    topo_order_.push_back(task_id);
+    for (auto child_id : children(task_id)) {
+      if (--parent_count[child_id] == 0) {
+        ready.push_back(child_id);
+      }
+    }
+  }
+  CAFFE_ENFORCE_EQ(
+      static_cast<int>(topo_order_.size()),
+      tasksNum(),
+      "Chain graph of the net has a cycle");
+
+  chain_time_ms_.resize(tasksNum(), 0.0);
+  priority_.resize(tasksNum(), 0.0);
+  updatePriorities();
+
+  pool_ = GetAsyncNetThreadPool<WorkStealingThreadPool, PROTO_CPU>(
+      -1, num_workers_, options_.use_per_net_pools_);
+}
+
+AsyncWorkStealingNet::~AsyncWorkStealingNet() {
+  // Running tasks reference the pool and the priorities, wait before they
+  // are destroyed
+  Wait();
+}
+
+void AsyncWorkStealingNet::updatePriorities() {
+  if (options_.report_stats_ &&
+      (op_time_ms_.empty() || num_runs_ % kOpStatsUpdateInterval == 0)) {
+    op_time_ms_ = counters_.GetReport().GetPerOperatorMeanTime();
+  }
+
+  for (auto it = topo_order_.rbegin(); it != topo_order_.rend(); ++it) {
+    auto task_id = *it;
+    float cost = 0.0;
+    if (!op_time_ms_.empty()) {
+      for (auto op_id : chains_[task_id]) {
+        cost += op_time_ms_[op_id];
+      }
+    } else if (chain_time_ms_[task_id] > 0.0) {
+      cost = chain_time_ms_[task_id];
+    } else {
+      // No measurements yet, count operators
+      cost = numOps(task_id);
+    }
+    float max_child_priority = 0.0;
+    for (auto child_id : children(task_id)) {
+      max_child_priority = std::max(max_child_priority, priority_[child_id]);
+    }
+    priority_[task_id] = cost + max_child_priority;
+  }
+}
+
+void AsyncWorkStealingNet::reset() {
+  AsyncSchedulingNet::reset();
+  if (num_runs_ > 0) {
+    updatePriorities();
+  }
+  ++num_runs_;
+}
+
+void AsyncWorkStealingNet::schedule(int task_id, bool run_inline) noexcept {
+  if (!testAndSetScheduled(task_id)) {
+    return;
+  }
+  if (run_inline) {
+    runTasks(task_id);
+  } else {
+    pool_->run([this, task_id]() { runTasks(task_id); });
+  }
+}
+
+// Runs the given chain, then keeps running the most critical ready child on
+// the same thread until the chain has no ready children left
+void AsyncWorkStealingNet::runTasks(int task_id) noexcept {
+  try {
+    std::vector<int> ready;
+    while (task_id >= 0) {
+      if (success_) {
+        Timer timer;
+        if (!run(task_id, /* stream_id */ 0)) {
+          success_ = false;
+        } else if (!options_.report_stats_) {
+          auto time_ms = timer.MilliSeconds();
+          auto& avg_ms = chain_time_ms_[task_id];
+          avg_ms = avg_ms > 0.0 ? avg_ms + (time_ms - avg_ms) * kChainTimeDecay
+                                : time_ms;
+        }
+      }
+
+      // With sync CPU operators a finished chain is done, children can be
+      // scheduled without checking events; on failure they are scheduled too
+      // and skip running their operators
+      ready.clear();
+      for (auto child_id : children(task_id)) {
+        if (updateParentCount(child_id) == 0) {
+          ready.push_back(child_id);
+        }
+      }
+      std::sort(ready.begin(), ready.end(), [this](int a, int b) {
+        return priority_[a] > priority_[b];
+      });
+
+      // Remaining children are pushed in priority order: thieves take the
+      // front of the deque, so the most critical ones move to idle workers
+      // first
+      int next_task_id = -1;
+      for (auto child_id : ready) {
+        if (!testAndSetScheduled(child_id)) {
+          continue;
+        }
+        if (next_task_id < 0) {
+          next_task_id = child_id;
+        } else {
+          pool_->run([this, child_id]() { runTasks(child_id); });
+        }
+      }
+
+      if (!success_) {
+        CancelAndFinishAsyncTasks();
+      }
+
+      // The inline child is not counted yet, so finishRun can't be reached
+      // while there is a next task to run
+      auto cur_processed_tasks = ++processed_tasks_num_;
+      if (cur_processed_tasks == tasksNum()) {
+        finishRun();
+      }
+      task_id = next_task_id;
+    }
+  } catch (const std::exception& e) {
+    // error of core scheduling and/or logic, will call terminate
+    LOG(FATAL) << "Unexpected error during graph scheduling run: " << e.what();
+  } catch (...) {
+    LOG(FATAL) << "Unknown error during graph scheduling run";
+  }
+}
+
+REGISTER_NET(async_work_stealing, AsyncWorkStealingNet);
+
+} // namespace caffe2
@@ -0,0 +1,111 @@
+#ifndef CAFFE2_CORE_NET_ASYNC_WORK_STEALING_H_
+#define CAFFE2_CORE_NET_ASYNC_WORK_STEALING_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "c10/core/thread_pool.h"
+#include "caffe2/core/net_async_scheduling.h"
+
+namespace caffe2 {
+
+/**
+ * Thread pool with a task deque per worker. Tasks submitted from a worker
+ * thread go to the worker's own deque, which the worker drains in LIFO
+ * order, so that a chain usually runs on the core that produced its inputs.
+ * Idle workers steal the oldest tasks from the other deques. Tasks submitted
+ * from outside of the pool are distributed round-robin.
+ */
+class CAFFE2_API WorkStealingThreadPool : public c10::TaskThreadPoolBase {
+ public:
+  explicit WorkStealingThreadPool(size_t pool_size, int numa_node_id = -1);
+  ~WorkStealingThreadPool() override;
+
+  void run(std::function<void()> func) override;
+
+  size_t size() const override;
+
+  size_t numAvailable() const override;
+
+  bool inThreadPool() const override;
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void mainLoop(size_t worker_id);
+  bool popLocal(size_t worker_id, std::function<void()>& task);
+  bool steal(size_t worker_id, std::function<void()>& task);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> threads_;
+
+  // Number of tasks pushed and not yet popped from any queue
+  std::atomic<size_t> pending_{0};
+  std::atomic<size_t> idle_{0};
+  std::atomic<size_t> next_queue_{0};
+
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  bool stop_ = false;
+
+  C10_DISABLE_COPY_AND_ASSIGN(WorkStealingThreadPool);
+};
+
+/**
+ * Async net for CPU inference that runs the chains of the operator DAG on a
+ * process-wide WorkStealingThreadPool (shared by all nets of this type with
+ * the same num_workers).
+ *
+ * When a chain finishes, its ready children are ordered by the estimated
+ * length of the longest path from them to the end of the net. The most
+ * critical child runs inline on the same thread, the others are pushed to
+ * the thread's deque where idle workers can steal them. Chain costs are
+ * taken from the prof_dag counters when operator profiling is enabled
+ * ("enable_profiling" net arg), from the measured chain run times otherwise.
+ *
+ * All operators must be CPU operators without an async part.
+ */
+class CAFFE2_API AsyncWorkStealingNet : public AsyncSchedulingNet {
+ public:
+  AsyncWorkStealingNet(
+      const std::shared_ptr<const NetDef>& net_def,
+      Workspace* ws);
+  ~AsyncWorkStealingNet() override;
+
+ protected:
+  void schedule(int task_id, bool run_inline = false) noexcept override;
+  void reset() override;
+
+ private:
+  void runTasks(int task_id) noexcept;
+  void updatePriorities();
+
+  std::shared_ptr<TaskThreadPoolBase> pool_;
+
+  // Chains in topological order
+  std::vector<int> topo_order_;
+  // Exponential moving average of the run time of each chain, only written by
+  // the thread running the chain and only read between runs
+  std::vector<float> chain_time_ms_;
+  // Per operator mean times from the prof_dag counters
+  std::vector<float> op_time_ms_;
+  // Estimated cost of the longest path from the start of a chain to the end
+  // of the net
+  std::vector<float> priority_;
+  int num_runs_ = 0;
+
+  C10_DISABLE_COPY_AND_ASSIGN(AsyncWorkStealingNet);
+};
+
+} // namespace caffe2
+
+#endif // CAFFE2_CORE_NET_ASYNC_WORK_STEALING_H_
@@ -2,6 +2,7 @@
 #include "c10/util/StringUtil.h"
 #include "caffe2/core/net.h"
 #include "caffe2/core/net_async_scheduling.h"
+#include "caffe2/core/net_async_work_stealing.h"
 #include "caffe2/core/operator.h"
 #include "caffe2/core/scope_guard.h"
 
@@ -1111,4 +1112,78 @@ TEST(NetTest, ProfDAGNetErrorTest) {
   testProfDAGNetErrorCase(/*test_error=*/true);
 }
 
+std::unique_ptr<NetBase> WorkStealingNet(
+    Workspace* ws,
+    const std::string& net_name,
+    int width,
+    bool fail) {
+  // in -> width parallel ops -> join op
+  NetDef net_def;
+  net_def.set_name(net_name);
+  net_def.set_type("async_work_stealing");
+  net_def.set_num_workers(4);
+  net_def.add_external_input("in");
+  for (int i = 0; i < width; ++i) {
+    auto* op = net_def.add_op();
+    op->set_type("NetTestDummy");
+    op->add_input("in");
+    op->add_output("hidden_" + c10::to_string(i));
+  }
+  auto* join_op = net_def.add_op();
+  join_op->set_type("NetTestDummy");
+  for (int i = 0; i < width; ++i) {
+    join_op->add_input("hidden_" + c10::to_string(i));
+  }
+  join_op->add_output("out");
+  if (fail) {
+    auto* arg = join_op->add_arg();
+    arg->set_name("fail");
+    arg->set_i(1);
+  }
+  return CreateNet(net_def, ws);
+}
+
+TEST(NetTest, WorkStealingNet) {
+  Workspace ws;
+  ws.CreateBlob("in");
+  const int width = 32;
+  auto net = WorkStealingNet(&ws, "work_stealing_net", width, false);
+  ASSERT_TRUE(
+      caffe2::dynamic_cast_if_rtti<AsyncWorkStealingNet*>(net.get()) !=
+      nullptr);
+  for (int i = 0; i < 10; ++i) {
+    counter.exchange(0);
+    ASSERT_TRUE(net->Run());
+    ASSERT_EQ(width + 1, counter.load());
+  }
+
+  net = WorkStealingNet(&ws, "work_stealing_net_fail", width, true);
+  for (int i = 0; i < 3; ++i) {
+    counter.exchange(0);
+    bool run_result = true;
+    try {
+      run_result = net->Run();
+    } catch (const std::exception&) {
+      run_result = false;
+    }
+    ASSERT_FALSE(run_result);
+    ASSERT_EQ(width, counter.load());
+  }
+}
+
+TEST(NetTest, WorkStealingNetRejectsAsyncOps) {
+  const auto spec = R"DOC(
+        name: "work_stealing_async_op"
+        type: "async_work_stealing"
+        op {
+          type: "AsyncErrorOp"
+        }
+  )DOC";
+
+  Workspace ws;
+  NetDef net_def;
+  CAFFE_ENFORCE(TextFormat::ParseFromString(spec, &net_def));
+  ASSERT_THROW(CreateNet(net_def, &ws), EnforceNotMet);
+}
+
 } // namespace caffe2
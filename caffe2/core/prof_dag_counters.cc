@@ -171,6 +171,17 @@ ProfDAGProtos ProfDAGReport::GetPerOperatorCost() const {
   return prof_dag_protos;
 }
 
+std::vector<float> ProfDAGReport::GetPerOperatorMeanTime() const {
+  std::vector<float> mean_times;
+  if (hasStats()) {
+    mean_times.reserve(time_per_op_total_.size());
+    for (const auto& stats : time_per_op_total_) {
+      mean_times.push_back(stats.computeMoments().first);
+    }
+  }
+  return mean_times;
+}
+
 void ProfDAGReport::PrintStats() {
   if (!hasStats()) {
     LOG(INFO) << "Insufficient number of runs";
@@ -1,11 +1,13 @@
 #include <cstdio>
 #include <iomanip>
+#include <set>
 #include <sstream>
 #include <thread>
 
 #include <gtest/gtest.h>
 #include "caffe2/core/blob_serialization.h"
 #include "caffe2/core/db.h"
+#include "caffe2/core/db_readahead.h"
 #include "caffe2/core/logging.h"
 #include "caffe2/proto/caffe2_pb.h"
 #include "common/gtest/gtest_extensions.h"
@@ -200,5 +202,118 @@ TEST(DBReaderShardedTest, Reader) {
   EXPECT_EQ(value, "05");
 }
 
+static std::vector<string> ReadAllKeys(Cursor* cursor) {
+  std::vector<string> keys;
+  for (; cursor->Valid(); cursor->Next()) {
+    keys.push_back(cursor->key());
+  }
+  return keys;
+}
+
+static void DBNextNTestWrapper(const string& db_type) {
+  std::string name = std::tmpnam(nullptr);
+  if (!CreateAndFill(db_type, name)) {
+    // Manually fail the test, and not do anything onwards.
+    EXPECT_TRUE(0);
+    return;
+  }
+  std::unique_ptr<DB> db(CreateDB(db_type, name, READ));
+  std::unique_ptr<Cursor> cursor(db->NewCursor());
+  std::vector<Record> records;
+  EXPECT_EQ(cursor->NextN(4, &records), 4u);
+  EXPECT_EQ(cursor->key(), "04");
+  // Records are appended
+  EXPECT_EQ(cursor->NextN(10, &records), size_t(kMaxItems - 4));
+  EXPECT_FALSE(cursor->Valid());
+  EXPECT_EQ(cursor->NextN(10, &records), 0u);
+  // The records of the first call are still valid after the cursor moved on,
+  // including those that view the memory of the database
+  ASSERT_EQ(records.size(), size_t(kMaxItems));
+  for (int i = 0; i < kMaxItems; ++i) {
+    std::stringstream ss;
+    ss << std::setw(2) << std::setfill('0') << i;
+    EXPECT_EQ(records[i].key(), ss.str());
+    EXPECT_EQ(records[i].value(), ss.str());
+  }
+}
+
+TEST(DBCursorTest, NextN) {
+  DBNextNTestWrapper("leveldb");
+}
+
+TEST(DBCursorTest, LMDBNextN) {
+  DBNextNTestWrapper("lmdb");
+}
+
+TEST(DBReadaheadTest, KeyRange) {
+  std::string name = std::tmpnam(nullptr);
+  CreateAndFill("leveldb", name);
+  std::unique_ptr<DB> db(CreateDB("leveldb", name, READ));
+  std::unique_ptr<Cursor> cursor(db->NewCursor());
+  EXPECT_EQ(SplitKeyRange(cursor.get(), 3), std::vector<string>({"03", "06"}));
+  EXPECT_EQ(SplitKeyRange(cursor.get(), 1).size(), 0u);
+  // No empty ranges when there are more shards than records
+  EXPECT_EQ(SplitKeyRange(cursor.get(), 2 * kMaxItems).size(), size_t(kMaxItems - 1));
+
+  KeyRangeCursor range(std::move(cursor), "03", "06");
+  EXPECT_EQ(ReadAllKeys(&range), std::vector<string>({"03", "04", "05"}));
+  range.Seek("01");
+  EXPECT_EQ(range.key(), "03");
+  range.Seek("05");
+  EXPECT_EQ(range.key(), "05");
+  range.Seek("07");
+  EXPECT_FALSE(range.Valid());
+  // NextN stops at the end of the range
+  range.SeekToFirst();
+  std::vector<Record> records;
+  EXPECT_EQ(range.NextN(5, &records), 3u);
+  EXPECT_FALSE(range.Valid());
+  EXPECT_EQ(records.back().key(), "05");
+}
+
+TEST(DBReadaheadTest, Interleaved) {
+  std::string name = std::tmpnam(nullptr);
+  CreateAndFill("leveldb", name);
+  std::unique_ptr<DB> db(CreateDB("leveldb", name, READ));
+  std::vector<std::unique_ptr<Cursor>> cursors;
+  cursors.push_back(make_unique<KeyRangeCursor>(db->NewCursor(), "", "03"));
+  cursors.push_back(make_unique<KeyRangeCursor>(db->NewCursor(), "03", "06"));
+  cursors.push_back(make_unique<KeyRangeCursor>(db->NewCursor(), "06", ""));
+  ReadaheadCursor cursor(std::move(cursors), 2);
+  const std::vector<string> expected(
+      {"00", "03", "06", "01", "04", "07", "02", "05", "08", "09"});
+  EXPECT_EQ(ReadAllKeys(&cursor), expected);
+  cursor.SeekToFirst();
+  std::vector<Record> records;
+  EXPECT_EQ(cursor.NextN(2 * kMaxItems, &records), size_t(kMaxItems));
+  for (int i = 0; i < kMaxItems; ++i) {
+    EXPECT_EQ(records[i].key(), expected[i]);
+    EXPECT_EQ(records[i].value(), expected[i]);
+  }
+}
+
+TEST(DBReadaheadTest, Reader) {
+  std::string name = std::tmpnam(nullptr);
+  CreateAndFill("leveldb", name);
+  for (int num_threads : {1, 3}) {
+    DBReader reader("leveldb", name, 2, 1);
+    reader.EnableReadahead(num_threads, 4);
+    std::multiset<string> keys;
+    string key;
+    string value;
+    for (int i = 0; i < kMaxItems; ++i) {
+      reader.Read(&key, &value);
+      EXPECT_EQ(key, value);
+      keys.insert(key);
+    }
+    // Every other record, twice since the reader wraps around
+    EXPECT_EQ(keys.size(), size_t(kMaxItems));
+    EXPECT_EQ(std::set<string>(keys.begin(), keys.end()).size(), size_t(kMaxItems / 2));
+    if (num_threads == 1) {
+      EXPECT_EQ(*keys.begin(), "01");
+    }
+  }
+}
+
 } // namespace db
 } // namespace caffe2
@@ -70,6 +70,24 @@ class LMDBCursor : public Cursor {
 
   bool Valid() override { return valid_; }
 
+  size_t NextN(size_t n, std::vector<Record>* records) override {
+    // The data returned by a read-only transaction stays valid until the
+    // transaction ends, i.e. until the cursor is destroyed, so we hand out
+    // views of the memory map instead of copying.
+    size_t count = 0;
+    for (; count < n && valid_; ++count) {
+      records->emplace_back();
+      records->back().SetView(
+          c10::string_view(
+              static_cast<const char*>(mdb_key_.mv_data), mdb_key_.mv_size),
+          c10::string_view(
+              static_cast<const char*>(mdb_value_.mv_data),
+              mdb_value_.mv_size));
+      Next();
+    }
+    return count;
+  }
+
  private:
   void SeekLMDB(MDB_cursor_op op) {
     int mdb_status = mdb_cursor_get(mdb_cursor_, &mdb_key_, &mdb_value_, op);
@@ -77,6 +77,42 @@ class TestReBatchingQueue(TestCase):
             workspace.FetchBlob(results[1]), workspace.FetchBlob("tensors")[5:]
         )
 
+    def test_rebatching_queue_whole_and_split_batches(self):
+        workspace.FeedBlob("batch0", np.arange(4, dtype=np.float32))
+        workspace.FeedBlob("batch1", np.arange(4, 10, dtype=np.float32))
+
+        init_net = core.Net('init_net')
+        queue = init_net.CreateRebatchingQueue(
+            [], 1, capacity=20, num_blobs=1)
+        workspace.RunNetOnce(init_net)
+
+        enqueue_net = core.Net('enqueue_net')
+        enqueue_net.EnqueueRebatchingQueue(
+            [queue, "batch0"], [], enqueue_batch=True)
+        enqueue_net.EnqueueRebatchingQueue(
+            [queue, "batch1"], [], enqueue_batch=True)
+        workspace.RunNetOnce(enqueue_net)
+
+        # The queue holds its own copy of the enqueued batches
+        workspace.FeedBlob("batch0", np.zeros(4, dtype=np.float32))
+
+        dequeue_net = core.Net('dequeue_net')
+        results = [
+            # Exactly the first batch
+            dequeue_net.DequeueRebatchingQueue([queue], 1, num_elements=4),
+            # Rows of the second batch
+            dequeue_net.DequeueRebatchingQueue([queue], 1, num_elements=2),
+            dequeue_net.DequeueRebatchingQueue([queue], 1, num_elements=4),
+        ]
+        workspace.RunNetOnce(dequeue_net)
+
+        npt.assert_array_equal(
+            workspace.FetchBlob(results[0]), np.arange(4, dtype=np.float32))
+        npt.assert_array_equal(
+            workspace.FetchBlob(results[1]), np.arange(4, 6, dtype=np.float32))
+        npt.assert_array_equal(
+            workspace.FetchBlob(results[2]), np.arange(6, 10, dtype=np.float32))
+
     def test_rebatching_queue_closes_properly(self):
         net = core.Net('net')
         workspace.FeedBlob(
@@ -1,10 +1,8 @@
 #include "caffe2/queue/blobs_queue.h"
 
 #include <atomic>
-#include <condition_variable>
+#include <chrono>
 #include <memory>
-#include <mutex>
-#include <queue>
 
 #include "caffe2/core/blob_stats.h"
 #include "caffe2/core/logging.h"
@@ -29,15 +27,17 @@ BlobsQueue::BlobsQueue(
     size_t numBlobs,
     bool enforceUniqueName,
     const std::vector<std::string>& fieldNames)
-    : numBlobs_(numBlobs), name_(queueName), stats_(queueName) {
+    : numBlobs_(numBlobs),
+      queue_(capacity),
+      name_(queueName),
+      stats_(queueName) {
   if (!fieldNames.empty()) {
     CAFFE_ENFORCE_EQ(
         fieldNames.size(), numBlobs, "Wrong number of fieldNames provided.");
     stats_.queue_dequeued_bytes.setDetails(fieldNames);
   }
-  queue_.reserve(capacity);
   for (size_t i = 0; i < capacity; ++i) {
-    std::vector<Blob*> blobs;
+    auto& blobs = queue_.slot(i);
     blobs.reserve(numBlobs);
     for (size_t j = 0; j < numBlobs; ++j) {
       const auto blobName = queueName + "_" + to_string(i) + "_" + to_string(j);
@@ -49,9 +49,8 @@ BlobsQueue::BlobsQueue(
       }
       blobs.push_back(ws->CreateBlob(blobName));
     }
-    queue_.push_back(blobs);
   }
-  DCHECK_EQ(queue_.size(), capacity);
+  DCHECK_EQ(queue_.capacity(), capacity);
 }
 
 bool BlobsQueue::blockingRead(
@@ -61,22 +60,28 @@ bool BlobsQueue::blockingRead(
   auto keeper = this->shared_from_this();
   const auto& name = name_.c_str();
   CAFFE_SDT(queue_read_start, name, (void*)this, SDT_BLOCKING_OP);
-  std::unique_lock<std::mutex> g(mutex_);
-  auto canRead = [this]() {
-    CAFFE_ENFORCE_LE(reader_, writer_);
-    return reader_ != writer_;
-  };
+  CAFFE_ENFORCE(inputs.size() >= numBlobs_);
   // Decrease queue balance before reading to indicate queue read pressure
   // is being increased (-ve queue balance indicates more reads than writes)
   CAFFE_EVENT(stats_, queue_balance, -1);
-  if (timeout_secs > 0) {
-    std::chrono::milliseconds timeout_ms(int(timeout_secs * 1000));
-    cv_.wait_for(
-        g, timeout_ms, [this, canRead]() { return closing_ || canRead(); });
-  } else {
-    cv_.wait(g, [this, canRead]() { return closing_ || canRead(); });
+  bool read = tryReadBlobs(inputs);
+  if (!read) {
+    Timer waitTimer;
+    // Items written before close() can still be read
+    auto ready = [&]() {
+      read = tryReadBlobs(inputs);
+      return read || closing_;
+    };
+    if (timeout_secs > 0) {
+      const auto deadline = QueueWaiter::Clock::now() +
+          std::chrono::milliseconds(int(timeout_secs * 1000));
+      readWaiter_.wait(ready, true, deadline);
+    } else {
+      readWaiter_.wait(ready);
+    }
+    CAFFE_EVENT(stats_, read_wait_time_ns, waitTimer.NanoSeconds());
   }
-  if (!canRead()) {
+  if (!read) {
     if (timeout_secs > 0 && !closing_) {
       LOG(ERROR) << "DequeueBlobs timed out in " << timeout_secs << " secs";
       CAFFE_SDT(queue_read_end, name, (void*)this, SDT_TIMEOUT);
@@ -85,19 +90,9 @@ bool BlobsQueue::blockingRead(
     }
     return false;
   }
-  DCHECK(canRead());
-  auto& result = queue_[reader_ % queue_.size()];
-  CAFFE_ENFORCE(inputs.size() >= result.size());
-  for (auto i = 0; i < result.size(); ++i) {
-    auto bytes = BlobStat::sizeBytes(*result[i]);
-    CAFFE_EVENT(stats_, queue_dequeued_bytes, bytes, i);
-    using std::swap;
-    swap(*(inputs[i]), *(result[i]));
-  }
-  CAFFE_SDT(queue_read_end, name, (void*)this, writer_ - reader_);
+  CAFFE_SDT(queue_read_end, name, (void*)this, queue_.size());
   CAFFE_EVENT(stats_, queue_dequeued_records);
-  ++reader_;
-  cv_.notify_all();
+  writeWaiter_.notifyAll();
   CAFFE_EVENT(stats_, read_time_ns, readTimer.NanoSeconds());
   return true;
 }
@@ -107,16 +102,15 @@ bool BlobsQueue::tryWrite(const std::vector<Blob*>& inputs) {
   auto keeper = this->shared_from_this();
   const auto& name = name_.c_str();
   CAFFE_SDT(queue_write_start, name, (void*)this, SDT_NONBLOCKING_OP);
-  std::unique_lock<std::mutex> g(mutex_);
-  if (!canWrite()) {
+  CAFFE_ENFORCE(inputs.size() >= numBlobs_);
+  if (!tryWriteBlobs(inputs)) {
     CAFFE_SDT(queue_write_end, name, (void*)this, SDT_ABORT);
     return false;
   }
-  // Increase queue balance before writing to indicate queue write pressure is
-  // being increased (+ve queue balance indicates more writes than reads)
+  // Increase queue balance to indicate queue write pressure is being
+  // increased (+ve queue balance indicates more writes than reads)
   CAFFE_EVENT(stats_, queue_balance, 1);
-  DCHECK(canWrite());
-  doWrite(inputs);
+  readWaiter_.notifyAll();
   CAFFE_EVENT(stats_, write_time_ns, writeTimer.NanoSeconds());
   return true;
 }
@@ -126,17 +120,24 @@ bool BlobsQueue::blockingWrite(const std::vector<Blob*>& inputs) {
   auto keeper = this->shared_from_this();
   const auto& name = name_.c_str();
   CAFFE_SDT(queue_write_start, name, (void*)this, SDT_BLOCKING_OP);
-  std::unique_lock<std::mutex> g(mutex_);
+  CAFFE_ENFORCE(inputs.size() >= numBlobs_);
   // Increase queue balance before writing to indicate queue write pressure is
   // being increased (+ve queue balance indicates more writes than reads)
   CAFFE_EVENT(stats_, queue_balance, 1);
-  cv_.wait(g, [this]() { return closing_ || canWrite(); });
-  if (!canWrite()) {
+  bool written = tryWriteBlobs(inputs);
+  if (!written) {
+    Timer waitTimer;
+    writeWaiter_.wait([&]() {
+      written = tryWriteBlobs(inputs);
+      return written || closing_;
+    });
+    CAFFE_EVENT(stats_, write_wait_time_ns, waitTimer.NanoSeconds());
+  }
+  if (!written) {
     CAFFE_SDT(queue_write_end, name, (void*)this, SDT_ABORT);
     return false;
   }
-  DCHECK(canWrite());
-  doWrite(inputs);
+  readWaiter_.notifyAll();
   CAFFE_EVENT(stats_, write_time_ns, writeTimer.NanoSeconds());
   return true;
 }
@@ -144,30 +145,36 @@ bool BlobsQueue::blockingWrite(const std::vector<Blob*>& inputs) {
 void BlobsQueue::close() {
   closing_ = true;
 
-  std::lock_guard<std::mutex> g(mutex_);
-  cv_.notify_all();
+  readWaiter_.notifyAll();
+  writeWaiter_.notifyAll();
 }
 
-bool BlobsQueue::canWrite() {
-  // writer is always within [reader, reader + size)
-  // we can write if reader is within [reader, reader + size)
-  CAFFE_ENFORCE_LE(reader_, writer_);
-  CAFFE_ENFORCE_LE(writer_, reader_ + queue_.size());
-  return writer_ != reader_ + queue_.size();
+bool BlobsQueue::tryReadBlobs(const std::vector<Blob*>& inputs) {
+  return queue_.tryPop([&](std::vector<Blob*>& result) {
+    for (auto i = 0; i < result.size(); ++i) {
+      auto bytes = BlobStat::sizeBytes(*result[i]);
+      CAFFE_EVENT(stats_, queue_dequeued_bytes, bytes, i);
+      using std::swap;
+      swap(*(inputs[i]), *(result[i]));
+    }
+  });
 }
 
-void BlobsQueue::doWrite(const std::vector<Blob*>& inputs) {
-  auto& result = queue_[writer_ % queue_.size()];
-  CAFFE_ENFORCE(inputs.size() >= result.size());
-  const auto& name = name_.c_str();
-  for (auto i = 0; i < result.size(); ++i) {
-    using std::swap;
-    swap(*(inputs[i]), *(result[i]));
+bool BlobsQueue::tryWriteBlobs(const std::vector<Blob*>& inputs) {
+  const bool written = queue_.tryPush([&](std::vector<Blob*>& result) {
+    for (auto i = 0; i < result.size(); ++i) {
+      using std::swap;
+      swap(*(inputs[i]), *(result[i]));
+    }
+  });
+  if (written) {
+    CAFFE_SDT(
+        queue_write_end,
+        name_.c_str(),
+        (void*)this,
+        queue_.capacity() - queue_.size());
   }
-  CAFFE_SDT(
-      queue_write_end, name, (void*)this, reader_ + queue_.size() - writer_);
-  ++writer_;
-  cv_.notify_all();
+  return written;
 }
 
 } // namespace caffe2
@@ -1,21 +1,20 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
-#include <queue>
 
 #include "caffe2/core/blob_stats.h"
 #include "caffe2/core/logging.h"
 #include "caffe2/core/stats.h"
 #include "caffe2/core/tensor.h"
 #include "caffe2/core/workspace.h"
+#include "caffe2/queue/mpmc_ring_buffer.h"
 
 namespace caffe2 {
 
 // A thread-safe, bounded, blocking queue.
-// Modelled as a circular buffer.
+// Modelled as a lock-free circular buffer: readers and writers only take a
+// lock when they have to wait for the queue to become non-empty or non-full.
 
 // Containing blobs are owned by the workspace.
 // On read, we swap out the underlying data for the blob passed in for blobs
@@ -45,17 +44,17 @@ class CAFFE2_API BlobsQueue : public std::enable_shared_from_this<BlobsQueue> {
   }
 
  private:
-  bool canWrite();
-  void doWrite(const std::vector<Blob*>& inputs);
+  bool tryReadBlobs(const std::vector<Blob*>& inputs);
+  bool tryWriteBlobs(const std::vector<Blob*>& inputs);
 
   std::atomic<bool> closing_{false};
 
   size_t numBlobs_;
-  std::mutex mutex_; // protects all variables in the class.
-  std::condition_variable cv_;
-  int64_t reader_{0};
-  int64_t writer_{0};
-  std::vector<std::vector<Blob*>> queue_;
+  MPMCRingBuffer<std::vector<Blob*>> queue_;
+  // Readers wait on readWaiter_ for the queue to become non-empty, writers
+  // wait on writeWaiter_ for it to become non-full.
+  QueueWaiter readWaiter_;
+  QueueWaiter writeWaiter_;
   const std::string name_;
 
   struct QueueStats {
@@ -65,6 +64,9 @@ class CAFFE2_API BlobsQueue : public std::enable_shared_from_this<BlobsQueue> {
     CAFFE_DETAILED_EXPORTED_STAT(queue_dequeued_bytes);
     CAFFE_AVG_EXPORTED_STAT(read_time_ns);
     CAFFE_AVG_EXPORTED_STAT(write_time_ns);
+    // Time spent blocked on an empty (read) or full (write) queue
+    CAFFE_AVG_EXPORTED_STAT(read_wait_time_ns);
+    CAFFE_AVG_EXPORTED_STAT(write_wait_time_ns);
   } stats_;
 };
 } // namespace caffe2
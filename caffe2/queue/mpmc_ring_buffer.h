@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "caffe2/core/logging.h"
+
+namespace caffe2 {
+
+// A bounded multi-producer multi-consumer ring buffer that doesn't take locks
+// on enqueue or dequeue.
+//
+// Each slot carries a sequence number. A slot at position pos is free for the
+// producer that claims pos when its sequence is pos, and holds a value for the
+// consumer that claims pos when its sequence is pos + 1. Producers and
+// consumers claim positions with a compare-and-swap on the enqueue and dequeue
+// counters, fill or drain the slot in place and then publish it by advancing
+// its sequence, so the values are never copied in or out of the buffer.
+//
+// tryPush() and tryPop() never block. Blocking is layered on top with
+// QueueWaiter below.
+template <typename T>
+class MPMCRingBuffer {
+ public:
+  explicit MPMCRingBuffer(size_t capacity)
+      : capacity_(capacity), slots_(new Slot[capacity]) {
+    CAFFE_ENFORCE_GT(capacity, 0, "Queue capacity must be positive");
+    for (size_t i = 0; i < capacity; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MPMCRingBuffer(const MPMCRingBuffer&) = delete;
+  MPMCRingBuffer& operator=(const MPMCRingBuffer&) = delete;
+
+  // Claims a free slot and calls fill(T&) on it. Returns false if the buffer
+  // is full.
+  template <typename F>
+  bool tryPush(F&& fill) {
+    Slot* slot = claim(enqueuePos_, 0);
+    if (!slot) {
+      return false;
+    }
+    const uint64_t pos = slot->sequence.load(std::memory_order_relaxed);
+    fill(slot->value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Claims a filled slot and calls drain(T&) on it. Returns false if the
+  // buffer is empty.
+  template <typename F>
+  bool tryPop(F&& drain) {
+    Slot* slot = claim(dequeuePos_, 1);
+    if (!slot) {
+      return false;
+    }
+    const uint64_t pos = slot->sequence.load(std::memory_order_relaxed) - 1;
+    drain(slot->value);
+    slot->sequence.store(pos + capacity_, std::memory_order_release);
+    return true;
+  }
+
+  // Number of values in the buffer. Only a snapshot when other threads are
+  // pushing or popping.
+  size_t size() const {
+    const uint64_t dequeued = dequeuePos_.load(std::memory_order_acquire);
+    const uint64_t enqueued = enqueuePos_.load(std::memory_order_acquire);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  // Gives direct access to the slots, e.g. to preallocate the values. Must not
+  // be called concurrently with tryPush() or tryPop().
+  T& slot(size_t i) {
+    return slots_[i].value;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    T value;
+  };
+
+  // Claims the slot at position pos, where the slot is ready when its sequence
+  // is pos + offset. Returns nullptr if the slot at the current position isn't
+  // ready, i.e. the buffer is full (for producers) or empty (for consumers).
+  Slot* claim(std::atomic<uint64_t>& position, uint64_t offset) {
+    uint64_t pos = position.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot* slot = &slots_[pos % capacity_];
+      const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const int64_t diff = static_cast<int64_t>(sequence - (pos + offset));
+      if (diff == 0) {
+        if (position.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          return slot;
+        }
+        // pos was updated by the failed compare-and-swap, retry
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        // Another thread claimed this position, move on to the current one
+        pos = position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  static constexpr size_t kCacheLineSize = 64;
+
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  // Producers and consumers update different counters, keep them on separate
+  // cache lines so that they don't contend
+  char pad0_[kCacheLineSize];
+  std::atomic<uint64_t> enqueuePos_{0};
+  char pad1_[kCacheLineSize - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> dequeuePos_{0};
+  char pad2_[kCacheLineSize - sizeof(std::atomic<uint64_t>)];
+};
+
+// Lets threads sleep until a condition on a lock-free structure may have
+// changed. The mutex is only taken by threads that actually have to wait, and
+// by notifyAll() when somebody is waiting, so the uncontended path of a queue
+// stays lock-free.
+class QueueWaiter {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Waits until ready() returns true, or until the deadline passes when
+  // timed. ready() is called with the mutex held and may have side effects,
+  // e.g. it can be the tryPop() that the caller is waiting to succeed.
+  // Returns the last result of ready().
+  template <typename Ready>
+  bool wait(Ready ready, bool timed = false, Clock::time_point deadline = {}) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiters_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool result = true;
+    if (timed) {
+      result = cv_.wait_until(lock, deadline, ready);
+    } else {
+      cv_.wait(lock, ready);
+    }
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    return result;
+  }
+
+  // Wakes up all the waiting threads. Must be called after the change that
+  // they wait for has been published.
+  void notifyAll() {
+    // Pairs with the fence in wait(): either the waiter sees
+    // the change when it evaluates ready(), or we see the waiter here.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) > 0) {
+      // Taking the mutex guarantees that a waiter that has missed the change
+      // is already blocked in the condition variable.
+      std::lock_guard<std::mutex> g(mutex_);
+      cv_.notify_all();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::atomic<int> waiters_{0};
+};
+
+} // namespace caffe2
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <atomic>
+#include <thread> // NOLINT
+#include <vector>
+
+#include "caffe2/queue/mpmc_ring_buffer.h"
+#include <gtest/gtest.h>
+
+namespace caffe2 {
+
+TEST(MPMCRingBufferTest, FullAndEmpty) {
+  MPMCRingBuffer<int> buffer(3);
+  int value = -1;
+  EXPECT_FALSE(buffer.tryPop([&](int& v) { value = v; }));
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(buffer.tryPush([&](int& v) { v = i; }));
+  }
+  EXPECT_FALSE(buffer.tryPush([](int& v) { v = 3; }));
+  EXPECT_EQ(buffer.size(), 3u);
+
+  // Values come out in order, and slots are reused after wrapping around
+  for (int round = 0; round < 5; ++round) {
+    EXPECT_TRUE(buffer.tryPop([&](int& v) { value = v; }));
+    EXPECT_EQ(value, round);
+    EXPECT_TRUE(buffer.tryPush([&](int& v) { v = round + 3; }));
+  }
+  EXPECT_EQ(buffer.size(), 3u);
+}
+
+TEST(MPMCRingBufferTest, MultipleProducersMultipleConsumers) {
+  const int kNumThreads = 4;
+  const int kNumValuesPerProducer = 10000;
+  MPMCRingBuffer<int> buffer(16);
+  QueueWaiter readWaiter;
+  QueueWaiter writeWaiter;
+  std::atomic<int> numProducersDone{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kNumThreads; ++p) {
+    threads.emplace_back([&, p]() {
+      for (int i = 0; i < kNumValuesPerProducer; ++i) {
+        const int value = p * kNumValuesPerProducer + i;
+        auto push = [&]() {
+          return buffer.tryPush([&](int& v) { v = value; });
+        };
+        if (!push()) {
+          writeWaiter.wait(push);
+        }
+        readWaiter.notifyAll();
+      }
+      ++numProducersDone;
+      readWaiter.notifyAll();
+    });
+  }
+
+  std::vector<std::vector<int>> received(kNumThreads);
+  for (int c = 0; c < kNumThreads; ++c) {
+    threads.emplace_back([&, c]() {
+      for (;;) {
+        bool popped = false;
+        auto pop = [&]() {
+          popped = buffer.tryPop([&](int& v) { received[c].push_back(v); });
+          return popped || numProducersDone == kNumThreads;
+        };
+        if (!pop()) {
+          readWaiter.wait(pop);
+        }
+        if (!popped) {
+          // The producers are done, drain what's left
+          while (buffer.tryPop([&](int& v) { received[c].push_back(v); })) {
+          }
+          return;
+        }
+        writeWaiter.notifyAll();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Every value was received exactly once
+  std::vector<int> all;
+  for (const auto& values : received) {
+    all.insert(all.end(), values.begin(), values.end());
+  }
+  std::sort(all.begin(), all.end());
+  ASSERT_EQ(all.size(), size_t(kNumThreads * kNumValuesPerProducer));
+  for (size_t i = 0; i < all.size(); ++i) {
+    EXPECT_EQ(all[i], static_cast<int>(i));
+  }
+}
+
+TEST(QueueWaiterTest, Timeout) {
+  QueueWaiter waiter;
+  const auto deadline =
+      QueueWaiter::Clock::now() + std::chrono::milliseconds(10);
+  EXPECT_FALSE(waiter.wait([]() { return false; }, true, deadline));
+  EXPECT_TRUE(waiter.wait([]() { return true; }, true, deadline));
+}
+
+} // namespace caffe2
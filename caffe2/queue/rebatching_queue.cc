@@ -1,209 +1,237 @@
 #include "rebatching_queue.h"
-#include "caffe2/utils/smart_tensor_printer.h"
+#include "caffe2/core/timer.h"
 
 namespace caffe2 {
 
 namespace {
 
-// This concat function will always create a new first dimension to concat
-void concat(
+using Row = RebatchingQueue::Row;
+
+// This concat function will always create a new first dimension to concat.
+// Returns true if it shared the data of an enqueued batch instead of copying.
+bool concat(
     CPUContext& context,
-    const std::vector<std::vector<TensorCPU>>& inputs,
+    const std::vector<Row>& rows,
     const std::vector<TensorCPU*>& outputs) {
-  CAFFE_ENFORCE(!inputs.empty());
-
-  const auto& inputZero = inputs[0];
-  const auto numTensors = inputZero.size();
-  const auto numRows = inputs.size();
+  CAFFE_ENFORCE(!rows.empty());
+
+  const auto& batchZero = *rows[0].batch;
+  const auto numTensors = batchZero.size();
+  const auto numRows = rows.size();
+  CAFFE_ENFORCE_EQ(outputs.size(), numTensors);
+
+  // If the rows are exactly one enqueued batch, share its data. The queue
+  // doesn't reference the batch anymore, so nobody else can modify it.
+  bool isWholeBatch = numTensors > 0 && batchZero[0].size(0) == numRows;
+  for (size_t i = 0; isWholeBatch && i < numRows; ++i) {
+    isWholeBatch =
+        rows[i].batch == rows[0].batch && rows[i].index == static_cast<int64_t>(i);
+  }
+  if (isWholeBatch) {
+    for (size_t j = 0; j < numTensors; ++j) {
+      outputs[j]->Resize(batchZero[j].sizes());
+      outputs[j]->ShareData(batchZero[j]);
+    }
+    return true;
+  }
 
   // Precompute the output sizes to avoid resizing
   std::vector<std::vector<int64_t>> outputDims(numTensors);
 
   for (size_t i = 0; i < numTensors; ++i) {
-    SmartTensorPrinter::PrintTensor(inputZero.at(i));
-    outputDims[i] = inputZero.at(i).sizes().vec();
-    outputDims[i].insert(outputDims[i].begin(), numRows);
+    outputDims[i] = batchZero.at(i).sizes().vec();
+    outputDims[i][0] = numRows;
   }
 
   // Resize to the final output size
   std::vector<void*> destinations(numTensors);
   for (size_t i = 0; i < numTensors; ++i) {
     outputs[i]->Resize(outputDims[i]);
-    destinations[i] = outputs[i]->raw_mutable_data(inputZero[i].meta());
+    destinations[i] = outputs[i]->raw_mutable_data(batchZero[i].meta());
   }
 
-  for (size_t i = 0; i < numRows; ++i) {
-    CAFFE_ENFORCE_EQ(inputs[i].size(), numTensors);
+  // Copy each run of consecutive rows of the same batch at once
+  size_t begin = 0;
+  while (begin < numRows) {
+    size_t end = begin + 1;
+    while (end < numRows && rows[end].batch == rows[begin].batch &&
+           rows[end].index == rows[end - 1].index + 1) {
+      ++end;
+    }
+
+    const auto& batch = *rows[begin].batch;
+    CAFFE_ENFORCE_EQ(batch.size(), numTensors);
 
     for (int j = 0; j < numTensors; ++j) {
-      const auto& input = inputs[i][j];
+      const auto& input = batch[j];
 
-      CAFFE_ENFORCE(inputZero[j].meta() == input.dtype());
-      CAFFE_ENFORCE_EQ(inputZero[j].itemsize(), input.itemsize());
-      CAFFE_ENFORCE_EQ(inputZero[j].ndim(), input.dim());
-      for (int k = 0; k < input.dim(); ++k) {
-        CAFFE_ENFORCE_EQ(input.sizes()[k], inputZero[j].size(k));
+      CAFFE_ENFORCE(batchZero[j].meta() == input.dtype());
+      CAFFE_ENFORCE_EQ(batchZero[j].itemsize(), input.itemsize());
+      CAFFE_ENFORCE_EQ(batchZero[j].ndim(), input.dim());
+      for (int k = 1; k < input.dim(); ++k) {
+        CAFFE_ENFORCE_EQ(input.sizes()[k], batchZero[j].size(k));
       }
 
+      const auto innerSize = input.size_from_dim(1);
+      const auto numItems = (end - begin) * innerSize;
       // Skip empty tensors
-      if (input.numel() == 0) {
+      if (numItems == 0) {
         continue;
       }
 
       context.CopyItemsToCPU(
           input.dtype(),
-          input.numel(),
-          input.raw_data() /* src */,
+          numItems,
+          (const char*)input.raw_data() +
+              rows[begin].index * innerSize * input.itemsize() /* src */,
           destinations[j] /* dst */
       );
 
-      destinations[j] =
-          (char*)destinations[j] + input.numel() * input.itemsize();
+      destinations[j] = (char*)destinations[j] + numItems * input.itemsize();
     }
+    begin = end;
   }
-}
-
-std::vector<std::vector<TensorCPU>> split(
-    CPUContext& context,
-    const std::vector<const TensorCPU*>& inputs) {
-  CAFFE_ENFORCE(!inputs.empty());
-
-  const auto outputSize = inputs[0]->sizes().at(0);
-  std::vector<std::vector<TensorCPU>> outputs(outputSize);
-
-  for (const auto* inputPtr : inputs) {
-    CAFFE_ENFORCE(inputPtr);
-
-    const auto& input = *inputPtr;
-    const auto innerSize = input.size_from_dim(1);
-    const auto itemSize = input.dtype().itemsize();
-
-    auto outputDims = input.sizes().vec();
-    CAFFE_ENFORCE(!outputDims.empty());
-    outputDims.erase(outputDims.begin());
-    CAFFE_ENFORCE_EQ(input.sizes().at(0), outputSize);
-
-    for (int i = 0; i < outputSize; ++i) {
-      outputs[i].push_back(Tensor(outputDims, CPU));
-      context.CopyItemsToCPU(
-          input.dtype(),
-          innerSize,
-          (char*)input.raw_data() + i * innerSize * itemSize /* src */,
-          outputs[i].back().raw_mutable_data(input.dtype()) /* dst */);
-    }
-  }
-
-  return outputs;
+  return false;
 }
 } // anonymous namespace
 
-RebatchingQueue::RebatchingQueue(size_t capacity, size_t numBlobs)
-    : capacity_(capacity), numBlobs_(numBlobs), queue_(capacity) {}
+RebatchingQueue::RebatchingQueue(
+    size_t capacity,
+    size_t numBlobs,
+    const std::string& name)
+    : capacity_(capacity),
+      numBlobs_(numBlobs),
+      queue_(capacity),
+      stats_(name) {}
 
 RebatchingQueue::~RebatchingQueue() {
   close();
 }
 
-bool RebatchingQueue::canRead() const {
-  return tail_ < head_;
-}
-
 bool RebatchingQueue::dequeue(
     CPUContext& context,
     size_t numElements,
     const std::vector<TensorCPU*>& outputs) {
-  std::vector<std::vector<TensorCPU>> results;
+  std::vector<Row> results;
   results.reserve(numElements);
 
+  auto tryDequeueRow = [&]() {
+    return queue_.tryPop([&](Row& row) { results.push_back(std::move(row)); });
+  };
+
   for (;;) {
+    const auto numDequeued = results.size();
+    while (results.size() < numElements && tryDequeueRow()) {
+    }
+    if (results.size() > numDequeued) {
+      writeWaiter_.notifyAll();
+    }
     if (results.size() == numElements) {
       break;
     }
 
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-
-      cvEmpty_.wait(lock, [this] { return canRead() || isClosed_; });
-
-      // We only want to stop reading if the queue is empty and closed
-      if (!canRead() && isClosed_) {
-        break;
-      }
-
-      do {
-        results.push_back(std::move(queue_[tail_++ % capacity()]));
-      } while (canRead() && results.size() < numElements);
-    }
+    Timer waitTimer;
+    bool dequeued = false;
+    readWaiter_.wait([&]() {
+      dequeued = tryDequeueRow();
+      return dequeued || isClosed_;
+    });
+    CAFFE_EVENT(stats_, dequeue_wait_time_ns, waitTimer.NanoSeconds());
 
-    if (numElements == 1) {
-      cvOverflow_.notify_one();
-    } else {
-      cvOverflow_.notify_all();
+    // We only want to stop reading if the queue is empty and closed
+    if (!dequeued) {
+      break;
     }
+    writeWaiter_.notifyAll();
   }
 
   if (results.empty()) {
     return false;
   }
 
-  concat(context, results, outputs);
+  CAFFE_EVENT(stats_, dequeued_rows, results.size());
+  if (concat(context, results, outputs)) {
+    CAFFE_EVENT(stats_, zero_copy_dequeues);
+  }
 
   return true;
 }
 
-bool RebatchingQueue::canWrite() const {
-  return tail_ + capacity() > head_;
-}
-
 bool RebatchingQueue::enqueueOne(
     CPUContext& /*context*/,
     const std::vector<const TensorCPU*>& inputs) {
-  std::vector<std::vector<TensorCPU>> splittedInputs;
-  splittedInputs.emplace_back();
-  auto& tensorVector = splittedInputs.back();
-  tensorVector.reserve(inputs.size());
+  auto batch = std::make_shared<std::vector<TensorCPU>>();
+  batch->reserve(inputs.size());
   for (const auto* tensorPtr : inputs) {
-    tensorVector.push_back(tensorPtr->Clone());
+    batch->push_back(tensorPtr->Clone());
+    // Enqueue the inputs as a batch of one row
+    auto dims = tensorPtr->sizes().vec();
+    dims.insert(dims.begin(), 1);
+    batch->back().Reshape(dims);
   }
 
-  return enqueue(std::move(splittedInputs));
+  return enqueue(std::move(batch));
 }
 
 bool RebatchingQueue::enqueueMany(
-    CPUContext& context,
+    CPUContext& /*context*/,
     const std::vector<const TensorCPU*>& inputs) {
   CAFFE_ENFORCE_EQ(numBlobs_, inputs.size());
+  CAFFE_ENFORCE(!inputs.empty());
 
-  std::vector<std::vector<TensorCPU>> splittedInputs;
-  splittedInputs = split(context, inputs);
-  return enqueue(std::move(splittedInputs));
+  const auto batchSize = inputs[0]->sizes().at(0);
+  auto batch = std::make_shared<std::vector<TensorCPU>>();
+  batch->reserve(inputs.size());
+  for (const auto* inputPtr : inputs) {
+    CAFFE_ENFORCE(inputPtr);
+    CAFFE_ENFORCE_GT(inputPtr->dim(), 0);
+    CAFFE_ENFORCE_EQ(inputPtr->sizes().at(0), batchSize);
+    // A single copy of the batch, shared by its rows
+    batch->push_back(inputPtr->Clone());
+  }
+
+  return enqueue(std::move(batch));
 }
 
 bool RebatchingQueue::enqueue(
-    std::vector<std::vector<TensorCPU>> splittedInputs) {
-  int idx = 0;
-  for (;;) {
-    if (idx >= splittedInputs.size()) {
-      break;
+    std::shared_ptr<const std::vector<TensorCPU>> batch) {
+  const int64_t numRows = batch->empty() ? 1 : (*batch)[0].size(0);
+  int64_t idx = 0;
+
+  auto tryEnqueueRow = [&]() {
+    if (queue_.tryPush([&](Row& row) {
+          row.batch = batch;
+          row.index = idx;
+        })) {
+      ++idx;
+      return true;
     }
+    return false;
+  };
 
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-
-      cvOverflow_.wait(lock, [this] { return canWrite() || isClosed_; });
-
-      if (isClosed_) {
-        // If we are here it means that we didn't apply the entire batch and if
-        // we get closed in the middle of enquing we treat it as a non-success.
-        return false;
-      }
+  // Rows that readers have been notified about
+  int64_t numAnnounced = 0;
+  for (;;) {
+    if (isClosed_) {
+      // If we are here it means that we didn't apply the entire batch and if
+      // we get closed in the middle of enquing we treat it as a non-success.
+      return false;
+    }
 
-      do {
-        queue_[head_++ % capacity()] = std::move(splittedInputs[idx++]);
-      } while (canWrite() && idx < splittedInputs.size());
+    while (idx < numRows && tryEnqueueRow()) {
+    }
+    if (idx > numAnnounced) {
+      CAFFE_EVENT(stats_, enqueued_rows, idx - numAnnounced);
+      numAnnounced = idx;
+      readWaiter_.notifyAll();
+    }
+    if (idx == numRows) {
+      break;
     }
 
-    cvEmpty_.notify_all();
+    Timer waitTimer;
+    writeWaiter_.wait([&]() { return isClosed_ || tryEnqueueRow(); });
+    CAFFE_EVENT(stats_, enqueue_wait_time_ns, waitTimer.NanoSeconds());
   }
 
   return true;
@@ -218,17 +246,13 @@ size_t RebatchingQueue::numBlobs() const {
 }
 
 bool RebatchingQueue::isClosed() const {
-  std::lock_guard<std::mutex> g(mutex_);
   return isClosed_;
 }
 
 void RebatchingQueue::close() {
-  {
-    std::lock_guard<std::mutex> g(mutex_);
-    isClosed_ = true;
-  }
+  isClosed_ = true;
 
-  cvEmpty_.notify_all();
-  cvOverflow_.notify_all();
+  readWaiter_.notifyAll();
+  writeWaiter_.notifyAll();
 }
 } // caffe2
@@ -1,25 +1,27 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
-#include <queue>
 
 #include "caffe2/core/logging.h"
 #include "caffe2/core/operator.h"
 #include "caffe2/core/stats.h"
 #include "caffe2/core/tensor.h"
+#include "caffe2/queue/mpmc_ring_buffer.h"
 
 namespace caffe2 {
 
-// TODO: This is a very naive implementation with a single mutex. We can do the
-// atomic index + circular queue optimizations or pull something more
-// heavy-weight later
+// A queue of rows that can be enqueued one at a time or as batches, and
+// dequeued as batches of a different size.
+//
+// The rows live in a lock-free ring buffer. Enqueueing a batch copies it once
+// and the rows of the batch share that copy, so rebatching only copies each
+// run of consecutive rows once, and a dequeue that takes exactly the rows of
+// one enqueued batch shares its data instead of copying it.
 
 class RebatchingQueue {
  public:
-  RebatchingQueue(size_t capacity, size_t numBlobs);
+  RebatchingQueue(size_t capacity, size_t numBlobs, const std::string& name);
 
   ~RebatchingQueue();
 
@@ -44,25 +46,35 @@ class RebatchingQueue {
 
   void close();
 
- private:
-  bool enqueue(std::vector<std::vector<TensorCPU>> splittedInputs);
+  // A row of an enqueued batch: the row index along the first dimension of
+  // the batch's tensors.
+  struct Row {
+    std::shared_ptr<const std::vector<TensorCPU>> batch;
+    int64_t index{0};
+  };
 
-  bool canWrite() const;
-  bool canRead() const;
+ private:
+  bool enqueue(std::shared_ptr<const std::vector<TensorCPU>> batch);
 
   const size_t capacity_;
   const size_t numBlobs_;
 
-  mutable std::mutex mutex_;
-
-  bool isClosed_{false};
+  std::atomic<bool> isClosed_{false};
 
-  uint64_t head_{0};
-  uint64_t tail_{0};
+  MPMCRingBuffer<Row> queue_;
 
-  std::condition_variable cvEmpty_;
-  std::condition_variable cvOverflow_;
+  // Readers wait on readWaiter_ for rows to be enqueued, writers wait on
+  // writeWaiter_ for rows to be dequeued.
+  QueueWaiter readWaiter_;
+  QueueWaiter writeWaiter_;
 
-  std::vector<std::vector<TensorCPU>> queue_;
+  struct QueueStats {
+    CAFFE_STAT_CTOR(QueueStats);
+    CAFFE_EXPORTED_STAT(enqueued_rows);
+    CAFFE_EXPORTED_STAT(dequeued_rows);
+    CAFFE_EXPORTED_STAT(zero_copy_dequeues);
+    CAFFE_AVG_EXPORTED_STAT(enqueue_wait_time_ns);
+    CAFFE_AVG_EXPORTED_STAT(dequeue_wait_time_ns);
+  } stats_;
 };
 } // caffe2
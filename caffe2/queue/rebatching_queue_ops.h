@@ -9,15 +9,19 @@ using RebatchingQueuePtr = std::unique_ptr<RebatchingQueue>;
 class CreateRebatchingQueueOp : public Operator<CPUContext> {
  public:
   CreateRebatchingQueueOp(const OperatorDef& operator_def, Workspace* ws)
-      : Operator(operator_def, ws) {}
+      : Operator(operator_def, ws), name_(operator_def.output(0)) {}
 
   bool RunOnDevice() override {
     *OperatorBase::Output<RebatchingQueuePtr>(0) =
         RebatchingQueuePtr(new RebatchingQueue(
             OperatorBase::GetSingleArgument<int>("capacity", 1),
-            OperatorBase::GetSingleArgument<int>("num_blobs", 1)));
+            OperatorBase::GetSingleArgument<int>("num_blobs", 1),
+            name_));
     return true;
   }
+
+ private:
+  const std::string name_;
 };
 
 class EnqueueRebatchingQueueOp : public Operator<CPUContext> {
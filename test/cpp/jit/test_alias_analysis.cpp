@@ -1348,5 +1348,46 @@ void testAliasRegistration() {
   }
 }
 
+void testAliasDbTryMove() {
+  {
+    // Moves of nodes without dependencies, and moves that must be rejected
+    auto graph = std::make_shared<Graph>();
+    std::unordered_map<std::string, Value*> vmap;
+    parseIR(
+        R"IR(
+  graph(%x : Tensor, %y : Tensor):
+    %a : Tensor = aten::mul(%x, %x)
+    %b : Tensor = aten::mul(%y, %y)
+    %w : Tensor = aten::relu_(%b)
+    %c : Tensor = aten::mul(%a, %a)
+    %e : Tensor = aten::mul(%b, %b)
+    %d : Tensor = aten::mul(%c, %e)
+    return (%d)
+    )IR",
+        &*graph,
+        vmap);
+    AliasDb aliasDb(graph);
+    auto a = vmap["a"]->node();
+    auto b = vmap["b"]->node();
+    auto w = vmap["w"]->node();
+    auto c = vmap["c"]->node();
+    auto e = vmap["e"]->node();
+    auto d = vmap["d"]->node();
+    // `e` reads %b, which `w` writes to
+    ASSERT_FALSE(aliasDb.moveBeforeTopologicallyValid(e, w));
+    // `c` uses `a`, and `d` uses `c`
+    ASSERT_FALSE(aliasDb.moveBeforeTopologicallyValid(c, a));
+    ASSERT_FALSE(aliasDb.moveAfterTopologicallyValid(c, d));
+    // `a` has no dependency with `b` and `w`
+    ASSERT_TRUE(aliasDb.moveAfterTopologicallyValid(a, w));
+    ASSERT_EQ(a->prev(), w);
+    ASSERT_EQ(a->next(), c);
+    ASSERT_TRUE(aliasDb.moveBeforeTopologicallyValid(a, b));
+    ASSERT_EQ(a->next(), b);
+    ASSERT_EQ(b->next(), w);
+    graph->lint();
+  }
+}
+
 } // namespace jit
 } // namespace torch
@@ -92,6 +92,64 @@ void testBlocks() {
       ->run(*g2);
 }
 
+void testIRArena() {
+  {
+    IRArena arena;
+    void* a = arena.allocate(40);
+    void* b = arena.allocate(40);
+    ASSERT_NE(a, b);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(a) % alignof(std::max_align_t), 0);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(b) % alignof(std::max_align_t), 0);
+    arena.deallocate(a, 40);
+    // freed memory is only reused for objects of the same size
+    void* c = arena.allocate(200);
+    ASSERT_NE(c, a);
+    ASSERT_EQ(arena.allocate(40), a);
+    const size_t reserved = arena.reservedBytes();
+    arena.deallocate(c, 200);
+    ASSERT_EQ(arena.allocate(200), c);
+    ASSERT_EQ(arena.reservedBytes(), reserved);
+    // larger than a chunk
+    void* big = arena.allocate(4 * 1024 * 1024);
+    ASSERT_NE(big, nullptr);
+    ASSERT_GE(arena.reservedBytes(), reserved + 4 * 1024 * 1024);
+  }
+
+  // Nodes, Values and Blocks created and destroyed in rounds
+  auto g = std::make_shared<Graph>();
+  Value* x = g->addInput("x");
+  Value* cond = g->addInput("cond");
+  for (int round = 0; round < 5; round++) {
+    std::vector<Node*> nodes;
+    Value* last = x;
+    for (int i = 0; i < 1000; i++) {
+      Node* n = g->insertNode(g->create(aten::relu, {last}));
+      last = n->output();
+      nodes.push_back(n);
+      if (i % 100 == 0) {
+        Node* if_node = g->insertNode(g->create(prim::If, {cond}, 1));
+        for (int b = 0; b < 2; b++) {
+          Block* block = if_node->addBlock();
+          WithInsertPoint guard(block);
+          block->registerOutput(g->insertNode(g->create(aten::neg, {last}))->output());
+        }
+        last = if_node->output();
+        nodes.push_back(if_node);
+      }
+    }
+    g->registerOutput(last);
+    g->lint();
+    auto copy = g->copy();
+    copy->lint();
+    g->eraseOutput(0);
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+      (*it)->destroy();
+    }
+    g->lint();
+  }
+  ASSERT_EQ(g->nodes().begin(), g->nodes().end());
+}
+
 void testCommonAncestor() {
   std::string input_str = R"(
 graph(%x : Tensor,
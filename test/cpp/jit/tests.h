@@ -39,7 +39,9 @@ namespace jit {
   _(WriteTracking)                     \
   _(Wildcards)                         \
   _(MemoryDAG)                         \
+  _(AliasDbTryMove)                    \
   _(IRParser)                          \
+  _(IRArena)                           \
   _(ConstantPooling)                   \
   _(THNNConv)                          \
   _(ATenNativeBatchNorm)               \
@@ -23,6 +23,8 @@ from torch.quantization import (
     per_channel_dynamic_qconfig,
     default_eval_fn,
     float16_dynamic_qconfig,
+    int4_dynamic_qconfig,
+    Int4GroupObserver,
     default_observer,
     default_weight_observer,
     default_per_channel_weight_observer,
@@ -488,6 +490,33 @@ class TestPostTrainingDynamic(QuantizationTestCase):
             quantize_dynamic(model, set([nn.Linear]), inplace=True, dtype=dtype)
             checkQuantized(model)
 
+    def test_int4_linear(self):
+        r"""4-bit weights with a scale per group of input features, through quantize_dynamic
+        """
+        model = nn.Sequential(nn.Linear(64, 8), nn.ReLU(), nn.Linear(8, 4)).eval()
+        data = [(torch.randn(3, 64), 0)]
+        qconfig_spec = {'0': int4_dynamic_qconfig._replace(
+            weight=Int4GroupObserver.with_args(group_size=32))}
+        qmodel = quantize_dynamic(model, qconfig_spec)
+        self.checkDynamicQuantizedLinear(qmodel[0], dtype=torch.qint8)
+        self.assertEqual(type(qmodel[2]), nn.Linear)
+        weight, bias = qmodel[0]._weight_bias()
+        self.assertEqual(weight.shape, (8, 2, 32))
+        self.assertEqual(bias, model[0].bias)
+        self.assertIn('group_size=32', repr(qmodel[0]))
+        ref = torch.nn.functional.linear(data[0][0], weight.flatten(1), bias)
+        self.assertEqual(qmodel(data[0][0]), model[2](model[1](ref)))
+
+        # state_dict and TorchScript serialization keep the packing
+        qmodel2 = quantize_dynamic(copy.deepcopy(model), qconfig_spec)
+        qmodel2.load_state_dict(qmodel.state_dict())
+        self.assertEqual(qmodel2(data[0][0]), qmodel(data[0][0]))
+        self.checkScriptable(qmodel, data, check_save_load=True)
+
+        # Layers whose input features aren't a multiple of the group size can't use it
+        with self.assertRaisesRegex(AssertionError, "multiple of the group size"):
+            quantize_dynamic(model, {'2': qconfig_spec['0']})
+
     def test_two_layers(self):
         r"""TwoLayerLinearModel has two Linear modules but we only quantize the second one
         `fc2`, and `fc1`is not quantized
@@ -348,6 +348,62 @@ graph(%input, %weight):
             torch._C._jit_pass_fuse_linear(graph)
             FileCheck().run(input_str, graph)
 
+    def test_fuse_quantized_elementwise(self):
+        input_strs = ["""
+graph(%a, %b, %c, %scale : float, %zero_point : int):
+    # CHECK-NOT: quantized::add(
+    # CHECK-NOT: aten::relu
+    # CHECK-NOT: quantized::hardswish
+    # CHECK-NOT: aten::hardtanh
+    # CHECK: quantized::elementwise
+    # CHECK: quantized::mul(
+    %min : float = prim::Constant[value=0.]()
+    %max : float = prim::Constant[value=6.]()
+    %x = quantized::add(%a, %b, %scale, %zero_point)
+    %x_relu = aten::relu(%x)
+    %y = quantized::hardswish(%x_relu, %scale, %zero_point)
+    %z = aten::hardtanh(%y, %min, %max)
+    %r = quantized::mul(%z, %c, %scale, %zero_point)
+    return (%r)""", """
+graph(%a, %packed_params : __torch__.torch.classes.quantized.LinearPackedParamsBase, %scale : float, %zero_point : int):
+    # CHECK-NOT: aten::relu_
+    # CHECK: quantized::linear_relu
+    %x = quantized::linear(%a, %packed_params, %scale, %zero_point)
+    %r = aten::relu_(%x)
+    return (%r)""", """
+graph(%a, %b, %c, %scale : float, %zero_point : int):
+    # CHECK-NOT: quantized::add_relu
+    # CHECK-NOT: quantized::hardswish
+    # CHECK: quantized::elementwise
+    # CHECK-NOT: quantized::mul(
+    # CHECK-NOT: quantized::hardswish
+    # CHECK: quantized::elementwise
+    # CHECK-NOT: quantized::hardswish
+    %x = quantized::add_relu(%a, %b, %scale, %zero_point)
+    %y = quantized::hardswish(%x, %scale, %zero_point)
+    %z = quantized::mul(%y, %c, %scale, %zero_point)
+    %r = quantized::hardswish(%z, %scale, %zero_point)
+    return (%r)""", """
+graph(%a, %scale : float, %zero_point : int):
+    # CHECK-NOT: quantized::elementwise
+    # CHECK: quantized::hardswish
+    # CHECK: aten::relu
+    %x = quantized::hardswish(%a, %scale, %zero_point)
+    %r = aten::relu(%x)
+    return (%x, %r)""", """
+graph(%a, %scale : float, %zero_point : int):
+    # CHECK-NOT: quantized::elementwise
+    # CHECK: quantized::hardswish
+    # CHECK: aten::clamp
+    %min : float = prim::Constant[value=0.]()
+    %x = quantized::hardswish(%a, %scale, %zero_point)
+    %r = aten::clamp(%x, %min, %scale)
+    return (%r)"""]
+        for input_str in input_strs:
+            graph = parse_ir(input_str)
+            torch._C._jit_pass_quant_fuse_elementwise(graph)
+            FileCheck().run(input_str, graph)
+
     def test_insert_observers(self):
         class M(torch.nn.Module):
             def __init__(self):
@@ -1124,10 +1180,11 @@ class TestQuantizeScriptPTSQOps(QuantizationTestCase):
     """ Test graph mode post training static quantization works
     for individual ops end to end.
     """
-    def _test_op_impl(self, module, data, quantized_op, debug=False):
+    def _test_op_impl(self, module, data, quantized_op, debug=False, fuse_elementwise=False):
         qconfig_dict = {'': get_default_qconfig(torch.backends.quantized.engine)}
         model = torch.jit.script(module).eval()
-        model = quantize_script(model, qconfig_dict, _test_only_eval_fn, [data], inplace=False)
+        model = quantize_script(model, qconfig_dict, _test_only_eval_fn, [data], inplace=False,
+                                fuse_elementwise=fuse_elementwise)
         if debug:
             print(model.graph)
         FileCheck().check(quantized_op) \
@@ -1965,6 +2022,53 @@ class TestQuantizeScriptPTSQOps(QuantizationTestCase):
         FileCheck().check_not("aten::hardswish") \
                    .run(m.graph)
 
+    def test_quantized_elementwise(self):
+        class M(torch.nn.Module):
+            def __init__(self):
+                super(M, self).__init__()
+                self.conv1 = torch.nn.Conv2d(3, 3, 3).float()
+                self.conv2 = torch.nn.Conv2d(3, 3, 3).float()
+                self.hardswish = torch.nn.Hardswish()
+
+            def forward(self, x, y):
+                x = self.conv1(x)
+                y = self.conv2(y)
+                x = self.hardswish(x + y)
+                return F.relu6(x)
+
+        data = [(torch.rand((1, 3, 10, 10), dtype=torch.float),
+                 torch.rand((1, 3, 10, 10), dtype=torch.float),
+                 torch.randint(0, 1, (1,), dtype=torch.long)) for _ in range(2)]
+        m = self._test_op_impl(M(), data, "quantized::elementwise", fuse_elementwise=True)
+        FileCheck().check_not("quantized::add(") \
+                   .check_not("quantized::hardswish") \
+                   .check_not("aten::hardtanh") \
+                   .run(m.graph)
+        # The fusion is off by default
+        m_unfused = self._test_op_impl(M(), data, "quantized::hardswish")
+        FileCheck().check_not("quantized::elementwise") \
+                   .run(m_unfused.graph)
+        # Matches running the ops one by one up to rounding
+        qconfig_dict = {'': get_default_qconfig(torch.backends.quantized.engine)}
+        m_debug = quantize_script(torch.jit.script(M()).eval(), qconfig_dict, _test_only_eval_fn,
+                                  [data], inplace=False, debug=True)
+        x, y, _ = data[0]
+        self.assertEqual(m(x, y), m_debug(x, y), atol=0.1, rtol=0)
+
+    def test_quantized_linear_relu(self):
+        class M(torch.nn.Module):
+            def __init__(self):
+                super(M, self).__init__()
+                self.fc = torch.nn.Linear(5, 5).float()
+
+            def forward(self, x):
+                return F.relu(self.fc(x))
+
+        data = [(torch.rand((1, 5), dtype=torch.float), torch.randint(0, 1, (1,), dtype=torch.long)) for _ in range(2)]
+        m = self._test_op_impl(M(), data, "quantized::linear_relu", fuse_elementwise=True)
+        FileCheck().check_not("aten::relu") \
+                   .run(m.graph)
+
     def test_layer_norm(self):
         data = [(torch.rand((1, 3, 10, 10), dtype=torch.float), torch.randint(0, 1, (1,), dtype=torch.long)) for _ in range(2)]
         layer_norm = torch.nn.LayerNorm([3, 10, 10])
@@ -714,6 +714,59 @@ class TestQuantizedOps(TestCase):
 
                 self.assertEqual(C_ref, qC_hat.dequantize())
 
+    """Tests the correctness of the fused elementwise op against running its ops one by one."""
+    def test_qelementwise(self):
+        elementwise = torch.ops.quantized.elementwise
+        A = torch.randn(2, 3, 8, 8) * 3
+        B = torch.randn(2, 3, 8, 8) * 3
+        for dtype, zero_point in [(torch.quint8, 130), (torch.qint8, 2)]:
+            qA = torch.quantize_per_tensor(A, 0.05, zero_point, dtype)
+            qB = torch.quantize_per_tensor(B, 0.04, zero_point - 2, dtype)
+            cases = [
+                # ops, args, (scales, zero_points), ops run one by one
+                (["add", "hardswish", "relu"], [], ([0.06, 0.03], [zero_point, zero_point - 5]),
+                 lambda: torch.relu(torch.ops.quantized.hardswish(
+                     torch.ops.quantized.add(qA, qB, 0.06, zero_point), 0.03, zero_point - 5))),
+                (["relu", "clamp", "clamp"], [-1., 2., 0.5, 10.], ([], []),
+                 lambda: torch.clamp(torch.clamp(torch.relu(qA), -1., 2.), 0.5, 10.)),
+                (["mul", "relu", "clamp"], [0., 3.], ([0.1], [zero_point]),
+                 lambda: torch.clamp(torch.ops.quantized.mul_relu(qA, qB, 0.1, zero_point), 0., 3.)),
+                # The second input can come in the middle of the chain
+                (["hardswish", "add"], [], ([0.02, 0.05], [zero_point, zero_point]),
+                 lambda: torch.ops.quantized.add(
+                     torch.ops.quantized.hardswish(qA, 0.02, zero_point), qB, 0.05, zero_point)),
+            ]
+            for ops, args, (scales, zero_points), unfused in cases:
+                qB_or_none = qB if "add" in ops or "mul" in ops else None
+                qC = elementwise(qA, qB_or_none, ops, args, scales, zero_points)
+                qC_ref = unfused()
+                self.assertEqual(qC.q_scale(), qC_ref.q_scale())
+                self.assertEqual(qC.q_zero_point(), qC_ref.q_zero_point())
+                # The fused op doesn't round the values between the ops
+                self.assertEqual(qC.int_repr().int(), qC_ref.int_repr().int(), atol=2, rtol=0,
+                                 message="quantized::elementwise {} failed".format(ops))
+
+            # Channels last inputs stay channels last
+            qA_nhwc = qA.contiguous(memory_format=torch.channels_last)
+            qC = elementwise(qA_nhwc, None, ["hardswish"], [], [0.03], [zero_point])
+            self.assertTrue(qC.is_contiguous(memory_format=torch.channels_last))
+            qC_ref = torch.ops.quantized.hardswish(qA, 0.03, zero_point)
+            self.assertEqual(qC.int_repr().int(), qC_ref.int_repr().int(), atol=1, rtol=0)
+
+            # Same size checks as the ops it replaces: mul broadcasts, add only
+            # takes inputs with as many elements
+            qB_row = torch.quantize_per_tensor(torch.randn(8) * 3, 0.04, zero_point, dtype)
+            qC = elementwise(qA, qB_row, ["mul"], [], [0.1], [zero_point])
+            qC_ref = torch.ops.quantized.mul(qA, qB_row, 0.1, zero_point)
+            self.assertEqual(qC.int_repr().int(), qC_ref.int_repr().int(), atol=1, rtol=0)
+            with self.assertRaisesRegex(RuntimeError, "same number of elements"):
+                elementwise(qA, qB_row, ["add"], [], [0.1], [zero_point])
+
+        with self.assertRaisesRegex(RuntimeError, "one add or mul"):
+            elementwise(qA, None, ["add"], [], [0.1], [0])
+        with self.assertRaisesRegex(RuntimeError, "unsupported op"):
+            elementwise(qA, None, ["tanh"], [], [], [])
+
     """Tests the correctness of the mul and mul_relu op."""
     def test_qmul_relu_different_qparams(self):
         for dtype in [torch.quint8, torch.qint8, torch.qint32]:
@@ -2137,6 +2190,49 @@ class TestDynamicQuantizedLinear(TestCase):
         self.assertEqual(Y_fp32, Y_fp32_ref,
                          message="torch.ops.quantized.fbgemm_linear_dynamic results are off")
 
+    @given(
+        batch_size=st.integers(1, 4),
+        group_size=st.sampled_from([16, 32, 64]),
+        num_groups=st.integers(1, 3),
+        output_channels=st.integers(1, 8),
+        use_bias=st.booleans(),
+        use_relu=st.booleans(),
+        use_multi_dim_input=st.booleans())
+    def test_qlinear_int4(self, batch_size, group_size, num_groups, output_channels,
+                          use_bias, use_relu, use_multi_dim_input):
+        input_channels = group_size * num_groups
+        W = torch.randn(output_channels, input_channels)
+        b = torch.randn(output_channels) if use_bias else None
+        W_prepack = torch.ops.quantized.linear_prepack_int4(W, b, group_size)
+
+        # The weight is unpacked dequantized and grouped
+        W_unpacked, b_unpacked = torch.ops.quantized.linear_unpack_int4(W_prepack)
+        self.assertEqual(W_unpacked.shape, (output_channels, num_groups, group_size))
+        self.assertEqual(b_unpacked, b)
+        W_grouped = W.view(output_channels, num_groups, group_size)
+        scales = W_grouped.abs().max(-1, keepdim=True)[0] / 7
+        self.assertTrue(((W_unpacked - W_grouped).abs() <= scales / 2 + 1e-6).all())
+        # Packing the unpacked weight again doesn't lose anything
+        W_repacked, _ = torch.ops.quantized.linear_unpack_int4(
+            torch.ops.quantized.linear_prepack_int4(W_unpacked.flatten(1), b, group_size))
+        self.assertEqual(W_repacked, W_unpacked)
+
+        if use_multi_dim_input:
+            X = torch.randn(batch_size, 3, input_channels)
+        else:
+            X = torch.randn(batch_size, input_channels)
+        if use_relu:
+            Y = torch.ops.quantized.linear_relu_dynamic(X, W_prepack)
+            Y_ref = F.relu(F.linear(X, W_unpacked.flatten(1), b))
+        else:
+            Y = torch.ops.quantized.linear_dynamic(X, W_prepack)
+            Y_ref = F.linear(X, W_unpacked.flatten(1), b)
+        self.assertEqual(Y, Y_ref, atol=1e-4, rtol=1e-4,
+                         message="torch.ops.quantized.linear_dynamic with 4-bit weights results are off")
+
+        with self.assertRaisesRegex(RuntimeError, "multiple of group_size"):
+            torch.ops.quantized.linear_prepack_int4(torch.randn(4, group_size + 16), None, group_size)
+
 class TestQuantizedLinear(unittest.TestCase):
     """Tests the correctness of the quantized linear and linear_relu op."""
     @given(batch_size=st.integers(1, 4),
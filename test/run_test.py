@@ -28,6 +28,7 @@ TESTS = [
     'test_cpp_extensions_jit',
     'distributed/test_c10d',
     'distributed/test_c10d_spawn',
+    'test_autocast',
     'test_cuda',
     'test_jit_cuda_fuser',
     'test_cuda_primary_ctx',
@@ -64,6 +65,7 @@ TESTS = [
     'test_jit_fuser_profiling',
     'test_tensorboard',
     'test_namedtensor',
+    'test_nested',
     'test_type_promotion',
     'test_jit_disabled',
     'test_function_schema',
@@ -77,6 +79,7 @@ TESTS = [
     'distributed/rpc/test_dist_optimizer_spawn',
     'distributed/rpc/test_rpc_spawn',
     'test_jit_py3',
+    'test_static_runtime',
     'test_determination',
     'distributed/rpc/jit/test_rpc_spawn',
     'distributed/rpc/faulty_agent/test_rpc_spawn',
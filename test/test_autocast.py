@@ -0,0 +1,177 @@
+import torch
+from torch._six import container_abcs
+from torch.testing._internal.common_utils import TestCase, run_tests
+from torch.testing._internal.autocast_test_lists import AutocastCPUTestLists
+
+
+class TestAutocastCPU(TestCase):
+    def setUp(self):
+        super(TestAutocastCPU, self).setUp()
+        self.autocast_lists = AutocastCPUTestLists(torch.device('cpu'))
+
+    def tearDown(self):
+        del self.autocast_lists
+        super(TestAutocastCPU, self).tearDown()
+
+    def _run_autocast_outofplace(self, op, args, run_as_type, out_type=None, module=torch, add_kwargs=None):
+        # helper to cast args
+        def cast(val, to_type):
+            if isinstance(val, torch.Tensor):
+                return val.to(to_type) if val.is_floating_point() else val
+            elif isinstance(val, container_abcs.Iterable):
+                return type(val)(cast(v, to_type) for v in val)
+            else:
+                return val
+
+        if add_kwargs is None:
+            add_kwargs = {}
+
+        self.assertFalse(torch.is_autocast_cpu_enabled())
+        with torch.cpu.amp.autocast():
+            self.assertTrue(torch.is_autocast_cpu_enabled())
+            # CPU autocasting doesn't turn on CUDA autocasting
+            self.assertFalse(torch.is_autocast_enabled())
+
+            out_type = out_type if out_type is not None else run_as_type
+            output = output_method = None
+
+            # Try module.* variant, if requested:
+            if module is not None and hasattr(module, op):
+                output = getattr(module, op)(*args, **add_kwargs)
+                if isinstance(output, torch.Tensor):
+                    self.assertTrue(out_type == output.dtype,
+                                    "autocast for torch.{} produced {}, should produce {}"
+                                    .format(op, output.dtype, out_type))
+
+            # Try Tensor.* variant:
+            if hasattr(torch.Tensor, op):
+                output_method = getattr(args[0], op)(*args[1:], **add_kwargs)
+                if isinstance(output_method, torch.Tensor):
+                    self.assertTrue(out_type == output_method.dtype,
+                                    "autocast for torch.{} produced {}, should produce torch.{}"
+                                    .format(op, output_method.dtype, out_type))
+
+            self.assertTrue((output is not None) or (output_method is not None),
+                            "{} not found as an attribute on either Tensor or the requested module {}".format(
+                            op, module))
+
+            # If both torch.* and Tensor.* variants were found, check outputs are identical
+            if (output is not None) and (output_method is not None):
+                self.assertTrue(type(output) == type(output_method))
+                comparison = torch.equal(output, output_method) if isinstance(output, torch.Tensor) \
+                    else (output == output_method)
+                self.assertTrue(comparison, "torch.{0} result did not match Tensor.{0} result".format(op))
+
+            # Compare numerics to Python-side "autocasting" that (we expect) does the same thing
+            # as the C++-side autocasting, and should be bitwise accurate.
+            output_to_compare = output if output is not None else output_method
+            with torch.cpu.amp.autocast(enabled=False):
+                self.assertFalse(torch.is_autocast_cpu_enabled())
+
+                if module is not None and hasattr(module, op):
+                    control = getattr(module, op)(*cast(args, run_as_type), **add_kwargs)
+                else:
+                    control = getattr(args[0].to(run_as_type), op)(*cast(args[1:], run_as_type), **add_kwargs)
+                self.assertTrue(type(output_to_compare) == type(control))
+                comparison = torch.equal(output_to_compare, control) if isinstance(control, torch.Tensor) \
+                    else (output_to_compare == control)
+                self.assertTrue(comparison, "torch.{} result did not match control".format(op))
+            self.assertTrue(torch.is_autocast_cpu_enabled())
+        self.assertFalse(torch.is_autocast_cpu_enabled())
+
+    def args_maybe_kwargs(self, op_with_args):
+        if len(op_with_args) == 2:
+            return op_with_args[0], op_with_args[1], {}
+        else:
+            return op_with_args[0], op_with_args[1], op_with_args[2]
+
+    def test_autocast_torch_bf16(self):
+        for op, args in self.autocast_lists.torch_bf16:
+            self._run_autocast_outofplace(op, args, torch.bfloat16)
+
+    def test_autocast_torch_fp32(self):
+        for op_with_args in self.autocast_lists.torch_fp32:
+            op, args, maybe_kwargs = self.args_maybe_kwargs(op_with_args)
+            self._run_autocast_outofplace(op, args, torch.float32, add_kwargs=maybe_kwargs)
+
+    def test_autocast_torch_need_autocast_promote(self):
+        for op, args in self.autocast_lists.torch_need_autocast_promote:
+            self._run_autocast_outofplace(op, args, torch.float32)
+
+    def test_autocast_nn_bf16(self):
+        for op, args in self.autocast_lists.nn_bf16:
+            self._run_autocast_outofplace(op, args, torch.bfloat16, module=torch._C._nn)
+
+    def test_autocast_nn_fp32(self):
+        for op, args in self.autocast_lists.nn_fp32:
+            self._run_autocast_outofplace(op, args, torch.float32, module=torch._C._nn)
+
+    def test_autocast_methods_bf16(self):
+        for op, args in self.autocast_lists.methods_bf16:
+            self._run_autocast_outofplace(op, args, torch.bfloat16, module=None)
+
+    def test_autocast_methods_fp32(self):
+        for op, args in self.autocast_lists.methods_fp32:
+            self._run_autocast_outofplace(op, args, torch.float32, module=None)
+
+    def test_autocast_ignored_types(self):
+        with torch.cpu.amp.autocast():
+            for ignore_type in (torch.double, torch.int32):
+                a_ignore = torch.ones((8, 8), dtype=ignore_type)
+                b_ignore = torch.ones((8, 8), dtype=ignore_type)
+                with torch.cpu.amp.autocast(enabled=False):
+                    type_no_autocast = torch.mm(a_ignore, b_ignore).dtype
+                self.assertTrue(torch.mm(a_ignore, b_ignore).dtype is type_no_autocast)
+                with torch.cpu.amp.autocast(enabled=False):
+                    type_no_autocast = torch.sum(a_ignore).dtype
+                self.assertTrue(torch.sum(a_ignore).dtype is type_no_autocast)
+
+    def test_autocast_cuda_tensors_ignored(self):
+        if not torch.cuda.is_available():
+            self.skipTest("CUDA not available")
+        a = torch.randn((8, 8), device="cuda")
+        with torch.cpu.amp.autocast():
+            self.assertEqual(torch.mm(a, a).dtype, torch.float32)
+
+    def test_autocast_cache(self):
+        weight = torch.randn(8, 8, requires_grad=True)
+        x = torch.randn(4, 8)
+
+        def weight_cast(out):
+            # The node that cast weight to bfloat16 for the mm that produced out
+            return out.grad_fn.next_functions[1][0]
+
+        with torch.cpu.amp.autocast():
+            out0 = torch.mm(x, weight)
+            # Casts of fp32 leaves that require grad are reused within the region,
+            # including in nested regions
+            with torch.cpu.amp.autocast():
+                out1 = torch.mm(x, weight)
+            self.assertEqual(out0.dtype, torch.bfloat16)
+            self.assertTrue(weight_cast(out0) is weight_cast(out1))
+            # Other tensors aren't cached
+            y = torch.randn(8, 8)
+            self.assertEqual(torch.mm(x, y), torch.mm(x, y), atol=0, rtol=0)
+
+        # The cache is cleared on exiting the outermost region
+        with torch.cpu.amp.autocast():
+            out2 = torch.mm(x, weight)
+        self.assertFalse(weight_cast(out0) is weight_cast(out2))
+
+        # Gradients flow back to the fp32 weight
+        out0.float().sum().backward()
+        self.assertEqual(weight.grad.dtype, torch.float32)
+
+    def test_autocast_decorator(self):
+        @torch.cpu.amp.autocast()
+        def run(a, b):
+            self.assertTrue(torch.is_autocast_cpu_enabled())
+            return torch.mm(a, b)
+
+        a = torch.randn(4, 4)
+        self.assertEqual(run(a, a).dtype, torch.bfloat16)
+        self.assertFalse(torch.is_autocast_cpu_enabled())
+
+
+if __name__ == '__main__':
+    run_tests()
@@ -2733,7 +2733,7 @@ t2.start()
                 b_ignore = torch.ones((8, 8), dtype=ignore_type, device="cuda:0")
                 c_16 = torch.ones((8, 8), dtype=torch.float16, device="cuda:0")
 
-                # Tests if CastPolicy::fp16 ops ignore double and int
+                # Tests if CastPolicy::lower_precision_fp ops ignore double and int
                 # Currently, no ops belonging to this policy support integer inputs.
                 if ignore_type is torch.double:
                     with self.assertRaises(RuntimeError):
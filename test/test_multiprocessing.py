@@ -63,6 +63,12 @@ def send_and_delete_tensors(queue, event, device, dtype, count, size=5):
     event.wait()
 
 
+def send_tensors(queue, event, count):
+    for i in range(count):
+        queue.put(torch.full([i + 1], i))
+    event.wait()
+
+
 def receive_and_send_sum(queue, out_queue, event, device, dtype, count, size=5):
     s = torch.full([size], 0, device=device, dtype=dtype)
     for i in range(count):
@@ -164,6 +170,16 @@ def fs_sharing():
         mp.set_sharing_strategy(prev_strategy)
 
 
+@contextlib.contextmanager
+def fs_slab_sharing():
+    prev_strategy = mp.get_sharing_strategy()
+    mp.set_sharing_strategy('file_system_slab')
+    try:
+        yield
+    finally:
+        mp.set_sharing_strategy(prev_strategy)
+
+
 class leak_checker(object):
 
     def __init__(self, test_case):
@@ -203,13 +219,15 @@ class leak_checker(object):
         if not HAS_SHM_FILES:
             return False
         result = self._has_shm_files()
-        if result and mp.get_sharing_strategy() == 'file_system' and wait:
+        if result and mp.get_sharing_strategy() in ('file_system', 'file_system_slab') and wait:
             time.sleep(0.5)
             return self._has_shm_files()
         return result
 
     def _has_shm_files(self):
         gc.collect()
+        if mp.get_sharing_strategy() == 'file_system_slab':
+            mp._release_unused_slab_segments()
         names = ['torch_' + str(pid) for pid in self.checked_pids]
         for filename in os.listdir('/dev/shm'):
             for name in names:
@@ -333,6 +351,97 @@ class TestMultiprocessing(TestCase):
         with fs_sharing():
             self._test_pool(repeat=TEST_REPEATS)
 
+    @unittest.skipIf(IS_WINDOWS, "file_system_slab strategy is not supported on Windows")
+    @unittest.skipIf(TEST_WITH_ASAN,
+                     "seems to hang with ASAN, see https://github.com/pytorch/pytorch/issues/5326")
+    def test_fs_slab_sharing(self):
+        with fs_slab_sharing():
+            self._test_sharing(repeat=TEST_REPEATS)
+
+    @unittest.skipIf(IS_WINDOWS, "file_system_slab strategy is not supported on Windows")
+    def test_fs_slab_preserve_sharing(self):
+        with fs_slab_sharing():
+            self._test_preserve_sharing(repeat=TEST_REPEATS)
+
+    @unittest.skipIf(IS_WINDOWS, "file_system_slab strategy is not supported on Windows")
+    def test_fs_slab_pool(self):
+        with fs_slab_sharing():
+            self._test_pool(repeat=TEST_REPEATS)
+
+    @unittest.skipIf(IS_WINDOWS, "file_system_slab strategy is not supported on Windows")
+    def test_fs_slab_reuse(self):
+        with fs_slab_sharing():
+            mp._release_unused_slab_segments()
+            storages = [torch.FloatStorage._new_shared(100) for _ in range(10)]
+            handles = [s._share_slab_() for s in storages]
+            # small storages are sub-allocated from a single segment
+            self.assertEqual(len(set(h[1] for h in handles)), 1)
+            self.assertEqual(len(set(h[3] for h in handles)), len(handles))
+            self.assertEqual(mp._slab_pool_stats()['live_blocks'], 10)
+
+            offsets = set(h[3] for h in handles)
+            del storages
+            gc.collect()
+            self.assertEqual(mp._slab_pool_stats()['live_blocks'], 0)
+            # freed blocks are reused
+            storages = [torch.FloatStorage._new_shared(100) for _ in range(10)]
+            self.assertEqual(set(s._share_slab_()[3] for s in storages), offsets)
+            self.assertEqual(mp._slab_pool_stats()['segments'], 1)
+
+            # a block sent to another process isn't reused until it is released
+            s = storages.pop()
+            s._shared_incref()
+            offset = s._share_slab_()[3]
+            received = torch.FloatStorage._new_shared_slab(*s._share_slab_())
+            received._shared_decref()
+            del s
+            gc.collect()
+            new = torch.FloatStorage._new_shared(100)
+            self.assertNotEqual(new._share_slab_()[3], offset)
+            del received
+            gc.collect()
+            new = torch.FloatStorage._new_shared(100)
+            self.assertEqual(new._share_slab_()[3], offset)
+
+            # large storages get a file of their own
+            large = torch.FloatStorage._new_shared(4 * 1024 * 1024)
+            self.assertTrue(large.is_shared())
+            self.assertIsNone(large._share_slab_())
+            t = torch.randn(4 * 1024 * 1024).share_memory_()
+            self.assertTrue(t.is_shared())
+            self.assertIsNone(t.storage()._share_slab_())
+
+            del storages, new, large, t
+            gc.collect()
+            mp._release_unused_slab_segments()
+            self.assertEqual(mp._slab_pool_stats()['segments'], 0)
+
+    @unittest.skipIf(IS_WINDOWS, "file_system_slab strategy is not supported on Windows")
+    @unittest.skipIf(not HAS_SHM_FILES, "don't not how to check if shm files exist")
+    def test_fs_slab_files(self):
+        count = 100
+
+        def shm_files(pid):
+            prefix = 'torch_' + str(pid)
+            return [f for f in os.listdir('/dev/shm') if f.startswith(prefix)]
+
+        with fs_slab_sharing(), leak_checker(self) as lc:
+            q = mp.Queue()
+            e = mp.Event()
+            p = mp.Process(target=send_tensors, args=(q, e, count))
+            p.daemon = True
+            p.start()
+            lc.check_pid(p.pid)
+            tensors = [q.get() for _ in range(count)]
+            for i, t in enumerate(tensors):
+                self.assertEqual(t, torch.full([i + 1], i))
+            # one segment instead of a file per tensor
+            self.assertEqual(len(shm_files(p.pid)), 1)
+            del tensors, t
+            e.set()
+            p.join(10)
+            self.assertFalse(p.is_alive())
+
     @unittest.skipIf(not HAS_SHM_FILES, "don't not how to check if shm files exist")
     def test_fs(self):
         def queue_put():
@@ -829,6 +938,11 @@ if __name__ == "__main__":
         with fs_sharing():
             self._test_is_shared()
 
+    @unittest.skipIf(IS_WINDOWS, "file_system_slab strategy is not supported on Windows")
+    def test_fs_slab_is_shared(self):
+        with fs_slab_sharing():
+            self._test_is_shared()
+
     @unittest.skipIf(not torch.cuda.is_available(), 'CUDA not available')
     def test_is_shared_cuda(self):
         t = torch.randn(5, 5).cuda()
@@ -0,0 +1,182 @@
+import torch
+import torch.nn.functional as F
+from torch.nested import NestedTensor, nested_tensor, from_padded
+from torch.testing._internal.common_utils import TestCase, run_tests
+
+
+def _random_sequences(lengths, features=(6,), dtype=torch.double, requires_grad=False):
+    return [torch.randn((length,) + features, dtype=dtype, requires_grad=requires_grad) for length in lengths]
+
+
+class TestNestedTensor(TestCase):
+    def test_construction(self):
+        tensors = _random_sequences([3, 0, 5])
+        nt = nested_tensor(tensors)
+        self.assertEqual(len(nt), 3)
+        self.assertEqual(nt.dim(), 3)
+        self.assertEqual(nt.nested_size(), [t.shape for t in tensors])
+        self.assertEqual(nt.offsets(), [0, 18, 18, 48])
+        self.assertEqual(nt.buffer.shape, (48,))
+        for a, b in zip(nt.unbind(), tensors):
+            self.assertEqual(a, b)
+        # components are views of the buffer
+        nt[2].zero_()
+        self.assertEqual(nt.buffer[18:], torch.zeros(30, dtype=torch.double))
+
+        with self.assertRaisesRegex(ValueError, "same number of dimensions"):
+            nested_tensor([torch.randn(2, 3), torch.randn(2)])
+        with self.assertRaisesRegex(ValueError, "buffer has"):
+            NestedTensor(torch.randn(5), [(2, 3)])
+
+    def test_padded_conversion(self):
+        lengths = [3, 0, 5, 1]
+        tensors = _random_sequences(lengths, features=(2, 3))
+        nt = nested_tensor(tensors)
+        padded = nt.to_padded(padding=-1.)
+        self.assertEqual(padded.shape, (4, 5, 2, 3))
+        for i, t in enumerate(tensors):
+            self.assertEqual(padded[i, :lengths[i]], t)
+            self.assertTrue((padded[i, lengths[i]:] == -1).all())
+
+        nt2 = from_padded(padded, lengths)
+        self.assertEqual(nt2.nested_size(), nt.nested_size())
+        self.assertEqual(nt2.buffer, nt.buffer)
+        self.assertEqual(from_padded(padded, torch.tensor(lengths)).buffer, nt.buffer)
+
+        # Ragged along several dimensions
+        tensors = [torch.randn(2, 3), torch.randn(4, 1)]
+        padded = nested_tensor(tensors).to_padded()
+        self.assertEqual(padded.shape, (2, 4, 3))
+        self.assertEqual(padded[0, :2, :3], tensors[0])
+        self.assertEqual(padded[1, :4, :1], tensors[1])
+        self.assertEqual(padded.sum(), sum(t.sum() for t in tensors))
+
+        with self.assertRaisesRegex(ValueError, "lengths must be in"):
+            from_padded(torch.randn(2, 3), [1, 4])
+
+    def test_elementwise(self):
+        tensors = _random_sequences([3, 1, 4])
+        nt = nested_tensor(tensors)
+        other = nested_tensor(_random_sequences([3, 1, 4]))
+        bias = torch.randn(6, dtype=torch.double)
+        cases = [
+            (lambda x: x + 1, lambda t, i: t + 1),
+            (lambda x: 2 * x, lambda t, i: 2 * t),
+            (lambda x: x - bias, lambda t, i: t - bias),
+            (lambda x: x * other, lambda t, i: t * other[i]),
+            (lambda x: x / 4, lambda t, i: t / 4),
+            (lambda x: 4 / x, lambda t, i: 4 / t),
+            (lambda x: -x, lambda t, i: -t),
+            (lambda x: torch.add(x, bias, alpha=2), lambda t, i: torch.add(t, bias, alpha=2)),
+            (torch.relu, lambda t, i: torch.relu(t)),
+            (torch.tanh, lambda t, i: torch.tanh(t)),
+            (F.gelu, lambda t, i: F.gelu(t)),
+        ]
+        for nested_fn, fn in cases:
+            result = nested_fn(nt)
+            self.assertIsInstance(result, NestedTensor)
+            for i, (a, t) in enumerate(zip(result.unbind(), tensors)):
+                self.assertEqual(a, fn(t, i))
+
+        with self.assertRaisesRegex(ValueError, "same sizes"):
+            nt + nested_tensor(_random_sequences([3, 2, 4]))
+        with self.assertRaisesRegex(ValueError, "must be the same to broadcast"):
+            nt + torch.randn(4, 6, dtype=torch.double)
+
+    def test_linear_and_matmul(self):
+        tensors = _random_sequences([3, 1, 4], features=(2, 6))
+        nt = nested_tensor(tensors)
+        weight = torch.randn(5, 6, dtype=torch.double)
+        bias = torch.randn(5, dtype=torch.double)
+        result = F.linear(nt, weight, bias)
+        self.assertEqual(result.nested_size(), [torch.Size([n, 2, 5]) for n in (3, 1, 4)])
+        for a, t in zip(result.unbind(), tensors):
+            self.assertEqual(a, F.linear(t, weight, bias))
+
+        result = nt @ weight.t()
+        for a, t in zip(result.unbind(), tensors):
+            self.assertEqual(a, t.matmul(weight.t()))
+
+        # Component by component, e.g. attention scores
+        q = nested_tensor(_random_sequences([3, 1, 4]))
+        k = nested_tensor([t.t() for t in _random_sequences([3, 1, 4])])
+        scores = torch.matmul(q, k)
+        self.assertEqual(scores.nested_size(), [torch.Size([n, n]) for n in (3, 1, 4)])
+        for a, x, y in zip(scores.unbind(), q.unbind(), k.unbind()):
+            self.assertEqual(a, x.matmul(y))
+
+    def test_layer_norm(self):
+        tensors = _random_sequences([3, 1, 4], features=(2, 6))
+        nt = nested_tensor(tensors)
+        weight = torch.randn(6, dtype=torch.double)
+        bias = torch.randn(6, dtype=torch.double)
+        for normalized_shape, w, b in (((6,), weight, bias), ((2, 6), None, None)):
+            result = F.layer_norm(nt, normalized_shape, w, b)
+            for a, t in zip(result.unbind(), tensors):
+                self.assertEqual(a, F.layer_norm(t, normalized_shape, w, b))
+
+    def test_softmax_and_reductions(self):
+        lengths = [3, 1, 5, 0, 2]
+        tensors = _random_sequences(lengths, features=(2, 4))
+        nt = nested_tensor(tensors)
+        for dim in (1, 2, 3, -1):
+            for result in (torch.softmax(nt, dim), F.softmax(nt, dim=dim), nt.softmax(dim)):
+                for a, t in zip(result.unbind(), tensors):
+                    self.assertEqual(a, t.softmax(dim - 1 if dim > 0 else dim))
+
+        for fn in (torch.sum, torch.mean):
+            self.assertEqual(fn(nt), fn(torch.cat([t.reshape(-1) for t in tensors])))
+            # Reducing the sequences gives a dense tensor
+            expected = torch.stack([fn(t, 0) if t.size(0) > 0 else torch.zeros(2, 4, dtype=torch.double)
+                                    for t in tensors])
+            self.assertEqual(fn(nt, 1), expected)
+            for dim in (2, 3):
+                result = fn(nt, dim)
+                self.assertIsInstance(result, NestedTensor)
+                for a, t in zip(result.unbind(), tensors):
+                    self.assertEqual(a, fn(t, dim - 1))
+
+        # Sequences of the same length, and ragged sequences of integers which
+        # aren't reduced by segment_reduce
+        for tensors in (_random_sequences([3, 3], features=(2, 4)),
+                        [torch.arange(6).view(3, 2), torch.arange(4).view(2, 2)]):
+            nt = nested_tensor(tensors)
+            result = torch.sum(nt, 1)
+            self.assertNotIsInstance(result, NestedTensor)
+            self.assertEqual(result, torch.stack([t.sum(0) for t in tensors]))
+        nt = nested_tensor(_random_sequences([3, 3], features=(2, 4)))
+        self.assertNotIsInstance(torch.mean(nt, 1), NestedTensor)
+
+        # Ragged along the last dimension, reduced component by component
+        tensors = [torch.randn(2, 3, dtype=torch.double), torch.randn(2, 5, dtype=torch.double)]
+        nt = nested_tensor(tensors)
+        for a, t in zip(torch.softmax(nt, -1).unbind(), tensors):
+            self.assertEqual(a, t.softmax(-1))
+        for a, t in zip(torch.sum(nt, 2).unbind(), tensors):
+            self.assertEqual(a, t.sum(1))
+
+        with self.assertRaisesRegex(IndexError, "batch dimension"):
+            torch.sum(nt, 0)
+
+    def test_autograd(self):
+        lengths = [3, 1, 4]
+        tensors = _random_sequences(lengths, requires_grad=True)
+        weight = torch.randn(5, 6, dtype=torch.double, requires_grad=True)
+
+        def nested_fn(*tensors):
+            nt = nested_tensor(tensors)
+            h = F.layer_norm(F.gelu(F.linear(nt, weight)), (5,))
+            return torch.softmax(h, 1).to_padded()
+
+        def padded_fn(*tensors):
+            outputs = [F.layer_norm(F.gelu(F.linear(t, weight)), (5,)).softmax(0) for t in tensors]
+            return torch.nn.utils.rnn.pad_sequence(outputs, batch_first=True)
+
+        self.assertEqual(nested_fn(*tensors), padded_fn(*tensors))
+        self.assertTrue(torch.autograd.gradcheck(nested_fn, tensors))
+        self.assertTrue(torch.autograd.gradcheck(
+            lambda *tensors: torch.mean(nested_tensor(tensors), 1), tensors))
+
+
+if __name__ == '__main__':
+    run_tests()
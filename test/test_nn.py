@@ -3840,6 +3840,86 @@ class TestNN(NNTestCase):
         self.assertIn('buf', l.state_dict())
         self.assertEqual(l.state_dict()['buf'], buf)
 
+    def test_conv_cpu_benchmark(self):
+        convs = [
+            (nn.Conv2d(16, 32, 3, padding=1), torch.randn(2, 16, 14, 14)),
+            (nn.Conv2d(32, 32, 3, padding=1, groups=32), torch.randn(1, 32, 10, 10)),
+            (nn.Conv2d(8, 8, 3, groups=2, bias=False), torch.randn(2, 8, 9, 9)),
+            (nn.Conv3d(4, 8, 3, groups=2), torch.randn(1, 4, 6, 6, 6)),
+            (nn.ConvTranspose2d(8, 4, 3, stride=2), torch.randn(2, 8, 5, 5)),
+        ]
+        expected = [conv(x) for conv, x in convs]
+
+        torch._C._clear_cpu_conv_benchmark_cache()
+        with torch.backends.cpu.flags(conv_benchmark=True):
+            self.assertTrue(torch.backends.cpu.conv_benchmark)
+            for (conv, x), out in zip(convs, expected):
+                x = x.requires_grad_()
+                # the first call picks the backend, the second one uses it
+                for _ in range(2):
+                    result = conv(x)
+                    self.assertEqual(result, out)
+                result.sum().backward()
+                self.assertEqual(x.grad.shape, x.shape)
+        self.assertFalse(torch.backends.cpu.conv_benchmark)
+
+        # convolutions with a single eligible backend aren't timed
+        num_cached = torch._C._cpu_conv_benchmark_cache_size()
+        self.assertLessEqual(num_cached, len(convs))
+        with TemporaryFileName() as fname:
+            torch.backends.cpu.save_conv_benchmark_cache(fname)
+            torch.backends.cpu.clear_conv_benchmark_cache()
+            self.assertEqual(torch._C._cpu_conv_benchmark_cache_size(), 0)
+            torch.backends.cpu.load_conv_benchmark_cache(fname)
+            self.assertEqual(torch._C._cpu_conv_benchmark_cache_size(), num_cached)
+            with open(fname, 'a') as f:
+                f.write('some shape\tnot_a_backend\n')
+            torch.backends.cpu.clear_conv_benchmark_cache()
+            with warnings.catch_warnings(record=True) as w:
+                warnings.simplefilter('always')
+                torch.backends.cpu.load_conv_benchmark_cache(fname)
+            self.assertTrue(any('not_a_backend' in str(warning.message) for warning in w))
+            self.assertEqual(torch._C._cpu_conv_benchmark_cache_size(), num_cached)
+
+        with torch.backends.cpu.flags(conv_benchmark=True):
+            for (conv, x), out in zip(convs, expected):
+                self.assertEqual(conv(x), out)
+        torch.backends.cpu.clear_conv_benchmark_cache()
+
+    def test_cpu_fast_math(self):
+        # large enough for the vectorized loops, odd so that the scalar ones
+        # run too
+        x = torch.randn(7, 67) * 6
+        x[0, :6] = torch.tensor([0., -0., float('inf'), -float('inf'), 100., -100.])
+        funcs = [
+            lambda t: torch.softmax(t, -1),
+            lambda t: torch.log_softmax(t, -1),
+            torch.sigmoid,
+            torch.tanh,
+            F.gelu,
+            F.logsigmoid,
+        ]
+        with torch.backends.cpu.flags(fast_math=True):
+            self.assertTrue(torch.backends.cpu.fast_math)
+            for func in funcs:
+                expected = func(x.double())
+                # the error bounds of ATen/cpu/vec256/fast_math.h, with some
+                # room for the arithmetic around the approximations. The
+                # absolute error of gelu goes up to 1.3e-6.
+                self.assertEqual(func(x), expected, atol=2e-6, rtol=1e-6, exact_dtype=False)
+                self.assertEqual(func(x.t().contiguous().t()), expected, atol=2e-6, rtol=1e-6, exact_dtype=False)
+                self.assertEqual(func(x[:, ::2]), func(x.double()[:, ::2]), atol=2e-6, rtol=1e-6, exact_dtype=False)
+                # NaN propagates, double has no approximation
+                self.assertTrue(torch.isnan(func(torch.full((3, 17), float('nan')))).all())
+                self.assertEqual(func(x.double()), expected, atol=0, rtol=0)
+
+            # masked elements of softmax stay exactly zero
+            masked = x.masked_fill(x < 0, -float('inf'))
+            self.assertEqual(torch.softmax(masked, -1)[x < 0], torch.zeros(int((x < 0).sum())), atol=0, rtol=0)
+        self.assertFalse(torch.backends.cpu.fast_math)
+        for func in funcs:
+            self.assertEqual(func(x), func(x.double()), exact_dtype=False)
+
     def test_Conv2d_inconsistent_types(self):
         inputs = torch.randn(4, 1, 7, 7, dtype=torch.float)
         weights = torch.randn(1, 1, 3, 3, dtype=torch.double)
@@ -6201,6 +6281,131 @@ class TestNN(NNTestCase):
         self.assertEqual(bn.bias.grad, ref_bn.bias.grad)
         self.assertEqual(input.grad, ref_input.grad)
 
+    def test_batchnorm_nhwc_cpu(self):
+        def helper(self, size, training):
+            channels = size[1]
+            memory_format = torch.channels_last if len(size) == 4 else torch.channels_last_3d
+            input = torch.randn(size, dtype=torch.float32, requires_grad=True)
+            input = input.contiguous(memory_format=memory_format)
+            input.retain_grad()
+            grad = torch.randn(size, dtype=torch.float32).contiguous(memory_format=memory_format)
+            bn = nn.BatchNorm2d(channels) if len(size) == 4 else nn.BatchNorm3d(channels)
+            bn.weight.data.uniform_()
+            bn.bias.data.uniform_()
+            bn.running_mean.uniform_()
+            bn.running_var.uniform_(0.5, 1.5)
+            bn.train(training)
+
+            ref_input = input.detach().clone().contiguous().requires_grad_(True)
+            ref_grad = grad.detach().clone().contiguous()
+            ref_bn = deepcopy(bn)
+
+            out = bn(input)
+            out.backward(grad)
+            ref_out = ref_bn(ref_input)
+            ref_out.backward(ref_grad)
+
+            self.assertTrue(out.is_contiguous(memory_format=memory_format))
+            self.assertTrue(ref_out.is_contiguous())
+            self.assertEqual(out, ref_out)
+            self.assertEqual(bn.running_mean, ref_bn.running_mean)
+            self.assertEqual(bn.running_var, ref_bn.running_var)
+            # the gradients are sums over N * H * W float32 values, which the
+            # two memory formats accumulate in different orders
+            self.assertEqual(bn.weight.grad, ref_bn.weight.grad, atol=1e-4, rtol=1e-4)
+            self.assertEqual(bn.bias.grad, ref_bn.bias.grad, atol=1e-4, rtol=1e-4)
+            self.assertEqual(input.grad, ref_input.grad, atol=1e-4, rtol=1e-4)
+
+        for training in [True, False]:
+            # channel counts around the vector width, and enough pixels to be
+            # split over several threads
+            helper(self, (4, 8, 2, 2), training)
+            helper(self, (2, 11, 17, 13), training)
+            helper(self, (3, 19, 4, 5, 6), training)
+            helper(self, (64, 3, 1, 1), training)
+
+    def test_groupnorm_nhwc_cpu(self):
+        def helper(self, size, groups):
+            channels = size[1]
+            memory_format = torch.channels_last if len(size) == 4 else torch.channels_last_3d
+            input = torch.randn(size, dtype=torch.float32, requires_grad=True)
+            input = input.contiguous(memory_format=memory_format)
+            input.retain_grad()
+            grad = torch.randn(size, dtype=torch.float32).contiguous(memory_format=memory_format)
+            gn = nn.GroupNorm(groups, channels)
+            gn.weight.data.uniform_()
+            gn.bias.data.uniform_()
+
+            ref_input = input.detach().clone().contiguous().requires_grad_(True)
+            ref_grad = grad.detach().clone().contiguous()
+            ref_gn = deepcopy(gn)
+
+            out = gn(input)
+            out.backward(grad)
+            ref_out = ref_gn(ref_input)
+            ref_out.backward(ref_grad)
+
+            self.assertTrue(out.is_contiguous(memory_format=memory_format))
+            self.assertTrue(ref_out.is_contiguous())
+            self.assertEqual(out, ref_out)
+            self.assertEqual(gn.weight.grad, ref_gn.weight.grad, atol=1e-4, rtol=1e-4)
+            self.assertEqual(gn.bias.grad, ref_gn.bias.grad, atol=1e-4, rtol=1e-4)
+            self.assertEqual(input.grad, ref_input.grad, atol=1e-4, rtol=1e-4)
+
+            # against the group norm computed by reshaping to [N, G, -1]
+            x = ref_input.detach().double()
+            x_grouped = x.view(size[0], groups, -1)
+            expected = ((x_grouped - x_grouped.mean(-1, keepdim=True)) /
+                        (x_grouped.var(-1, unbiased=False, keepdim=True) + gn.eps).sqrt()).view(size)
+            affine_shape = [1, channels] + [1] * (len(size) - 2)
+            expected = expected * gn.weight.detach().double().view(affine_shape) + \
+                gn.bias.detach().double().view(affine_shape)
+            self.assertEqual(out.double(), expected, atol=1e-5, rtol=0)
+
+        helper(self, (4, 8, 2, 2), 2)
+        helper(self, (2, 12, 17, 13), 3)
+        helper(self, (3, 19, 4, 5, 6), 19)
+        helper(self, (5, 16, 1, 1), 4)
+
+        for memory_format in [torch.contiguous_format, torch.channels_last]:
+            input = torch.randn(2, 6, 3, 4, dtype=torch.double)
+            input = input.contiguous(memory_format=memory_format).requires_grad_()
+            weight = torch.randn(6, dtype=torch.double, requires_grad=True)
+            bias = torch.randn(6, dtype=torch.double, requires_grad=True)
+            fn = lambda input, weight, bias: F.group_norm(input, 3, weight, bias)
+            self.assertTrue(gradcheck(fn, (input, weight, bias)))
+            self.assertTrue(gradgradcheck(fn, (input, weight, bias)))
+
+    def test_batchnorm_groupnorm_nhwc_large_cpu(self):
+        # The per channel sums over a large image are accumulated in double
+        # for float inputs (after short chunks in float for contiguous
+        # inputs), so they match a double reference
+        size = (1, 4, 1024, 1024)
+        for memory_format in [torch.contiguous_format, torch.channels_last]:
+            input = (torch.randn(size) + 10).contiguous(memory_format=memory_format).requires_grad_()
+            grad = torch.randn(size).contiguous(memory_format=memory_format)
+            ref_input = input.detach().double().contiguous().requires_grad_()
+            ref_grad = grad.double().contiguous()
+            for module in [nn.BatchNorm2d(4), nn.GroupNorm(2, 4)]:
+                module.weight.data.uniform_()
+                module.bias.data.uniform_()
+                ref_module = deepcopy(module).double()
+                input.grad = None
+                ref_input.grad = None
+
+                out = module(input)
+                out.backward(grad)
+                ref_out = ref_module(ref_input)
+                ref_out.backward(ref_grad)
+
+                self.assertEqual(out.double(), ref_out, atol=1e-4, rtol=0)
+                if isinstance(module, nn.BatchNorm2d):
+                    self.assertEqual(module.running_mean.double(), ref_module.running_mean, atol=1e-5, rtol=1e-5)
+                    self.assertEqual(module.running_var.double(), ref_module.running_var, atol=1e-5, rtol=1e-5)
+                self.assertEqual(module.weight.grad.double(), ref_module.weight.grad, atol=1e-4, rtol=1e-5)
+                self.assertEqual(module.bias.grad.double(), ref_module.bias.grad, atol=1e-4, rtol=1e-5)
+                self.assertEqual(input.grad.double(), ref_input.grad, atol=1e-4, rtol=0)
+
     @unittest.skipIf(not TEST_CUDA, "CUDA unavailable")
     def test_batchnorm_cudnn_half(self):
         # THNN
@@ -6998,6 +7203,65 @@ class TestNN(NNTestCase):
 
                     test(N, C, D, H, W, mode, padding_mode, align_corners)
 
+    def test_grid_sample_3d_channels_last_and_threads(self):
+        def grid_sample(input, grid, mode, padding_mode, align_corners):
+            input = input.detach().requires_grad_()
+            grid = grid.detach().requires_grad_()
+            out = F.grid_sample(input, grid, mode=mode, padding_mode=padding_mode,
+                                align_corners=align_corners)
+            gOut = torch.arange(out.numel(), dtype=out.dtype).view_as(out).cos()
+            out.backward(gOut)
+            return out, input.grad, grid.grad
+
+        num_threads = torch.get_num_threads()
+        for mode in ('bilinear', 'nearest'):
+            for padding_mode in ('zeros', 'border', 'reflection'):
+                for align_corners in (True, False):
+                    # channels last input, where C is not a multiple of the
+                    # vector size
+                    input = torch.randn(2, 11, 3, 4, 5, dtype=torch.double)
+                    grid = torch.randn(2, 4, 3, 6, 3, dtype=torch.double)
+                    expected = grid_sample(input, grid, mode, padding_mode, align_corners)
+                    input_cl = input.contiguous(memory_format=torch.channels_last_3d)
+                    actual = grid_sample(input_cl, grid, mode, padding_mode, align_corners)
+                    self.assertTrue(actual[0].is_contiguous(memory_format=torch.channels_last_3d))
+                    for a, e in zip(actual, expected):
+                        self.assertEqual(a, e)
+
+                    self.assertTrue(gradcheck(
+                        lambda inp, grid: F.grid_sample(inp, grid, mode=mode, padding_mode=padding_mode,
+                                                        align_corners=align_corners),
+                        (input_cl[:, :3].contiguous(memory_format=torch.channels_last_3d).requires_grad_(),
+                         grid[:, :2].requires_grad_())))
+
+                    # a single large sample, whose rows are split among the
+                    # threads in backward
+                    input = torch.randn(1, 3, 8, 8, 8, dtype=torch.double)
+                    grid = torch.randn(1, 16, 32, 32, 3, dtype=torch.double) * 0.8
+                    for input_ in (input, input.contiguous(memory_format=torch.channels_last_3d)):
+                        try:
+                            torch.set_num_threads(1)
+                            expected = grid_sample(input_, grid, mode, padding_mode, align_corners)
+                        finally:
+                            torch.set_num_threads(num_threads)
+                        actual = grid_sample(input_, grid, mode, padding_mode, align_corners)
+                        for a, e in zip(actual, expected):
+                            self.assertEqual(a, e)
+
+    def test_grid_sample_3d_nearest_rounds_half_away_from_zero(self):
+        # With align_corners=True and W = 5, x = ix / 2 - 1 is exact, so the
+        # unnormalized coordinates below are exact ties
+        ix = torch.tensor([-0.5, 0.5, 1.5, 2.5, 3.5, 4.5] * 3)
+        for dtype in (torch.float, torch.double):
+            input = torch.arange(1, 6, dtype=dtype).view(1, 1, 1, 1, 5).expand(1, 3, 1, 1, 5)
+            grid = torch.zeros(1, 1, 1, ix.numel(), 3, dtype=dtype)
+            grid[..., 0] = ix / 2 - 1
+            # -0.5 rounds to -1 and 4.5 rounds to 5, which are out of bounds
+            expected = torch.tensor([0., 2., 3., 4., 5., 0.] * 3, dtype=dtype).expand(1, 3, 1, 1, ix.numel())
+            for input_ in (input.contiguous(), input.contiguous(memory_format=torch.channels_last_3d)):
+                out = F.grid_sample(input_, grid, mode='nearest', padding_mode='zeros', align_corners=True)
+                self.assertEqual(out, expected)
+
     def test_affine_grid(self):
         # test known input on CPU
         input = torch.arange(1., 7).view(1, 2, 3)
@@ -7576,6 +7840,41 @@ class TestNN(NNTestCase):
             out_t_5 = m(in_t_9[:, :, :5, :5])
         self.assertEqual(out_t_9[:, :, :15, :15], out_t_5)
 
+    def test_upsamplingBiMode2d_channels_last(self):
+        for mode, align_corners, antialias in itertools.product(['bilinear', 'bicubic'], [True, False], [True, False]):
+            kwargs = dict(mode=mode, align_corners=align_corners, antialias=antialias)
+            for size in [(7, 11), (16, 16), (3, 5)]:
+                in_t = torch.randn(2, 5, 9, 13)
+                out_t = F.interpolate(in_t, size=size, **kwargs)
+                in_t_cl = in_t.contiguous(memory_format=torch.channels_last)
+                out_t_cl = F.interpolate(in_t_cl, size=size, **kwargs)
+                self.assertTrue(out_t_cl.is_contiguous(memory_format=torch.channels_last))
+                self.assertEqual(out_t, out_t_cl)
+                # non contiguous input
+                out_t_nc = F.interpolate(in_t.transpose(2, 3), size=size[::-1], **kwargs)
+                self.assertEqual(F.interpolate(in_t.transpose(2, 3).contiguous(), size=size[::-1], **kwargs), out_t_nc)
+
+    def test_upsamplingBiMode2d_antialias(self):
+        # bilinear antialiasing downsamples with a triangle filter as wide as
+        # two output pixels, along each axis [0, 1, 2, 3] becomes [5 / 7, 16 / 7]
+        in_t = torch.arange(16.).view(1, 1, 4, 4)
+        out_t = F.interpolate(in_t, size=(2, 2), mode='bilinear', align_corners=False, antialias=True)
+        self.assertEqual(out_t, torch.tensor([[[[25., 36.], [69., 80.]]]]) / 7)
+
+        for mode, align_corners in itertools.product(['bilinear', 'bicubic'], [True, False]):
+            kwargs = dict(mode=mode, align_corners=align_corners, antialias=True)
+            # the weights are normalized
+            for size in [(1, 1), (3, 4), (5, 17), (40, 40)]:
+                out_t = F.interpolate(torch.ones(2, 3, 20, 20), size=size, **kwargs)
+                self.assertEqual(out_t, torch.ones(2, 3, *size))
+
+            input = torch.randn(1, 2, 8, 7, dtype=torch.double, requires_grad=True)
+            gradcheck(lambda x: F.interpolate(x, size=(3, 10), **kwargs), [input])
+            gradgradcheck(lambda x: F.interpolate(x, size=(3, 10), **kwargs), [input])
+
+        with self.assertRaisesRegex(ValueError, "Anti-alias option is only supported"):
+            F.interpolate(torch.ones(1, 1, 4, 4), size=(2, 2), mode='nearest', antialias=True)
+
     def test_upsamplingNearest3d(self):
         for memory_format in [torch.contiguous_format, torch.channels_last_3d]:
             m = nn.Upsample(size=4, mode='nearest')
@@ -7816,6 +8115,49 @@ class TestNN(NNTestCase):
         out = conv(input)
         self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
 
+    def test_conv_thnn_nhwc(self):
+        # (in_channels, out_channels, kernel_size, stride, padding, bias)
+        configs = [
+            (8, 4, 1, 1, 0, True),
+            (8, 4, 1, 2, 0, False),
+            (3, 16, 3, 1, 1, True),
+            (5, 6, (3, 2), (2, 1), (1, 0), True),
+            (4, 4, 5, 2, 2, False),
+        ]
+        for in_channels, out_channels, kernel_size, stride, padding, bias in configs:
+            input = torch.randn(2, in_channels, 9, 7, dtype=torch.double)
+            input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+            conv = nn.Conv2d(in_channels, out_channels, kernel_size, stride=stride,
+                             padding=padding, bias=bias).double()
+            ref_input = input.detach().clone().contiguous().requires_grad_()
+            ref_conv = nn.Conv2d(in_channels, out_channels, kernel_size, stride=stride,
+                                 padding=padding, bias=bias).double()
+            ref_conv.load_state_dict(conv.state_dict())
+
+            with torch.backends.mkldnn.flags(enabled=False):
+                out = conv(input)
+                ref_out = ref_conv(ref_input)
+            grad = torch.randn_like(out)
+            out.backward(grad)
+            ref_out.backward(grad.contiguous())
+
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+            self.assertTrue(ref_out.is_contiguous())
+            self.assertEqual(out, ref_out)
+            self.assertTrue(input.grad.is_contiguous(memory_format=torch.channels_last))
+            self.assertEqual(input.grad, ref_input.grad)
+            self.assertEqual(conv.weight.grad, ref_conv.weight.grad)
+            if bias:
+                self.assertEqual(conv.bias.grad, ref_conv.bias.grad)
+
+        input = torch.randn(2, 3, 6, 5, dtype=torch.double)
+        input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+        weight = torch.randn(4, 3, 3, 3, dtype=torch.double, requires_grad=True)
+        bias = torch.randn(4, dtype=torch.double, requires_grad=True)
+        self.assertTrue(gradcheck(
+            lambda i, w, b: torch._C._nn.thnn_conv2d(i, w, (3, 3), b, (2, 1), (1, 1)),
+            (input, weight, bias)))
+
     def test_conv_double_backward(self):
         batch_size = 2
         for kern, inp_size, dilations in [(3, 6, [1, 2]), (3, 7, [1]), (4, 9, [1])]:
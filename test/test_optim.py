@@ -2,6 +2,7 @@ import warnings
 import math
 import unittest
 import functools
+import itertools
 from copy import deepcopy
 import torch
 from torch._six import inf
@@ -410,6 +411,113 @@ class TestOptim(TestCase):
              lambda opt: ReduceLROnPlateau(opt, threshold=1e-4)]
         )
 
+    def test_rowwise_adagrad(self):
+        self._test_basic_cases(
+            lambda weight, bias: optim.RowWiseAdagrad([weight, bias], lr=1e-1)
+        )
+        self._test_basic_cases(
+            lambda weight, bias: optim.RowWiseAdagrad(
+                self._build_params_dict(weight, bias, lr=1e-2),
+                lr=1e-1, weight_decay=1e-3)
+        )
+        self._test_basic_cases(
+            lambda weight, bias: optim.RowWiseAdagrad([weight, bias], lr=1e-1,
+                                                      momentum_dtype=torch.bfloat16)
+        )
+        with self.assertRaisesRegex(ValueError, "Invalid momentum_dtype"):
+            optim.RowWiseAdagrad(None, lr=1e-2, momentum_dtype=torch.int)
+
+    def test_rowwise_adagrad_sparse(self):
+        self._test_rosenbrock_sparse(
+            lambda params: optim.RowWiseAdagrad(params, lr=1e-1)
+        )
+
+    def _test_fused_embedding_bag(self, constructor, weight_decay):
+        num_rows, dim, num_indices = 20, 8, 30
+        for mode, include_last_offset, use_weights in itertools.product(
+                ['sum', 'mean'], [False, True], [False, True]):
+            if mode == 'mean' and use_weights:
+                continue
+            weight = torch.randn(num_rows, dim, requires_grad=True)
+            weight_ref = weight.detach().clone().requires_grad_()
+            optimizer = constructor([weight], weight_decay)
+            optimizer_ref = constructor([weight_ref], weight_decay)
+            offsets = torch.tensor([0, 5, 5, 17, 30] if include_last_offset else [0, 5, 5, 17])
+            for _ in range(3):
+                input = torch.randint(0, num_rows, (num_indices,))
+                per_sample_weights = torch.rand(num_indices) if use_weights else None
+                grad_output = torch.randn(4, dim)
+
+                output = optimizer.embedding_bag(
+                    weight, input, offsets, mode=mode, per_sample_weights=per_sample_weights,
+                    include_last_offset=include_last_offset)
+                output.backward(grad_output)
+
+                optimizer_ref.zero_grad()
+                output_ref = F.embedding_bag(
+                    input, weight_ref, offsets, mode=mode, sparse=True,
+                    per_sample_weights=per_sample_weights, include_last_offset=include_last_offset)
+                output_ref.backward(grad_output)
+                optimizer_ref.step()
+
+                self.assertEqual(output, output_ref)
+                self.assertIsNone(weight.grad)
+                self.assertEqual(weight, weight_ref)
+            for key, value in optimizer.state[weight].items():
+                self.assertEqual(value, optimizer_ref.state[weight_ref][key])
+
+    def test_rowwise_adagrad_embedding_bag(self):
+        self._test_fused_embedding_bag(
+            lambda params, weight_decay: optim.RowWiseAdagrad(params, lr=1e-1, weight_decay=weight_decay),
+            weight_decay=1e-2)
+
+    def test_sgd_embedding_bag(self):
+        self._test_fused_embedding_bag(
+            lambda params, weight_decay: optim.SGD(params, lr=1e-1),
+            weight_decay=0)
+        weight = torch.randn(4, 2, requires_grad=True)
+        with self.assertRaisesRegex(ValueError, "does not support momentum"):
+            optim.SGD([weight], lr=1e-1, momentum=0.9).embedding_bag(
+                weight, torch.tensor([[0, 1]]))
+        with self.assertRaisesRegex(ValueError, "not a parameter of this optimizer"):
+            optim.SGD([torch.randn(2, requires_grad=True)], lr=1e-1).embedding_bag(
+                weight, torch.tensor([[0, 1]]))
+
+    def test_embedding_bag_low_precision(self):
+        for dtype in [torch.half, torch.bfloat16]:
+            weight = torch.randn(20, 8)
+            weight_fp32 = weight.clone().requires_grad_()
+            weight = weight.to(dtype).requires_grad_()
+            optimizer = optim.RowWiseAdagrad([weight], lr=1e-1, momentum_dtype=dtype)
+            optimizer_fp32 = optim.RowWiseAdagrad([weight_fp32], lr=1e-1)
+            input = torch.randint(0, 20, (6, 3))
+            grad_output = torch.randn(6, 8)
+            for stochastic_rounding in [False, True]:
+                output = optimizer.embedding_bag(
+                    weight, input, stochastic_rounding=stochastic_rounding)
+                self.assertEqual(output.dtype, torch.float)
+                output.backward(grad_output)
+                optimizer_fp32.embedding_bag(weight_fp32, input).backward(grad_output)
+                self.assertEqual(weight.float(), weight_fp32, atol=5e-2, rtol=0)
+
+    def test_embedding_bag_stochastic_rounding(self):
+        # Updates smaller than half an ulp are lost with round to nearest, with
+        # stochastic rounding they are applied in expectation
+        num_rows, dim = 1000, 8
+        for dtype, delta, ulp in [(torch.bfloat16, 1e-3, 2 ** -8), (torch.half, 1e-4, 2 ** -11)]:
+            for stochastic_rounding in [False, True]:
+                weight = torch.ones(num_rows, dim, dtype=dtype, requires_grad=True)
+                optimizer = optim.SGD([weight], lr=1)
+                output = optimizer.embedding_bag(
+                    weight, torch.arange(num_rows).unsqueeze(1),
+                    stochastic_rounding=stochastic_rounding)
+                output.backward(torch.full((num_rows, dim), delta))
+                mean = weight.detach().double().mean().item()
+                if stochastic_rounding:
+                    self.assertLess(abs(mean - (1 - delta)), ulp / 10)
+                else:
+                    self.assertEqual(mean, 1.0)
+
     def test_adamax(self):
         self._test_basic_cases(
             lambda weight, bias: optim.Adamax([weight, bias], lr=1e-1)
@@ -0,0 +1,137 @@
+import torch
+from torch import nn
+from torch.testing._internal.common_utils import TestCase, run_tests
+from torch.utils import ThroughputBenchmark
+
+
+class StaticRuntime:
+    def __init__(self, scripted, *example_inputs):
+        if hasattr(scripted, "_c"):
+            self.static_runtime = torch._C._jit_to_static_runtime(
+                scripted._c, *example_inputs)
+        else:
+            self.static_runtime = torch._C._jit_to_static_runtime(
+                scripted.graph, *example_inputs)
+
+    def __call__(self, *args):
+        return self.static_runtime.run(*args)
+
+
+class MLP(nn.Module):
+    def __init__(self, D_in, H, D_out):
+        super(MLP, self).__init__()
+        self.linear1 = nn.Linear(D_in, H)
+        self.linear2 = nn.Linear(H, D_out)
+
+    def forward(self, x):
+        h = torch.relu(self.linear1(x))
+        return torch.sigmoid(self.linear2(h) + x.sum())
+
+
+class TwoInputs(nn.Module):
+    def __init__(self, D_in, H):
+        super(TwoInputs, self).__init__()
+        self.linear = nn.Linear(D_in, H)
+
+    def forward(self, x1, x2):
+        h1 = torch.tanh(self.linear(x1))
+        h2 = torch.tanh(self.linear(x2))
+        return torch.cat([h1 * h2, h1 + h2], 1), h1
+
+
+def trivial_graph(a, b, c):
+    s = torch.tensor([[3, 3], [3, 3]])
+    return a + b * c + s
+
+
+class TestStaticRuntime(TestCase):
+    def test_trivial_graph(self):
+        s = torch.full((2, 2), 2)
+        tg = torch.jit.script(trivial_graph)
+        o_ref = tg(s, s, s)
+        tg_a = StaticRuntime(tg)
+        o_test = tg_a(s, s, s)
+        self.assertEqual(o_ref, o_test)
+
+    def test_mlp(self):
+        mod = MLP(10, 20, 10).eval()
+        scripted = torch.jit.script(mod)
+        # F.linear branches on the input rank, specializing on an example
+        # input folds that branch away
+        static = StaticRuntime(scripted, torch.randn(2, 10))
+        for batch in [1, 4, 16]:
+            x = torch.randn(batch, 10)
+            self.assertEqual(mod(x), static(x))
+
+    def test_outputs_are_not_reused(self):
+        mod = MLP(8, 16, 8).eval()
+        x1 = torch.randn(4, 8)
+        x2 = torch.randn(4, 8)
+        static = StaticRuntime(torch.jit.script(mod), x1)
+        o1 = static(x1)
+        o1_copy = o1.clone()
+        o2 = static(x2)
+        # the second run must not write into the tensor returned by the first
+        self.assertEqual(o1, o1_copy)
+        self.assertEqual(o2, mod(x2))
+
+    def test_multiple_outputs(self):
+        mod = TwoInputs(6, 12).eval()
+        x1 = torch.randn(3, 6)
+        x2 = torch.randn(3, 6)
+        static = StaticRuntime(torch.jit.script(mod), x1, x2)
+        for _ in range(3):
+            ref = mod(x1, x2)
+            out = static(x1, x2)
+            self.assertEqual(ref[0], out[0])
+            self.assertEqual(ref[1], out[1])
+
+    def test_specialized_rank_is_checked(self):
+        mod = MLP(4, 4, 4).eval()
+        static = StaticRuntime(torch.jit.script(mod), torch.randn(2, 4))
+        with self.assertRaisesRegex(RuntimeError, "specialized"):
+            static(torch.randn(2, 2, 4))
+
+    def test_control_flow_unsupported(self):
+        @torch.jit.script
+        def fn(x, flag: bool):
+            if flag:
+                x = x + 1
+            return x
+
+        with self.assertRaisesRegex(RuntimeError, "control flow"):
+            StaticRuntime(fn)
+
+    def test_mutation_unsupported(self):
+        @torch.jit.script
+        def fn(x):
+            y = x * 2
+            y.add_(1)
+            return y
+
+        with self.assertRaisesRegex(RuntimeError, "mutate"):
+            StaticRuntime(fn)
+
+    def test_throughput_benchmark(self):
+        mod = TwoInputs(10, 5).eval()
+        inputs = [[torch.randn(8, 10), torch.randn(8, 10)] for _ in range(2)]
+        static = torch._C._jit_to_static_runtime(
+            torch.jit.script(mod)._c, *inputs[0])
+        bench = ThroughputBenchmark(static)
+        for inp in inputs:
+            bench.add_input(*inp)
+        for inp in inputs:
+            ref = mod(*inp)
+            out = bench.run_once(*inp)
+            self.assertEqual(ref[0], out[0])
+            self.assertEqual(ref[1], out[1])
+        stats = bench.benchmark(
+            num_calling_threads=4,
+            num_warmup_iters=10,
+            num_iters=100,
+        )
+        self.assertGreater(stats.num_iters, 0)
+
+
+if __name__ == "__main__":
+    run_tests()
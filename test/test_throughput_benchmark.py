@@ -2,7 +2,8 @@ from __future__ import absolute_import, division, print_function, unicode_litera
 
 import torch
 import tempfile
-from torch.utils import ThroughputBenchmark
+import threading
+from torch.utils import ThroughputBenchmark, BatchingServer
 from torch.testing import assert_allclose
 
 from torch.testing._internal.common_utils import run_tests, TestCase
@@ -80,6 +81,61 @@ class TestThroughputBenchmark(TestCase):
         with tempfile.NamedTemporaryFile(delete=False) as f:
             self.linear_test(TwoLayerNetModule, profiler_output_path=f.name)
 
+    def test_latency_percentiles(self):
+        module = TwoLayerNet(10, 5, 15)
+        bench = ThroughputBenchmark(module)
+        bench.add_input(torch.randn(4, 10), torch.randn(4, 10))
+        stats = bench.benchmark(num_calling_threads=2, num_warmup_iters=5, num_iters=50)
+        self.assertGreater(stats.latency_p50_ms, 0)
+        self.assertGreaterEqual(stats.latency_p99_ms, stats.latency_p50_ms)
+
+    def test_batching_server(self):
+        D_in, H, D_out = 10, 5, 15
+        module = TwoLayerNet(D_in, H, D_out)
+        server = BatchingServer(
+            module, max_batch_size=8, max_latency_ms=50, num_worker_threads=2)
+
+        NUM_THREADS = 8
+        inputs = [[torch.randn(i % 3 + 1, D_in), torch.randn(i % 3 + 1, D_in)]
+                  for i in range(NUM_THREADS)]
+        results = [None] * NUM_THREADS
+
+        def request(i):
+            results[i] = server.run(*inputs[i])
+
+        threads = [threading.Thread(target=request, args=(i,)) for i in range(NUM_THREADS)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        with torch.no_grad():
+            for i in range(NUM_THREADS):
+                assert_allclose(results[i], module(*inputs[i]))
+
+        future = server.submit(*inputs[0])
+        assert_allclose(future.wait(), results[0])
+
+        stats = server.stats()
+        self.assertEqual(stats.num_requests, NUM_THREADS + 1)
+        self.assertLessEqual(stats.num_batches, NUM_THREADS + 1)
+
+        # requests with mismatched batch dimensions are rejected upfront
+        with self.assertRaisesRegex(RuntimeError, "same size of dim 0"):
+            server.submit(torch.randn(2, D_in), torch.randn(3, D_in))
+
+    def test_batching_server_benchmark(self):
+        module = TwoLayerNet(10, 5, 15)
+        server = BatchingServer(module, max_batch_size=4, max_latency_ms=1)
+        bench = ThroughputBenchmark(server)
+        x1, x2 = torch.randn(1, 10), torch.randn(1, 10)
+        bench.add_input(x1, x2)
+        with torch.no_grad():
+            assert_allclose(bench.run_once(x1, x2), module(x1, x2))
+        stats = bench.benchmark(num_calling_threads=4, num_warmup_iters=10, num_iters=100)
+        self.assertGreaterEqual(stats.latency_p99_ms, stats.latency_p50_ms)
+        print(stats)
+
 
 if __name__ == '__main__':
     run_tests()
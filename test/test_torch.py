@@ -2416,6 +2416,50 @@ class _TestTorchMixin(object):
                 added = zeros.index_add(0, torch.arange(0, size[0], dtype=torch.long, device=device), tensor)
                 self.assertEqual(added, tensor)
 
+    # index_add_, scatter_add_ with an expanded index and index_put_ with
+    # accumulate=True run in parallel on CPU, and must give the same result
+    # for any number of threads.
+    def test_index_accumulate_parallel_deterministic(self):
+        num_dest, num_src, row = 50, 4000, 33
+        idx = torch.randint(0, num_dest, (num_src,))
+        ops = {
+            'index_add_': lambda dest, src: dest.index_add_(0, idx, src),
+            'index_add_dim1': lambda dest, src: dest.t().index_add_(1, idx, src.t()).t(),
+            'index_put_': lambda dest, src: dest.index_put_((idx,), src, accumulate=True),
+            'scatter_add_': lambda dest, src: dest.scatter_add_(0, idx.unsqueeze(1).expand_as(src), src),
+        }
+        num_threads = torch.get_num_threads()
+        try:
+            for dtype in [torch.float, torch.double, torch.int64, torch.cfloat, torch.half, torch.bool]:
+                if dtype == torch.bool:
+                    src = torch.rand(num_src, row) < 0.01
+                else:
+                    src = torch.randn(num_src, row).to(dtype)
+                dest = torch.randn(num_dest, row).to(dtype)
+                for name, op in ops.items():
+                    results = []
+                    for n in (1, 2, 4):
+                        torch.set_num_threads(n)
+                        results.append(op(dest.clone(), src))
+                    for res in results[1:]:
+                        self.assertEqual(res, results[0], atol=0, rtol=0, message='{} {}'.format(name, dtype))
+
+                    expected = dest.clone()
+                    for i in range(num_dest):
+                        if dtype == torch.bool:
+                            expected[i] |= src[idx == i].any(0)
+                        else:
+                            acc_dtype = torch.cdouble if dtype.is_complex else torch.double
+                            expected[i] += src[idx == i].to(acc_dtype).sum(0).to(dtype)
+                    if dtype == torch.half:
+                        self.assertEqual(results[0], expected, atol=1, rtol=1e-2)
+                    elif dtype in (torch.float, torch.cfloat):
+                        self.assertEqual(results[0], expected, atol=1e-3, rtol=1e-4)
+                    else:
+                        self.assertEqual(results[0], expected)
+        finally:
+            torch.set_num_threads(num_threads)
+
     def test_t(self):
         # Test 0D tensors
         x = torch.randn(())
@@ -4512,6 +4556,212 @@ tensor([[[1., 1., 1.,  ..., 1., 1., 1.],
             torch.Tensor(bad_mock_seq)
         self.assertEqual(torch.Tensor([1.0, 2.0, 3.0]), torch.Tensor(good_mock_seq))
 
+    def test_tensor_from_homogeneous_sequence(self):
+        # Lists and tuples of floats, ints and bools are converted without
+        # going through the generic path, which a list subclass still takes.
+        class SlowList(list):
+            pass
+
+        def check(data, dtype=None):
+            expected = torch.tensor(SlowList(data), dtype=dtype)
+            for res in (torch.tensor(data, dtype=dtype), torch.tensor(tuple(data), dtype=dtype)):
+                self.assertEqual(res, expected)
+                self.assertIs(res.dtype, expected.dtype)
+                self.assertEqual(res.shape, expected.shape)
+
+        for dtype in (None, torch.bool, torch.uint8, torch.int8, torch.int16, torch.int32, torch.int64,
+                      torch.half, torch.bfloat16, torch.float, torch.double, torch.complex64):
+            check([], dtype)
+            check([[], []], dtype)
+            check([1, 2, 3], dtype)
+            check([[1, 0], [3, -4]], dtype)
+            check([(True, False), [False, True]], dtype)
+            check([[[1, True]], [[False, 5]]], dtype)
+            if dtype is None or dtype.is_floating_point or dtype.is_complex:
+                check([0.5, -1.25, 3.], dtype)
+                check([[1, 2.5], (3, 4)], dtype)
+                check([[True, 2.5], [-1, 4]], dtype)
+
+        for default_dtype in (torch.float32, torch.float64):
+            saved_dtype = torch.get_default_dtype()
+            torch.set_default_dtype(default_dtype)
+            try:
+                self.assertIs(torch.tensor([[1.5, 2], [3, 4]]).dtype, default_dtype)
+                self.assertIs(torch.tensor([[], []]).dtype, default_dtype)
+                self.assertIs(torch.tensor([[1, True], [3, 4]]).dtype, torch.int64)
+                self.assertIs(torch.tensor(((True,), (False,))).dtype, torch.bool)
+            finally:
+                torch.set_default_dtype(saved_dtype)
+
+        self.assertEqual(torch.tensor([2 ** 62, -2 ** 62]).tolist(), [2 ** 62, -2 ** 62])
+        with self.assertRaisesRegex(RuntimeError, "Overflow"):
+            torch.tensor([1, 2 ** 64])
+        with self.assertRaisesRegex(RuntimeError, "Precision loss"):
+            torch.tensor([1, 2 ** 60], dtype=torch.float)
+
+        # Ragged and mixed nests still get the errors of the generic path
+        with self.assertRaisesRegex(ValueError, "expected sequence of length 2 at dim 1"):
+            torch.tensor([[1, 2], [3]])
+        with self.assertRaisesRegex(ValueError, "expected sequence of length 0 at dim 1"):
+            torch.tensor([[], [3]])
+        with self.assertRaises(Exception):
+            torch.tensor([[1, 2], 3])
+        with self.assertRaisesRegex(TypeError, "invalid data type"):
+            torch.tensor([[1, 2], ['a', 'b']])
+        self.assertEqual(torch.tensor([[1, 2], [torch.tensor(3), 4]]), torch.tensor([[1, 2], [3, 4]]))
+
+    def test_arg_parser_fast_path(self):
+        x = torch.randn(2, 3)
+        y = torch.randn(2, 3)
+        s = torch.tensor(2.)
+        i = torch.tensor(2)
+        p = torch.nn.Parameter(torch.randn(2, 3))
+        calls = [
+            lambda: torch.add(x, y),
+            lambda: torch.add(x, 2),
+            lambda: torch.add(x, 2.5),
+            lambda: torch.add(x, True),
+            lambda: torch.add(x, s),
+            lambda: torch.add(p, x),
+            lambda: torch.add(x, y, alpha=2),
+            lambda: x.add(y),
+            lambda: x.mul(s),
+            lambda: torch.pow(x, s),
+            lambda: torch.pow(2, x),
+            lambda: x.clone().fill_(s),
+            lambda: x.clone().fill_(i),
+            lambda: x.view(3, 2),
+            lambda: x.view(i, 3),
+            lambda: x.view((3, 2)),
+            lambda: x.permute(1, 0),
+            lambda: x.sum(),
+            lambda: x.sum(0),
+            lambda: x.sum(0, True),
+            lambda: torch.clamp(x, None, 0.5),
+            lambda: torch.clamp(x, -0.5),
+            lambda: torch.flatten(x, 0, 1),
+            lambda: torch.zeros(2, 3),
+            lambda: torch.zeros((2, 3), dtype=torch.int),
+            lambda: x.to(torch.double),
+            lambda: x.to('cpu', torch.double),
+            lambda: x.transpose(0, 1),
+            lambda: x[0].max(0),
+        ]
+        errors = [
+            lambda: torch.add(x, 'a'),
+            lambda: torch.add(x),
+            lambda: x.sum(0.5),
+            lambda: x.view(2.0, 3),
+            lambda: x.transpose(0, 1, 2),
+        ]
+
+        saved = torch._C._get_arg_parser_fast_path()
+        try:
+            results = []
+            messages = []
+            for enabled in (False, True):
+                torch._C._set_arg_parser_fast_path(enabled)
+                self.assertEqual(torch._C._get_arg_parser_fast_path(), enabled)
+                # Twice, so that the overloads remembered by the parsers are used
+                results.append([call() for call in calls + calls])
+                messages.append([])
+                for call in errors:
+                    with self.assertRaises(TypeError) as cm:
+                        call()
+                    messages[-1].append(str(cm.exception))
+        finally:
+            torch._C._set_arg_parser_fast_path(saved)
+
+        self.assertEqual(messages[0], messages[1])
+        for expected, res in zip(*results):
+            self.assertEqual(expected, res)
+            if torch.is_tensor(expected):
+                self.assertIs(expected.dtype, res.dtype)
+
+        # The overload remembered for a call site depends on the kinds of the
+        # arguments, not on the first call
+        self.assertEqual(x.sum(0).shape, (3,))
+        self.assertEqual(x.sum(0, True).shape, (1, 3))
+        self.assertEqual(x.sum(0).shape, (3,))
+        self.assertEqual(x.sum().shape, ())
+        self.assertIs(torch.add(i, 1).dtype, torch.int64)
+        self.assertIs(torch.add(i, 1.5).dtype, torch.get_default_dtype())
+
+        class TorchFunctionTensor(object):
+            def __torch_function__(self, func, types, args=(), kwargs=None):
+                return "overridden"
+
+        self.assertEqual(torch.add(x, TorchFunctionTensor()), "overridden")
+        self.assertEqual(torch.add(TorchFunctionTensor(), 1), "overridden")
+
+    def test_tensor_from_buffer(self):
+        import array
+
+        for typecode, dtype in (('b', torch.int64), ('B', torch.int64), ('h', torch.int64), ('i', torch.int64),
+                                ('l', torch.int64), ('q', torch.int64), ('f', torch.get_default_dtype()),
+                                ('d', torch.get_default_dtype())):
+            a = array.array(typecode, [1, 2, 3, 4, 5, 6])
+            res = torch.tensor(a)
+            self.assertIs(res.dtype, dtype)
+            self.assertEqual(res, torch.tensor(a.tolist()))
+            self.assertEqual(torch.tensor(a, dtype=torch.double), torch.tensor(a.tolist(), dtype=torch.double))
+            # torch.tensor always copies
+            a[0] = 7
+            self.assertEqual(res[0].item(), 1)
+
+        # as_tensor shares the memory when the type allows it
+        a = array.array('q', [1, 2, 3])
+        t = torch.as_tensor(a)
+        a[0] = 7
+        self.assertEqual(t[0].item(), 7)
+        t[1] = 8
+        self.assertEqual(a[1], 8)
+        a = array.array('d', [1, 2, 3])
+        t = torch.as_tensor(a, dtype=torch.double)
+        t[0] = 0.5
+        self.assertEqual(a[0], 0.5)
+        t = torch.as_tensor(a, dtype=torch.float)
+        t[0] = 2
+        self.assertEqual(a[0], 0.5)
+
+        # bytearray and memoryview
+        b = bytearray([1, 2, 255])
+        self.assertEqual(torch.tensor(b), torch.tensor([1, 2, 255]))
+        self.assertEqual(torch.tensor(b, dtype=torch.uint8), torch.tensor([1, 2, 255], dtype=torch.uint8))
+        m = memoryview(array.array('i', range(12))).cast('B').cast('i', [3, 4])
+        self.assertEqual(torch.tensor(m), torch.arange(12).view(3, 4))
+        self.assertEqual(torch.tensor(memoryview(array.array('i', range(12)))[::3]), torch.tensor([0, 3, 6, 9]))
+        # Read-only buffers are copied
+        ro = memoryview(bytes([1, 2, 3]))
+        t = torch.as_tensor(ro, dtype=torch.uint8)
+        t[0] = 5
+        self.assertEqual(ro[0], 1)
+        # Formats without a tensor type take the generic path
+        self.assertEqual(torch.tensor(array.array('Q', [1, 2])), torch.tensor([1, 2]))
+        # Negative strides are not wrapped
+        r = memoryview(array.array('d', [1, 2, 3]))[::-1]
+        self.assertEqual(torch.tensor(r, dtype=torch.double), torch.tensor([3., 2., 1.], dtype=torch.double))
+        self.assertEqual(torch.as_tensor(r), torch.tensor([3., 2., 1.]))
+        r = memoryview(array.array('i', range(12)))[10::-3]
+        self.assertEqual(torch.tensor(r), torch.tensor([10, 7, 4, 1]))
+
+    @unittest.skipIf(not TEST_NUMPY, "Numpy not found")
+    def test_tensor_from_numpy_scalar(self):
+        # numpy scalars export a buffer but keep their numpy dtype
+        for np_dtype, dtype in ((np.float64, torch.float64), (np.float32, torch.float32),
+                                (np.float16, torch.float16), (np.int64, torch.int64),
+                                (np.int32, torch.int32), (np.int16, torch.int16),
+                                (np.int8, torch.int8), (np.uint8, torch.uint8),
+                                (np.bool_, torch.bool)):
+            for value in (1, 0):
+                res = torch.tensor(np_dtype(value))
+                self.assertIs(res.dtype, dtype)
+                self.assertEqual(res.dim(), 0)
+                self.assertEqual(res.item(), value)
+                self.assertIs(torch.as_tensor(np_dtype(value)).dtype, dtype)
+        self.assertEqual(torch.tensor(np.float64(1.5)).item(), 1.5)
+        self.assertEqual(torch.tensor(np.float64(1.5), dtype=torch.float).dtype, torch.float)
+
     def test_comparison_ops(self):
         x = torch.randn(5, 5)
         y = torch.randn(5, 5)
@@ -5304,6 +5554,7 @@ def add_neg_dim_tests():
         ('cumsum', (10, 20), lambda: [DIM_ARG], [METHOD, FUNCTIONAL]),
         ('cummax', (10, 20), lambda: [DIM_ARG], [METHOD, FUNCTIONAL]),
         ('cummin', (10, 20), lambda: [DIM_ARG], [METHOD, FUNCTIONAL]),
+        ('logcumsumexp', (10, 20), lambda: [DIM_ARG], [METHOD, FUNCTIONAL]),
         ('mean', (10, 20), lambda: [DIM_ARG], [METHOD, FUNCTIONAL]),
         ('median', (10, 20), lambda: [DIM_ARG], [METHOD, FUNCTIONAL]),
         ('mode', (10, 20), lambda: [DIM_ARG], [METHOD, FUNCTIONAL]),
@@ -11313,6 +11564,81 @@ class TestTorchDeviceType(TestCase):
                                                        [0, 0, 0],
                                                        [0, 0, 0]]), expected_out)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_logcumsumexp(self, device, dtype):
+        a = torch.randn(5, 4, device=device, dtype=dtype)
+        res = torch.logcumsumexp(a, 1)
+        self.assertEqual(res, torch.cumsum(a.exp(), 1).log())
+        out = torch.empty(0, device=device, dtype=dtype)
+        torch.logcumsumexp(a, 1, out=out)
+        self.assertEqual(res, out)
+        self.assertEqual(a.logcumsumexp(0), torch.cumsum(a.exp(), 0).log())
+
+        # Large values don't overflow, infinities and nan behave like in the
+        # log of the cumulative sum of exponentials
+        x = torch.tensor([1000, -inf, 1000, inf, -inf], device=device, dtype=dtype)
+        self.assertEqual(torch.logcumsumexp(x, 0),
+                         torch.tensor([1000, 1000, 1000 + math.log(2), inf, inf], device=device, dtype=dtype))
+        x = torch.tensor([-inf, -inf, 0, nan, 1], device=device, dtype=dtype)
+        self.assertEqual(torch.logcumsumexp(x, 0),
+                         torch.tensor([-inf, -inf, 0, nan, nan], device=device, dtype=dtype))
+
+        for shape in ([2, 0], [0, 2, 3], [1], [5]):
+            x = torch.randn(shape, device=device, dtype=dtype)
+            for dim in range(len(shape)):
+                self.assertEqual(torch.logcumsumexp(x, dim).shape, x.shape)
+        self.assertEqual(torch.logcumsumexp(torch.tensor(3., device=device, dtype=dtype), 0), 3.)
+
+        if dtype == torch.double:
+            a = torch.randn(3, 5, device=device, dtype=dtype, requires_grad=True)
+            self.assertTrue(torch.autograd.gradcheck(lambda x: torch.logcumsumexp(x, 1), (a,)))
+            self.assertTrue(torch.autograd.gradgradcheck(lambda x: torch.logcumsumexp(x, 1), (a,)))
+
+    @onlyCPU
+    def test_cumulative_ops_blocked_scan(self, device):
+        # A few slices along a long dimension are scanned in parallel blocks,
+        # which must give the results of the sequential scan
+        ops = {
+            'cumsum': lambda x, dim: x.cumsum(dim),
+            'cumprod': lambda x, dim: x.cumprod(dim),
+            'cummax': lambda x, dim: x.cummax(dim),
+            'cummin': lambda x, dim: x.cummin(dim),
+            'logcumsumexp': lambda x, dim: x.logcumsumexp(dim),
+        }
+        num_threads = torch.get_num_threads()
+        try:
+            for shape, dim in (((200000,), 0), ((2, 100000), 1), ((100000, 3), 0)):
+                for dtype in (torch.float, torch.double, torch.int64):
+                    if dtype.is_floating_point:
+                        x = torch.randn(shape, device=device, dtype=dtype)
+                    else:
+                        x = torch.randint(-1000, 1000, shape, device=device, dtype=dtype)
+                    for name, op in ops.items():
+                        if name == 'logcumsumexp' and not dtype.is_floating_point:
+                            continue
+                        t = x
+                        if name == 'cumprod':
+                            t = 1 + x / 1e4 if dtype.is_floating_point else x.sign()
+                        elif name in ('cummax', 'cummin') and dtype.is_floating_point:
+                            # ties, and a nan in the last block
+                            t = x.round()
+                            t.view(-1)[-100] = nan
+                        results = []
+                        for n in (1, 4):
+                            torch.set_num_threads(n)
+                            results.append(op(t, dim))
+                        msg = '{} {} {}'.format(name, dtype, shape)
+                        if name in ('cummax', 'cummin'):
+                            self.assertEqual(results[1][0], results[0][0], atol=0, rtol=0, message=msg)
+                            self.assertEqual(results[1][1], results[0][1], atol=0, rtol=0, message=msg)
+                        elif dtype == torch.float:
+                            self.assertEqual(results[1], results[0], atol=1e-4, rtol=1e-5, message=msg)
+                        else:
+                            self.assertEqual(results[1], results[0], message=msg)
+        finally:
+            torch.set_num_threads(num_threads)
+
     def test_std_mean(self, device):
         x = torch.rand(100, 50, 20, device=device)
         for dim in range(x.dim()):
@@ -16860,6 +17186,84 @@ scipy_lobpcg  | {:10.2e}  | {:10.2e}  | {:6} | N/A
         t_copy.abs_()
         self.assertEqual(t, t_copy)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_segment_reduce(self, device, dtype):
+        reduce_fns = {
+            'sum': lambda t, axis: t.sum(axis),
+            'mean': lambda t, axis: t.mean(axis),
+            'max': lambda t, axis: t.max(axis)[0],
+            'min': lambda t, axis: t.min(axis)[0],
+        }
+        lengths = torch.tensor([3, 0, 1, 70, 6, 0, 20], device=device)
+        offsets = torch.cat((torch.zeros(1, dtype=torch.long, device=device), lengths.cumsum(0)))
+        for shape, axis in (((100,), 0), ((100, 5), 0), ((4, 100, 3), 1), ((2, 3, 100), -1)):
+            data = torch.randn(shape, dtype=dtype, device=device)
+            for reduce, fn in reduce_fns.items():
+                expected = torch.stack([
+                    fn(chunk, axis) if chunk.size(axis) > 0 else torch.zeros_like(fn(data, axis))
+                    for chunk in data.split(lengths.tolist(), axis)], axis)
+                self.assertEqual(torch.segment_reduce(data, reduce, lengths=lengths, axis=axis), expected)
+                self.assertEqual(torch.segment_reduce(data, reduce, offsets=offsets, axis=axis), expected)
+
+                # Shuffle the elements along axis
+                ids = torch.repeat_interleave(torch.arange(lengths.numel(), device=device), lengths)
+                perm = torch.randperm(ids.numel(), device=device)
+                self.assertEqual(
+                    torch.unsorted_segment_reduce(data.index_select(axis, perm), ids[perm], lengths.numel(), reduce, axis),
+                    expected)
+                self.assertEqual(torch.unsorted_segment_reduce(data, ids, lengths.numel(), reduce, axis), expected)
+
+        # Results are the same whatever the number of threads
+        data = torch.randn(100000, 3, dtype=dtype, device=device)
+        lengths = torch.full((1000,), 100, dtype=torch.long, device=device)
+        num_threads = torch.get_num_threads()
+        try:
+            results = []
+            for n in (1, 4):
+                torch.set_num_threads(n)
+                results.append(torch.segment_reduce(data, 'sum', lengths=lengths))
+            self.assertEqual(results[0], results[1], atol=0, rtol=0)
+        finally:
+            torch.set_num_threads(num_threads)
+
+        # NaN propagates through max and min
+        data = torch.tensor([1., float('nan'), 3., 4.], dtype=dtype, device=device)
+        lengths = torch.tensor([3, 1], device=device)
+        for reduce in ('max', 'min'):
+            result = torch.segment_reduce(data, reduce, lengths=lengths)
+            self.assertTrue(torch.isnan(result[0]))
+            self.assertEqual(result[1], 4.)
+
+        with self.assertRaisesRegex(RuntimeError, "exactly one of lengths and offsets"):
+            torch.segment_reduce(data, 'sum')
+        with self.assertRaisesRegex(RuntimeError, "unsupported reduction"):
+            torch.segment_reduce(data, 'prod', lengths=lengths)
+        with self.assertRaisesRegex(RuntimeError, "cover the 4 elements"):
+            torch.segment_reduce(data, 'sum', lengths=torch.tensor([1, 2], device=device))
+        with self.assertRaisesRegex(RuntimeError, "nondecreasing offsets"):
+            torch.segment_reduce(data, 'sum', offsets=torch.tensor([0, 3, 2, 4], device=device))
+        with self.assertRaisesRegex(RuntimeError, "out of range"):
+            torch.unsorted_segment_reduce(data, torch.tensor([0, 1, 2, 0], device=device), 2, 'sum')
+
+    @onlyCPU
+    @dtypes(torch.double)
+    def test_segment_reduce_backward(self, device, dtype):
+        lengths = torch.tensor([2, 0, 3, 1], device=device)
+        ids = torch.tensor([2, 0, 3, 0, 2, 3], device=device)
+        for reduce in ('sum', 'mean', 'max', 'min'):
+            for shape, axis in (((6,), 0), ((6, 3), 0), ((2, 6, 3), 1)):
+                data = torch.randn(shape, dtype=dtype, device=device, requires_grad=True)
+                self.assertTrue(torch.autograd.gradcheck(
+                    lambda x: torch.segment_reduce(x, reduce, lengths=lengths, axis=axis), (data,)))
+                self.assertTrue(torch.autograd.gradcheck(
+                    lambda x: torch.unsorted_segment_reduce(x, ids, 4, reduce, axis), (data,)))
+
+        # The gradient of max goes to the first maximum
+        data = torch.tensor([2., 1., 2., 5.], dtype=dtype, device=device, requires_grad=True)
+        torch.segment_reduce(data, 'max', lengths=torch.tensor([3, 1], device=device)).sum().backward()
+        self.assertEqual(data.grad, torch.tensor([1., 0., 0., 1.], dtype=dtype, device=device))
+
     def test_bucketization(self, device):
         values_1d = torch.tensor([1, 2, 3, 4, 5, 6, 7, 8, 9], device=device)
         values_3d = torch.tensor([[[1, 3, 5], [2, 4, 6]], [[1, 2, 3], [4, 5, 6]]], device=device)
@@ -405,6 +405,7 @@ del ComplexFloatStorageBase
 ################################################################################
 
 import torch.cuda
+import torch.cpu
 import torch.autograd
 from torch.autograd import no_grad, enable_grad, set_grad_enabled
 import torch.nn
@@ -420,6 +421,7 @@ import torch.hub
 import torch.random
 import torch.distributions
 import torch.testing
+import torch.backends.cpu
 import torch.backends.cuda
 import torch.backends.mkl
 import torch.backends.mkldnn
@@ -449,6 +451,9 @@ from torch._classes import classes
 # Import the quasi random sampler
 import torch.quasirandom
 
+# Import the nested tensor package
+import torch.nested
+
 # If you are seeing this, it means that this call site was not checked if
 # the memory format could be preserved, and it was switched to old default
 # behaviour of contiguous
@@ -3091,6 +3091,30 @@ Example::
     tensor([ True,  True, False, False])
 """.format(**common_args))
 
+add_docstr(torch.logcumsumexp,
+           r"""
+logcumsumexp(input, dim, out=None) -> Tensor
+Returns the logarithm of the cumulative summation of the exponentiation of
+elements of :attr:`input` in the dimension :attr:`dim`. The computation is
+numerically stabilized.
+
+For summation index :math:`j` given by `dim` and other indices :math:`i`, the result is
+
+    .. math::
+        \text{{logcumsumexp}}(x)_{{ij}} = \log \sum\limits_{{j=0}}^{{i}} \exp(x_{{ij}})
+
+Args:
+    {input}
+    dim  (int): the dimension to do the operation over
+    {out}
+
+Example::
+
+    >>> a = torch.arange(-1., 4.)
+    >>> torch.logcumsumexp(a, dim=0)
+    tensor([-1.0000,  0.3133,  1.4076,  2.4402,  3.4519])
+""".format(**reduceops_common_args))
+
 add_docstr(torch.logspace,
            r"""
 logspace(start, end, steps=100, base=10.0, out=None, dtype=None, layout=torch.strided, device=None, requires_grad=False) -> Tensor
@@ -7863,6 +7887,70 @@ Example::
             [1, 3, 4]])
 """)
 
+add_docstr(torch.segment_reduce,
+           r"""
+segment_reduce(data, reduce, *, lengths=None, offsets=None, axis=0) -> Tensor
+
+Reduces the consecutive segments of :attr:`data` along dimension :attr:`axis`.
+The segments are given either by their :attr:`lengths`, or by the
+:attr:`offsets` of their boundaries, so that segment ``i`` is
+``data.narrow(axis, offsets[i], offsets[i + 1] - offsets[i])``. The result
+has the shape of :attr:`data`, with size ``num_segments`` along :attr:`axis`.
+
+Segments are reduced in parallel, and empty segments reduce to 0. For ``"max"``
+and ``"min"``, the gradient flows to the first element of each segment equal
+to the result.
+
+Args:
+    data (Tensor): the floating point tensor to reduce
+    reduce (str): the reduction, one of ``"sum"``, ``"mean"``, ``"max"`` or ``"min"``
+    lengths (LongTensor, optional): 1-D tensor of the ``num_segments`` lengths
+        of the segments, which must sum to ``data.size(axis)``
+    offsets (LongTensor, optional): 1-D tensor of ``num_segments + 1``
+        nondecreasing offsets, starting at 0 and ending at ``data.size(axis)``
+    axis (int, optional): the dimension to reduce. Default: 0
+
+Exactly one of :attr:`lengths` and :attr:`offsets` must be given.
+
+.. note:: Only CPU tensors are supported.
+
+Example::
+
+    >>> data = torch.tensor([1., 2., 3., 4., 5., 6.])
+    >>> torch.segment_reduce(data, "sum", lengths=torch.tensor([2, 0, 3, 1]))
+    tensor([ 3.,  0., 12.,  6.])
+    >>> torch.segment_reduce(data, "max", lengths=torch.tensor([2, 0, 3, 1]))
+    tensor([2., 0., 5., 6.])
+    >>> torch.segment_reduce(data, "mean", offsets=torch.tensor([0, 2, 2, 5, 6]))
+    tensor([1.5000, 0.0000, 4.0000, 6.0000])
+""")
+
+add_docstr(torch.unsorted_segment_reduce,
+           r"""
+unsorted_segment_reduce(data, segment_ids, num_segments, reduce, axis=0) -> Tensor
+
+Reduces the segments of :attr:`data` along dimension :attr:`axis`, where
+``data.select(axis, j)`` belongs to segment ``segment_ids[j]``. Unlike
+:func:`torch.segment_reduce`, the elements of a segment don't need to be
+consecutive. If :attr:`segment_ids` is sorted, :attr:`data` is reduced
+without being copied, otherwise it is first gathered segment by segment.
+
+Args:
+    data (Tensor): the floating point tensor to reduce
+    segment_ids (LongTensor): 1-D tensor of ``data.size(axis)`` segment ids in
+        ``[0, num_segments)``
+    num_segments (int): the number of segments, which is the size of the
+        result along :attr:`axis`
+    reduce (str): the reduction, one of ``"sum"``, ``"mean"``, ``"max"`` or ``"min"``
+    axis (int, optional): the dimension to reduce. Default: 0
+
+Example::
+
+    >>> data = torch.tensor([1., 2., 3., 4.])
+    >>> torch.unsorted_segment_reduce(data, torch.tensor([1, 0, 1, 2]), 3, "sum")
+    tensor([2., 4., 4.])
+""")
+
 add_docstr(torch.bucketize,
            r"""
 bucketize(input, boundaries, out_int32=False, right=False, out=None) -> Tensor
@@ -0,0 +1,70 @@
+import sys
+import torch
+from contextlib import contextmanager
+from torch.backends import ContextProp, PropModule, __allow_nonbracketed_mutation
+
+# Write:
+#
+#   torch.backends.cpu.conv_benchmark = True
+#
+# to time the available CPU convolution implementations (MKL-DNN, XNNPACK,
+# NNPACK, ...) the first time each convolution shape is seen, and use the
+# fastest one from then on. This is the CPU counterpart of
+# torch.backends.cudnn.benchmark.
+#
+#   torch.backends.cpu.fast_math = True
+#
+# to compute exp, log, tanh, erf and sigmoid of float32 tensors in the
+# softmax, log_softmax, sigmoid, tanh and gelu CPU kernels with polynomial
+# approximations that are faster but less accurate than the default ones.
+# See ATen/cpu/vec256/fast_math.h for their error bounds and
+# benchmarks/fast_math for how to measure them.
+
+def set_flags(_conv_benchmark=None, _fast_math=None):
+    orig_flags = (torch._C._get_cpu_conv_benchmark(), torch._C._get_cpu_fast_math())
+    if _conv_benchmark is not None:
+        torch._C._set_cpu_conv_benchmark(_conv_benchmark)
+    if _fast_math is not None:
+        torch._C._set_cpu_fast_math(_fast_math)
+    return orig_flags
+
+@contextmanager
+def flags(conv_benchmark=False, fast_math=False):
+    with __allow_nonbracketed_mutation():
+        orig_flags = set_flags(conv_benchmark, fast_math)
+    try:
+        yield
+    finally:
+        with __allow_nonbracketed_mutation():
+            set_flags(orig_flags[0], orig_flags[1])
+
+def save_conv_benchmark_cache(path):
+    r"""Writes the convolution implementations chosen by ``conv_benchmark`` to
+    ``path``, so that another process can skip the timing with
+    :func:`load_conv_benchmark_cache`.
+
+    The choices depend on the machine and on the number of threads, they are
+    only meaningful for processes running on the same kind of hardware.
+    """
+    torch._C._save_cpu_conv_benchmark_cache(str(path))
+
+def load_conv_benchmark_cache(path):
+    r"""Adds the choices of a file written by :func:`save_conv_benchmark_cache`
+    to the cache of ``conv_benchmark``. Choices naming an implementation that
+    is not available in this build are timed again."""
+    torch._C._load_cpu_conv_benchmark_cache(str(path))
+
+def clear_conv_benchmark_cache():
+    r"""Forgets all the convolution implementations chosen by ``conv_benchmark``."""
+    torch._C._clear_cpu_conv_benchmark_cache()
+
+class CPUModule(PropModule):
+    def __init__(self, m, name):
+        super(CPUModule, self).__init__(m, name)
+
+    conv_benchmark = ContextProp(torch._C._get_cpu_conv_benchmark, torch._C._set_cpu_conv_benchmark)
+    fast_math = ContextProp(torch._C._get_cpu_fast_math, torch._C._set_cpu_fast_math)
+
+# This is the sys.modules replacement trick, see
+# https://stackoverflow.com/questions/2447353/getattr-on-a-module/7668273#7668273
+sys.modules[__name__] = CPUModule(sys.modules[__name__], __name__)
@@ -0,0 +1,6 @@
+r"""
+This package contains CPU-specific utilities, such as :mod:`torch.cpu.amp`
+for running regions of a script in mixed precision on the CPU.
+"""
+
+from . import amp  # noqa: F401
@@ -0,0 +1,64 @@
+import torch
+import functools
+
+
+class autocast(object):
+    r"""
+    Instances of :class:`autocast` serve as context managers or decorators that
+    allow regions of your script to run in mixed precision on the CPU.
+
+    In these regions, CPU ops run in an op-specific dtype chosen by autocast:
+    matrix multiplications and convolutions run in ``bfloat16``, while reductions,
+    norms, softmax, losses and other ops that need range or precision run in ``float32``.
+    See the :ref:`CPU Autocast Op Reference<autocast-cpu-op-reference>` for details.
+
+    CPU autocasting is independent of :class:`torch.cuda.amp.autocast`: it only affects
+    CPU tensors, and the two can be enabled at the same time.
+
+    Example::
+
+        model = Net()
+
+        with torch.cpu.amp.autocast():
+            # The linear layers of the model run in bfloat16
+            output = model(input)
+            # The loss runs in float32
+            loss = loss_fn(output, target)
+
+        loss.backward()
+
+    As with CUDA autocasting, ``bfloat16`` casts of ``float32`` leaf tensors that require grad
+    (typically model weights) are cached for the duration of the outermost autocast-enabled
+    region, so a weight used by several ops is only cast once per forward pass.
+
+    Floating-point Tensors produced in an autocast-enabled region may be ``bfloat16``.
+    After returning to an autocast-disabled region, cast them back to ``float32`` if they
+    are used with ``float32`` Tensors.
+
+    ``autocast(enabled=False)`` subregions can be nested in autocast-enabled regions.
+    The autocast state is thread-local.
+
+    Arguments:
+        enabled(bool, optional, default=True):  Whether autocasting should be enabled in the region.
+    """
+    def __init__(self, enabled=True):
+        self._enabled = enabled
+
+    def __enter__(self):
+        self.prev = torch.is_autocast_cpu_enabled()
+        torch.set_autocast_cpu_enabled(self._enabled)
+        torch.autocast_increment_nesting()
+
+    def __exit__(self, *args):
+        # Drop the cache when we exit to a nesting level that's outside any instance of autocast.
+        if torch.autocast_decrement_nesting() == 0:
+            torch.clear_autocast_cache()
+        torch.set_autocast_cpu_enabled(self.prev)
+        return False
+
+    def __call__(self, func):
+        @functools.wraps(func)
+        def decorate_autocast(*args, **kwargs):
+            with self:
+                return func(*args, **kwargs)
+        return decorate_autocast
@@ -16,6 +16,7 @@
 #include <ATen/DLConvertor.h>
 #include <ATen/Parallel.h>
 #include <ATen/Utils.h>
+#include <ATen/native/ConvAutotune.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -35,6 +36,7 @@
 #include <torch/csrc/multiprocessing/init.h>
 #include <torch/csrc/tensor/python_tensor.h>
 #include <torch/csrc/utils/tensor_dtypes.h>
+#include <torch/csrc/utils/python_arg_parser.h>
 #include <torch/csrc/utils/python_strings.h>
 #include <torch/csrc/utils/tensor_layouts.h>
 #include <torch/csrc/utils/tensor_memoryformats.h>
@@ -466,6 +468,79 @@ PyObject *THPModule_benchmarkCuDNN(PyObject *_unused, PyObject *noargs)
   else Py_RETURN_FALSE;
 }
 
+PyObject *THPModule_setBenchmarkCPUConv(PyObject *_unused, PyObject *arg)
+{
+  THPUtils_assert(PyBool_Check(arg), "set_benchmark_cpu_conv expects a bool, "
+          "but got %s", THPUtils_typename(arg));
+  at::globalContext().setBenchmarkCPUConv(arg == Py_True);
+  Py_RETURN_NONE;
+}
+
+PyObject *THPModule_benchmarkCPUConv(PyObject *_unused, PyObject *noargs)
+{
+  if (at::globalContext().benchmarkCPUConv()) Py_RETURN_TRUE;
+  else Py_RETURN_FALSE;
+}
+
+PyObject *THPModule_setFastMathCPU(PyObject *_unused, PyObject *arg)
+{
+  THPUtils_assert(PyBool_Check(arg), "set_cpu_fast_math expects a bool, "
+          "but got %s", THPUtils_typename(arg));
+  at::globalContext().setFastMathCPU(arg == Py_True);
+  Py_RETURN_NONE;
+}
+
+PyObject *THPModule_fastMathCPU(PyObject *_unused, PyObject *noargs)
+{
+  if (at::globalContext().fastMathCPU()) Py_RETURN_TRUE;
+  else Py_RETURN_FALSE;
+}
+
+PyObject *THPModule_saveCPUConvBenchmarkCache(PyObject *_unused, PyObject *arg)
+{
+  HANDLE_TH_ERRORS
+  THPUtils_assert(THPUtils_checkString(arg), "save_cpu_conv_benchmark_cache expects a str, "
+          "but got %s", THPUtils_typename(arg));
+  at::native::cpu_conv_autotune_save(THPUtils_unpackString(arg));
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject *THPModule_loadCPUConvBenchmarkCache(PyObject *_unused, PyObject *arg)
+{
+  HANDLE_TH_ERRORS
+  THPUtils_assert(THPUtils_checkString(arg), "load_cpu_conv_benchmark_cache expects a str, "
+          "but got %s", THPUtils_typename(arg));
+  at::native::cpu_conv_autotune_load(THPUtils_unpackString(arg));
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject *THPModule_clearCPUConvBenchmarkCache(PyObject *_unused, PyObject *noargs)
+{
+  at::native::cpu_conv_autotune_clear();
+  Py_RETURN_NONE;
+}
+
+PyObject *THPModule_cpuConvBenchmarkCacheSize(PyObject *_unused, PyObject *noargs)
+{
+  return PyLong_FromSize_t(at::native::cpu_conv_autotune_size());
+}
+
+PyObject *THPModule_setArgParserFastPath(PyObject *_unused, PyObject *arg)
+{
+  THPUtils_assert(PyBool_Check(arg), "set_arg_parser_fast_path expects a bool, "
+          "but got %s", THPUtils_typename(arg));
+  torch::PythonArgParser::set_fast_path_enabled(arg == Py_True);
+  Py_RETURN_NONE;
+}
+
+PyObject *THPModule_argParserFastPath(PyObject *_unused, PyObject *noargs)
+{
+  if (torch::PythonArgParser::fast_path_enabled()) Py_RETURN_TRUE;
+  else Py_RETURN_FALSE;
+}
+
 PyObject *THPModule_setFlushDenormal(PyObject *_unused, PyObject *arg) {
   THPUtils_assert(PyBool_Check(arg), "flush_denormal expects a bool, "
           "but got %s", THPUtils_typename(arg));
@@ -558,6 +633,16 @@ static PyMethodDef TorchMethods[] = {
   {"_set_cudnn_benchmark", (PyCFunction)THPModule_setBenchmarkCuDNN, METH_O,  nullptr},
   {"_get_cudnn_deterministic", (PyCFunction)THPModule_deterministicCuDNN, METH_NOARGS,     nullptr},
   {"_set_cudnn_deterministic", (PyCFunction)THPModule_setDeterministicCuDNN, METH_O,  nullptr},
+  {"_get_cpu_conv_benchmark", (PyCFunction)THPModule_benchmarkCPUConv, METH_NOARGS,     nullptr},
+  {"_set_cpu_conv_benchmark", (PyCFunction)THPModule_setBenchmarkCPUConv, METH_O,  nullptr},
+  {"_save_cpu_conv_benchmark_cache", (PyCFunction)THPModule_saveCPUConvBenchmarkCache, METH_O, nullptr},
+  {"_load_cpu_conv_benchmark_cache", (PyCFunction)THPModule_loadCPUConvBenchmarkCache, METH_O, nullptr},
+  {"_clear_cpu_conv_benchmark_cache", (PyCFunction)THPModule_clearCPUConvBenchmarkCache, METH_NOARGS, nullptr},
+  {"_cpu_conv_benchmark_cache_size", (PyCFunction)THPModule_cpuConvBenchmarkCacheSize, METH_NOARGS, nullptr},
+  {"_get_cpu_fast_math", (PyCFunction)THPModule_fastMathCPU, METH_NOARGS,     nullptr},
+  {"_set_cpu_fast_math", (PyCFunction)THPModule_setFastMathCPU, METH_O,  nullptr},
+  {"_get_arg_parser_fast_path", (PyCFunction)THPModule_argParserFastPath, METH_NOARGS, nullptr},
+  {"_set_arg_parser_fast_path", (PyCFunction)THPModule_setArgParserFastPath, METH_O, nullptr},
   {"_to_dlpack",      (PyCFunction)THPModule_toDLPack,          METH_O,       nullptr},
   {"_from_dlpack",    (PyCFunction)THPModule_fromDLPack,        METH_O,       nullptr},
   {"set_flush_denormal", (PyCFunction)THPModule_setFlushDenormal, METH_O,     nullptr},
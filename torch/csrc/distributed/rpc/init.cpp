@@ -383,6 +383,13 @@ PyObject* rpc_init(PyObject* /* unused */) {
                   :meth:`~torch.distributed.rpc.rpc_async` if necessary.
               init_method (str, optional): The URL to initialize
                   ``ProcessGroupGloo`` (default: ``env://``).
+              shm_transport (bool, optional): Send tensors through shared
+                  memory to workers on the same host that enable it too,
+                  instead of copying them into the messages. Storages that
+                  are already shared with the ``file_system`` sharing
+                  strategy (see :meth:`torch.Tensor.share_memory_`) are not
+                  copied at all, so the receiver sees later writes to them
+                  (default: ``False``).
 
 
           Example::
@@ -404,15 +411,23 @@ PyObject* rpc_init(PyObject* /* unused */) {
               >>> # omitting init_rpc invocation on worker2
       )")
       .def(
-          py::init<int, float, std::string>(),
+          py::init<int, float, std::string, bool>(),
           py::arg("num_send_recv_threads") = kDefaultNumSendRecvThreads,
           py::arg("rpc_timeout") = kDefaultRpcTimeoutSeconds,
-          py::arg("init_method") = kDefaultInitMethod)
+          py::arg("init_method") = kDefaultInitMethod,
+          py::arg("shm_transport") = false)
       .def_readwrite(
           "num_send_recv_threads",
           &ProcessGroupRpcBackendOptions::numSendRecvThreads,
           R"(
               The number of threads in the thread-pool used by ProcessGroupAgent.
+          )")
+      .def_readwrite(
+          "shm_transport",
+          &ProcessGroupRpcBackendOptions::shmTransport,
+          R"(
+              Whether tensors are sent through shared memory to workers on the
+              same host.
           )");
 
   module.attr("_DEFAULT_NUM_SEND_RECV_THREADS") =
@@ -424,11 +439,13 @@ PyObject* rpc_init(PyObject* /* unused */) {
               std::string,
               std::shared_ptr<::c10d::ProcessGroup>,
               int,
-              std::chrono::milliseconds>(),
+              std::chrono::milliseconds,
+              bool>(),
           py::arg("name"),
           py::arg("process_group"),
           py::arg("num_send_recv_threads"),
-          py::arg("rpc_timeout"))
+          py::arg("rpc_timeout"),
+          py::arg("shm_transport") = false)
       .def(
           "get_worker_info",
           (const WorkerInfo& (ProcessGroupAgent::*)(void)const) &
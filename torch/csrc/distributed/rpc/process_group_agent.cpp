@@ -7,12 +7,16 @@
 
 #include <Python.h>
 
+#include <unistd.h>
+#include <cstring>
+
 namespace torch {
 namespace distributed {
 namespace rpc {
 
 namespace {
 constexpr auto kSecToMsConversion = 1000;
+constexpr auto kMaxHostNameLen = 256;
 }
 
 //////////////////////////  MessageCounter  /////////////////////////////////
@@ -93,11 +97,47 @@ void ProcessGroupAgent::collectNames() {
   }
 }
 
+void ProcessGroupAgent::collectShmPeers(bool shmTransport) {
+  const auto worldSize = pg_->getSize();
+
+  // The first byte tells whether the transport is enabled, followed by the
+  // host name.
+  torch::Tensor hostTensor = torch::zeros({kMaxHostNameLen + 1}, torch::kChar);
+  auto hostData = hostTensor.data_ptr<int8_t>();
+  hostData[0] = shmTransport;
+  TORCH_CHECK(
+      gethostname(reinterpret_cast<char*>(hostData + 1), kMaxHostNameLen) ==
+          0,
+      "Failed to get the host name: ",
+      strerror(errno));
+  hostData[kMaxHostNameLen] = 0;
+  std::vector<torch::Tensor> inputHost = {hostTensor};
+  std::vector<std::vector<torch::Tensor>> outputHosts(1);
+  for (int i = 0; i < worldSize; ++i) {
+    outputHosts[0].emplace_back(
+        torch::empty({kMaxHostNameLen + 1}, {torch::kChar}));
+  }
+  pg_->allgather(outputHosts, inputHost)->wait();
+
+  shmPeers_.resize(worldSize, false);
+  if (!shmTransport) {
+    return;
+  }
+  shmTransport_ = std::make_unique<ShmTensorTransport>();
+  const auto selfHost = reinterpret_cast<const char*>(hostData + 1);
+  for (worker_id_t i = 0; i < worldSize; ++i) {
+    const auto peerData = outputHosts[0][i].data_ptr<int8_t>();
+    shmPeers_[i] = peerData[0] &&
+        strcmp(reinterpret_cast<const char*>(peerData + 1), selfHost) == 0;
+  }
+}
+
 ProcessGroupAgent::ProcessGroupAgent(
     std::string workerName,
     std::shared_ptr<c10d::ProcessGroup> pg,
     int numSendRecvThreads,
-    std::chrono::milliseconds rpcTimeout)
+    std::chrono::milliseconds rpcTimeout,
+    bool shmTransport)
     : RpcAgent(
           WorkerInfo(std::move(workerName), (int64_t)pg->getRank()),
           std::make_unique<RequestCallbackImpl>(),
@@ -114,6 +154,7 @@ ProcessGroupAgent::ProcessGroupAgent(
   metrics_[ProcessGroupAgentMetrics::GIL_WAIT_TIME] =
       std::make_unique<AverageMetricsTracker>(kGilAverageWaitTime);
   collectNames();
+  collectShmPeers(shmTransport);
   auto workerRankIter = nameMap_.find(workerInfo_.name_);
   TORCH_CHECK(
       workerRankIter != nameMap_.end(),
@@ -417,8 +458,10 @@ std::shared_ptr<FutureMessage> ProcessGroupAgent::send(
 }
 
 void ProcessGroupAgent::handleSend(const SendWork& work) {
-  auto serializedPayload = std::make_unique<std::string>(std::move(
-      wireSerialize(work.message_.payload(), work.message_.tensors())));
+  auto serializedPayload = std::make_unique<std::string>(std::move(wireSerialize(
+      work.message_.payload(),
+      work.message_.tensors(),
+      shmPeers_[work.to_.id_] ? shmTransport_.get() : nullptr)));
 
   std::vector<torch::Tensor> preamble = {torch::tensor(
       {(int64_t)pg_->getRank(),
@@ -506,7 +549,8 @@ void ProcessGroupAgent::enqueueSend(SendWork work) {
 
 bool ProcessGroupAgent::handleRecv(RecvWork& work) {
   torch::Tensor& payload = work.payload_;
-  auto data = wireDeserialize(payload.storage().data(), payload.numel());
+  auto data = wireDeserialize(
+      payload.storage().data(), payload.numel(), shmTransport_.get());
   Message message(
       std::move(data.first), std::move(data.second), work.type_, work.id_);
   if (message.isRequest()) {
@@ -862,6 +906,10 @@ std::unordered_map<std::string, std::string> ProcessGroupAgent::getMetrics() {
       metrics[kGilAverageWaitTime] = c10::to_string(avgGilWaitTime);
     }
   }
+  if (shmTransport_) {
+    auto shmMetrics = shmTransport_->getMetrics();
+    metrics.insert(shmMetrics.begin(), shmMetrics.end());
+  }
   return metrics;
 }
 
@@ -3,6 +3,7 @@
 #include <c10/core/thread_pool.h>
 #include <c10d/ProcessGroup.hpp>
 #include <torch/csrc/distributed/rpc/rpc_agent.h>
+#include <torch/csrc/distributed/rpc/shm_transport.h>
 
 #include <atomic>
 #include <thread>
@@ -17,9 +18,11 @@ struct ProcessGroupRpcBackendOptions : public RpcBackendOptions {
   ProcessGroupRpcBackendOptions(
       int num_send_recv_threads,
       float rpc_timeout,
-      std::string init_method)
+      std::string init_method,
+      bool shm_transport = false)
       : RpcBackendOptions(rpc_timeout, init_method),
-        numSendRecvThreads(num_send_recv_threads) {
+        numSendRecvThreads(num_send_recv_threads),
+        shmTransport(shm_transport) {
     TORCH_CHECK(
         num_send_recv_threads > 0,
         "Cannot create ProcessGroup RPC backend with ",
@@ -28,6 +31,9 @@ struct ProcessGroupRpcBackendOptions : public RpcBackendOptions {
   }
 
   int numSendRecvThreads;
+  // Send large tensors through shared memory to peers on the same host that
+  // enabled it too, see ShmTensorTransport.
+  bool shmTransport;
 };
 
 // SendWork and RecvWork will be put into a task queue, and later picked up by
@@ -62,7 +68,8 @@ class ProcessGroupAgent : public RpcAgent {
       std::string workerName,
       std::shared_ptr<c10d::ProcessGroup> pg,
       int numSendRecvThreads,
-      std::chrono::milliseconds rpcTimeout);
+      std::chrono::milliseconds rpcTimeout,
+      bool shmTransport = false);
 
   const WorkerInfo& getWorkerInfo(const std::string& workerName) const override;
 
@@ -148,6 +155,9 @@ class ProcessGroupAgent : public RpcAgent {
   };
 
   void collectNames();
+  // Finds the peers running on the same host with the shared memory transport
+  // enabled. Like collectNames(), this is collective.
+  void collectShmPeers(bool shmTransport);
   // handle a SendWork request. This serializes the payload inside the work
   // object, and sends the message to the receiver using the underlying
   // ProcessGroup.
@@ -214,6 +224,10 @@ class ProcessGroupAgent : public RpcAgent {
   // worker name -> rank
   std::unordered_map<std::string, worker_id_t> nameMap_;
   std::vector<WorkerInfo> allWorkerInfo_;
+  // Tensors sent to the ranks set in shmPeers_ go through shmTransport_, which
+  // is only created if the transport is enabled on this worker.
+  std::unique_ptr<ShmTensorTransport> shmTransport_;
+  std::vector<bool> shmPeers_;
   // record the number of messages sent to and received from each peer. The recv
   // counter is only marked after the message is processed. Join uses allgather
   // to collect all counts from all peers, uses these counters to detect global
@@ -0,0 +1,150 @@
+#include <torch/csrc/distributed/rpc/shm_transport.h>
+
+#include <libshm.h>
+#include <torch/csrc/jit/serialization/pickler.h>
+
+#include <unistd.h>
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+namespace {
+
+const std::string kShmTensorsShared = "agent.shm_tensors_shared";
+const std::string kShmTensorsCopied = "agent.shm_tensors_copied";
+const std::string kShmSegmentsCreated = "agent.shm_segments_created";
+const std::string kShmPoolBytes = "agent.shm_pool_bytes";
+
+size_t roundUpToPowerOfTwo(size_t n) {
+  size_t result = 1;
+  while (result < n) {
+    result <<= 1;
+  }
+  return result;
+}
+
+// The descriptor is "<manager handle>\n<filename>\n<size in bytes>"
+std::string makeDescriptor(
+    const char* managerHandle,
+    const char* filename,
+    size_t size) {
+  return c10::str(managerHandle, "\n", filename, "\n", size);
+}
+
+} // namespace
+
+ShmTensorTransport::ShmTensorTransport(size_t minBytes, size_t maxCachedBytes)
+    : minBytes_(minBytes), maxCachedBytes_(maxCachedBytes) {}
+
+std::string ShmTensorTransport::share(const jit::WriteableTensorData& data) {
+  const auto nbytes = data.sizeInBytes();
+  if (nbytes < minBytes_) {
+    return std::string();
+  }
+
+  const auto& dataPtr = data.storageDataPtr();
+  auto* ctx = THManagedMapAllocator::fromDataPtr(dataPtr);
+  if (ctx && ctx->data() == dataPtr.get()) {
+    ctx->incref();
+    ++numShared_;
+    return makeDescriptor(ctx->manager_handle(), ctx->filename(), nbytes);
+  }
+
+  const auto capacity = roundUpToPowerOfTwo(nbytes);
+  at::DataPtr segment;
+  ctx = acquireSegment(capacity, segment);
+  memcpy(ctx->data(), data.data(), nbytes);
+  ++numCopied_;
+  return makeDescriptor(ctx->manager_handle(), ctx->filename(), capacity);
+}
+
+at::DataPtr ShmTensorTransport::open(const std::string& descriptor) {
+  const auto filenamePos = descriptor.find('\n');
+  const auto sizePos = filenamePos == std::string::npos
+      ? std::string::npos
+      : descriptor.find('\n', filenamePos + 1);
+  TORCH_CHECK(
+      sizePos != std::string::npos,
+      "Invalid shared memory tensor descriptor: ",
+      descriptor);
+  const auto managerHandle = descriptor.substr(0, filenamePos);
+  const auto filename =
+      descriptor.substr(filenamePos + 1, sizePos - filenamePos - 1);
+  const auto size = c10::stoll(descriptor.substr(sizePos + 1));
+
+  auto dataPtr = THManagedMapAllocator::makeDataPtr(
+      managerHandle.c_str(),
+      filename.c_str(),
+      TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE,
+      size);
+  // Drop the reference the sender took for us, our mapping holds its own.
+  THManagedMapAllocator::fromDataPtr(dataPtr)->decref();
+  return dataPtr;
+}
+
+THManagedMapAllocator* ShmTensorTransport::acquireSegment(
+    size_t capacity,
+    at::DataPtr& segment) {
+  std::lock_guard<std::mutex> guard(poolMutex_);
+  auto& pooled = segments_[capacity];
+  for (const auto& dataPtr : pooled) {
+    auto* ctx = THManagedMapAllocator::fromDataPtr(dataPtr);
+    // Only the pool references the segment, every receiver released it.
+    if (ctx->refcount() == 1) {
+      ctx->incref();
+      return ctx;
+    }
+  }
+
+  const auto handle = c10::str("/torch_", getpid(), "_", randomDevice_());
+  auto dataPtr = THManagedMapAllocator::makeDataPtr(
+      "",
+      handle.c_str(),
+      TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE,
+      capacity);
+  auto* ctx = THManagedMapAllocator::fromDataPtr(dataPtr);
+  ctx->incref();
+  ++numSegmentsCreated_;
+  if (reserveLocked(capacity)) {
+    pooled.push_back(std::move(dataPtr));
+    cachedBytes_ += capacity;
+  } else {
+    // The pool is full of segments in use, the receiver's reference keeps
+    // this one alive once the caller drops it.
+    segment = std::move(dataPtr);
+  }
+  return ctx;
+}
+
+bool ShmTensorTransport::reserveLocked(size_t nbytes) {
+  for (auto& entry : segments_) {
+    auto& pooled = entry.second;
+    auto it = pooled.begin();
+    while (cachedBytes_ + nbytes > maxCachedBytes_ && it != pooled.end()) {
+      if (THManagedMapAllocator::fromDataPtr(*it)->refcount() == 1) {
+        cachedBytes_ -= entry.first;
+        it = pooled.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  return cachedBytes_ + nbytes <= maxCachedBytes_;
+}
+
+std::unordered_map<std::string, std::string> ShmTensorTransport::getMetrics() {
+  std::unordered_map<std::string, std::string> metrics;
+  metrics[kShmTensorsShared] = c10::to_string(numShared_.load());
+  metrics[kShmTensorsCopied] = c10::to_string(numCopied_.load());
+  metrics[kShmSegmentsCreated] = c10::to_string(numSegmentsCreated_.load());
+  {
+    std::lock_guard<std::mutex> guard(poolMutex_);
+    metrics[kShmPoolBytes] = c10::to_string(cachedBytes_);
+  }
+  return metrics;
+}
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <torch/csrc/distributed/rpc/utils.h>
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+class THManagedMapAllocator;
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+// Storages smaller than this are sent inline, mapping a file costs more than
+// copying them.
+constexpr size_t kDefaultShmMinBytes = 64 * 1024;
+// Upper bound on the shared memory kept by the pool of a sender.
+constexpr size_t kDefaultShmMaxCachedBytes = 512 * 1024 * 1024;
+
+// WireTensorTransport for peers on the same host. Storages are sent as handles
+// to shared memory files registered with torch_shm_manager (see
+// torch/lib/libshm), and the receiver maps the file instead of copying the
+// data.
+//
+// Storages that already live in a named shared memory file (share_memory_()
+// with the file_system sharing strategy) are sent without any copy, so the
+// receiver sees later writes to them, as with torch.multiprocessing. Other
+// storages are copied once into a segment of a pool owned by the sender. Segments are refcounted across processes by
+// THRefcountedMapAllocator, and reused once every receiver has released them.
+//
+// The sender takes a reference on behalf of the receiver before the handle is
+// sent, which the receiver drops after mapping the file, so the file can't be
+// freed in between. The segment of a message that is never received stays
+// allocated until torch_shm_manager cleans up at exit.
+class ShmTensorTransport : public WireTensorTransport {
+ public:
+  explicit ShmTensorTransport(
+      size_t minBytes = kDefaultShmMinBytes,
+      size_t maxCachedBytes = kDefaultShmMaxCachedBytes);
+
+  std::string share(const jit::WriteableTensorData& data) override;
+
+  at::DataPtr open(const std::string& descriptor) override;
+
+  std::unordered_map<std::string, std::string> getMetrics();
+
+ private:
+  // Returns a segment of the given capacity with a reference taken for the
+  // receiver. Pooled segments are owned by the pool and segment is left empty,
+  // otherwise segment owns the sender's mapping.
+  THManagedMapAllocator* acquireSegment(size_t capacity, at::DataPtr& segment);
+  // Frees unused pooled segments until nbytes more fit in the pool, returns
+  // whether they do. Requires poolMutex_.
+  bool reserveLocked(size_t nbytes);
+
+  const size_t minBytes_;
+  const size_t maxCachedBytes_;
+
+  std::mutex poolMutex_;
+  // Pooled segments by capacity (a power of two), each holding the pool's own
+  // reference.
+  std::unordered_map<size_t, std::vector<at::DataPtr>> segments_;
+  size_t cachedBytes_{0};
+  std::random_device randomDevice_;
+
+  std::atomic<uint64_t> numShared_{0};
+  std::atomic<uint64_t> numCopied_{0};
+  std::atomic<uint64_t> numSegmentsCreated_{0};
+};
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
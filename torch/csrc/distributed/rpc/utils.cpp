@@ -155,6 +155,9 @@ namespace {
 //    - "payload" - the payload bits
 //    - "meta"    - metadata for the unpickler
 //    - "0" ...   - tensor sections for the unpickler
+//    - "external_0" ...
+//                - descriptors of tensor sections passed out of band by a
+//                  WireTensorTransport, in place of the "0" ... sections
 //
 // Note that per the header comments, the format is subject to change,
 // and is best used for rpcs, rather than persistent disk storage.
@@ -212,6 +215,7 @@ parseWireSections(const void* data, size_t data_size) {
 
 static const char* kMeta = "meta";
 static const char* kPayload = "payload";
+static const std::string kExternalPrefix = "external_";
 }; // namespace
 
 c10::List<at::Tensor> cloneSparseTensors(
@@ -240,7 +244,8 @@ c10::List<at::Tensor> cloneSparseTensors(
 
 std::string wireSerialize(
     const std::vector<char>& payload,
-    const std::vector<at::Tensor>& tensors) {
+    const std::vector<at::Tensor>& tensors,
+    WireTensorTransport* transport) {
   for (const auto& tensor : tensors) {
     TORCH_CHECK(
         tensor.device().is_cpu(),
@@ -258,6 +263,7 @@ std::string wireSerialize(
   std::vector<Ent> entries;
   std::string metaEntry;
   std::vector<jit::WriteableTensorData> tensorData;
+  std::vector<std::string> externalDescriptors;
 
   if (!payload.empty()) {
     entries.push_back({kPayload, payload.data(), payload.size()});
@@ -274,7 +280,18 @@ std::string wireSerialize(
     // tensorData is in function scope so that the data() pointers stay valid.
     tensorData = pickler.tensorData();
     entries.push_back({kMeta, metaEntry.data(), metaEntry.size()});
+    // Reserved so that the data() pointers stay valid.
+    externalDescriptors.reserve(tensorData.size());
     for (size_t i = 0; i < tensorData.size(); i++) {
+      auto descriptor =
+          transport ? transport->share(tensorData[i]) : std::string();
+      if (!descriptor.empty()) {
+        externalDescriptors.push_back(std::move(descriptor));
+        entries.push_back({kExternalPrefix + c10::to_string(i),
+                           externalDescriptors.back().data(),
+                           externalDescriptors.back().size()});
+        continue;
+      }
       entries.push_back({c10::to_string(i),
                          tensorData[i].data(),
                          tensorData[i].sizeInBytes()});
@@ -303,7 +320,8 @@ std::string wireSerialize(
 
 std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
     const void* data,
-    size_t data_size) {
+    size_t data_size,
+    WireTensorTransport* transport) {
   auto sections = parseWireSections(data, data_size);
 
   std::vector<char> payload;
@@ -331,7 +349,18 @@ std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
     auto sectionReadFunc = [&](const std::string& ename) -> at::DataPtr {
       auto it = sections.find(ename);
       if (it == sections.end()) {
-        throw std::runtime_error("Couldn't find entity " + ename);
+        auto externalIt = sections.find(kExternalPrefix + ename);
+        if (externalIt == sections.end()) {
+          throw std::runtime_error("Couldn't find entity " + ename);
+        }
+        TORCH_CHECK(
+            transport,
+            "Tensor ",
+            ename,
+            " was sent out of band, but no tensor transport is enabled");
+        const auto& descriptor = externalIt->second;
+        return transport->open(
+            std::string(descriptor.first, descriptor.second));
       }
       const auto& idat = it->second;
       auto dptr = at::getCPUAllocator()->allocate(idat.second);
@@ -4,6 +4,10 @@
 #include <torch/csrc/distributed/rpc/rpc_command_base.h>
 
 namespace torch {
+namespace jit {
+struct WriteableTensorData;
+} // namespace jit
+
 namespace distributed {
 namespace rpc {
 
@@ -30,15 +34,32 @@ IValue deserializeResptoIValueInternal(
     MessageType messageType);
 TORCH_API IValue deserializeRespToIValue(const Message& message);
 
+// Passes tensor storages out of band in wireSerialize() and
+// wireDeserialize(), e.g. through shared memory when both ends of the wire are
+// on the same host. Only a descriptor of the storage is put on the wire.
+class TORCH_API WireTensorTransport {
+ public:
+  virtual ~WireTensorTransport() = default;
+
+  // Returns the descriptor to send instead of the storage bytes, or an empty
+  // string to send the bytes inline.
+  virtual std::string share(const jit::WriteableTensorData& data) = 0;
+
+  // Returns the storage for a descriptor returned by share() on the sender.
+  virtual at::DataPtr open(const std::string& descriptor) = 0;
+};
+
 // Note: format is subject to change and intended for RPCs.
 // For saving persistently to disk, use torch::save().
 TORCH_API std::string wireSerialize(
     const std::vector<char>& payload,
-    const std::vector<at::Tensor>& tensors);
+    const std::vector<at::Tensor>& tensors,
+    WireTensorTransport* transport = nullptr);
 
 TORCH_API std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
     const void* data,
-    size_t data_size);
+    size_t data_size,
+    WireTensorTransport* transport = nullptr);
 
 // TensorPipeEntry represents serialized tensorpipe message,
 // plus reserved tensor datas to keep memory lifetime.
@@ -15,6 +15,11 @@ static PyObject * THPStorage_(sharedDecref)(THPStorage *self, PyObject *noargs)
   if (ctx) {
     ctx->decref();
   }
+#ifndef _WIN32
+  if (auto block = THManagedSlabBlock::fromDataPtr(storage->data_ptr())) {
+    block->decref();
+  }
+#endif
 #endif
   Py_INCREF(self);
   return (PyObject *)self;
@@ -30,6 +35,11 @@ static PyObject * THPStorage_(sharedIncref)(THPStorage *self, PyObject *noargs)
   if (ctx) {
     ctx->incref();
   }
+#ifndef _WIN32
+  if (auto block = THManagedSlabBlock::fromDataPtr(storage->data_ptr())) {
+    block->incref();
+  }
+#endif
 #endif
   Py_RETURN_NONE;
   END_HANDLE_TH_ERRORS
@@ -129,6 +139,109 @@ static PyObject * THPStorage_(newSharedFilename)(PyObject *_unused, PyObject *ar
   END_HANDLE_TH_ERRORS
 }
 
+#ifndef _WIN32
+// Returns nullptr if the storage is too large for a slab block
+static THWStorage* THPStorage_(newSlabStorage)(ptrdiff_t size)
+{
+  auto block = THManagedSlabBlock::allocate(size * sizeof(scalar_t));
+  if (!block) {
+    return nullptr;
+  }
+  return THWStorage_(newWithDataAndAllocator)(std::move(block), size, /* allocator */ nullptr);
+}
+
+static PyObject * THPStorage_(pyNewSlabStorage)(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  long long size;
+  if (!PyArg_ParseTuple(args, "L", &size)) {
+    return nullptr;
+  }
+  THWStorage *storage = THPStorage_(newSlabStorage)(size);
+  if (!storage) {
+    storage = THPStorage_(newFilenameStorage)(size);
+  }
+  return THPStorage_(New)(storage);
+  END_HANDLE_TH_ERRORS
+}
+
+// Returns None for storages that are shared as files of their own (large
+// ones, or ones that already are), see _share_filename_
+static PyObject * THPStorage_(shareSlab)(THPStorage *self, PyObject *noargs)
+{
+  HANDLE_TH_ERRORS
+  THWStorage *storage = self->cdata;
+  THManagedSlabBlock *block;
+  // Storage is already in shared memory, just return a handle
+  if ((block = THManagedSlabBlock::fromDataPtr(storage->data_ptr()))) {
+    // done
+  } else if (THManagedMapAllocator::fromDataPtr(storage->data_ptr())) {
+    Py_RETURN_NONE;
+  } else {
+    THWStoragePtr new_storage(
+        THPStorage_(newSlabStorage)(storage->nbytes() / sizeof(scalar_t)));
+    if (!new_storage) {
+      Py_RETURN_NONE;
+    }
+    THWStorage_(copy)(new_storage, storage);
+    THWStorage_(swap)(storage, new_storage);
+    block = THManagedSlabBlock::fromDataPtr(storage->data_ptr());
+    AT_ASSERT(block);
+  }
+
+  THPObjectPtr manager_handle(PyBytes_FromString(block->manager_handle()));
+  if (!manager_handle) return nullptr;
+  THPObjectPtr segment_handle(PyBytes_FromString(block->filename()));
+  if (!segment_handle) return nullptr;
+  THPObjectPtr segment_size(PyLong_FromSize_t(block->segment_size()));
+  if (!segment_size) return nullptr;
+  THPObjectPtr offset(PyLong_FromSize_t(block->offset()));
+  if (!offset) return nullptr;
+  THPObjectPtr size(PyLong_FromLong(storage->nbytes() / sizeof(scalar_t)));
+  if (!size) return nullptr;
+
+  THPObjectPtr tuple(PyTuple_New(5));
+  if (!tuple) return nullptr;
+  PyTuple_SET_ITEM(tuple.get(), 0, manager_handle.release());
+  PyTuple_SET_ITEM(tuple.get(), 1, segment_handle.release());
+  PyTuple_SET_ITEM(tuple.get(), 2, segment_size.release());
+  PyTuple_SET_ITEM(tuple.get(), 3, offset.release());
+  PyTuple_SET_ITEM(tuple.get(), 4, size.release());
+  return tuple.release();
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject * THPStorage_(newSharedSlab)(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  THPUtils_assert(PyTuple_GET_SIZE(args) == 5, "tuple of 5 items expected");
+  PyObject *_manager_handle = PyTuple_GET_ITEM(args, 0);
+  PyObject *_segment_handle = PyTuple_GET_ITEM(args, 1);
+  PyObject *_segment_size = PyTuple_GET_ITEM(args, 2);
+  PyObject *_offset = PyTuple_GET_ITEM(args, 3);
+  PyObject *_size = PyTuple_GET_ITEM(args, 4);
+  if (!PyBytes_Check(_manager_handle) || !PyBytes_Check(_segment_handle) ||
+      !THPUtils_checkLong(_segment_size) || !THPUtils_checkLong(_offset) ||
+      !THPUtils_checkLong(_size)) {
+    THPUtils_invalidArguments(args, nullptr, "_new_shared in file system slab mode", 1,
+        "a manager handle, a segment handle (string/bytes), the segment size, the offset "
+        "of the storage in the segment and the storage size (int)");
+    return nullptr;
+  }
+  const char *manager_handle = PyBytes_AS_STRING(_manager_handle);
+  const char *segment_handle = PyBytes_AS_STRING(_segment_handle);
+  int64_t segment_size = THPUtils_unpackLong(_segment_size);
+  int64_t offset = THPUtils_unpackLong(_offset);
+  int64_t size = THPUtils_unpackLong(_size);
+  return THPStorage_(New)(
+          THWStorage_(newWithDataAndAllocator)(
+            THManagedSlabBlock::open(manager_handle, segment_handle, segment_size, offset, size * sizeof(scalar_t)),
+            size,
+            /* allocator */ nullptr));
+  END_HANDLE_TH_ERRORS
+}
+#endif
+
 static THWStorage* THPStorage_(newFdStorage)(ptrdiff_t size)
 {
   int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM |
@@ -520,9 +633,13 @@ PyObject * THPStorage_(isShared)(THPStorage *self, PyObject *noargs)
   if (THMapAllocator::fromDataPtr(self->cdata->data_ptr()) ||
       THManagedMapAllocator::fromDataPtr(self->cdata->data_ptr())) {
     Py_RETURN_TRUE;
-  } else {
-    Py_RETURN_FALSE;
   }
+#ifndef _WIN32
+  if (THManagedSlabBlock::fromDataPtr(self->cdata->data_ptr())) {
+    Py_RETURN_TRUE;
+  }
+#endif
+  Py_RETURN_FALSE;
 #endif
 }
 
@@ -539,6 +656,11 @@ static PyMethodDef THPStorage_(sharingMethods)[] = {
   {"_share_filename_", (PyCFunction)THPStorage_(shareFilename), METH_NOARGS, nullptr},
   {"_new_shared_filename", (PyCFunction)(void(*)(void))THPStorage_(newSharedFilename), METH_VARARGS | METH_STATIC, nullptr},
   {"_new_using_filename", (PyCFunction)(void(*)(void))THPStorage_(pyNewFilenameStorage), METH_VARARGS | METH_STATIC, nullptr},
+#ifndef _WIN32
+  {"_share_slab_", (PyCFunction)THPStorage_(shareSlab), METH_NOARGS, nullptr},
+  {"_new_shared_slab", (PyCFunction)(void(*)(void))THPStorage_(newSharedSlab), METH_VARARGS | METH_STATIC, nullptr},
+  {"_new_using_slab", (PyCFunction)(void(*)(void))THPStorage_(pyNewSlabStorage), METH_VARARGS | METH_STATIC, nullptr},
+#endif
 #endif
   {"_weak_ref", (PyCFunction)THPStorage_(weakRef), METH_NOARGS, nullptr},
   {"_free_weak_ref", (PyCFunction)(void(*)(void))THPStorage_(freeWeakRef), METH_O | METH_STATIC, nullptr},
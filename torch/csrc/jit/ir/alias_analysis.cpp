@@ -1216,22 +1216,29 @@ class AliasDb::WorkingSet {
   }
 
   bool hasMutabilityDependency(Node* n) const {
+    // The reads and writes of `n` are only computed if the working set has
+    // anything they could intersect with.
+
     // Check that `n` does not write to anything used by the working set
-    const auto& nWrites = aliasDb_.getWrites(n);
-    if (reads_.intersects(nWrites)) {
-      return true;
-    }
-    if (mover_ && moverReads_.intersects(nWrites)) {
-      return true;
+    if (!reads_.empty() || (mover_ && !moverReads_.empty())) {
+      const auto& nWrites = aliasDb_.getWrites(n);
+      if (reads_.intersects(nWrites)) {
+        return true;
+      }
+      if (mover_ && moverReads_.intersects(nWrites)) {
+        return true;
+      }
     }
 
     // Check that the working set doesn't write to anything that `n` uses.
-    const auto& nReads = aliasDb_.getReads(n);
-    if (writes_.intersects(nReads)) {
-      return true;
-    }
-    if (mover_ && moverWrites_.intersects(nReads)) {
-      return true;
+    if (!writes_.empty() || (mover_ && !moverWrites_.empty())) {
+      const auto& nReads = aliasDb_.getReads(n);
+      if (writes_.intersects(nReads)) {
+        return true;
+      }
+      if (mover_ && moverWrites_.intersects(nReads)) {
+        return true;
+      }
     }
     return false;
   }
@@ -1335,6 +1342,9 @@ bool AliasDb::tryMove(
   if (toMove == movePoint) {
     return true;
   }
+  if (tryMoveWithoutDependencies(toMove, movePoint, moveSide, dryRun)) {
+    return true;
+  }
 
   // 1. Move from `this` toward movePoint, building up the working set of
   // dependencies
@@ -1419,6 +1429,64 @@ bool AliasDb::tryMove(
   return true;
 }
 
+// Fast path of `tryMove()` for the common case where `toMove` can be moved on
+// its own: it has no mutability dependency with any node in the graph, its
+// inputs are produced before its new position and its outputs are used after
+// it. This only looks at the inputs and uses of `toMove`, instead of scanning
+// every node between `toMove` and `movePoint`.
+//
+// Returns false if the fast path doesn't apply, in which case the move may
+// still be possible by moving the dependencies of `toMove` along with it.
+bool AliasDb::tryMoveWithoutDependencies(
+    Node* toMove,
+    Node* movePoint,
+    MoveSide moveSide,
+    bool dryRun) {
+  if (!toMove->blocks().empty()) {
+    // The values used in the sub-blocks would need to be checked as well
+    return false;
+  }
+  if (!getWrites(toMove).empty() ||
+      writtenToLocationsIndex_->intersects(getReads(toMove))) {
+    return false;
+  }
+
+  // Is `n`, a node in the block of `toMove`, before the new position of
+  // `toMove`?
+  const auto isBeforeNewPosition = [&](const Node* n) {
+    if (moveSide == MoveSide::AFTER && n == movePoint) {
+      return true;
+    }
+    return n->isBefore(movePoint);
+  };
+
+  Block* block = toMove->owningBlock();
+  for (const auto input : toMove->inputs()) {
+    // Values from enclosing blocks are available anywhere in `block`
+    Node* producer = input->node();
+    if (producer->owningBlock() == block && !isBeforeNewPosition(producer)) {
+      return false;
+    }
+  }
+  for (const auto output : toMove->outputs()) {
+    for (const auto& use : output->uses()) {
+      // Uses in sub-blocks count as uses by the node that owns the sub-block
+      Node* user = use.user;
+      while (user->owningBlock() != block) {
+        user = user->owningBlock()->owningNode();
+      }
+      if (isBeforeNewPosition(user)) {
+        return false;
+      }
+    }
+  }
+
+  if (!dryRun) {
+    move(toMove, movePoint, moveSide);
+  }
+  return true;
+}
+
 // Helper function so we can generalize `tryMove`
 void AliasDb::move(Node* toMove, Node* movePoint, MoveSide moveSide) {
   switch (moveSide) {
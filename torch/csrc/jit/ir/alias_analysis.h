@@ -142,6 +142,11 @@ class AliasDb {
   class WorkingSet;
   enum class MoveSide { BEFORE, AFTER };
   bool tryMove(Node* toMove, Node* movePoint, MoveSide moveSide, bool dryRun);
+  bool tryMoveWithoutDependencies(
+      Node* toMove,
+      Node* movePoint,
+      MoveSide moveSide,
+      bool dryRun);
   void move(Node* toMove, Node* movePoint, MoveSide moveSide);
   bool isBeforeOrAfter(const Node* n, MoveSide moveSide) const;
 
@@ -16,6 +16,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -1181,7 +1182,7 @@ void Node::eraseOutput(size_t i) {
 
 Block* Node::addBlock() {
   op_ = nullptr;
-  blocks_.push_back(new Block(owningGraph(), this));
+  blocks_.push_back(owningGraph()->arena_.make<Block>(owningGraph(), this));
   return blocks_.back();
 }
 
@@ -1207,6 +1208,10 @@ void Node::destroy() {
   graph_->freeNode(this);
 }
 
+Node* Node::allocNewInstance(Graph* g) {
+  return g->arena_.make<Node>(g, kind());
+}
+
 void Node::cloneFrom(Node* s) {
   source_range_ = s->source_range_;
   if (s->scope_ && !s->scope_->isBlank()) {
@@ -1274,14 +1279,14 @@ void Node::replaceInputWith(Value* from, Value* to) {
 }
 
 Value* Node::addOutput() {
-  outputs_.push_back(new Value(this, outputs_.size()));
+  outputs_.push_back(graph_->arena_.make<Value>(this, outputs_.size()));
   op_ = nullptr;
   return outputs_.back();
 }
 
 Value* Node::insertOutput(size_t i) {
   op_ = nullptr;
-  outputs_.insert(outputs_.begin() + i, new Value(this, i));
+  outputs_.insert(outputs_.begin() + i, graph_->arena_.make<Value>(this, i));
   for (size_t itr = i + 1; itr < outputs_.size(); ++itr) {
     outputs_[itr]->setOffset(outputs_[itr]->offset() + 1);
   }
@@ -1509,7 +1514,7 @@ Value* Graph::insert(
 
 Node* Graph::create(NodeKind kind, size_t num_outputs) {
   // NB: Node constructor adds node to all_nodes
-  auto n = new Node(this, kind);
+  auto n = arena_.make<Node>(this, kind);
   for (size_t i = 0; i < num_outputs; i++) {
     n->addOutput();
   }
@@ -1789,35 +1794,46 @@ std::string Graph::toString(bool print_source_locations) const {
   return oss.str();
 }
 
+// Plain Nodes live in the arena of their graph (see Graph::create and
+// Node::allocNewInstance), while subclasses of Node allocate their instances
+// with new in their allocNewInstance.
+static void deleteNode(IRArena& arena, const Node* n) {
+  if (typeid(*n) == typeid(Node)) {
+    arena.destroy(n);
+  } else {
+    delete n;
+  }
+}
+
 Graph::~Graph() {
   for (const Node* n : all_nodes) {
-    delete n;
+    deleteNode(arena_, n);
   }
   for (const Value* v : all_values) {
-    delete v;
+    arena_.destroy(v);
   }
   for (const Block* b : all_blocks) {
-    delete b;
+    arena_.destroy(b);
   }
 }
 
 void Graph::freeNode(Node* n) {
   auto it = all_nodes.find(n);
   AT_ASSERT(it != all_nodes.end());
-  delete *it;
+  deleteNode(arena_, *it);
   all_nodes.erase(it);
 }
 void Graph::freeValue(Value* v) {
   v->setDebugName("");
   auto it = all_values.find(v);
   AT_ASSERT(it != all_values.end());
-  delete *it;
+  arena_.destroy(*it);
   all_values.erase(it);
 }
 void Graph::freeBlock(Block* b) {
   auto it = all_blocks.find(b);
   AT_ASSERT(it != all_blocks.end());
-  delete *it;
+  arena_.destroy(*it);
   all_blocks.erase(it);
 }
 
@@ -2,6 +2,7 @@
 
 #include <torch/csrc/jit/ir/attributes.h>
 #include <torch/csrc/jit/ir/graph_node_list.h>
+#include <torch/csrc/jit/ir/ir_arena.h>
 #include <torch/csrc/jit/ir/named_value.h>
 #include <torch/csrc/jit/ir/scope.h>
 #include <torch/csrc/jit/runtime/operator.h>
@@ -247,6 +248,7 @@ struct Value {
 
 struct TORCH_API Node {
   TH_DISALLOW_COPY_AND_ASSIGN(Node);
+  friend class IRArena;
   friend struct Graph;
   friend struct Block;
   friend struct Value;
@@ -856,9 +858,7 @@ struct TORCH_API Node {
   // of a node in another graph. It should allocate a new instance of the same
   // concrete type as 'this', but in graph 'g' which might be different
   // than graph_
-  virtual Node* allocNewInstance(Graph* g) {
-    return new Node(g, kind());
-  }
+  virtual Node* allocNewInstance(Graph* g);
   // create a copy of all properties of Node s into this.
   // subclasses should extend if they have additional information to copy.
   // 'this' will be allocated with s->allocNewInstance(g) so it should have
@@ -995,6 +995,10 @@ struct Graph {
   friend struct Block;
 
  private:
+  // memory of the plain Nodes, Values and Blocks of the graph; declared
+  // first so that it outlives them
+  IRArena arena_;
+
   // only used to keep track of allocated nodes
   // actual representation of Graph is done with
   // inputs, outputs, nodes
@@ -1017,7 +1021,7 @@ struct Graph {
   Graph(ScopePtr scope_root)
       : next_unique_(0),
         current_scope_(std::move(scope_root)),
-        block_(new Block(this, nullptr)),
+        block_(arena_.make<Block>(this, nullptr)),
         insert_before_(return_node()) {}
 
   Graph() : Graph(c10::make_intrusive<Scope>()) {}
@@ -0,0 +1,55 @@
+#include <torch/csrc/jit/ir/ir_arena.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace torch {
+namespace jit {
+
+IRArena::~IRArena() {
+  for (void* chunk : chunks_) {
+    std::free(chunk);
+  }
+}
+
+void* IRArena::allocate(size_t size) {
+  size = roundUp(std::max(size, sizeof(void*)));
+  const size_t size_class = size / kAlignment;
+  if (size_class < free_lists_.size() && free_lists_[size_class]) {
+    void* ptr = free_lists_[size_class];
+    free_lists_[size_class] = *static_cast<void**>(ptr);
+    return ptr;
+  }
+
+  if (static_cast<size_t>(end_ - cursor_) < size) {
+    // The rest of the current chunk is left unused
+    const size_t chunk_size = std::max(next_chunk_size_, size);
+    // malloc aligns to max_align_t
+    void* chunk = std::malloc(chunk_size);
+    if (!chunk) {
+      throw std::bad_alloc();
+    }
+    chunks_.push_back(chunk);
+    reserved_bytes_ += chunk_size;
+    cursor_ = static_cast<char*>(chunk);
+    end_ = cursor_ + chunk_size;
+    next_chunk_size_ = std::min(next_chunk_size_ * 2, kMaxChunkSize);
+  }
+  void* ptr = cursor_;
+  cursor_ += size;
+  return ptr;
+}
+
+void IRArena::deallocate(void* ptr, size_t size) {
+  size = roundUp(std::max(size, sizeof(void*)));
+  const size_t size_class = size / kAlignment;
+  if (size_class >= free_lists_.size()) {
+    free_lists_.resize(size_class + 1, nullptr);
+  }
+  *static_cast<void**>(ptr) = free_lists_[size_class];
+  free_lists_[size_class] = ptr;
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,73 @@
+#pragma once
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// IRArena holds the memory of the Nodes, Values and Blocks of a Graph.
+// Objects are bump allocated from large chunks, and the memory of destroyed
+// objects is kept in free lists by size to be reused by the next objects of
+// the same size, so passes that create and destroy many IR objects (inlining,
+// constant propagation, ...) don't go to the system allocator, and the
+// objects created together stay close in memory. Chunks are only returned
+// to the system when the arena is destroyed, together with its Graph.
+class TORCH_API IRArena {
+ public:
+  IRArena() = default;
+  ~IRArena();
+
+  template <typename T, typename... Args>
+  T* make(Args&&... args) {
+    void* ptr = allocate(sizeof(T));
+    try {
+      return new (ptr) T(std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(ptr, sizeof(T));
+      throw;
+    }
+  }
+
+  // obj must have been created by make<T>() on this arena, with the same T
+  template <typename T>
+  void destroy(const T* obj) {
+    obj->~T();
+    deallocate(const_cast<T*>(obj), sizeof(T));
+  }
+
+  void* allocate(size_t size);
+  void deallocate(void* ptr, size_t size);
+
+  // Bytes of the chunks allocated by the arena
+  size_t reservedBytes() const {
+    return reserved_bytes_;
+  }
+
+ private:
+  IRArena(const IRArena&) = delete;
+  IRArena& operator=(const IRArena&) = delete;
+
+  static constexpr size_t kAlignment = alignof(std::max_align_t);
+  static constexpr size_t kFirstChunkSize = 16 * 1024;
+  static constexpr size_t kMaxChunkSize = 1024 * 1024;
+
+  static size_t roundUp(size_t size) {
+    return (size + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  std::vector<void*> chunks_;
+  char* cursor_ = nullptr;
+  char* end_ = nullptr;
+  size_t next_chunk_size_ = kFirstChunkSize;
+  size_t reserved_bytes_ = 0;
+  // Heads of the lists of freed blocks, by size / kAlignment. Each free block
+  // starts with a pointer to the next one.
+  std::vector<void*> free_lists_;
+};
+
+} // namespace jit
+} // namespace torch
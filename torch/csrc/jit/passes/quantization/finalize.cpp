@@ -1,6 +1,7 @@
 #include <torch/csrc/jit/passes/quantization/finalize.h>
 #include <torch/csrc/jit/passes/freeze_module.h>
 #include <torch/csrc/jit/passes/prepack_folding.h>
+#include <torch/csrc/jit/passes/quantization/fuse_elementwise.h>
 #include <torch/csrc/jit/passes/quantization/quantization_patterns.h>
 
 namespace torch {
@@ -125,10 +126,13 @@ void FoldQuantizedPrepackingOps(Module& module) {
   PrePackingOpsFolder(module, filter_fn, "quantized");
 }
 
-Module Finalize(Module& module, bool is_dynamic) {
+Module Finalize(Module& module, bool is_dynamic, bool fuse_elementwise) {
   auto graph = module.get_method("forward").graph();
   InsertPrepackUnpack(graph);
   QuantFusion(graph, is_dynamic);
+  if (fuse_elementwise && !is_dynamic) {
+    FuseQuantizedElementwise(graph);
+  }
   auto frozen = freeze_module(module);
   FoldQuantizedPrepackingOps(frozen);
   return frozen;
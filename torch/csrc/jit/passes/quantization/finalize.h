@@ -46,9 +46,18 @@ TORCH_API void InsertPrepackUnpack(std::shared_ptr<Graph>& graph);
  */
 TORCH_API void InsertPrepackUnpack(Module& module);
 
+/** \brief Finalizes the quantized module: fuses the quantized ops, freezes
+ * the module and folds the prepacking ops.
+ *
+ * \param fuse_elementwise also runs FuseQuantizedElementwise for static
+ * quantization. The fused chains of elementwise ops don't round their
+ * intermediate values to their quantization, so results may differ from the
+ * unfused ops by rounding.
+ */
 TORCH_API script::Module Finalize(
     script::Module& module,
-    bool is_dynamic = false);
+    bool is_dynamic = false,
+    bool fuse_elementwise = false);
 
 TORCH_API void FoldQuantizedPrepackingOps(Module& module);
 
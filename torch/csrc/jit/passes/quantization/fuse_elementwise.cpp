@@ -0,0 +1,275 @@
+#include <torch/csrc/jit/passes/quantization/fuse_elementwise.h>
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// relu keeps the quantization of its input, so clamping the output of the
+// quantized op at its zero point gives the same result
+void foldReluIntoQuantizedOps(std::shared_ptr<Graph>& graph) {
+  const std::vector<std::pair<std::string, std::string>> ops = {
+      {"quantized::linear", "quantized::linear_relu"},
+      {"quantized::conv1d", "quantized::conv1d_relu"},
+      {"quantized::conv2d", "quantized::conv2d_relu"},
+      {"quantized::conv3d", "quantized::conv3d_relu"},
+      {"quantized::add", "quantized::add_relu"},
+      {"quantized::mul", "quantized::mul_relu"}};
+  for (const auto& item : ops) {
+    // All of them take two tensor inputs and the output quantization
+    const std::string op_with_relu = R"(
+graph(%a_quant, %b, %r_scale, %r_zero_point):
+        %r = )" + item.first +
+        R"((%a_quant, %b, %r_scale, %r_zero_point)
+        %r_relu = aten::relu(%r)
+        return (%r_relu) )";
+    const std::string op_with_inplace_relu = R"(
+graph(%a_quant, %b, %r_scale, %r_zero_point):
+        %r = )" + item.first +
+        R"((%a_quant, %b, %r_scale, %r_zero_point)
+        %r_relu = aten::relu_(%r)
+        return (%r_relu) )";
+    const std::string fused_op = R"(
+graph(%a_quant, %b, %r_scale, %r_zero_point):
+        %r_relu = )" + item.second +
+        R"((%a_quant, %b, %r_scale, %r_zero_point)
+        return (%r_relu) )";
+    for (const auto& pattern : {op_with_relu, op_with_inplace_relu}) {
+      SubgraphRewriter rewriter;
+      rewriter.RegisterRewritePattern(pattern, fused_op);
+      rewriter.runOnGraph(graph);
+    }
+  }
+}
+
+// Whether n is a quantized op with a quantized output, the dynamic ones
+// output float tensors
+bool isQuantizedOp(const Node* n) {
+  static const Symbol quantized_ns =
+      Symbol::fromQualString("namespaces::quantized");
+  if (n->kind().ns() != quantized_ns) {
+    return false;
+  }
+  const std::string name = n->kind().toUnqualString();
+  return name.find("dynamic") == std::string::npos;
+}
+
+bool isQuantizedAdd(const Node* n) {
+  return n->kind() == Symbol::fromQualString("quantized::add") ||
+      n->kind() == Symbol::fromQualString("quantized::add_relu");
+}
+
+bool isQuantizedMul(const Node* n) {
+  return n->kind() == Symbol::fromQualString("quantized::mul") ||
+      n->kind() == Symbol::fromQualString("quantized::mul_relu");
+}
+
+bool isClampOp(const Node* n) {
+  return n->kind() == aten::hardtanh || n->kind() == aten::clamp;
+}
+
+// Whether v is known to be a quantized tensor, the aten ops of the chains
+// run on quantized tensors only after a quantized op
+bool isQuantizedValue(const Value* v) {
+  const Node* n = v->node();
+  if (isQuantizedOp(n) || n->kind() == aten::quantize_per_tensor) {
+    return true;
+  }
+  if (n->kind() == aten::relu || isClampOp(n)) {
+    return isQuantizedValue(n->input(0));
+  }
+  return false;
+}
+
+// Constant bound of clamp, a missing bound doesn't clamp
+c10::optional<double> getClampBound(const Value* v, double missing) {
+  auto ivalue = toIValue(v);
+  if (!ivalue) {
+    return c10::nullopt;
+  }
+  if (ivalue->isNone()) {
+    return missing;
+  }
+  if (!ivalue->isDouble() && !ivalue->isInt()) {
+    return c10::nullopt;
+  }
+  return ivalue->toScalar().toDouble();
+}
+
+struct ElementwiseChain {
+  std::vector<Node*> nodes;
+  Value* input = nullptr;
+  Value* other = nullptr;
+  std::vector<std::string> ops;
+  std::vector<double> args;
+  std::vector<Value*> scales;
+  std::vector<Value*> zero_points;
+
+  // Adds n to the chain if it can run as part of quantized::elementwise.
+  // value is the output of the chain that n uses, or nullptr if n starts the
+  // chain. Leaves the chain as is if n can't be added.
+  bool add(Node* n, Value* value) {
+    if (isQuantizedAdd(n) || isQuantizedMul(n)) {
+      if (other) {
+        return false;
+      }
+      Value* a = n->input(0);
+      Value* b = n->input(1);
+      if (!value) {
+        input = a;
+        other = b;
+      } else if (a == value && b != value) {
+        other = b;
+      } else if (b == value && a != value) {
+        other = a;
+      } else {
+        return false;
+      }
+      ops.push_back(isQuantizedAdd(n) ? "add" : "mul");
+      if (n->kind() == Symbol::fromQualString("quantized::add_relu") ||
+          n->kind() == Symbol::fromQualString("quantized::mul_relu")) {
+        ops.push_back("relu");
+      }
+      scales.push_back(n->input(2));
+      zero_points.push_back(n->input(3));
+    } else if (n->kind() == Symbol::fromQualString("quantized::hardswish")) {
+      ops.push_back("hardswish");
+      scales.push_back(n->input(1));
+      zero_points.push_back(n->input(2));
+    } else if (n->kind() == aten::relu) {
+      if (!value && !isQuantizedValue(n->input(0))) {
+        return false;
+      }
+      ops.push_back("relu");
+    } else if (isClampOp(n)) {
+      if (!value && !isQuantizedValue(n->input(0))) {
+        return false;
+      }
+      const auto min = getClampBound(
+          n->input(1), -std::numeric_limits<double>::infinity());
+      const auto max = getClampBound(
+          n->input(2), std::numeric_limits<double>::infinity());
+      if (!min || !max) {
+        return false;
+      }
+      ops.push_back("clamp");
+      args.push_back(*min);
+      args.push_back(*max);
+    } else {
+      return false;
+    }
+    if (!input) {
+      input = n->input(0);
+    }
+    nodes.push_back(n);
+    return true;
+  }
+};
+
+void collectElementwiseChains(
+    Block* block,
+    const AliasDb& alias_db,
+    std::unordered_set<Node*>* visited,
+    std::vector<ElementwiseChain>* chains) {
+  for (Node* n : block->nodes()) {
+    for (Block* sub_block : n->blocks()) {
+      collectElementwiseChains(sub_block, alias_db, visited, chains);
+    }
+    if (visited->count(n)) {
+      continue;
+    }
+    ElementwiseChain chain;
+    if (!chain.add(n, nullptr)) {
+      continue;
+    }
+    Node* last = n;
+    while (last->outputs().size() == 1 &&
+           last->output()->uses().size() == 1) {
+      Node* user = last->output()->uses()[0].user;
+      if (user->owningBlock() != block || !chain.add(user, last->output())) {
+        break;
+      }
+      last = user;
+    }
+    // The fused op reads the inputs where the last op of the chain was, so
+    // nothing may write to them in between
+    if (chain.nodes.size() < 2 || alias_db.hasWriters(chain.input) ||
+        (chain.other && alias_db.hasWriters(chain.other))) {
+      continue;
+    }
+    visited->insert(chain.nodes.begin(), chain.nodes.end());
+    chains->push_back(std::move(chain));
+  }
+}
+
+// A chain stops at its second add or mul, which starts the next chain, so
+// the input of a chain can be the output of the chain before it. replaced
+// maps the outputs of the chains replaced so far to their fused op.
+void replaceElementwiseChain(
+    Graph* graph,
+    const ElementwiseChain& chain,
+    std::unordered_map<Value*, Value*>* replaced) {
+  const auto remap = [&](Value* v) {
+    auto it = replaced->find(v);
+    return it == replaced->end() ? v : it->second;
+  };
+  Node* last = chain.nodes.back();
+  WithInsertPoint guard(last);
+  c10::List<std::string> ops;
+  for (const auto& op : chain.ops) {
+    ops.push_back(op);
+  }
+  c10::List<double> args;
+  for (double arg : chain.args) {
+    args.push_back(arg);
+  }
+  Value* other =
+      chain.other ? remap(chain.other) : graph->insertConstant(IValue());
+  Value* scales =
+      graph->insertNode(graph->createList(FloatType::get(), chain.scales))
+          ->output();
+  Value* zero_points =
+      graph->insertNode(graph->createList(IntType::get(), chain.zero_points))
+          ->output();
+  Value* fused = graph->insert(
+      Symbol::fromQualString("quantized::elementwise"),
+      {remap(chain.input),
+       other,
+       graph->insertConstant(ops),
+       graph->insertConstant(args),
+       scales,
+       zero_points});
+  last->output()->replaceAllUsesWith(fused);
+  (*replaced)[last->output()] = fused;
+  for (auto it = chain.nodes.rbegin(); it != chain.nodes.rend(); ++it) {
+    (*it)->destroy();
+  }
+}
+
+} // namespace
+
+void FuseQuantizedElementwise(std::shared_ptr<Graph>& graph) {
+  foldReluIntoQuantizedOps(graph);
+  std::vector<ElementwiseChain> chains;
+  {
+    AliasDb alias_db(graph);
+    std::unordered_set<Node*> visited;
+    collectElementwiseChains(graph->block(), alias_db, &visited, &chains);
+  }
+  std::unordered_map<Value*, Value*> replaced;
+  for (const auto& chain : chains) {
+    replaceElementwiseChain(graph.get(), chain, &replaced);
+  }
+  GRAPH_DUMP("After FuseQuantizedElementwise: ", graph);
+}
+
+} // namespace jit
+} // namespace torch
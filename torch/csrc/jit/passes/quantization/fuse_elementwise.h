@@ -0,0 +1,29 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Fuses the elementwise ops of a quantized graph, run after
+ * QuantFusion.
+ *
+ * A relu that follows quantized::linear, quantized::conv{1,2,3}d,
+ * quantized::add or quantized::mul is folded into the op, e.g.
+ * relu(quantized::linear(...)) --> quantized::linear_relu(...)
+ *
+ * A chain of quantized elementwise ops where each op only feeds the next one,
+ * e.g.
+ * relu(quantized::hardswish(quantized::add(a, b, s1, z1), s2, z2))
+ * is replaced by a single quantized::elementwise op that reads its inputs
+ * and writes its output once, instead of making a pass over memory and
+ * requantizing for each op. The chain can have relu, hardtanh and clamp
+ * with constant bounds, quantized::hardswish and at most one of
+ * quantized::add, quantized::mul and their relu variants.
+ *
+ * \param graph the graph we want to apply fusion
+ */
+TORCH_API void FuseQuantizedElementwise(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -41,6 +41,7 @@
 #include <torch/csrc/jit/passes/peephole.h>
 #include <torch/csrc/jit/passes/quantization/dedup_module_uses.h>
 #include <torch/csrc/jit/passes/quantization/finalize.h>
+#include <torch/csrc/jit/passes/quantization/fuse_elementwise.h>
 #include <torch/csrc/jit/passes/quantization/insert_observers.h>
 #include <torch/csrc/jit/passes/quantization/insert_quant_dequant.h>
 #include <torch/csrc/jit/passes/remove_dropout.h>
@@ -65,6 +66,7 @@
 #include <torch/csrc/jit/runtime/jit_exception.h>
 #include <torch/csrc/jit/runtime/operator.h>
 #include <torch/csrc/jit/runtime/print_handler.h>
+#include <torch/csrc/jit/runtime/static/init.h>
 #include <torch/csrc/jit/serialization/export.h>
 #include <torch/csrc/jit/serialization/import.h>
 #include <torch/csrc/jit/tensorexpr/execution_counter.h>
@@ -216,6 +218,9 @@ void initJITBindings(PyObject* module) {
       .def(
           "_jit_pass_quant_fusion",
           [](std::shared_ptr<Graph>& g) { return QuantFusion(g); })
+      .def(
+          "_jit_pass_quant_fuse_elementwise",
+          [](std::shared_ptr<Graph>& g) { return FuseQuantizedElementwise(g); })
       .def("_jit_pass_fold_convbn", &FoldConvBatchNorm2d)
       .def(
           "_freeze_module",
@@ -233,11 +238,12 @@ void initJITBindings(PyObject* module) {
           [](Module& module) { SwapFunctionalLinear(module); })
       .def(
           "_jit_pass_quant_finalize",
-          [](Module& module, bool is_dynamic) {
-            return Finalize(module, is_dynamic);
+          [](Module& module, bool is_dynamic, bool fuse_elementwise) {
+            return Finalize(module, is_dynamic, fuse_elementwise);
           },
           py::arg("module"),
-          py::arg("is_dynamic") = false)
+          py::arg("is_dynamic") = false,
+          py::arg("fuse_elementwise") = false)
       .def(
           "_jit_pass_pattern_based_rewrite",
           [](const Module& m) { return PatternBasedRewrite(m); })
@@ -903,6 +909,7 @@ void initJITBindings(PyObject* module) {
   initTreeViewBindings(module);
   initJitScriptBindings(module);
   initJitBackendBindings(module);
+  initStaticRuntimeBindings(module);
 
   setPrintHandler([](const std::string& str) {
     py::gil_scoped_acquire acquire;
@@ -0,0 +1,325 @@
+#include <torch/csrc/jit/runtime/static/impl.h>
+
+#include <ATen/core/grad_mode.h>
+#include <torch/csrc/jit/passes/constant_propagation.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/passes/inliner.h>
+#include <torch/csrc/jit/passes/peephole.h>
+#include <torch/csrc/jit/runtime/vararg_functions.h>
+
+#include <algorithm>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Container constructors are emitted as dedicated instructions by the
+// interpreter rather than as operators, mirror that here.
+bool isInterpreterInstruction(Node* node) {
+  switch (node->kind()) {
+    case prim::ListConstruct:
+    case prim::ListUnpack:
+    case prim::TupleConstruct:
+    case prim::DictConstruct:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void checkSupported(Node* node) {
+  TORCH_CHECK(
+      node->blocks().empty(),
+      "Static runtime does not support control flow, found ",
+      node->kind().toQualString());
+  if (isInterpreterInstruction(node)) {
+    return;
+  }
+  TORCH_CHECK(
+      node->maybeOperator(),
+      "Static runtime does not support ",
+      node->kind().toQualString(),
+      ". Did you forget to freeze the module?");
+  TORCH_CHECK(
+      !node->hasSideEffects(),
+      "Static runtime only supports side-effect-free graphs, found ",
+      node->kind().toQualString());
+  if (auto schema = node->maybeSchema()) {
+    TORCH_CHECK(
+        !schema->is_mutable(),
+        "Static runtime does not support ops that mutate their inputs, found ",
+        *schema);
+  }
+}
+
+} // namespace
+
+ProcessedNode::ProcessedNode(
+    Node* node,
+    std::vector<size_t> inputs,
+    std::vector<size_t> outputs)
+    : node_(node), inputs_(std::move(inputs)), outputs_(std::move(outputs)) {
+  if (isInterpreterInstruction(node)) {
+    return;
+  }
+  fn_ = getStaticRuntimeOperation(node);
+  if (!fn_) {
+    op_ = node->getOperation();
+  }
+}
+
+void ProcessedNode::run(std::vector<IValue>& reg) const {
+  if (fn_) {
+    fn_(this, reg);
+  } else {
+    runBoxed(reg);
+  }
+}
+
+void ProcessedNode::runBoxed(std::vector<IValue>& reg) const {
+  Stack stack;
+  stack.reserve(std::max(inputs_.size(), outputs_.size()));
+  for (size_t i : inputs_) {
+    stack.emplace_back(reg[i]);
+  }
+  switch (node_->kind()) {
+    case prim::ListConstruct:
+      listConstruct(
+          stack, node_->output()->type()->expect<ListType>(), inputs_.size());
+      break;
+    case prim::ListUnpack:
+      listUnpack(stack, outputs_.size());
+      break;
+    case prim::TupleConstruct: {
+      auto type = node_->output()->type()->expect<TupleType>();
+      if (type->name().has_value()) {
+        namedTupleConstruct(stack, type, inputs_.size());
+      } else {
+        tupleConstruct(stack, inputs_.size());
+      }
+    } break;
+    case prim::DictConstruct:
+      dictConstruct(
+          stack, node_->output()->type()->expect<DictType>(), inputs_.size());
+      break;
+    default:
+      (*op_)(stack);
+      break;
+  }
+  TORCH_INTERNAL_ASSERT(stack.size() == outputs_.size());
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    reg[outputs_[i]] = std::move(stack[i]);
+  }
+}
+
+StaticRuntime::StaticRuntime(
+    std::shared_ptr<Graph> g,
+    const std::vector<IValue>& example_inputs)
+    : graph_(std::move(g)) {
+  init(example_inputs);
+}
+
+StaticRuntime::StaticRuntime(
+    const Module& m,
+    const std::vector<IValue>& example_inputs) {
+  Module module = m.deepcopy();
+  module.eval();
+  module = freeze_module(module);
+  graph_ = module.get_method("forward").graph()->copy();
+  // After freezing all attributes are constants, `self` must be unused
+  Value* self = graph_->inputs().at(0);
+  TORCH_CHECK(
+      self->uses().empty(),
+      "Static runtime requires a frozen module that does not use `self`");
+  graph_->eraseInput(0);
+  init(example_inputs);
+}
+
+void StaticRuntime::specializeInputs(const std::vector<IValue>& example_inputs) {
+  input_types_.assign(graph_->inputs().size(), nullptr);
+  if (example_inputs.empty()) {
+    return;
+  }
+  TORCH_CHECK(
+      example_inputs.size() == graph_->inputs().size(),
+      "Expected ",
+      graph_->inputs().size(),
+      " example inputs, got ",
+      example_inputs.size());
+  for (size_t i = 0; i < example_inputs.size(); ++i) {
+    const auto& example = example_inputs[i];
+    Value* input = graph_->inputs()[i];
+    if (!example.isTensor() || !input->type()->cast<TensorType>()) {
+      continue;
+    }
+    const auto& t = example.toTensor();
+    auto type = TensorType::create(
+        t.scalar_type(), t.device(), t.dim(), /*requires_grad=*/false);
+    input->setType(type);
+    input_types_[i] = type;
+  }
+}
+
+void StaticRuntime::checkInputs(const Stack& stack, size_t first_input) const {
+  for (size_t i = 0; i < input_types_.size(); ++i) {
+    const auto& type = input_types_[i];
+    if (!type) {
+      continue;
+    }
+    const auto& input = stack[first_input + i];
+    TORCH_CHECK(
+        input.isTensor(),
+        "Expected a tensor for input ",
+        i,
+        " of the static runtime");
+    const auto& t = input.toTensor();
+    TORCH_CHECK(
+        t.dim() == static_cast<int64_t>(*type->dim()) &&
+            t.scalar_type() == *type->scalarType() &&
+            t.device() == *type->device(),
+        "Static runtime was specialized on ",
+        *type,
+        " for input ",
+        i,
+        ", got a ",
+        t.dim(),
+        "-d ",
+        t.toString(),
+        " tensor");
+  }
+}
+
+void StaticRuntime::init(const std::vector<IValue>& example_inputs) {
+  Inline(*graph_);
+  specializeInputs(example_inputs);
+  // Folds aten::dim and friends on the specialized inputs, constant
+  // propagation then removes the branches that became dead
+  PeepholeOptimize(graph_);
+  ConstantPropagation(graph_);
+  EliminateDeadCode(graph_);
+
+  std::unordered_map<Value*, size_t> value_to_reg;
+  for (Node* node : graph_->nodes()) {
+    if (node->kind() != prim::Constant) {
+      continue;
+    }
+    auto ivalue = toIValue(node->output());
+    TORCH_INTERNAL_ASSERT(ivalue.has_value());
+    value_to_reg[node->output()] = constants_.size();
+    constants_.emplace_back(std::move(*ivalue));
+  }
+
+  size_t num_regs = constants_.size();
+  for (Value* input : graph_->inputs()) {
+    value_to_reg[input] = num_regs;
+    input_regs_.push_back(num_regs++);
+  }
+
+  for (Node* node : graph_->nodes()) {
+    if (node->kind() == prim::Constant) {
+      continue;
+    }
+    checkSupported(node);
+    std::vector<size_t> inputs;
+    inputs.reserve(node->inputs().size());
+    for (Value* v : node->inputs()) {
+      inputs.push_back(value_to_reg.at(v));
+    }
+    std::vector<size_t> outputs;
+    outputs.reserve(node->outputs().size());
+    for (Value* v : node->outputs()) {
+      value_to_reg[v] = num_regs;
+      outputs.push_back(num_regs++);
+    }
+    nodes_.emplace_back(node, std::move(inputs), std::move(outputs));
+  }
+  num_regs_ = num_regs;
+
+  for (Value* output : graph_->outputs()) {
+    size_t reg = value_to_reg.at(output);
+    output_regs_.push_back(reg);
+    if (reg >= constants_.size()) {
+      transient_output_regs_.push_back(reg);
+    }
+  }
+}
+
+std::unique_ptr<std::vector<IValue>> StaticRuntime::acquireRegisters() const {
+  {
+    std::lock_guard<std::mutex> guard(pool_mutex_);
+    if (!register_pool_.empty()) {
+      auto reg = std::move(register_pool_.back());
+      register_pool_.pop_back();
+      return reg;
+    }
+  }
+  auto reg = std::make_unique<std::vector<IValue>>(num_regs_);
+  std::copy(constants_.begin(), constants_.end(), reg->begin());
+  return reg;
+}
+
+void StaticRuntime::releaseRegisters(
+    std::unique_ptr<std::vector<IValue>> reg) const {
+  std::lock_guard<std::mutex> guard(pool_mutex_);
+  register_pool_.emplace_back(std::move(reg));
+}
+
+void StaticRuntime::run(Stack& stack) const {
+  const size_t num_inputs = input_regs_.size();
+  TORCH_CHECK(
+      stack.size() >= num_inputs,
+      "Expected ",
+      num_inputs,
+      " inputs to the static runtime, got ",
+      stack.size());
+  at::NoGradGuard no_grad;
+
+  // If a node throws the register file is simply dropped instead of being
+  // returned to the pool
+  auto reg_ptr = acquireRegisters();
+  auto& reg = *reg_ptr;
+  const size_t first_input = stack.size() - num_inputs;
+  checkInputs(stack, first_input);
+  for (size_t i = 0; i < num_inputs; ++i) {
+    reg[input_regs_[i]] = std::move(stack[first_input + i]);
+  }
+  drop(stack, num_inputs);
+
+  for (const auto& node : nodes_) {
+    node.run(reg);
+  }
+
+  for (size_t i : output_regs_) {
+    stack.emplace_back(reg[i]);
+  }
+  // Drop our references to the inputs and results so that the next run does
+  // not write into tensors the caller still holds
+  for (size_t i : input_regs_) {
+    reg[i] = IValue();
+  }
+  for (size_t i : transient_output_regs_) {
+    reg[i] = IValue();
+  }
+  releaseRegisters(std::move(reg_ptr));
+}
+
+std::vector<at::Tensor> StaticRuntime::run(
+    const std::vector<at::Tensor>& inps) const {
+  Stack stack(inps.begin(), inps.end());
+  run(stack);
+  std::vector<at::Tensor> outputs;
+  outputs.reserve(stack.size());
+  for (auto& output : stack) {
+    TORCH_CHECK(
+        output.isTensor(),
+        "Expected the graph to return tensors, got ",
+        output.tagKind());
+    outputs.emplace_back(std::move(output).toTensor());
+  }
+  return outputs;
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <ATen/core/ivalue.h>
+#include <ATen/core/stack.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/runtime/static/ops.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// A graph node flattened for the static runtime. All of its inputs and
+// outputs are resolved to slots of a register file when the runtime is built,
+// and the kernel is picked once: an unboxed SROperator if ops.cpp knows the
+// node, the boxed Operation otherwise.
+class TORCH_API ProcessedNode {
+ public:
+  ProcessedNode(
+      Node* node,
+      std::vector<size_t> inputs,
+      std::vector<size_t> outputs);
+
+  void run(std::vector<IValue>& reg) const;
+
+  Node* node() const {
+    return node_;
+  }
+
+  const IValue& input(size_t i, const std::vector<IValue>& reg) const {
+    return reg[inputs_[i]];
+  }
+
+  IValue& output(size_t i, std::vector<IValue>& reg) const {
+    return reg[outputs_[i]];
+  }
+
+  bool hasUnboxedOperation() const {
+    return static_cast<bool>(fn_);
+  }
+
+ private:
+  void runBoxed(std::vector<IValue>& reg) const;
+
+  Node* node_;
+  std::vector<size_t> inputs_;
+  std::vector<size_t> outputs_;
+  SROperator fn_;
+  c10::optional<Operation> op_;
+};
+
+// StaticRuntime runs frozen, side-effect-free inference graphs without the
+// GraphExecutor and the interpreter. The graph is flattened once into a
+// vector of ProcessedNodes that read and write a flat register file:
+//
+//   [ constants (weights) | graph inputs | node outputs ]
+//
+// Registers of intermediate values survive between runs so that out= kernels
+// can write into the tensors allocated on the previous run. The runtime itself
+// is immutable after construction and can be shared by any number of calling
+// threads; each concurrent call borrows its own register file from a pool.
+//
+// When example inputs are given, the graph is specialized on the rank, dtype
+// and device of every tensor input. This lets rank dependent branches, e.g.
+// the addmm fast path of F.linear, be folded away before the graph is
+// flattened. Sizes stay dynamic, but every later run must match the ranks
+// and dtypes of the example.
+//
+// Requirements on the graph after specialization: a single block without
+// control flow, no attribute access and no ops that mutate their inputs or
+// have side effects. Runs happen with gradient recording disabled.
+class TORCH_API StaticRuntime {
+ public:
+  explicit StaticRuntime(
+      std::shared_ptr<Graph> g,
+      const std::vector<IValue>& example_inputs = {});
+  // Freezes a copy of `m` (in eval mode) and uses its forward method.
+  // `example_inputs` do not include `self`.
+  explicit StaticRuntime(
+      const Module& m,
+      const std::vector<IValue>& example_inputs = {});
+
+  std::vector<at::Tensor> run(const std::vector<at::Tensor>& inps) const;
+
+  // Consumes the graph inputs on `stack` and leaves the outputs there
+  void run(Stack& stack) const;
+
+  const std::shared_ptr<Graph>& graph() const {
+    return graph_;
+  }
+
+  const std::vector<ProcessedNode>& nodes() const {
+    return nodes_;
+  }
+
+  size_t num_inputs() const {
+    return input_regs_.size();
+  }
+
+ private:
+  void init(const std::vector<IValue>& example_inputs);
+  void specializeInputs(const std::vector<IValue>& example_inputs);
+  void checkInputs(const Stack& stack, size_t first_input) const;
+
+  std::unique_ptr<std::vector<IValue>> acquireRegisters() const;
+  void releaseRegisters(std::unique_ptr<std::vector<IValue>> reg) const;
+
+  std::shared_ptr<Graph> graph_;
+  // Constant values including the frozen weights, in register order
+  std::vector<IValue> constants_;
+  std::vector<size_t> input_regs_;
+  // Specialized tensor type of every graph input, nullptr if not specialized
+  std::vector<TensorTypePtr> input_types_;
+  std::vector<size_t> output_regs_;
+  // Output registers that are not constants and must be cleared after a run
+  // so that the caller becomes the only owner of the results
+  std::vector<size_t> transient_output_regs_;
+  size_t num_regs_{0};
+  std::vector<ProcessedNode> nodes_;
+
+  mutable std::mutex pool_mutex_;
+  mutable std::vector<std::unique_ptr<std::vector<IValue>>> register_pool_;
+};
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,65 @@
+#include <torch/csrc/jit/runtime/static/init.h>
+
+#include <torch/csrc/jit/python/pybind_utils.h>
+#include <torch/csrc/jit/runtime/static/impl.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+std::vector<IValue> toExampleInputs(const py::args& args) {
+  std::vector<IValue> inputs;
+  inputs.reserve(args.size());
+  for (const auto& arg : args) {
+    inputs.emplace_back(toTypeInferredIValue(arg));
+  }
+  return inputs;
+}
+
+} // namespace
+
+void initStaticRuntimeBindings(PyObject* module) {
+  auto m = py::handle(module).cast<py::module>();
+  py::class_<StaticRuntime, std::shared_ptr<StaticRuntime>>(m, "StaticRuntime")
+      .def(
+          "run",
+          [](const StaticRuntime& self, py::args args) {
+            const auto& inputs = self.graph()->inputs();
+            TORCH_CHECK(
+                args.size() == inputs.size(),
+                "Expected ",
+                inputs.size(),
+                " inputs to the static runtime, got ",
+                args.size());
+            Stack stack;
+            stack.reserve(args.size());
+            for (size_t i = 0; i < args.size(); ++i) {
+              stack.emplace_back(toIValue(args[i], inputs[i]->type()));
+            }
+            {
+              pybind11::gil_scoped_release no_gil_guard;
+              self.run(stack);
+            }
+            return createPyObjectForStack(std::move(stack));
+          })
+      .def_property_readonly(
+          "graph", [](const StaticRuntime& self) { return self.graph(); });
+  // Optional trailing arguments are example inputs the runtime is specialized
+  // on, see StaticRuntime for details
+  m.def(
+       "_jit_to_static_runtime",
+       [](const std::shared_ptr<Graph>& g, py::args example_inputs) {
+         return std::make_shared<StaticRuntime>(
+             g->copy(), toExampleInputs(example_inputs));
+       })
+      .def(
+          "_jit_to_static_runtime",
+          [](const Module& module, py::args example_inputs) {
+            return std::make_shared<StaticRuntime>(
+                module, toExampleInputs(example_inputs));
+          });
+}
+
+} // namespace jit
+} // namespace torch
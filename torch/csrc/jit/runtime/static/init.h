@@ -0,0 +1,11 @@
+#pragma once
+
+#include <torch/csrc/jit/python/pybind.h>
+#include <torch/csrc/utils/pybind.h>
+
+namespace torch {
+namespace jit {
+// Initialize Python bindings for the static runtime
+void initStaticRuntimeBindings(PyObject* module);
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,193 @@
+#include <torch/csrc/jit/runtime/static/ops.h>
+
+#include <ATen/ATen.h>
+#include <torch/csrc/jit/runtime/static/impl.h>
+
+#include <algorithm>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Returns the tensor left in `out` by the previous run if the static runtime
+// is its only owner and it has the expected dtype and device, so that it can
+// be passed as the `out=` argument. Otherwise returns an undefined tensor and
+// the caller has to use the functional kernel. Tensors handed back to the
+// caller, or aliased by a view that is still alive, are never written to.
+at::Tensor reusableOutput(
+    const IValue& out,
+    c10::ScalarType dtype,
+    c10::Device device) {
+  if (!out.isTensor() || out.use_count() != 1) {
+    return at::Tensor();
+  }
+  at::Tensor t = out.toTensor();
+  if (!t.defined() || t.is_mkldnn() || t.is_sparse() || t.is_quantized() ||
+      t.requires_grad() || t.scalar_type() != dtype || t.device() != device ||
+      t.storage().use_count() != 1) {
+    return at::Tensor();
+  }
+  return t;
+}
+
+// Binary pointwise ops are only run out of place when no type promotion can
+// make the result dtype differ from the one of the preallocated output.
+bool sameTensorOptions(const at::Tensor& a, const at::Tensor& b) {
+  return a.scalar_type() == b.scalar_type() && a.device() == b.device() &&
+      a.dim() > 0 && b.dim() > 0;
+}
+
+SROperator unaryOutVariant(
+    at::Tensor (*fn)(const at::Tensor&),
+    at::Tensor& (*out_fn)(at::Tensor&, const at::Tensor&)) {
+  return [fn, out_fn](const ProcessedNode* p_node, std::vector<IValue>& reg) {
+    const auto& self = p_node->input(0, reg).toTensor();
+    IValue& out_ivalue = p_node->output(0, reg);
+    if (self.is_floating_point()) {
+      auto out = reusableOutput(out_ivalue, self.scalar_type(), self.device());
+      if (out.defined()) {
+        out_fn(out, self);
+        return;
+      }
+    }
+    out_ivalue = fn(self);
+  };
+}
+
+} // namespace
+
+SROperator getStaticRuntimeOperation(Node* n) {
+  if (n->matches(
+          "aten::add.Tensor(Tensor self, Tensor other, *, Scalar alpha=1) -> Tensor")) {
+    return [](const ProcessedNode* p_node, std::vector<IValue>& reg) {
+      const auto& self = p_node->input(0, reg).toTensor();
+      const auto& other = p_node->input(1, reg).toTensor();
+      const auto alpha = p_node->input(2, reg).toScalar();
+      IValue& out_ivalue = p_node->output(0, reg);
+      if (sameTensorOptions(self, other)) {
+        auto out =
+            reusableOutput(out_ivalue, self.scalar_type(), self.device());
+        if (out.defined()) {
+          at::add_out(out, self, other, alpha);
+          return;
+        }
+      }
+      out_ivalue = at::add(self, other, alpha);
+    };
+  }
+  if (n->matches("aten::mul.Tensor(Tensor self, Tensor other) -> Tensor")) {
+    return [](const ProcessedNode* p_node, std::vector<IValue>& reg) {
+      const auto& self = p_node->input(0, reg).toTensor();
+      const auto& other = p_node->input(1, reg).toTensor();
+      IValue& out_ivalue = p_node->output(0, reg);
+      if (sameTensorOptions(self, other)) {
+        auto out =
+            reusableOutput(out_ivalue, self.scalar_type(), self.device());
+        if (out.defined()) {
+          at::mul_out(out, self, other);
+          return;
+        }
+      }
+      out_ivalue = at::mul(self, other);
+    };
+  }
+  if (n->matches(
+          "aten::addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta=1, Scalar alpha=1) -> Tensor")) {
+    return [](const ProcessedNode* p_node, std::vector<IValue>& reg) {
+      const auto& self = p_node->input(0, reg).toTensor();
+      const auto& mat1 = p_node->input(1, reg).toTensor();
+      const auto& mat2 = p_node->input(2, reg).toTensor();
+      const auto beta = p_node->input(3, reg).toScalar();
+      const auto alpha = p_node->input(4, reg).toScalar();
+      IValue& out_ivalue = p_node->output(0, reg);
+      auto out = reusableOutput(out_ivalue, mat1.scalar_type(), mat1.device());
+      if (out.defined()) {
+        at::addmm_out(out, self, mat1, mat2, beta, alpha);
+        return;
+      }
+      out_ivalue = at::addmm(self, mat1, mat2, beta, alpha);
+    };
+  }
+  if (n->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
+    return [](const ProcessedNode* p_node, std::vector<IValue>& reg) {
+      const auto& self = p_node->input(0, reg).toTensor();
+      const auto& mat2 = p_node->input(1, reg).toTensor();
+      IValue& out_ivalue = p_node->output(0, reg);
+      auto out = reusableOutput(out_ivalue, self.scalar_type(), self.device());
+      if (out.defined()) {
+        at::mm_out(out, self, mat2);
+        return;
+      }
+      out_ivalue = at::mm(self, mat2);
+    };
+  }
+  if (n->matches("aten::relu(Tensor self) -> Tensor")) {
+    return [](const ProcessedNode* p_node, std::vector<IValue>& reg) {
+      const auto& self = p_node->input(0, reg).toTensor();
+      IValue& out_ivalue = p_node->output(0, reg);
+      auto out = reusableOutput(out_ivalue, self.scalar_type(), self.device());
+      if (out.defined()) {
+        // relu is threshold(self, 0, 0), see native/Activation.cpp
+        at::threshold_out(out, self, 0, 0);
+        return;
+      }
+      out_ivalue = at::relu(self);
+    };
+  }
+  if (n->matches("aten::sigmoid(Tensor self) -> Tensor")) {
+    return unaryOutVariant(at::sigmoid, at::sigmoid_out);
+  }
+  if (n->matches("aten::tanh(Tensor self) -> Tensor")) {
+    return unaryOutVariant(at::tanh, at::tanh_out);
+  }
+  if (n->matches("aten::cat(Tensor[] tensors, int dim=0) -> Tensor")) {
+    return [](const ProcessedNode* p_node, std::vector<IValue>& reg) {
+      const auto tensors = p_node->input(0, reg).toTensorVector();
+      const auto dim = p_node->input(1, reg).toInt();
+      IValue& out_ivalue = p_node->output(0, reg);
+      if (!tensors.empty()) {
+        const auto& first = tensors[0];
+        bool same_options = std::all_of(
+            tensors.begin(), tensors.end(), [&](const at::Tensor& t) {
+              return sameTensorOptions(first, t);
+            });
+        if (same_options) {
+          auto out =
+              reusableOutput(out_ivalue, first.scalar_type(), first.device());
+          if (out.defined()) {
+            at::cat_out(out, tensors, dim);
+            return;
+          }
+        }
+      }
+      out_ivalue = at::cat(tensors, dim);
+    };
+  }
+  // The ops below have no out= overload, calling them unboxed still saves
+  // building and tearing down a Stack for every invocation.
+  if (n->matches(
+          "aten::linear(Tensor input, Tensor weight, Tensor? bias=None) -> Tensor")) {
+    return [](const ProcessedNode* p_node, std::vector<IValue>& reg) {
+      const auto& input = p_node->input(0, reg).toTensor();
+      const auto& weight = p_node->input(1, reg).toTensor();
+      const auto& bias_ivalue = p_node->input(2, reg);
+      at::Tensor bias =
+          bias_ivalue.isNone() ? at::Tensor() : bias_ivalue.toTensor();
+      p_node->output(0, reg) = at::linear(input, weight, bias);
+    };
+  }
+  if (n->matches("aten::t(Tensor(a) self) -> Tensor(a)")) {
+    return [](const ProcessedNode* p_node, std::vector<IValue>& reg) {
+      p_node->output(0, reg) = p_node->input(0, reg).toTensor().t();
+    };
+  }
+  return nullptr;
+}
+
+bool canRunUnboxed(Node* n) {
+  return getStaticRuntimeOperation(n) != nullptr;
+}
+
+} // namespace jit
+} // namespace torch
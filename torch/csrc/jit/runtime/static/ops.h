@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ATen/core/ivalue.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/ir/ir.h>
+
+#include <functional>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+class ProcessedNode;
+
+// An unboxed kernel for the static runtime. It reads its arguments straight
+// out of the register file through the ProcessedNode's pre-resolved input
+// indices and writes its results back the same way, so no Stack is built.
+using SROperator =
+    std::function<void(const ProcessedNode*, std::vector<IValue>&)>;
+
+// Returns an unboxed kernel for `n` or an empty function if the static
+// runtime has to fall back to the node's boxed Operation. Where an `out=`
+// overload exists the kernel writes into the tensor it produced on the
+// previous run, provided the runtime is the only owner of that tensor.
+TORCH_API SROperator getStaticRuntimeOperation(Node* n);
+
+TORCH_API bool canRunUnboxed(Node* n);
+
+} // namespace jit
+} // namespace torch
@@ -103,6 +103,9 @@ struct WriteableTensorData {
   bool storageHasDeleter() const {
     return tensor_.storage().data_ptr().get_context() != nullptr;
   }
+  const at::DataPtr& storageDataPtr() const {
+    return tensor_.storage().data_ptr();
+  }
 
  private:
   friend WriteableTensorData getWriteableTensorData(const at::Tensor& tensor);
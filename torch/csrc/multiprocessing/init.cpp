@@ -8,6 +8,10 @@
 #include <sys/prctl.h>
 #endif
 
+#ifndef _WIN32
+#include <libshm.h>
+#endif
+
 #define SYSASSERT(rv, ...)                                                 \
   if ((rv) < 0) {                                                          \
     throw std::system_error(errno, std::system_category(), ##__VA_ARGS__); \
@@ -34,6 +38,26 @@ PyObject* multiprocessing_init(PyObject* _unused, PyObject *noargs) {
 #endif
   });
 
+#ifndef _WIN32
+  module.def("_release_unused_slab_segments", []() {
+    THManagedSlabBlock::releaseUnusedSegments();
+  });
+
+  module.def("_release_slab_pool", []() {
+    THManagedSlabBlock::releasePool();
+  });
+
+  module.def("_slab_pool_stats", []() {
+    size_t segments, bytes, live_blocks;
+    std::tie(segments, bytes, live_blocks) = THManagedSlabBlock::poolStats();
+    py::dict stats;
+    stats["segments"] = segments;
+    stats["bytes"] = bytes;
+    stats["live_blocks"] = live_blocks;
+    return stats;
+  });
+#endif
+
   Py_RETURN_TRUE;
 }
 
@@ -0,0 +1,280 @@
+#include <torch/csrc/utils/batching_server.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/core/grad_mode.h>
+#include <c10/util/Logging.h>
+
+#include <algorithm>
+#include <numeric>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace torch {
+namespace serving {
+
+namespace {
+
+// Weight of the newest sample in the running forward time estimate
+constexpr int64_t kForwardTimeDecay = 8;
+
+void pinCurrentThread(size_t worker_id) {
+#ifdef __linux__
+  const auto num_cpus = std::max(1u, std::thread::hardware_concurrency());
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(worker_id % num_cpus, &cpu_set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+    LOG(WARNING) << "Failed to pin batching server worker " << worker_id;
+  }
+#else
+  TORCH_WARN_ONCE("Pinning worker threads is only supported on Linux");
+#endif
+}
+
+int64_t batchRows(const std::vector<at::Tensor>& inputs) {
+  TORCH_CHECK(!inputs.empty(), "A request needs at least one input tensor");
+  const auto& first = inputs[0];
+  TORCH_CHECK(first.dim() > 0, "Request inputs need a batch dimension");
+  const int64_t rows = first.size(0);
+  for (const auto& input : inputs) {
+    TORCH_CHECK(
+        input.dim() > 0 && input.size(0) == rows,
+        "All inputs of a request must have the same size of dim 0, got ",
+        input.sizes(),
+        " and ",
+        first.sizes());
+  }
+  return rows;
+}
+
+// Splits a batched output along dim 0 into one value per request
+std::vector<c10::IValue> splitOutput(
+    const c10::IValue& output,
+    const std::vector<int64_t>& rows) {
+  std::vector<c10::IValue> results;
+  results.reserve(rows.size());
+  if (output.isTensor()) {
+    for (auto& t : output.toTensor().split_with_sizes(rows, 0)) {
+      results.emplace_back(std::move(t));
+    }
+    return results;
+  }
+  TORCH_CHECK(
+      output.isTuple(),
+      "Batched forward must return a tensor or a tuple of tensors, got ",
+      output.tagKind());
+  const auto& elements = output.toTuple()->elements();
+  std::vector<std::vector<at::Tensor>> split_elements;
+  split_elements.reserve(elements.size());
+  for (const auto& element : elements) {
+    TORCH_CHECK(
+        element.isTensor(),
+        "Batched forward must return a tensor or a tuple of tensors, got a tuple with ",
+        element.tagKind());
+    split_elements.push_back(element.toTensor().split_with_sizes(rows, 0));
+  }
+  for (size_t i = 0; i < rows.size(); ++i) {
+    std::vector<c10::IValue> request_elements;
+    request_elements.reserve(split_elements.size());
+    for (auto& split : split_elements) {
+      request_elements.emplace_back(std::move(split[i]));
+    }
+    results.emplace_back(
+        c10::ivalue::Tuple::create(std::move(request_elements)));
+  }
+  return results;
+}
+
+} // namespace
+
+BatchingServer::BatchingServer(jit::Module module, BatchingConfig config)
+    : module_(std::move(module)), config_(config) {
+  TORCH_CHECK(config_.max_batch_size > 0, "max_batch_size must be positive");
+  TORCH_CHECK(config_.max_latency_us >= 0, "max_latency_us can't be negative");
+  TORCH_CHECK(
+      config_.num_worker_threads > 0, "num_worker_threads must be positive");
+  workers_.reserve(config_.num_worker_threads);
+  for (int i = 0; i < config_.num_worker_threads; ++i) {
+    workers_.emplace_back([this, i]() { workerLoop(i); });
+  }
+}
+
+BatchingServer::~BatchingServer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> BatchingServer::submit(
+    std::vector<c10::IValue> inputs) {
+  Request request;
+  request.inputs.reserve(inputs.size());
+  for (auto& input : inputs) {
+    TORCH_CHECK(
+        input.isTensor(),
+        "BatchingServer only supports tensor inputs, got ",
+        input.tagKind());
+    request.inputs.emplace_back(std::move(input).toTensor());
+  }
+  request.rows = batchRows(request.inputs);
+  request.future =
+      c10::make_intrusive<c10::ivalue::Future>(c10::AnyType::get());
+  auto future = request.future;
+
+  bool notify_all = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TORCH_CHECK(!shutdown_, "BatchingServer is shut down");
+    request.arrival = Clock::now();
+    queued_rows_ += request.rows;
+    queue_.emplace_back(std::move(request));
+    // Workers waiting for a partial batch to fill up only need to be woken
+    // once it is full, a worker waiting for work is woken by the first request
+    notify_all = queued_rows_ >= config_.max_batch_size;
+  }
+  if (notify_all) {
+    cv_.notify_all();
+  } else {
+    cv_.notify_one();
+  }
+  ++num_requests_;
+  return future;
+}
+
+c10::IValue BatchingServer::run(std::vector<c10::IValue> inputs) {
+  auto future = submit(std::move(inputs));
+  future->wait();
+  return future->value();
+}
+
+BatchingStats BatchingServer::stats() const {
+  BatchingStats stats;
+  stats.num_requests = num_requests_.load();
+  stats.num_batches = num_batches_.load();
+  if (stats.num_batches > 0) {
+    stats.avg_batch_rows =
+        static_cast<double>(num_batched_rows_.load()) / stats.num_batches;
+  }
+  stats.avg_forward_us = forward_time_us_.load();
+  return stats;
+}
+
+BatchingServer::Clock::time_point BatchingServer::dispatchDeadline(
+    Clock::time_point arrival) const {
+  // Leave enough of the latency budget to run the forward itself. Under low
+  // load this dispatches small batches early, under high load batches fill up
+  // before the deadline.
+  const int64_t wait_us =
+      std::max<int64_t>(0, config_.max_latency_us - forward_time_us_.load());
+  return arrival + std::chrono::microseconds(wait_us);
+}
+
+bool BatchingServer::takeBatch(std::vector<Request>& batch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return false;
+    }
+    // The front may have been taken by another worker while we were waiting,
+    // so the deadline is recomputed on every wake up
+    const auto deadline = dispatchDeadline(queue_.front().arrival);
+    if (shutdown_ || queued_rows_ >= config_.max_batch_size ||
+        Clock::now() >= deadline) {
+      break;
+    }
+    cv_.wait_until(lock, deadline);
+  }
+
+  int64_t rows = 0;
+  while (!queue_.empty()) {
+    auto& request = queue_.front();
+    if (!batch.empty() && rows + request.rows > config_.max_batch_size) {
+      break;
+    }
+    rows += request.rows;
+    queued_rows_ -= request.rows;
+    batch.emplace_back(std::move(request));
+    queue_.pop_front();
+  }
+  const bool more_work = !queue_.empty();
+  lock.unlock();
+  if (more_work) {
+    cv_.notify_one();
+  }
+  return true;
+}
+
+void BatchingServer::runBatch(std::vector<Request>& batch) {
+  const auto start = Clock::now();
+  try {
+    at::NoGradGuard no_grad;
+    std::vector<int64_t> rows;
+    rows.reserve(batch.size());
+    for (const auto& request : batch) {
+      rows.push_back(request.rows);
+    }
+
+    const size_t num_inputs = batch[0].inputs.size();
+    std::vector<c10::IValue> inputs;
+    inputs.reserve(num_inputs);
+    for (size_t i = 0; i < num_inputs; ++i) {
+      std::vector<at::Tensor> to_cat;
+      to_cat.reserve(batch.size());
+      for (const auto& request : batch) {
+        TORCH_CHECK(
+            request.inputs.size() == num_inputs,
+            "All requests must have the same number of inputs");
+        to_cat.push_back(request.inputs[i]);
+      }
+      inputs.emplace_back(
+          to_cat.size() == 1 ? to_cat[0] : at::cat(to_cat, 0));
+    }
+
+    auto results = splitOutput(module_.forward(std::move(inputs)), rows);
+    for (size_t i = 0; i < batch.size(); ++i) {
+      batch[i].future->markCompleted(std::move(results[i]));
+    }
+    num_batched_rows_ +=
+        std::accumulate(rows.begin(), rows.end(), static_cast<int64_t>(0));
+  } catch (const std::exception& e) {
+    for (auto& request : batch) {
+      request.future->setErrorIfNeeded(e.what());
+    }
+  }
+  ++num_batches_;
+
+  const int64_t elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          Clock::now() - start)
+          .count();
+  const int64_t previous_us = forward_time_us_.load();
+  forward_time_us_.store(
+      previous_us == 0
+          ? elapsed_us
+          : previous_us + (elapsed_us - previous_us) / kForwardTimeDecay);
+}
+
+void BatchingServer::workerLoop(size_t worker_id) {
+  if (config_.pin_worker_threads) {
+    pinCurrentThread(worker_id);
+  }
+  at::init_num_threads();
+  std::vector<Request> batch;
+  while (takeBatch(batch)) {
+    runBatch(batch);
+    batch.clear();
+  }
+}
+
+} // namespace serving
+} // namespace torch
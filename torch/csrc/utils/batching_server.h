@@ -0,0 +1,114 @@
+#pragma once
+
+#include <ATen/core/ivalue.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/api/module.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace torch {
+namespace serving {
+
+/**
+ * Configuration of a BatchingServer. A batch is handed to a worker as soon as
+ * either max_batch_size rows are queued or the oldest queued request would
+ * otherwise miss its latency deadline.
+ */
+struct BatchingConfig {
+  // Maximum number of rows (sum over requests of the size of dim 0 of their
+  // inputs) in one batched forward call. A single larger request still runs
+  // on its own.
+  int64_t max_batch_size{32};
+  // End-to-end latency budget of a request in microseconds. The server
+  // dispatches a partial batch early enough for it to finish within this
+  // budget, using a running estimate of the forward time.
+  int64_t max_latency_us{2000};
+  // Number of worker threads running batched forward calls
+  int num_worker_threads{1};
+  // If set, worker i is pinned to CPU i (only supported on Linux)
+  bool pin_worker_threads{false};
+};
+
+struct BatchingStats {
+  int64_t num_requests{0};
+  int64_t num_batches{0};
+  double avg_batch_rows{0};
+  // Running estimate of the time of one batched forward call
+  double avg_forward_us{0};
+};
+
+/**
+ * BatchingServer serves a ScriptModule to many client threads. Every request
+ * is a list of tensors sharing the size of their first dimension, which is
+ * the batch dimension of the module's forward method. Requests are queued and
+ * concatenated along dim 0 into batches, the batched forward runs on one of
+ * the server's worker threads and its result (a tensor or a tuple of tensors)
+ * is split back along dim 0 and delivered through the request's future.
+ *
+ * Forward calls run with gradient recording disabled. Destroying the server
+ * finishes all requests that were already submitted.
+ */
+class TORCH_API BatchingServer {
+ public:
+  BatchingServer(jit::Module module, BatchingConfig config);
+  ~BatchingServer();
+
+  BatchingServer(const BatchingServer&) = delete;
+  BatchingServer& operator=(const BatchingServer&) = delete;
+
+  c10::intrusive_ptr<c10::ivalue::Future> submit(
+      std::vector<c10::IValue> inputs);
+
+  // Convenience wrapper: submits and waits for the result, rethrowing errors
+  c10::IValue run(std::vector<c10::IValue> inputs);
+
+  BatchingStats stats() const;
+
+  const BatchingConfig& config() const {
+    return config_;
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Request {
+    std::vector<at::Tensor> inputs;
+    int64_t rows;
+    Clock::time_point arrival;
+    c10::intrusive_ptr<c10::ivalue::Future> future;
+  };
+
+  void workerLoop(size_t worker_id);
+  // Blocks until a batch is ready and moves it into `batch`. Returns false
+  // once the server is shut down and the queue is drained.
+  bool takeBatch(std::vector<Request>& batch);
+  void runBatch(std::vector<Request>& batch);
+  Clock::time_point dispatchDeadline(Clock::time_point arrival) const;
+
+  jit::Module module_;
+  const BatchingConfig config_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  // TODO: add GUARDED_BY once it is available
+  std::deque<Request> queue_;
+  int64_t queued_rows_{0};
+  bool shutdown_{false};
+
+  std::atomic<int64_t> num_requests_{0};
+  std::atomic<int64_t> num_batches_{0};
+  std::atomic<int64_t> num_batched_rows_{0};
+  // Exponential moving average of the forward time in microseconds
+  std::atomic<int64_t> forward_time_us_{0};
+
+  std::vector<std::thread> workers_;
+};
+
+} // namespace serving
+} // namespace torch
@@ -21,10 +21,58 @@ void initThroughputBenchmarkBindings(PyObject* module) {
 
   py::class_<BenchmarkExecutionStats>(m, "BenchmarkExecutionStats")
       .def_readonly("latency_avg_ms", &BenchmarkExecutionStats::latency_avg_ms)
+      .def_readonly("latency_p50_ms", &BenchmarkExecutionStats::latency_p50_ms)
+      .def_readonly("latency_p99_ms", &BenchmarkExecutionStats::latency_p99_ms)
       .def_readonly("num_iters", &BenchmarkExecutionStats::num_iters);
 
+  using serving::BatchingConfig;
+  using serving::BatchingServer;
+  using serving::BatchingStats;
+  py::class_<BatchingConfig>(m, "BatchingConfig")
+      .def(py::init<>())
+      .def_readwrite("max_batch_size", &BatchingConfig::max_batch_size)
+      .def_readwrite("max_latency_us", &BatchingConfig::max_latency_us)
+      .def_readwrite("num_worker_threads", &BatchingConfig::num_worker_threads)
+      .def_readwrite("pin_worker_threads", &BatchingConfig::pin_worker_threads);
+
+  py::class_<BatchingStats>(m, "BatchingStats")
+      .def_readonly("num_requests", &BatchingStats::num_requests)
+      .def_readonly("num_batches", &BatchingStats::num_batches)
+      .def_readonly("avg_batch_rows", &BatchingStats::avg_batch_rows)
+      .def_readonly("avg_forward_us", &BatchingStats::avg_forward_us);
+
+  py::class_<BatchingServer, std::shared_ptr<BatchingServer>>(
+      m, "BatchingServer")
+      .def(py::init<jit::Module, BatchingConfig>())
+      .def(
+          "submit",
+          [](BatchingServer& self, py::args args) {
+            std::vector<c10::IValue> inputs;
+            for (const auto& arg : args) {
+              inputs.emplace_back(jit::toTypeInferredIValue(arg));
+            }
+            return jit::toPyObject(c10::IValue(self.submit(std::move(inputs))));
+          })
+      .def(
+          "run",
+          [](BatchingServer& self, py::args args) {
+            std::vector<c10::IValue> inputs;
+            for (const auto& arg : args) {
+              inputs.emplace_back(jit::toTypeInferredIValue(arg));
+            }
+            c10::IValue result;
+            {
+              pybind11::gil_scoped_release no_gil_guard;
+              result = self.run(std::move(inputs));
+            }
+            return jit::toPyObject(std::move(result));
+          })
+      .def("stats", &BatchingServer::stats);
+
   py::class_<ThroughputBenchmark>(m, "ThroughputBenchmark", py::dynamic_attr())
       .def(py::init<jit::Module>())
+      .def(py::init<std::shared_ptr<jit::StaticRuntime>>())
+      .def(py::init<std::shared_ptr<serving::BatchingServer>>())
       .def(py::init<py::object>())
       .def(
           "add_input",
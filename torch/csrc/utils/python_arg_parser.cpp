@@ -8,6 +8,7 @@
 
 #include <ATen/ATen.h>
 
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -324,6 +325,32 @@ auto FunctionParameter::check(PyObject* obj, std::vector<py::handle> &overloaded
   }
 }
 
+void FunctionParameter::init_kind_matches() {
+  // Must agree with check() for every object of these kinds. Parameters that
+  // take numbers also take zero-dim tensors that don't require grad.
+  auto match = [](bool accepted) { return accepted ? ArgMatch::YES : ArgMatch::NO; };
+  bool number = type_ == ParameterType::SCALAR || type_ == ParameterType::COMPLEX ||
+      type_ == ParameterType::DOUBLE;
+  bool any = type_ == ParameterType::PYOBJECT;
+
+  kind_matches[static_cast<int>(ArgKind::TENSOR)] =
+      (type_ == ParameterType::TENSOR || any) ? ArgMatch::YES :
+      (number || type_ == ParameterType::INT64) ? ArgMatch::MAYBE : ArgMatch::NO;
+  kind_matches[static_cast<int>(ArgKind::INT)] = match(
+      any || number || type_ == ParameterType::INT64 || type_ == ParameterType::DEVICE ||
+      (type_ == ParameterType::TENSOR && allow_numbers_as_tensors) ||
+      (type_ == ParameterType::INT_LIST && size > 0));
+  kind_matches[static_cast<int>(ArgKind::FLOAT)] = match(
+      any || number || (type_ == ParameterType::TENSOR && allow_numbers_as_tensors));
+  kind_matches[static_cast<int>(ArgKind::BOOL)] = match(
+      any || number || type_ == ParameterType::BOOL ||
+      (type_ == ParameterType::TENSOR && allow_numbers_as_tensors));
+  kind_matches[static_cast<int>(ArgKind::NONE)] = match(
+      any || allow_none || type_ == ParameterType::DIMNAME ||
+      (type_ == ParameterType::DIMNAME_LIST && size == 1));
+  kind_matches[static_cast<int>(ArgKind::OTHER)] = ArgMatch::MAYBE;
+}
+
 std::string FunctionParameter::type_name() const {
   switch (type_) {
     case ParameterType::TENSOR: return "Tensor";
@@ -451,9 +478,11 @@ FunctionSignature::FunctionSignature(const std::string& fmt, int index)
   : min_args(0)
   , max_args(0)
   , max_pos_args(0)
+  , min_pos_args(0)
   , index(index)
   , hidden(false)
   , deprecated(false)
+  , allow_varargs_intlist(false)
 {
   auto open_paren = fmt.find('(');
   if (open_paren == std::string::npos) {
@@ -490,6 +519,7 @@ FunctionSignature::FunctionSignature(const std::string& fmt, int index)
     } else {
       params.emplace_back(param_str, keyword_only);
       params.back().allow_numbers_as_tensors = allow_numbers_as_tensors;
+      params.back().init_kind_matches();
     }
   }
 
@@ -504,14 +534,21 @@ FunctionSignature::FunctionSignature(const std::string& fmt, int index)
   max_args = params.size();
 
   // count the number of non-optional args
-  for (auto& param : params) {
-    if (!param.optional) {
+  for (size_t i = 0; i < params.size(); i++) {
+    if (!params[i].optional) {
       min_args++;
+      min_pos_args = i + 1;
     }
-    if (!param.keyword_only) {
+    if (!params[i].keyword_only) {
       max_pos_args++;
     }
   }
+
+  // if there is a single positional IntArrayRef argument, i.e. expand(..), view(...),
+  // allow a var-args style IntArrayRef, so expand(5,3) behaves as expand((5,3))
+  if (max_pos_args == 1 && params[0].type_ == ParameterType::INT_LIST) {
+    allow_varargs_intlist = true;
+  }
 }
 
 std::string FunctionSignature::toString() const {
@@ -618,13 +655,6 @@ bool FunctionSignature::parse(PyObject* args, PyObject* kwargs, PyObject* dst[],
   auto nargs = PyTuple_GET_SIZE(args);
   ssize_t remaining_kwargs = kwargs ? PyDict_Size(kwargs) : 0;
   ssize_t arg_pos = 0;
-  bool allow_varargs_intlist = false;
-
-  // if there is a single positional IntArrayRef argument, i.e. expand(..), view(...),
-  // allow a var-args style IntArrayRef, so expand(5,3) behaves as expand((5,3))
-  if (max_pos_args == 1 && params[0].type_ == ParameterType::INT_LIST) {
-    allow_varargs_intlist = true;
-  }
 
   if (nargs > max_pos_args && !allow_varargs_intlist) {
     if (raise_exception) {
@@ -718,6 +748,75 @@ bool FunctionSignature::parse(PyObject* args, PyObject* kwargs, PyObject* dst[],
   return true;
 }
 
+ArgMatch FunctionSignature::match_positional(ssize_t nargs, const ArgKind* kinds) const {
+  if (allow_varargs_intlist) {
+    return ArgMatch::MAYBE;
+  }
+  if (nargs > max_pos_args || nargs < min_pos_args) {
+    return ArgMatch::NO;
+  }
+  auto result = ArgMatch::YES;
+  for (ssize_t i = 0; i < nargs; i++) {
+    switch (params[i].check_kind(kinds[i])) {
+      case ArgMatch::NO:
+        return ArgMatch::NO;
+      case ArgMatch::MAYBE:
+        result = ArgMatch::MAYBE;
+        break;
+      case ArgMatch::YES:
+        break;
+    }
+  }
+  return result;
+}
+
+void FunctionSignature::bind_positional(PyObject* args, PyObject* dst[]) {
+  auto nargs = PyTuple_GET_SIZE(args);
+  if (!overloaded_args.empty()) {
+    overloaded_args.clear();
+  }
+  for (ssize_t i = 0; i < nargs; i++) {
+    PyObject* obj = PyTuple_GET_ITEM(args, i);
+    dst[i] = (obj == Py_None && params[i].allow_none) ? nullptr : obj;
+  }
+  for (size_t i = nargs; i < params.size(); i++) {
+    dst[i] = nullptr;
+  }
+}
+
+static bool arg_parser_fast_path = true;
+
+void PythonArgParser::set_fast_path_enabled(bool enabled) {
+  arg_parser_fast_path = enabled;
+}
+
+bool PythonArgParser::fast_path_enabled() {
+  return arg_parser_fast_path;
+}
+
+static inline ArgKind arg_kind(PyObject* obj) {
+  if (THPVariable_CheckExact(obj)) {
+    return ArgKind::TENSOR;
+  }
+  if (PyLong_CheckExact(obj)) {
+    return ArgKind::INT;
+  }
+  if (PyFloat_CheckExact(obj)) {
+    return ArgKind::FLOAT;
+  }
+  if (PyBool_Check(obj)) {
+    return ArgKind::BOOL;
+  }
+  if (obj == Py_None) {
+    return ArgKind::NONE;
+  }
+  return ArgKind::OTHER;
+}
+
+// Up to this many arguments, the number of arguments and their kinds fit in a
+// 64-bit key, with 3 bits per kind
+static constexpr ssize_t kMaxKeyedArgs = 19;
+
 PythonArgParser::PythonArgParser(std::vector<std::string> fmts, bool traceable)
  : max_args(0)
  , traceable(traceable)
@@ -741,6 +840,70 @@ PythonArgParser::PythonArgParser(std::vector<std::string> fmts, bool traceable)
     [](const FunctionSignature & sig) {
       return !sig.deprecated;
     });
+
+  ssize_t max_pos_args = 0;
+  for (auto& signature : signatures_) {
+    max_pos_args = std::max(max_pos_args, signature.max_pos_args);
+  }
+  signatures_by_nargs_.resize(max_pos_args + 2);
+  for (ssize_t nargs = 0; nargs < (ssize_t)signatures_by_nargs_.size(); nargs++) {
+    for (size_t i = 0; i < signatures_.size(); i++) {
+      auto& signature = signatures_[i];
+      if (signature.allow_varargs_intlist ||
+          (nargs <= signature.max_pos_args && nargs >= signature.min_pos_args)) {
+        signatures_by_nargs_[nargs].push_back(i);
+      }
+    }
+  }
+}
+
+// See Note [Positional fast path]. Returns the signature of the first overload
+// accepting the arguments with parsed_args filled, or nullptr if none does.
+FunctionSignature* PythonArgParser::parse_positional(PyObject* args, PyObject* parsed_args[]) {
+  auto nargs = PyTuple_GET_SIZE(args);
+  at::SmallVector<ArgKind, 8> kinds(nargs);
+  uint64_t key = 0;
+  if (nargs <= kMaxKeyedArgs) {
+    key = nargs + 1;
+    for (ssize_t i = 0; i < nargs; i++) {
+      kinds[i] = arg_kind(PyTuple_GET_ITEM(args, i));
+      key |= static_cast<uint64_t>(kinds[i]) << (5 + 3 * i);
+    }
+    if (key == last_kinds_key_) {
+      last_signature_->bind_positional(args, parsed_args);
+      return last_signature_;
+    }
+  } else {
+    for (ssize_t i = 0; i < nargs; i++) {
+      kinds[i] = arg_kind(PyTuple_GET_ITEM(args, i));
+    }
+  }
+
+  const auto& candidates = nargs < (ssize_t)signatures_by_nargs_.size() ?
+      signatures_by_nargs_[nargs] : signatures_by_nargs_.back();
+  // Whether the result only depends on the kinds of the arguments
+  bool by_kinds = true;
+  for (int i : candidates) {
+    auto& signature = signatures_[i];
+    switch (signature.match_positional(nargs, kinds.data())) {
+      case ArgMatch::YES:
+        signature.bind_positional(args, parsed_args);
+        if (by_kinds && key != 0) {
+          last_kinds_key_ = key;
+          last_signature_ = &signature;
+        }
+        return &signature;
+      case ArgMatch::MAYBE:
+        by_kinds = false;
+        if (signature.parse(args, nullptr, parsed_args, false)) {
+          return &signature;
+        }
+        break;
+      case ArgMatch::NO:
+        break;
+    }
+  }
+  return nullptr;
 }
 
 void PythonArgParser::check_deprecated(const FunctionSignature & signature) {
@@ -762,6 +925,14 @@ void PythonArgParser::check_deprecated(const FunctionSignature & signature) {
 }
 
 PythonArgs PythonArgParser::raw_parse(PyObject* args, PyObject* kwargs, PyObject* parsed_args[]) {
+  if (arg_parser_fast_path && (!kwargs || PyDict_Size(kwargs) == 0)) {
+    if (auto signature = parse_positional(args, parsed_args)) {
+      check_deprecated(*signature);
+      return PythonArgs(traceable, *signature, parsed_args);
+    }
+    // No overload accepts the arguments, let the slow path report it
+  }
+
   if (signatures_.size() == 1) {
     auto& signature = signatures_[0];
     signature.parse(args, kwargs, parsed_args, true);
@@ -38,6 +38,19 @@
 //    - Zero-dim tensors (e.g., torch.tensor(2)) bind to both
 //      Scalar and Tensor, UNLESS they require grad (in which case
 //      they only bind to Tensor).
+//
+//    - Note [Positional fast path]
+//      Calls without keyword arguments are first matched by the types
+//      of their arguments alone: for each kind of argument (Tensor,
+//      int, float, bool, None) every parameter knows in advance whether
+//      it accepts it. Only the overloads that can take that many
+//      positional arguments are tried, and the overload found for a
+//      combination of kinds is remembered by the parser, so a call
+//      site calling an op with the same kinds of arguments in a loop
+//      skips the matching altogether. Arguments of other types (and
+//      zero-dim tensors given to numbers) go through
+//      FunctionSignature::parse as before, so the chosen overload is
+//      always the one of the slow path.
 
 
 #include <torch/csrc/python_headers.h>
@@ -81,6 +94,17 @@ enum class ParameterType {
   DIMNAME, DIMNAME_LIST, QSCHEME
 };
 
+// Python objects whose type alone decides whether a parameter accepts them,
+// see Note [Positional fast path]
+enum class ArgKind : uint8_t {
+  TENSOR, INT, FLOAT, BOOL, NONE, OTHER
+};
+constexpr int kNumArgKinds = 6;
+
+enum class ArgMatch : uint8_t {
+  NO, YES, MAYBE
+};
+
 struct FunctionParameter;
 struct FunctionSignature;
 struct PythonArgs;
@@ -102,13 +126,27 @@ struct PythonArgParser {
   // Formatted strings of non-hidden signatures
   std::vector<std::string> get_signatures() const;
 
+  // Turns Note [Positional fast path] on or off, to measure what it saves.
+  static void set_fast_path_enabled(bool enabled);
+  static bool fast_path_enabled();
+
 private:
   [[noreturn]]
   void print_error(PyObject* args, PyObject* kwargs, PyObject* parsed_args[]);
   void check_deprecated(const FunctionSignature & signature);
   PythonArgs raw_parse(PyObject* args, PyObject* kwargs, PyObject* parsed_args[]);
+  FunctionSignature* parse_positional(PyObject* args, PyObject* parsed_args[]);
 
   std::vector<FunctionSignature> signatures_;
+  // Indices of the signatures that can be called with n positional arguments
+  // and no keyword arguments, by n. The last entry is for the calls with
+  // more positional arguments than any signature has.
+  std::vector<std::vector<int>> signatures_by_nargs_;
+  // Number of positional arguments and kinds of the last call that was matched
+  // by kinds alone, and the signature it was matched to. Only read and written
+  // with the GIL held.
+  uint64_t last_kinds_key_ = 0;
+  FunctionSignature* last_signature_ = nullptr;
   std::string function_name;
   ssize_t max_args;
   bool traceable;
@@ -119,6 +157,12 @@ struct PYBIND11_EXPORT FunctionSignature {
 
   bool parse(PyObject* args, PyObject* kwargs, PyObject* dst[], bool raise_exception);
 
+  // Whether parse() would accept nargs positional arguments of the given
+  // kinds and no keyword arguments; MAYBE if that depends on their values.
+  ArgMatch match_positional(ssize_t nargs, const ArgKind* kinds) const;
+  // Fills dst like parse() does for arguments match_positional() said YES to.
+  void bind_positional(PyObject* args, PyObject* dst[]);
+
   std::string toString() const;
 
   std::string name;
@@ -127,9 +171,13 @@ struct PYBIND11_EXPORT FunctionSignature {
   ssize_t min_args;
   ssize_t max_args;
   ssize_t max_pos_args;
+  // Number of positional arguments needed to reach the last parameter
+  // without a default
+  ssize_t min_pos_args;
   int index;
   bool hidden;
   bool deprecated;
+  bool allow_varargs_intlist;
 };
 
 struct PythonArgs {
@@ -196,8 +244,12 @@ struct FunctionParameter {
   FunctionParameter(const std::string& fmt, bool keyword_only);
 
   bool check(PyObject* obj, std::vector<py::handle> &overloaded_args);
+  ArgMatch check_kind(ArgKind kind) const {
+    return kind_matches[static_cast<int>(kind)];
+  }
 
   void set_default_str(const std::string& str);
+  void init_kind_matches();
   std::string type_name() const;
 
   ParameterType type_;
@@ -211,6 +263,7 @@ struct FunctionParameter {
   // anyway, and Py_Finalize can already be called when this is destructed.
   PyObject *python_name;
   at::SmallVector<PyObject *, 5> numpy_python_names;
+  std::array<ArgMatch, kNumArgKinds> kind_matches;
   at::Scalar default_scalar;
   std::vector<int64_t> default_intlist;
   union {
@@ -23,7 +23,9 @@
 #include <c10/util/Exception.h>
 #include <c10/util/Optional.h>
 
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 using at::Backend;
@@ -230,6 +232,217 @@ void recursive_store(char* data, IntArrayRef sizes, IntArrayRef strides, int64_t
   }
 }
 
+// Kinds of leaves of a nest of lists and tuples that the fast path of
+// internal_new_from_data converts itself.
+enum SequenceLeafKind : uint8_t {
+  kBoolLeaf = 1,
+  kLongLeaf = 2,
+  kFloatLeaf = 4,
+};
+
+// Computes the sizes of a nest of lists and tuples and the kinds of its leaves
+// in a single pass. Returns false if the nest isn't rectangular or has leaves
+// that aren't exactly Python floats, ints or bools; the generic path handles
+// (or reports) these.
+bool scan_sequence(PyObject* seq, size_t dim, std::vector<int64_t>& sizes,
+                   int64_t& ndim, uint8_t& kinds) {
+  const auto length = PySequence_Fast_GET_SIZE(seq);
+  if (dim == sizes.size()) {
+    if (sizes.size() == MAX_DIMS) return false;
+    sizes.push_back(length);
+  } else if (sizes[dim] != length) {
+    return false;
+  }
+  if (length == 0) {
+    // An empty sequence ends the shape
+    if (ndim < 0) ndim = dim + 1;
+    return true;
+  }
+
+  PyObject** items = PySequence_Fast_ITEMS(seq);
+  for (Py_ssize_t i = 0; i < length; i++) {
+    PyObject* item = items[i];
+    if (PyList_CheckExact(item) || PyTuple_CheckExact(item)) {
+      if ((ndim >= 0 && (int64_t)dim + 1 >= ndim) || item == seq) return false;
+      if (!scan_sequence(item, dim + 1, sizes, ndim, kinds)) return false;
+      continue;
+    }
+    if (PyFloat_CheckExact(item)) {
+      kinds |= kFloatLeaf;
+    } else if (PyLong_CheckExact(item)) {
+      kinds |= kLongLeaf;
+    } else if (PyBool_Check(item)) {
+      kinds |= kBoolLeaf;
+    } else {
+      return false;
+    }
+    if (ndim < 0) {
+      ndim = dim + 1;
+    } else if (ndim != (int64_t)dim + 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Same conversions as store_scalar, for the leaves accepted by scan_sequence.
+template <typename scalar_t>
+inline scalar_t unpack_sequence_leaf(PyObject* obj, std::true_type /*is_integral*/) {
+  return at::convert<scalar_t, int64_t>(THPUtils_unpackLong(obj));
+}
+
+template <typename scalar_t>
+inline scalar_t unpack_sequence_leaf(PyObject* obj, std::false_type /*is_integral*/) {
+  return at::convert<scalar_t, double>(THPUtils_unpackDouble(obj));
+}
+
+template <typename scalar_t>
+void store_sequence(scalar_t*& data, PyObject* seq, int64_t dim, int64_t ndim) {
+  const auto length = PySequence_Fast_GET_SIZE(seq);
+  PyObject** items = PySequence_Fast_ITEMS(seq);
+  if (dim + 1 == ndim) {
+    for (Py_ssize_t i = 0; i < length; i++) {
+      *data++ = unpack_sequence_leaf<scalar_t>(items[i], std::is_integral<scalar_t>());
+    }
+    return;
+  }
+  for (Py_ssize_t i = 0; i < length; i++) {
+    store_sequence(data, items[i], dim + 1, ndim);
+  }
+}
+
+// Fast path of internal_new_from_data for rectangular nests of lists and
+// tuples of Python floats, ints and bools, which is what most data given to
+// torch.tensor is. The shape and dtype are found in one pass over the nest,
+// and the leaves are stored with a loop specialized on the dtype instead of
+// going through store_scalar one element at a time. Returns an undefined
+// tensor if the nest doesn't qualify.
+Tensor new_from_sequence_fast(PyObject* data, ScalarType scalar_type,
+                              bool type_inference, bool pin_memory) {
+  if (!PyList_CheckExact(data) && !PyTuple_CheckExact(data)) {
+    return Tensor();
+  }
+  std::vector<int64_t> sizes;
+  int64_t ndim = -1;
+  uint8_t kinds = 0;
+  if (!scan_sequence(data, 0, sizes, ndim, kinds)) {
+    return Tensor();
+  }
+
+  // Same types as infer_scalar_type
+  if (type_inference) {
+    if ((kinds & kFloatLeaf) || kinds == 0) {
+      scalar_type = torch::tensors::get_default_scalar_type();
+    } else if (kinds & kLongLeaf) {
+      scalar_type = ScalarType::Long;
+    } else {
+      scalar_type = ScalarType::Bool;
+    }
+  }
+  // Floats stored to integral types go through __index__/__int__, and complex
+  // types aren't specialized; leave these to store_scalar.
+  if ((kinds & kFloatLeaf) && (at::isIntegralType(scalar_type, /*includeBool=*/true))) {
+    return Tensor();
+  }
+  if (at::isComplexType(scalar_type)) {
+    return Tensor();
+  }
+
+  at::AutoNonVariableTypeMode guard;
+  auto tensor = at::empty(sizes, at::initialTensorOptions().dtype(scalar_type).pinned_memory(pin_memory));
+  if (tensor.numel() > 0) {
+    AT_DISPATCH_ALL_TYPES_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+        scalar_type, "new_from_sequence_fast", [&] {
+      scalar_t* out = tensor.data_ptr<scalar_t>();
+      store_sequence(out, data, 0, ndim);
+    });
+  }
+  return tensor;
+}
+
+// Maps the struct module format of a buffer to a ScalarType, or returns
+// Undefined if the format has no equivalent.
+ScalarType buffer_format_to_scalar_type(const char* format, Py_ssize_t itemsize) {
+  if (!format) {
+    // Unsigned bytes
+    return ScalarType::Byte;
+  }
+  if (*format == '@' || *format == '=') {
+    format++;
+  }
+  if (format[0] == '\0' || format[1] != '\0') {
+    return ScalarType::Undefined;
+  }
+  switch (format[0]) {
+    case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+      switch (itemsize) {
+        case 1: return ScalarType::Char;
+        case 2: return ScalarType::Short;
+        case 4: return ScalarType::Int;
+        case 8: return ScalarType::Long;
+      }
+      break;
+    case 'B':
+      return itemsize == 1 ? ScalarType::Byte : ScalarType::Undefined;
+    case 'e':
+      return itemsize == 2 ? ScalarType::Half : ScalarType::Undefined;
+    case 'f':
+      return itemsize == 4 ? ScalarType::Float : ScalarType::Undefined;
+    case 'd':
+      return itemsize == 8 ? ScalarType::Double : ScalarType::Undefined;
+    case '?':
+      return itemsize == 1 ? ScalarType::Bool : ScalarType::Undefined;
+  }
+  return ScalarType::Undefined;
+}
+
+// Wraps the memory of an object supporting the buffer protocol, such as an
+// array.array, a bytearray or a memoryview, in a CPU tensor without copying
+// it. The buffer is released when the tensor is freed. Returns an undefined
+// tensor if the object doesn't export a buffer with a supported format and
+// non-negative strides that are multiples of the item size, or if the buffer
+// is 0-d: scalars are left to infer_scalar_type.
+Tensor tensor_from_buffer(PyObject* obj, bool& writable) {
+  auto view = std::unique_ptr<Py_buffer>(new Py_buffer());
+  if (PyObject_GetBuffer(obj, view.get(), PyBUF_FORMAT | PyBUF_STRIDES) != 0) {
+    PyErr_Clear();
+    return Tensor();
+  }
+  auto release = [](Py_buffer* view) {
+    PyBuffer_Release(view);
+    delete view;
+  };
+
+  const auto scalar_type = buffer_format_to_scalar_type(view->format, view->itemsize);
+  if (scalar_type == ScalarType::Undefined || view->ndim == 0 || view->ndim > MAX_DIMS ||
+      view->suboffsets) {
+    release(view.release());
+    return Tensor();
+  }
+  std::vector<int64_t> sizes(view->ndim);
+  std::vector<int64_t> strides(view->ndim);
+  for (int i = 0; i < view->ndim; i++) {
+    if (view->strides[i] < 0 || view->strides[i] % view->itemsize != 0) {
+      release(view.release());
+      return Tensor();
+    }
+    sizes[i] = view->shape[i];
+    strides[i] = view->strides[i] / view->itemsize;
+  }
+
+  writable = !view->readonly;
+  void* data_ptr = view->buf;
+  return at::from_blob(
+      data_ptr,
+      sizes,
+      strides,
+      [view = view.release(), release](void* data) {
+        pybind11::gil_scoped_acquire gil;
+        release(view);
+      },
+      at::device(kCPU).dtype(scalar_type));
+}
+
 Tensor internal_new_from_data(
     c10::DispatchKey dispatch_key,
     at::ScalarType scalar_type,
@@ -281,13 +494,44 @@ Tensor internal_new_from_data(
   }
 #endif
 
-  auto sizes = compute_sizes(data);
-  ScalarType inferred_scalar_type = type_inference ? infer_scalar_type(data) : scalar_type;
+  // Numpy scalars export a 0-d buffer too, but keep their numpy dtype.
+  bool is_numpy_scalar = false;
+#ifdef USE_NUMPY
+  is_numpy_scalar = PyArray_CheckScalar(data);
+#endif
+  if (!pin_memory && !is_numpy_scalar && PyObject_CheckBuffer(data)) {
+    bool writable = false;
+    auto tensor = tensor_from_buffer(data, writable);
+    if (tensor.defined()) {
+      // Infer the types the elements of the buffer would give as a sequence,
+      // e.g. an array.array('d') follows the default dtype like a list of floats.
+      ScalarType inferred_scalar_type = scalar_type;
+      if (type_inference) {
+        if (at::isFloatingType(tensor.scalar_type())) {
+          inferred_scalar_type = torch::tensors::get_default_scalar_type();
+        } else if (tensor.scalar_type() == ScalarType::Bool) {
+          inferred_scalar_type = ScalarType::Bool;
+        } else {
+          inferred_scalar_type = ScalarType::Long;
+        }
+      }
+      auto device = device_opt.has_value() ? *device_opt : at::Device(computeDeviceType(dispatch_key));
+      pybind11::gil_scoped_release no_gil;
+      maybe_initialize_cuda(device);
+      return tensor.to(device, inferred_scalar_type, /*non_blocking=*/false, /*copy=*/copy_numpy || !writable);
+    }
+  }
+
   // This exists to prevent us from tracing the call to empty().  The actual
   // autograd code doesn't really matter, because requires_grad is always false
   // here.
-  Tensor tensor;
-  {
+  Tensor tensor = new_from_sequence_fast(data, scalar_type, type_inference, pin_memory);
+  ScalarType inferred_scalar_type;
+  if (tensor.defined()) {
+    inferred_scalar_type = tensor.scalar_type();
+  } else {
+    auto sizes = compute_sizes(data);
+    inferred_scalar_type = type_inference ? infer_scalar_type(data) : scalar_type;
     at::AutoNonVariableTypeMode guard;
     tensor = at::empty(sizes, at::initialTensorOptions().dtype(inferred_scalar_type).pinned_memory(pin_memory));
     recursive_store(
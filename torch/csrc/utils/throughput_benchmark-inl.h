@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <random>
 #include <thread>
 
@@ -28,6 +29,9 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
   // overhead from the benchmark runner itself
   std::vector<std::vector<Input>> thread_inputs(config.num_calling_threads);
   std::vector<size_t> input_iters(config.num_calling_threads);
+  // Latency of every measured call in milliseconds, per calling thread
+  std::vector<std::vector<float>> thread_latencies_ms(
+      config.num_calling_threads);
   {
     std::random_device seeder;
     std::mt19937 engine(seeder());
@@ -45,6 +49,7 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
         thread_inputs[thread_id].push_back(cloneInput(inputs_[dist(engine)]));
       }
       input_iters[thread_id] = 0;
+      thread_latencies_ms[thread_id].reserve(config.num_iters);
     }
   }
 
@@ -58,6 +63,9 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
   std::atomic<int64_t> num_attempted_iters{0};
   std::vector<std::thread> callers;
 
+  using Clock = std::chrono::high_resolution_clock;
+  using TimePoint = std::chrono::time_point<Clock>;
+
   for (auto thread_id = 0; thread_id < config.num_calling_threads;
        ++thread_id) {
     callers.emplace_back([&, thread_id]() {
@@ -77,7 +85,13 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
       }
       LOG(INFO) << "Starting forward thread " << thread_id;
       while (num_attempted_iters.fetch_add(1) < config.num_iters) {
+        TimePoint iter_start = Clock::now();
         runOnce(std::move(thread_inputs[thread_id][input_iters[thread_id]]));
+        thread_latencies_ms[thread_id].push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - iter_start)
+                .count() /
+            1000.0 / 1000.0);
         ++input_iters[thread_id];
       }
 
@@ -92,8 +106,6 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
     });
   }
 
-  using Clock = std::chrono::high_resolution_clock;
-  using TimePoint = std::chrono::time_point<Clock>;
   TimePoint start_time;
 
   std::unique_ptr<torch::autograd::profiler::RecordProfile> profiler_guard;
@@ -138,6 +150,23 @@ BenchmarkExecutionStats BenchmarkHelper<Input, Output, Model>::benchmark(
   for (auto& t : callers) {
     t.join();
   }
+
+  std::vector<float> latencies_ms;
+  latencies_ms.reserve(config.num_iters);
+  for (const auto& thread_latencies : thread_latencies_ms) {
+    latencies_ms.insert(
+        latencies_ms.end(), thread_latencies.begin(), thread_latencies.end());
+  }
+  if (!latencies_ms.empty()) {
+    auto percentile = [&](double p) {
+      auto nth = latencies_ms.begin() +
+          static_cast<size_t>(p * (latencies_ms.size() - 1));
+      std::nth_element(latencies_ms.begin(), nth, latencies_ms.end());
+      return *nth;
+    };
+    stats.latency_p50_ms = percentile(0.5);
+    stats.latency_p99_ms = percentile(0.99);
+  }
   return stats;
 }
 
@@ -8,13 +8,26 @@ namespace throughput_benchmark {
 
 std::ostream& operator<<(std::ostream& os, const BenchmarkExecutionStats& value) {
     return os << "Average latency / iter (ms): " << value.latency_avg_ms
+              << "\n P50 latency (ms): " << value.latency_p50_ms
+              << "\n P99 latency (ms): " << value.latency_p99_ms
               << "\n Total number of iters: " << value.num_iters;
 }
 
+int ThroughputBenchmark::numInitialized() const {
+  return static_cast<int>(script_module_.initialized()) +
+      static_cast<int>(module_.initialized()) +
+      static_cast<int>(static_runtime_.initialized()) +
+      static_cast<int>(batching_server_.initialized());
+}
+
 void ThroughputBenchmark::addInput(py::args args, py::kwargs kwargs) {
-  CHECK(script_module_.initialized() ^ module_.initialized());
+  CHECK_EQ(numInitialized(), 1);
   if (script_module_.initialized()) {
     script_module_.addInput(std::move(args), std::move(kwargs));
+  } else if (static_runtime_.initialized()) {
+    static_runtime_.addInput(std::move(args), std::move(kwargs));
+  } else if (batching_server_.initialized()) {
+    batching_server_.addInput(std::move(args), std::move(kwargs));
   } else {
     CHECK(module_.initialized());
     module_.addInput(std::move(args), std::move(kwargs));
@@ -22,7 +35,7 @@ void ThroughputBenchmark::addInput(py::args args, py::kwargs kwargs) {
 }
 
 py::object ThroughputBenchmark::runOnce(py::args&& args, py::kwargs&& kwargs)  {
-  CHECK(script_module_.initialized() ^ module_.initialized());
+  CHECK_EQ(numInitialized(), 1);
   if (script_module_.initialized()) {
     c10::IValue result;
     {
@@ -30,6 +43,16 @@ py::object ThroughputBenchmark::runOnce(py::args&& args, py::kwargs&& kwargs)  {
       result = script_module_.runOnce(std::move(args), std::move(kwargs));
     }
     return jit::toPyObject(std::move(result));
+  } else if (static_runtime_.initialized()) {
+    // Inputs are converted under the GIL, the GIL is only released for the
+    // actual run inside of StaticRuntimeBenchmark::runOnce
+    c10::IValue result =
+        static_runtime_.runOnce(std::move(args), std::move(kwargs));
+    return jit::toPyObject(std::move(result));
+  } else if (batching_server_.initialized()) {
+    c10::IValue result =
+        batching_server_.runOnce(std::move(args), std::move(kwargs));
+    return jit::toPyObject(std::move(result));
   } else {
     CHECK(module_.initialized());
     return module_.runOnce(std::move(args), std::move(kwargs));
@@ -40,18 +63,30 @@ ThroughputBenchmark::ThroughputBenchmark(
     jit::Module script_module)
     : script_module_(script_module) {}
 
+ThroughputBenchmark::ThroughputBenchmark(
+    std::shared_ptr<jit::StaticRuntime> runtime)
+    : static_runtime_(std::move(runtime)) {}
+
+ThroughputBenchmark::ThroughputBenchmark(
+    std::shared_ptr<serving::BatchingServer> server)
+    : batching_server_(std::move(server)) {}
+
 ThroughputBenchmark::ThroughputBenchmark(
     py::object module)
     : module_(std::move(module)) {}
 
 BenchmarkExecutionStats ThroughputBenchmark::benchmark(
     const BenchmarkConfig& config) const {
-  CHECK(script_module_.initialized() ^ module_.initialized());
+  CHECK_EQ(numInitialized(), 1);
   // Main benchmark thread doesn't hold the GIL after scheduling worker threads
   // But for now we don't release it as we will be implicitly manipulating with
   // py::object ref. counts in the case of nn.Module benchmarking.
   if (script_module_.initialized()) {
     return script_module_.benchmark(config);
+  } else if (static_runtime_.initialized()) {
+    return static_runtime_.benchmark(config);
+  } else if (batching_server_.initialized()) {
+    return batching_server_.benchmark(config);
   } else {
     CHECK(module_.initialized());
     TORCH_WARN("Starting benchmark on an nn.Module. This can be slow due "
@@ -120,6 +155,106 @@ void ModuleBenchmark::addInput(py::args&& args, py::kwargs&& kwargs) {
   inputs_.emplace_back(std::move(args), std::move(kwargs));
 }
 
+namespace {
+
+ScriptModuleInput createStackForStaticRuntime(
+    const jit::StaticRuntime& runtime,
+    py::args&& args,
+    py::kwargs&& kwargs) {
+  const auto& inputs = runtime.graph()->inputs();
+  TORCH_CHECK(
+      kwargs.size() == 0,
+      "Static runtime inputs can only be passed as positional arguments");
+  TORCH_CHECK(
+      args.size() == inputs.size(),
+      "Expected ",
+      inputs.size(),
+      " inputs to the static runtime, got ",
+      args.size());
+  ScriptModuleInput stack;
+  stack.reserve(args.size());
+  for (size_t i = 0; i < args.size(); ++i) {
+    stack.emplace_back(jit::toIValue(args[i], inputs[i]->type()));
+  }
+  return stack;
+}
+
+} // namespace
+
+template <>
+void StaticRuntimeBenchmark::runOnce(ScriptModuleInput&& input) const {
+  CHECK(initialized_);
+  ScriptModuleInput stack = std::move(input);
+  model_->run(stack);
+}
+
+template <>
+ScriptModuleOutput StaticRuntimeBenchmark::runOnce(
+    py::args&& args,
+    py::kwargs&& kwargs) const {
+  CHECK(initialized_);
+  ScriptModuleInput stack =
+      createStackForStaticRuntime(*model_, std::move(args), std::move(kwargs));
+  {
+    pybind11::gil_scoped_release no_gil_guard;
+    model_->run(stack);
+  }
+  if (stack.size() == 1) {
+    return std::move(stack[0]);
+  }
+  return c10::ivalue::Tuple::create(std::move(stack));
+}
+
+template <>
+void StaticRuntimeBenchmark::addInput(py::args&& args, py::kwargs&& kwargs) {
+  inputs_.emplace_back(
+      createStackForStaticRuntime(*model_, std::move(args), std::move(kwargs)));
+}
+
+template <>
+void StaticRuntimeBenchmark::addInput(ScriptModuleInput&& input) {
+  inputs_.emplace_back(std::move(input));
+}
+
+template <>
+void BatchingServerBenchmark::runOnce(ScriptModuleInput&& input) const {
+  CHECK(initialized_);
+  model_->run(std::move(input));
+}
+
+template <>
+ScriptModuleOutput BatchingServerBenchmark::runOnce(
+    py::args&& args,
+    py::kwargs&& kwargs) const {
+  CHECK(initialized_);
+  ScriptModuleInput inputs;
+  for (const auto& arg : args) {
+    inputs.emplace_back(jit::toTypeInferredIValue(arg));
+  }
+  TORCH_CHECK(
+      kwargs.size() == 0,
+      "BatchingServer inputs can only be passed as positional arguments");
+  pybind11::gil_scoped_release no_gil_guard;
+  return model_->run(std::move(inputs));
+}
+
+template <>
+void BatchingServerBenchmark::addInput(py::args&& args, py::kwargs&& kwargs) {
+  TORCH_CHECK(
+      kwargs.size() == 0,
+      "BatchingServer inputs can only be passed as positional arguments");
+  ScriptModuleInput inputs;
+  for (const auto& arg : args) {
+    inputs.emplace_back(jit::toTypeInferredIValue(arg));
+  }
+  inputs_.emplace_back(std::move(inputs));
+}
+
+template <>
+void BatchingServerBenchmark::addInput(ScriptModuleInput&& input) {
+  inputs_.emplace_back(std::move(input));
+}
+
 template <>
 ModuleInput cloneInput<ModuleInput>(const ModuleInput& input) {
   pybind11::gil_scoped_acquire gil_guard;
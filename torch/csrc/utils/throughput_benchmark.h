@@ -2,6 +2,8 @@
 
 #include <ATen/core/ivalue.h>
 #include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/runtime/static/impl.h>
+#include <torch/csrc/utils/batching_server.h>
 #include <pybind11/pybind11.h>
 
 #include <torch/csrc/jit/python/pybind_utils.h>
@@ -23,6 +25,10 @@ namespace throughput_benchmark {
 struct BenchmarkExecutionStats {
   float latency_avg_ms{-1};
   int64_t num_iters{-1};
+  // Percentiles of the latency of single calls measured by the calling
+  // threads, in milliseconds
+  float latency_p50_ms{-1};
+  float latency_p99_ms{-1};
 };
 
 std::ostream& operator<<(std::ostream& os, const BenchmarkExecutionStats& value);
@@ -125,6 +131,32 @@ typedef BenchmarkHelper<ModuleInput, py::object, py::object> ModuleBenchmark;
 template <>
 inline BenchmarkHelper<ModuleInput, py::object, py::object>::BenchmarkHelper()
   : initialized_(false) {}
+// Static runtime takes the same input format as a ScriptModule minus `self`
+typedef BenchmarkHelper<
+    ScriptModuleInput,
+    at::IValue,
+    std::shared_ptr<jit::StaticRuntime>>
+    StaticRuntimeBenchmark;
+template <>
+inline BenchmarkHelper<
+    ScriptModuleInput,
+    at::IValue,
+    std::shared_ptr<jit::StaticRuntime>>::BenchmarkHelper()
+  : initialized_(false) {}
+
+// Requests go through a BatchingServer, concurrent calls from the calling
+// threads are batched into one forward call
+typedef BenchmarkHelper<
+    ScriptModuleInput,
+    at::IValue,
+    std::shared_ptr<serving::BatchingServer>>
+    BatchingServerBenchmark;
+template <>
+inline BenchmarkHelper<
+    ScriptModuleInput,
+    at::IValue,
+    std::shared_ptr<serving::BatchingServer>>::BenchmarkHelper()
+  : initialized_(false) {}
 
 template <>
 void ScriptModuleBenchmark::runOnce(
@@ -151,6 +183,32 @@ void ScriptModuleBenchmark::addInput(ScriptModuleInput&& input);
 template <>
 void ModuleBenchmark::addInput(py::args&& args, py::kwargs&& kwargs);
 
+template <>
+void StaticRuntimeBenchmark::runOnce(ScriptModuleInput&& input) const;
+
+template <>
+ScriptModuleOutput StaticRuntimeBenchmark::runOnce(
+    py::args&& args,
+    py::kwargs&& kwargs) const;
+
+template <>
+void StaticRuntimeBenchmark::addInput(py::args&& args, py::kwargs&& kwargs);
+template <>
+void StaticRuntimeBenchmark::addInput(ScriptModuleInput&& input);
+
+template <>
+void BatchingServerBenchmark::runOnce(ScriptModuleInput&& input) const;
+
+template <>
+ScriptModuleOutput BatchingServerBenchmark::runOnce(
+    py::args&& args,
+    py::kwargs&& kwargs) const;
+
+template <>
+void BatchingServerBenchmark::addInput(py::args&& args, py::kwargs&& kwargs);
+template <>
+void BatchingServerBenchmark::addInput(ScriptModuleInput&& input);
+
 } // namespace detail
 
 /**
@@ -163,13 +221,17 @@ void ModuleBenchmark::addInput(py::args&& args, py::kwargs&& kwargs);
  * For current available configurations refer to the BenchmkarConfig
  * documentation
  *
- * The class supports working with either nn.Module or ScriptModule.
- * Under the hood it just dispatches to corresponding specialization of
- * class BenchmarkHelper<Input, Output, Model>
+ * The class supports working with either nn.Module, ScriptModule, a
+ * StaticRuntime built from a frozen ScriptModule or a BatchingServer serving
+ * a ScriptModule. Under the hood it just dispatches to corresponding
+ * specialization of class BenchmarkHelper<Input, Output, Model>
  */
 class C10_HIDDEN ThroughputBenchmark {
  public:
   explicit ThroughputBenchmark(jit::Module module);
+  explicit ThroughputBenchmark(std::shared_ptr<jit::StaticRuntime> runtime);
+  explicit ThroughputBenchmark(
+      std::shared_ptr<serving::BatchingServer> server);
   explicit ThroughputBenchmark(py::object module);
 
   // Add one more input example. This input example should be in the exact
@@ -188,8 +250,13 @@ class C10_HIDDEN ThroughputBenchmark {
   BenchmarkExecutionStats benchmark(const BenchmarkConfig& config) const;
 
  private:
+  // Exactly one of the benchmarks below is initialized
+  int numInitialized() const;
+
   detail::ScriptModuleBenchmark script_module_;
   detail::ModuleBenchmark module_;
+  detail::StaticRuntimeBenchmark static_runtime_;
+  detail::BatchingServerBenchmark batching_server_;
 };
 } // namespace throughput benchmark
 } // namepsace torch
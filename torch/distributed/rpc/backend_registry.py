@@ -89,6 +89,7 @@ def _process_group_construct_rpc_backend_options_handler(
     rpc_timeout,
     init_method,
     num_send_recv_threads=rpc_constants.DEFAULT_NUM_SEND_RECV_THREADS,
+    shm_transport=False,
     **kwargs
 ):
     from . import ProcessGroupRpcBackendOptions
@@ -96,7 +97,8 @@ def _process_group_construct_rpc_backend_options_handler(
     return ProcessGroupRpcBackendOptions(
         rpc_timeout=rpc_timeout,
         init_method=init_method,
-        num_send_recv_threads=num_send_recv_threads
+        num_send_recv_threads=num_send_recv_threads,
+        shm_transport=shm_transport
     )
 
 
@@ -141,6 +143,7 @@ def _process_group_init_backend_handler(
             group,
             rpc_backend_options.num_send_recv_threads,
             timedelta(seconds=rpc_backend_options.rpc_timeout),
+            rpc_backend_options.shm_transport,
         )
     except Exception as ex:
         dist.destroy_process_group()
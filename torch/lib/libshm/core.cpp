@@ -1,4 +1,5 @@
 #include <cstring>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -9,6 +10,9 @@
 
 std::unordered_map<std::string, ClientSocket> managers;
 std::string manager_executable_path;
+// Guards managers and the manager sockets, allocations can be made and freed
+// by threads that don't hold the GIL (e.g. RPC workers)
+std::mutex managers_mutex;
 
 AllocInfo get_alloc_info(const char* filename) {
   AllocInfo info = {0};
@@ -82,6 +86,7 @@ THManagedMapAllocatorInit::THManagedMapAllocatorInit(const char* manager_handle,
   : manager_handle_(manager_handle ? manager_handle : "") {
   // TODO: unlock GIL when contacting the manager
   try {
+    std::lock_guard<std::mutex> lock(managers_mutex);
     ClientSocket *socket;
     if (!manager_handle_.empty()) {
       socket = &get_manager_socket(manager_handle_);
@@ -107,6 +112,7 @@ void THManagedMapAllocator::close() {
   if (closed_) return;
   AllocInfo info = get_alloc_info(filename());
   info.free = true;
+  std::lock_guard<std::mutex> lock(managers_mutex);
   ClientSocket &socket = get_manager_socket(manager_handle_);
   THRefcountedMapAllocator::close();
   socket.register_deallocation(info);
@@ -4,6 +4,11 @@
 
 #ifdef __cplusplus
 
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unistd.h>
+
 void libshm_init(const char *manager_exec_path);
 
 // Superclass to run a constructor before THRefcountedMapAllocator
@@ -30,4 +35,59 @@ public:
   const char* manager_handle() const { return manager_handle_.c_str(); }
 };
 
+class THManagedSlabSegment;
+
+// A storage sub-allocated from a large shared memory segment, for processes
+// that share many small storages (e.g. DataLoader workers). Segments are
+// THManagedMapAllocator files, so torch_shm_manager tracks segments rather
+// than storages, and a process maps each segment it receives from only once.
+//
+// Every block starts with a header holding the number of references to it
+// across processes. The process that allocated a block puts it back in its
+// pool once the count drops to zero. As with THRefcountedMapAllocator, a
+// sender takes a reference before sending a block, which the receiver drops
+// after opening it.
+class THManagedSlabBlock {
+public:
+  THManagedSlabBlock(std::shared_ptr<THManagedSlabSegment> segment, size_t offset, size_t size, bool owned);
+  THManagedSlabBlock(const THManagedSlabBlock&) = delete;
+  THManagedSlabBlock& operator=(const THManagedSlabBlock&) = delete;
+  ~THManagedSlabBlock();
+
+  void incref();
+  void decref();
+
+  void* data() const;
+  size_t size() const { return size_; }
+  // Offset of the data in the segment
+  size_t offset() const { return offset_; }
+  const char* manager_handle() const;
+  const char* filename() const;
+  size_t segment_size() const;
+
+  // Allocates a block from the slab pool of this process. Returns an empty
+  // DataPtr if size is too large for a slab.
+  static at::DataPtr allocate(size_t size);
+  // Maps a block allocated by another process.
+  static at::DataPtr open(const char* manager_handle, const char* filename, size_t segment_size, size_t offset, size_t size);
+  static THManagedSlabBlock* fromDataPtr(const at::DataPtr&);
+
+  // Unmaps the segments of the pool without any block in use.
+  static void releaseUnusedSegments();
+  // Stops reusing any segment of the pool, and unmaps those without any block
+  // in use in this process. Called before exiting, so that the segments are
+  // removed once other processes stop using them.
+  static void releasePool();
+  // Number of segments in the pool, of bytes they hold and of blocks in use.
+  static std::tuple<size_t, size_t, size_t> poolStats();
+
+private:
+  std::shared_ptr<THManagedSlabSegment> segment_;
+  size_t offset_;
+  size_t size_;
+  // Whether the block was allocated by the pool of this process
+  bool owned_;
+  pid_t pid_;
+};
+
 #endif
@@ -0,0 +1,300 @@
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <TH/TH.h>
+#include <libshm/libshm.h>
+
+namespace {
+
+// Size of the segments of the pool. Storages too large for a block of
+// kMaxBlockSize get a file of their own.
+constexpr size_t kSegmentSize = 64 * 1024 * 1024;
+constexpr size_t kMaxBlockSize = 4 * 1024 * 1024;
+// Blocks are rounded up to a power of two of at least kMinBlockSize bytes,
+// including the header.
+constexpr size_t kMinBlockSize = 512;
+// Keeps the data of the blocks aligned like the data of other allocators.
+constexpr size_t kHeaderSize = 64;
+
+struct BlockHeader {
+  std::atomic<int64_t> refcount;
+};
+static_assert(sizeof(BlockHeader) <= kHeaderSize, "block header doesn't fit");
+static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t),
+              "refcounts in shared memory must be lock-free");
+
+size_t block_capacity(size_t size) {
+  size_t capacity = kMinBlockSize;
+  while (capacity < size + kHeaderSize) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+std::string new_segment_handle() {
+  static std::random_device rd;
+  std::string handle = "/torch_";
+  handle += std::to_string(getpid());
+  handle += "_slab_";
+  handle += std::to_string(rd());
+  return handle;
+}
+
+} // namespace
+
+class THManagedSlabSegment {
+public:
+  THManagedSlabSegment(at::DataPtr mapping, size_t size)
+    : mapping_(std::move(mapping)),
+      ctx_(THManagedMapAllocator::fromDataPtr(mapping_)),
+      size_(size) {}
+
+  char* base() const { return static_cast<char*>(mapping_.get()); }
+  BlockHeader* header(size_t offset) const {
+    return reinterpret_cast<BlockHeader*>(base() + offset - kHeaderSize);
+  }
+  THManagedMapAllocator* ctx() const { return ctx_; }
+  size_t size() const { return size_; }
+
+  // Only used by the pool that created the segment, under its mutex
+  size_t used = 0;
+  size_t live_blocks = 0;
+  // Set once the pool stops reusing the blocks of the segment
+  bool retired = false;
+
+private:
+  at::DataPtr mapping_;
+  THManagedMapAllocator* ctx_;
+  size_t size_;
+};
+
+namespace {
+
+struct FreeBlock {
+  std::shared_ptr<THManagedSlabSegment> segment;
+  size_t offset;
+  size_t capacity;
+};
+
+struct SlabPool {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<THManagedSlabSegment>> segments;
+  // Blocks ready for reuse, by capacity
+  std::unordered_map<size_t, std::vector<FreeBlock>> free_blocks;
+  // Blocks released by this process that other processes still use
+  std::vector<FreeBlock> pending;
+  // Segments of other processes mapped by this one, by file name
+  std::unordered_map<std::string, std::weak_ptr<THManagedSlabSegment>> opened;
+
+  // Moves the pending blocks nobody uses anymore to the free lists.
+  void reclaim_pending() {
+    auto it = std::partition(pending.begin(), pending.end(), [](const FreeBlock& block) {
+      return block.segment->header(block.offset)->refcount.load() != 0;
+    });
+    for (auto free = it; free != pending.end(); ++free) {
+      free_blocks[free->capacity].push_back(std::move(*free));
+    }
+    pending.erase(it, pending.end());
+  }
+};
+
+SlabPool* pool_ptr = nullptr;
+
+void reset_pool_after_fork() {
+  // The child can't use the segments of its parent to allocate, and must not
+  // release them either. The pool of the parent is leaked.
+  pool_ptr = new SlabPool();
+}
+
+SlabPool& pool() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    pool_ptr = new SlabPool();
+    pthread_atfork(nullptr, nullptr, &reset_pool_after_fork);
+  });
+  return *pool_ptr;
+}
+
+void deleteTHManagedSlabBlock(void* ptr) {
+  delete static_cast<THManagedSlabBlock*>(ptr);
+}
+
+at::DataPtr make_block_data_ptr(THManagedSlabBlock* block) {
+  return {block->data(), block, &deleteTHManagedSlabBlock, at::DeviceType::CPU};
+}
+
+} // namespace
+
+THManagedSlabBlock::THManagedSlabBlock(std::shared_ptr<THManagedSlabSegment> segment, size_t offset, size_t size, bool owned)
+  : segment_(std::move(segment)), offset_(offset), size_(size), owned_(owned), pid_(getpid()) {}
+
+THManagedSlabBlock::~THManagedSlabBlock() {
+  // Blocks inherited through fork belong to the parent
+  if (pid_ != getpid()) {
+    return;
+  }
+  if (!owned_) {
+    segment_->header(offset_)->refcount.fetch_sub(1);
+    return;
+  }
+  auto& p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  if (segment_->retired) {
+    segment_->header(offset_)->refcount.fetch_sub(1);
+    return;
+  }
+  FreeBlock block{std::move(segment_), offset_, block_capacity(size_)};
+  block.segment->live_blocks--;
+  if (block.segment->header(offset_)->refcount.fetch_sub(1) == 1) {
+    p.free_blocks[block.capacity].push_back(std::move(block));
+  } else {
+    p.pending.push_back(std::move(block));
+  }
+}
+
+// The references taken for a receiver also keep the segment file from being
+// removed if every process that maps it exits before the receiver opens it.
+void THManagedSlabBlock::incref() {
+  segment_->header(offset_)->refcount.fetch_add(1);
+  segment_->ctx()->incref();
+}
+
+void THManagedSlabBlock::decref() {
+  segment_->header(offset_)->refcount.fetch_sub(1);
+  segment_->ctx()->decref();
+}
+
+void* THManagedSlabBlock::data() const {
+  return segment_->base() + offset_;
+}
+
+const char* THManagedSlabBlock::manager_handle() const {
+  return segment_->ctx()->manager_handle();
+}
+
+const char* THManagedSlabBlock::filename() const {
+  return segment_->ctx()->filename();
+}
+
+size_t THManagedSlabBlock::segment_size() const {
+  return segment_->size();
+}
+
+at::DataPtr THManagedSlabBlock::allocate(size_t size) {
+  const size_t capacity = block_capacity(size);
+  if (capacity > kMaxBlockSize) {
+    return {};
+  }
+
+  auto& p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  auto& free = p.free_blocks[capacity];
+  if (free.empty()) {
+    p.reclaim_pending();
+  }
+
+  std::shared_ptr<THManagedSlabSegment> segment;
+  size_t offset;
+  if (!free.empty()) {
+    segment = std::move(free.back().segment);
+    offset = free.back().offset;
+    free.pop_back();
+  } else {
+    if (p.segments.empty() || p.segments.back()->used + capacity > kSegmentSize) {
+      int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE;
+      p.segments.push_back(std::make_shared<THManagedSlabSegment>(
+          THManagedMapAllocator::makeDataPtr("", new_segment_handle().c_str(), flags, kSegmentSize),
+          kSegmentSize));
+    }
+    segment = p.segments.back();
+    offset = segment->used + kHeaderSize;
+    segment->used += capacity;
+  }
+  segment->live_blocks++;
+  segment->header(offset)->refcount.store(1);
+  return make_block_data_ptr(new THManagedSlabBlock(std::move(segment), offset, size, /*owned=*/true));
+}
+
+at::DataPtr THManagedSlabBlock::open(const char* manager_handle, const char* filename, size_t segment_size, size_t offset, size_t size) {
+  if (offset < kHeaderSize || offset + size > segment_size) {
+    THError("invalid slab block at offset %zu of size %zu in a segment of %zu bytes", offset, size, segment_size);
+  }
+
+  std::shared_ptr<THManagedSlabSegment> segment;
+  {
+    auto& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    auto& weak = p.opened[filename];
+    segment = weak.lock();
+    if (!segment) {
+      int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE;
+      segment = std::make_shared<THManagedSlabSegment>(
+          THManagedMapAllocator::makeDataPtr(manager_handle, filename, flags, segment_size),
+          segment_size);
+      weak = segment;
+      for (auto it = p.opened.begin(); it != p.opened.end();) {
+        it = it->second.expired() ? p.opened.erase(it) : std::next(it);
+      }
+    }
+  }
+  segment->header(offset)->refcount.fetch_add(1);
+  return make_block_data_ptr(new THManagedSlabBlock(std::move(segment), offset, size, /*owned=*/false));
+}
+
+THManagedSlabBlock* THManagedSlabBlock::fromDataPtr(const at::DataPtr& dptr) {
+  return dptr.cast_context<THManagedSlabBlock>(&deleteTHManagedSlabBlock);
+}
+
+void THManagedSlabBlock::releaseUnusedSegments() {
+  auto& p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.reclaim_pending();
+  auto is_unused = [](const std::shared_ptr<THManagedSlabSegment>& segment) {
+    return segment->live_blocks == 0;
+  };
+  for (auto& entry : p.free_blocks) {
+    auto& blocks = entry.second;
+    blocks.erase(
+        std::remove_if(blocks.begin(), blocks.end(), [&](const FreeBlock& block) {
+          return is_unused(block.segment);
+        }),
+        blocks.end());
+  }
+  // Blocks still used by other processes keep their segment mapped
+  p.segments.erase(
+      std::remove_if(p.segments.begin(), p.segments.end(), [&](const std::shared_ptr<THManagedSlabSegment>& segment) {
+        return is_unused(segment) &&
+            std::none_of(p.pending.begin(), p.pending.end(), [&](const FreeBlock& block) {
+              return block.segment == segment;
+            });
+      }),
+      p.segments.end());
+}
+
+void THManagedSlabBlock::releasePool() {
+  auto& p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  for (auto& segment : p.segments) {
+    segment->retired = true;
+  }
+  p.segments.clear();
+  p.free_blocks.clear();
+  p.pending.clear();
+}
+
+std::tuple<size_t, size_t, size_t> THManagedSlabBlock::poolStats() {
+  auto& p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  size_t live_blocks = 0;
+  for (const auto& segment : p.segments) {
+    live_blocks += segment->live_blocks;
+  }
+  return std::make_tuple(p.segments.size(), p.segments.size() * kSegmentSize, live_blocks);
+}
@@ -17,6 +17,7 @@ import torch
 import sys
 from .reductions import init_reductions
 import multiprocessing
+import multiprocessing.util
 
 __all__ = ['set_sharing_strategy', 'get_sharing_strategy',
            'get_all_sharing_strategies']
@@ -45,12 +46,15 @@ them. This depends `mp.get_context` which was added in Python 3.4."""
 from .spawn import spawn, SpawnContext, _supports_context, start_processes, ProcessContext
 
 
-if sys.platform == 'darwin' or sys.platform == 'win32':
+if sys.platform == 'win32':
     _sharing_strategy = 'file_system'
     _all_sharing_strategies = {'file_system'}
+elif sys.platform == 'darwin':
+    _sharing_strategy = 'file_system'
+    _all_sharing_strategies = {'file_system', 'file_system_slab'}
 else:
     _sharing_strategy = 'file_descriptor'
-    _all_sharing_strategies = {'file_descriptor', 'file_system'}
+    _all_sharing_strategies = {'file_descriptor', 'file_system', 'file_system_slab'}
 
 
 def set_sharing_strategy(new_strategy):
@@ -75,4 +79,17 @@ def get_all_sharing_strategies():
     return _all_sharing_strategies
 
 
+def _register_slab_pool_finalizer():
+    # Processes started by multiprocessing exit with os._exit(), the slab
+    # segments they own would only be removed by torch_shm_manager when every
+    # process of the group has exited.
+    if sys.platform != 'win32':
+        multiprocessing.util.Finalize(None, _release_slab_pool, exitpriority=0)
+
+
+_register_slab_pool_finalizer()
+multiprocessing.util.register_after_fork(_register_slab_pool_finalizer,
+                                         lambda f: f())
+
+
 init_reductions()
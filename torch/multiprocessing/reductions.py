@@ -300,6 +300,15 @@ def rebuild_storage_filename(cls, manager, handle, size):
     return storage._shared_decref()
 
 
+def rebuild_storage_slab(cls, manager, segment, segment_size, offset, size):
+    storage = storage_from_cache(cls, (segment, offset))
+    if storage is not None:
+        return storage._shared_decref()
+    storage = cls._new_shared_slab(manager, segment, segment_size, offset, size)
+    shared_cache[(segment, offset)] = StorageWeakRef(storage)
+    return storage._shared_decref()
+
+
 def rebuild_storage_empty(cls):
     return cls()
 
@@ -313,6 +322,17 @@ def reduce_storage(storage):
         cache_key = metadata[1]
         rebuild = rebuild_storage_filename
         storage._shared_incref()
+    elif get_sharing_strategy() == 'file_system_slab':
+        # Storages too large for a slab are shared as in 'file_system'
+        metadata = storage._share_slab_()
+        if metadata is None:
+            metadata = storage._share_filename_()
+            cache_key = metadata[1]
+            rebuild = rebuild_storage_filename
+        else:
+            cache_key = (metadata[1], metadata[3])
+            rebuild = rebuild_storage_slab
+        storage._shared_incref()
     elif storage.size() == 0:
         # This is special cased because Empty tensors
         # (with size 0) cannot be mmapped.
@@ -0,0 +1,448 @@
+r"""
+The :mod:`torch.nested` package provides :class:`NestedTensor`, a batch of
+tensors of different sizes stored without padding.
+"""
+
+import torch
+import torch.nn.functional as F
+
+__all__ = ['NestedTensor', 'nested_tensor', 'from_padded']
+
+
+_HANDLED_FUNCTIONS = {}
+
+
+def _implements(*torch_functions):
+    r"""Registers the decorated function as the implementation of
+    :attr:`torch_functions` for :class:`NestedTensor`"""
+    def decorator(func):
+        for torch_function in torch_functions:
+            _HANDLED_FUNCTIONS[torch_function] = func
+        return func
+    return decorator
+
+
+class NestedTensor(object):
+    r"""A batch of tensors with the same number of dimensions, dtype and
+    device but possibly different sizes.
+
+    The elements of all the components are stored one after the other in a
+    single contiguous 1-D :attr:`buffer`, so that operations which don't mix
+    components run once on the whole buffer instead of once per component or
+    on a padded tensor. The dimensions of a :class:`NestedTensor` are the
+    batch dimension followed by the dimensions of the components, so the
+    components of ``nt`` are ``nt[0]``, ``nt[1]``, ...
+
+    The typical nested tensor is a batch of sequences of different lengths,
+    whose components have shape ``(length, *features)``. A
+    :class:`NestedTensor` supports through ``__torch_function__``:
+
+    - elementwise operations, e.g. ``nt + 1``, ``nt * other``,
+      :func:`torch.relu` or :func:`torch.nn.functional.gelu`, where ``other``
+      is a :class:`NestedTensor` of the same sizes or a tensor broadcastable to
+      the trailing dimensions shared by all components, such as a bias;
+    - :func:`torch.nn.functional.linear` and :func:`torch.matmul` with a
+      weight matrix, applied to all the rows of all the components at once,
+      and :func:`torch.matmul` of two nested tensors, component by component;
+    - :func:`torch.nn.functional.layer_norm` over trailing dimensions shared
+      by all components;
+    - :func:`torch.softmax`, :func:`torch.sum` and :func:`torch.mean` along
+      any dimension of the components. Along the sequence dimension, they use
+      :func:`torch.segment_reduce` on CPU, and the sum and mean return a dense
+      ``(batch, *features)`` tensor.
+
+    All these operations are differentiable with respect to the buffer.
+
+    Args:
+        buffer (Tensor): 1-D tensor of the elements of all the components
+        nested_size (list of torch.Size): the sizes of the components
+    """
+
+    def __init__(self, buffer, nested_size):
+        if buffer.dim() != 1:
+            raise ValueError("NestedTensor: expected a 1-D buffer, got a {}-D tensor".format(buffer.dim()))
+        self._buffer = buffer
+        self._nested_size = [torch.Size(size) for size in nested_size]
+        if len(set(len(size) for size in self._nested_size)) > 1:
+            raise ValueError("NestedTensor: expected components with the same number of dimensions")
+        self._offsets = [0]
+        for size in self._nested_size:
+            self._offsets.append(self._offsets[-1] + size.numel())
+        if self._offsets[-1] != buffer.numel():
+            raise ValueError("NestedTensor: the components have {} elements but the buffer has {}".format(
+                self._offsets[-1], buffer.numel()))
+
+    @property
+    def buffer(self):
+        r"""The 1-D tensor of the elements of all the components"""
+        return self._buffer
+
+    @property
+    def dtype(self):
+        return self._buffer.dtype
+
+    @property
+    def device(self):
+        return self._buffer.device
+
+    @property
+    def requires_grad(self):
+        return self._buffer.requires_grad
+
+    def requires_grad_(self, requires_grad=True):
+        self._buffer.requires_grad_(requires_grad)
+        return self
+
+    def nested_size(self):
+        r"""Returns the list of the sizes of the components"""
+        return list(self._nested_size)
+
+    def offsets(self):
+        r"""Returns the list of the ``len(self) + 1`` offsets of the components
+        in :attr:`buffer`"""
+        return list(self._offsets)
+
+    def __len__(self):
+        return len(self._nested_size)
+
+    def dim(self):
+        return 1 + self._component_dim()
+
+    def numel(self):
+        return self._buffer.numel()
+
+    def __getitem__(self, i):
+        size = self._nested_size[i]
+        return self._buffer.narrow(0, self._offsets[i], size.numel()).view(size)
+
+    def unbind(self):
+        r"""Returns the components, as views of :attr:`buffer`"""
+        return tuple(self[i] for i in range(len(self)))
+
+    def __iter__(self):
+        return iter(self.unbind())
+
+    def __repr__(self):
+        return "NestedTensor(nested_size={}, dtype={}, device={})".format(
+            [tuple(size) for size in self._nested_size], self.dtype, self.device)
+
+    def __torch_function__(self, func, types, args=(), kwargs=None):
+        if kwargs is None:
+            kwargs = {}
+        if func not in _HANDLED_FUNCTIONS:
+            return NotImplemented
+        return _HANDLED_FUNCTIONS[func](*args, **kwargs)
+
+    def _with_buffer(self, buffer, nested_size=None):
+        return NestedTensor(buffer, self._nested_size if nested_size is None else nested_size)
+
+    def _component_dim(self):
+        return len(self._nested_size[0]) if self._nested_size else 0
+
+    def _uniform_dims(self):
+        r"""Returns the number of trailing component dimensions with the same
+        size in all the components"""
+        ndim = self._component_dim()
+        if not self._nested_size:
+            return ndim
+        first = self._nested_size[0]
+        for d in range(ndim - 1, -1, -1):
+            if any(size[d] != first[d] for size in self._nested_size):
+                return ndim - 1 - d
+        return ndim
+
+    def _rows(self, num_trailing_dims):
+        r"""Returns :attr:`buffer` as a ``(-1, *trailing)`` tensor, where
+        ``trailing`` are the last :attr:`num_trailing_dims` dimensions of the
+        components, or None if they differ between components"""
+        if num_trailing_dims > self._uniform_dims() or not self._nested_size:
+            return None
+        trailing = self._nested_size[0][self._component_dim() - num_trailing_dims:]
+        return self._buffer.view((-1,) + tuple(trailing))
+
+    def _component_dim_index(self, dim):
+        ndim = self.dim()
+        if dim < 0:
+            dim += ndim
+        if dim <= 0 or dim >= ndim:
+            raise IndexError("NestedTensor: dimension {} is out of range for a nested tensor of dimension {}, "
+                             "the batch dimension 0 can't be reduced".format(dim, ndim))
+        return dim - 1
+
+    def _lengths(self):
+        return torch.tensor([size[0] for size in self._nested_size], dtype=torch.long, device=self.device)
+
+    def _can_segment_reduce(self, c):
+        # segment_reduce only has a CPU kernel
+        return (c == 0 and len(self._nested_size) > 0 and self._uniform_dims() >= self._component_dim() - 1 and
+                self.device.type == 'cpu' and self.dtype.is_floating_point)
+
+    def to_padded(self, padding=0.):
+        r"""Returns a ``(len(self), *max_size)`` tensor holding the
+        components padded with :attr:`padding`, where ``max_size`` is the
+        maximum size of the components along each dimension"""
+        if not self._nested_size:
+            raise RuntimeError("NestedTensor: can't pad an empty nested tensor")
+        ndim = self._component_dim()
+        max_size = [max(size[d] for size in self._nested_size) for d in range(ndim)]
+        padded = self._buffer.new_full([len(self)] + max_size, padding)
+        rows = self._rows(ndim - 1) if ndim > 0 else None
+        if rows is not None:
+            # Only the first dimension is ragged: copy all the rows at once
+            index = _padded_row_index(self._lengths(), max_size[0])
+            return padded.view((-1,) + rows.shape[1:]).index_copy(0, index, rows).view(padded.shape)
+        for i, component in enumerate(self.unbind()):
+            padded[i][tuple(slice(0, s) for s in component.shape)] = component
+        return padded
+
+    def __add__(self, other):
+        return torch.add(self, other)
+
+    __radd__ = __add__
+
+    def __sub__(self, other):
+        return torch.sub(self, other)
+
+    def __rsub__(self, other):
+        return torch.neg(torch.sub(self, other))
+
+    def __mul__(self, other):
+        return torch.mul(self, other)
+
+    __rmul__ = __mul__
+
+    def __truediv__(self, other):
+        return torch.div(self, other)
+
+    def __rtruediv__(self, other):
+        return _elementwise_binary(torch.div)(other, self)
+
+    def __neg__(self):
+        return torch.neg(self)
+
+    def __matmul__(self, other):
+        return torch.matmul(self, other)
+
+    def detach(self):
+        return self._with_buffer(self._buffer.detach())
+
+    def clone(self):
+        return self._with_buffer(self._buffer.clone())
+
+    def to(self, *args, **kwargs):
+        return self._with_buffer(self._buffer.to(*args, **kwargs))
+
+    def relu(self):
+        return torch.relu(self)
+
+    def softmax(self, dim):
+        return torch.softmax(self, dim)
+
+    def sum(self, dim=None):
+        return torch.sum(self) if dim is None else torch.sum(self, dim)
+
+    def mean(self, dim=None):
+        return torch.mean(self) if dim is None else torch.mean(self, dim)
+
+    def matmul(self, other):
+        return torch.matmul(self, other)
+
+
+def _padded_row_index(lengths, max_length):
+    r"""Returns the index of each row of the components in the rows of the
+    padded ``(len(lengths), max_length, ...)`` tensor"""
+    batch = torch.arange(lengths.numel(), device=lengths.device)
+    starts = lengths.cumsum(0) - lengths
+    num_rows = int(lengths.sum())
+    position = torch.arange(num_rows, device=lengths.device) - starts.repeat_interleave(lengths)
+    return batch.repeat_interleave(lengths) * max_length + position
+
+
+def nested_tensor(tensors):
+    r"""Returns a :class:`NestedTensor` with a copy of :attr:`tensors` as
+    components. Gradients flow back to :attr:`tensors`.
+
+    Args:
+        tensors (list of Tensor): tensors with the same number of dimensions,
+            dtype and device
+
+    Example::
+
+        >>> nt = torch.nested.nested_tensor([torch.randn(3, 8), torch.randn(5, 8)])
+        >>> nt.nested_size()
+        [torch.Size([3, 8]), torch.Size([5, 8])]
+        >>> nt.to_padded().shape
+        torch.Size([2, 5, 8])
+    """
+    tensors = list(tensors)
+    if not tensors:
+        raise ValueError("nested_tensor: expected at least one tensor")
+    if any(t.dtype != tensors[0].dtype or t.device != tensors[0].device for t in tensors):
+        raise ValueError("nested_tensor: expected tensors with the same dtype and device")
+    buffer = torch.cat([t.reshape(-1) for t in tensors])
+    return NestedTensor(buffer, [t.shape for t in tensors])
+
+
+def from_padded(padded, lengths):
+    r"""Returns the :class:`NestedTensor` whose ``i``-th component is
+    ``padded[i, :lengths[i]]``. This is the inverse of
+    :meth:`NestedTensor.to_padded` for sequences.
+
+    Args:
+        padded (Tensor): ``(batch, max_length, *features)`` tensor
+        lengths (list of int or LongTensor): the ``batch`` lengths of the
+            sequences, at most ``max_length``
+    """
+    if padded.dim() < 2:
+        raise ValueError("from_padded: expected a tensor with at least 2 dimensions")
+    lengths = torch.as_tensor(lengths, dtype=torch.long, device=padded.device)
+    if lengths.dim() != 1 or lengths.numel() != padded.size(0):
+        raise ValueError("from_padded: expected {} lengths".format(padded.size(0)))
+    if lengths.numel() > 0 and (int(lengths.min()) < 0 or int(lengths.max()) > padded.size(1)):
+        raise ValueError("from_padded: lengths must be in [0, {}]".format(padded.size(1)))
+    features = padded.shape[2:]
+    index = _padded_row_index(lengths, padded.size(1))
+    rows = padded.reshape((-1,) + tuple(features)).index_select(0, index)
+    return NestedTensor(rows.reshape(-1), [(length,) + tuple(features) for length in lengths.tolist()])
+
+
+def _buffer_or_rows(nt, other):
+    r"""Returns the tensors to combine for an elementwise operation between
+    :attr:`nt` and :attr:`other`, and whether the result is a view of the
+    rows of :attr:`nt`"""
+    if isinstance(other, NestedTensor):
+        if other._nested_size != nt._nested_size:
+            raise ValueError("NestedTensor: expected nested tensors of the same sizes, got {} and {}".format(
+                [tuple(s) for s in nt._nested_size], [tuple(s) for s in other._nested_size]))
+        return nt._buffer, other._buffer
+    if isinstance(other, torch.Tensor) and other.dim() > 0:
+        rows = nt._rows(other.dim())
+        if rows is None:
+            raise ValueError("NestedTensor: the last {} dimensions of the components must be the same to "
+                             "broadcast a tensor of shape {}".format(other.dim(), tuple(other.shape)))
+        return rows, other
+    return nt._buffer, other
+
+
+def _elementwise_binary(func):
+    def impl(input, other, *args, **kwargs):
+        if not isinstance(input, NestedTensor):
+            input, other = other, input
+            swapped = True
+        else:
+            swapped = False
+        lhs, rhs = _buffer_or_rows(input, other)
+        if swapped:
+            lhs, rhs = rhs, lhs
+        return input._with_buffer(func(lhs, rhs, *args, **kwargs).reshape(-1))
+    return impl
+
+
+for _func in (torch.add, torch.sub, torch.mul, torch.div):
+    _implements(_func)(_elementwise_binary(_func))
+
+
+def _elementwise_unary(func):
+    def impl(input, *args, **kwargs):
+        return input._with_buffer(func(input._buffer, *args, **kwargs))
+    return impl
+
+
+for _func in (torch.neg, torch.abs, torch.exp, torch.tanh, torch.sigmoid, torch.relu,
+              F.relu, F.gelu, F.dropout):
+    _implements(_func)(_elementwise_unary(_func))
+
+
+@_implements(F.linear)
+def _linear(input, weight, bias=None):
+    rows = input._rows(1)
+    if rows is None:
+        raise ValueError("NestedTensor: linear expects components with the same last dimension")
+    output = F.linear(rows, weight, bias)
+    return NestedTensor(output.reshape(-1), [size[:-1] + output.shape[-1:] for size in input._nested_size])
+
+
+@_implements(torch.matmul)
+def _matmul(input, other):
+    if isinstance(input, NestedTensor) and isinstance(other, NestedTensor):
+        if len(input) != len(other):
+            raise ValueError("NestedTensor: matmul expects nested tensors with the same number of components")
+        return nested_tensor([torch.matmul(a, b) for a, b in zip(input.unbind(), other.unbind())])
+    if not isinstance(input, NestedTensor) or other.dim() != 2:
+        raise ValueError("NestedTensor: matmul expects a nested tensor and a matrix, or two nested tensors")
+    rows = input._rows(1)
+    if rows is None:
+        raise ValueError("NestedTensor: matmul expects components with the same last dimension")
+    output = rows.matmul(other)
+    return NestedTensor(output.reshape(-1), [size[:-1] + output.shape[-1:] for size in input._nested_size])
+
+
+@_implements(torch.layer_norm)
+def _layer_norm(input, normalized_shape, weight=None, bias=None, eps=1e-5, cudnn_enable=True):
+    rows = input._rows(len(normalized_shape))
+    if rows is None or tuple(rows.shape[1:]) != tuple(normalized_shape):
+        raise ValueError("NestedTensor: layer_norm expects components whose last dimensions are {}".format(
+            tuple(normalized_shape)))
+    output = torch.layer_norm(rows, normalized_shape, weight, bias, eps, cudnn_enable)
+    return input._with_buffer(output.reshape(-1))
+
+
+def _repeat_segments(t, lengths):
+    return t.repeat_interleave(lengths, dim=0)
+
+
+@_implements(torch.softmax)
+def _softmax(input, dim, dtype=None):
+    c = input._component_dim_index(dim)
+    ndim = input._component_dim()
+    nt = input if dtype is None else input.to(dtype)
+    rows = nt._rows(ndim - c)
+    if rows is not None:
+        return nt._with_buffer(rows.softmax(1).reshape(-1))
+    if nt._can_segment_reduce(c):
+        # Softmax along the sequences of the whole batch at once
+        lengths = nt._lengths()
+        x = nt._rows(ndim - 1)
+        shift = torch.segment_reduce(x.detach(), 'max', lengths=lengths)
+        e = (x - _repeat_segments(shift, lengths)).exp()
+        total = torch.segment_reduce(e, 'sum', lengths=lengths)
+        return nt._with_buffer((e / _repeat_segments(total, lengths)).reshape(-1))
+    return nested_tensor([t.softmax(c) for t in nt.unbind()])
+
+
+@_implements(F.softmax)
+def _functional_softmax(input, dim=None, _stacklevel=3, dtype=None):
+    if dim is None:
+        raise ValueError("NestedTensor: softmax expects an explicit dim")
+    return _softmax(input, dim, dtype)
+
+
+def _reduction(func, reduce):
+    def impl(input, dim=None, keepdim=False, dtype=None):
+        if dim is None:
+            return func(input._buffer) if dtype is None else func(input._buffer, dtype=dtype)
+        if keepdim:
+            raise ValueError("NestedTensor: keepdim=True isn't supported")
+        nt = input if dtype is None else input.to(dtype)
+        c = nt._component_dim_index(dim)
+        ndim = nt._component_dim()
+        rows = nt._rows(ndim - c)
+        # Reducing the sequences gives a dense tensor unless the other dimensions are ragged
+        dense = c == 0 and nt._uniform_dims() >= ndim - 1
+        if rows is not None:
+            output = func(rows, 1)
+            if dense:
+                return output
+            return NestedTensor(output.reshape(-1), [size[:c] + size[c + 1:] for size in nt._nested_size])
+        if nt._can_segment_reduce(c):
+            # Reduce the sequences of the whole batch at once
+            return torch.segment_reduce(nt._rows(ndim - 1), reduce, lengths=nt._lengths())
+        outputs = [func(t, c) for t in nt.unbind()]
+        if dense and outputs:
+            return torch.stack(outputs)
+        return nested_tensor(outputs)
+    return impl
+
+
+_implements(torch.sum)(_reduction(torch.sum, 'sum'))
+_implements(torch.mean)(_reduction(torch.mean, 'mean'))
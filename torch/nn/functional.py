@@ -3011,27 +3011,32 @@ def _interp_output_size(closed_over_args):  # noqa: F811
     return [int(math.floor(float(input.size(i + 2)) * scale_factors[i])) for i in range(dim)]
 
 @_overload  # noqa: F811
-def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None):  # noqa: F811
-    # type: (Tensor, Optional[int], Optional[List[float]], str, Optional[bool], Optional[bool]) -> Tensor
+def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None,  # noqa: F811
+                recompute_scale_factor=None, antialias=False):
+    # type: (Tensor, Optional[int], Optional[List[float]], str, Optional[bool], Optional[bool], bool) -> Tensor
     pass
 
 @_overload  # noqa: F811
-def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None):  # noqa: F811
-    # type: (Tensor, Optional[List[int]], Optional[List[float]], str, Optional[bool], Optional[bool]) -> Tensor
+def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None,  # noqa: F811
+                recompute_scale_factor=None, antialias=False):
+    # type: (Tensor, Optional[List[int]], Optional[List[float]], str, Optional[bool], Optional[bool], bool) -> Tensor
     pass
 
 @_overload  # noqa: F811
-def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None):  # noqa: F811
-    # type: (Tensor, Optional[int], Optional[float], str, Optional[bool], Optional[bool]) -> Tensor
+def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None,  # noqa: F811
+                recompute_scale_factor=None, antialias=False):
+    # type: (Tensor, Optional[int], Optional[float], str, Optional[bool], Optional[bool], bool) -> Tensor
     pass
 
 @_overload  # noqa: F811
-def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None):  # noqa: F811
-    # type: (Tensor, Optional[List[int]], Optional[float], str, Optional[bool], Optional[bool]) -> Tensor
+def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None,  # noqa: F811
+                recompute_scale_factor=None, antialias=False):
+    # type: (Tensor, Optional[List[int]], Optional[float], str, Optional[bool], Optional[bool], bool) -> Tensor
     pass
 
-def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None, recompute_scale_factor=None):  # noqa: F811
-    # type: (Tensor, Optional[int], Optional[List[float]], str, Optional[bool], Optional[bool]) -> Tensor
+def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corners=None,  # noqa: F811
+                recompute_scale_factor=None, antialias=False):
+    # type: (Tensor, Optional[int], Optional[List[float]], str, Optional[bool], Optional[bool], bool) -> Tensor
     r"""Down/up samples the input to either the given :attr:`size` or the given
     :attr:`scale_factor`
 
@@ -3073,6 +3078,9 @@ def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corne
             be used in the interpolation computation.  Note that when `scale_factor` is floating-point,
             the recomputed scale_factor may differ from the one passed in due to rounding and precision
             issues.
+        antialias (bool, optional): flag to apply anti-aliasing when downsampling. With
+            ``align_corners=False``, the result matches the one of Pillow. Only supported for the
+            ``'bilinear'`` and ``'bicubic'`` modes on CPU. Default: ``False``
 
     .. note::
         With ``mode='bicubic'``, it's possible to cause overshoot, in other words it can produce
@@ -3108,7 +3116,7 @@ def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corne
             return handle_torch_function(
                 interpolate, (input,), input, size=size, scale_factor=scale_factor,
                 mode=mode, align_corners=align_corners,
-                recompute_scale_factor=recompute_scale_factor)
+                recompute_scale_factor=recompute_scale_factor, antialias=antialias)
 
     if mode in ('nearest', 'area'):
         if align_corners is not None:
@@ -3122,6 +3130,9 @@ def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corne
                           "See the documentation of nn.Upsample for details.".format(mode))
             align_corners = False
 
+    if antialias and not (mode in ('bilinear', 'bicubic') and input.dim() == 4):
+        raise ValueError("Anti-alias option is only supported for bilinear and bicubic modes")
+
     scale_factor_len = input.dim() - 2
     scale_factor_list = torch.jit.annotate(List[Optional[float]], [None for _ in range(scale_factor_len)])
     if scale_factor is not None and recompute_scale_factor is False:
@@ -3160,6 +3171,8 @@ def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corne
         raise NotImplementedError("Got 4D input, but linear mode needs 3D input")
     elif input.dim() == 4 and mode == 'bilinear':
         assert align_corners is not None
+        if antialias:
+            return torch._C._nn._upsample_bilinear2d_aa(input, output_size, align_corners, sfl[0], sfl[1])
         return torch._C._nn.upsample_bilinear2d(input, output_size, align_corners, sfl[0], sfl[1])
     elif input.dim() == 4 and mode == 'trilinear':
         raise NotImplementedError("Got 4D input, but trilinear mode needs 5D input")
@@ -3172,6 +3185,8 @@ def interpolate(input, size=None, scale_factor=None, mode='nearest', align_corne
         return torch._C._nn.upsample_trilinear3d(input, output_size, align_corners, sfl[0], sfl[1], sfl[2])
     elif input.dim() == 4 and mode == 'bicubic':
         assert align_corners is not None
+        if antialias:
+            return torch._C._nn._upsample_bicubic2d_aa(input, output_size, align_corners, sfl[0], sfl[1])
         return torch._C._nn.upsample_bicubic2d(input, output_size, align_corners, sfl[0], sfl[1])
     else:
         raise NotImplementedError("Input Error: Only 3D, 4D and 5D input Tensors supported"
@@ -19,6 +19,9 @@ class Linear(nnq.Linear):
         bias (Tensor): the non-learnable bias of the module of shape :math:`(\text{out\_features})`.
                 If :attr:`bias` is ``True``, the values are initialized to zero.
 
+    With 4-bit weights (see :attr:`~torch.quantization.int4_dynamic_qconfig`), :attr:`weight`
+    is dequantized and grouped as :math:`(\text{out\_features}, \text{in\_features} / \text{group\_size}, \text{group\_size})`.
+
     Examples::
 
         >>> m = nn.quantized.dynamic.Linear(20, 30)
@@ -55,7 +58,12 @@ class Linear(nnq.Linear):
             self.in_features, self.out_features, self._packed_params.dtype
         )
         if self._packed_params.dtype == torch.qint8:
-            extra_repr_str += ', qscheme={}'.format(self.weight().qscheme())
+            weight = self.weight()
+            if weight.is_quantized:
+                extra_repr_str += ', qscheme={}'.format(weight.qscheme())
+            else:
+                extra_repr_str += ', qscheme={}, group_size={}'.format(
+                    torch.per_channel_group_symmetric, weight.size(2))
         return extra_repr_str
 
     @classmethod
@@ -79,7 +87,13 @@ class Linear(nnq.Linear):
         dtype = weight_observer.dtype
         assert dtype in [torch.qint8, torch.float16], 'The only supported dtypes for dynamic quantized linear are qint8 and float16'
         weight_observer(mod.weight)
-        if dtype == torch.qint8:
+        if getattr(weight_observer, 'qscheme', None) == torch.per_channel_group_symmetric:
+            # 4-bit weights are quantized when they are packed, pass them grouped
+            group_size = weight_observer.group_size
+            assert mod.in_features % group_size == 0, \
+                'The number of input features must be a multiple of the group size for 4-bit weights'
+            qweight = mod.weight.float().reshape(mod.out_features, -1, group_size)
+        elif dtype == torch.qint8:
             qweight = _quantize_weight(mod.weight.float(), weight_observer)
         elif dtype == torch.float16:
             qweight = mod.weight.float()
@@ -23,7 +23,13 @@ class LinearPackedParams(torch.nn.Module):
     def set_weight_bias(self, weight, bias):
         # type: (torch.Tensor, Optional[torch.Tensor]) -> None
         if self.dtype == torch.qint8:
-            self._packed_params = torch.ops.quantized.linear_prepack(weight, bias)
+            if not weight.is_quantized and weight.dim() == 3:
+                # 4-bit weight of dynamic quantized linear, dequantized and grouped as
+                # (out_features, in_features / group_size, group_size)
+                self._packed_params = torch.ops.quantized.linear_prepack_int4(
+                    weight.flatten(1), bias, weight.size(2))
+            else:
+                self._packed_params = torch.ops.quantized.linear_prepack(weight, bias)
         elif self.dtype == torch.float16:
             self._packed_params = torch.ops.quantized.linear_prepack_fp16(weight, bias)
         else:
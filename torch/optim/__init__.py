@@ -15,6 +15,7 @@ from .asgd import ASGD
 from .sgd import SGD
 from .rprop import Rprop
 from .rmsprop import RMSprop
+from .rowwise_adagrad import RowWiseAdagrad
 from .optimizer import Optimizer
 from .lbfgs import LBFGS
 from . import lr_scheduler
@@ -29,5 +30,6 @@ del asgd
 del sgd
 del rprop
 del rmsprop
+del rowwise_adagrad
 del optimizer
 del lbfgs
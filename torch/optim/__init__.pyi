@@ -9,5 +9,6 @@ from .lbfgs import LBFGS as LBFGS
 from .optimizer import Optimizer as Optimizer
 from .rmsprop import RMSprop as RMSprop
 from .rprop import Rprop as Rprop
+from .rowwise_adagrad import RowWiseAdagrad as RowWiseAdagrad
 from .sgd import SGD as SGD
 from .sparse_adam import SparseAdam as SparseAdam
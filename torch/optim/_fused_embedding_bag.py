@@ -0,0 +1,90 @@
+r"""Fused embedding_bag backward and sparse optimizer update.
+
+The ``embedding_bag`` methods of the optimizers that support it return the
+output of :func:`torch.nn.functional.embedding_bag`, but instead of computing a
+gradient for ``weight`` the backward pass applies the optimizer update to the
+rows of ``weight`` looked up in the batch right away, in a single
+multithreaded pass over the unique rows.
+"""
+import torch
+
+_MODES = {'sum': 0, 'mean': 1}
+
+
+class _FusedEmbeddingBag(torch.autograd.Function):
+
+    @staticmethod
+    def forward(ctx, weight, input, offsets, per_sample_weights, mode,
+                include_last_offset, update):
+        ctx.mode = mode
+        ctx.include_last_offset = include_last_offset
+        ctx.update = update
+        ctx.save_for_backward(input, offsets, per_sample_weights)
+        if weight.dtype in (torch.float, torch.double):
+            return torch.embedding_bag(
+                weight, input, offsets, False, mode, False,
+                per_sample_weights, include_last_offset)[0]
+        # The CPU embedding_bag kernel only supports float weights, gather the
+        # rows used by the batch and run it on an fp32 copy of those
+        rows, input = torch.unique(input, return_inverse=True)
+        if per_sample_weights is not None:
+            per_sample_weights = per_sample_weights.float()
+        return torch.embedding_bag(
+            weight.index_select(0, rows).float(), input, offsets, False, mode,
+            False, per_sample_weights, include_last_offset)[0]
+
+    @staticmethod
+    def backward(ctx, grad_output):
+        input, offsets, per_sample_weights = ctx.saved_tensors
+        with torch.no_grad():
+            ctx.update(grad_output, input, offsets, ctx.mode,
+                       per_sample_weights, ctx.include_last_offset)
+        return None, None, None, None, None, None, None
+
+
+def _find_group(optimizer, weight):
+    for group in optimizer.param_groups:
+        if any(p is weight for p in group['params']):
+            return group
+    raise ValueError("weight is not a parameter of this optimizer")
+
+
+def fused_embedding_bag(weight, input, offsets, mode, per_sample_weights,
+                        include_last_offset, update):
+    r"""Runs ``embedding_bag`` with ``update(grad, indices, offsets, mode,
+    per_sample_weights, include_last_offset)`` as its backward. ``input``,
+    ``offsets`` and ``per_sample_weights`` follow
+    :func:`torch.nn.functional.embedding_bag`."""
+    if weight.dim() != 2:
+        raise ValueError("weight has to be a 2D Tensor, but got Tensor of dimension {}"
+                         .format(weight.dim()))
+    if mode not in _MODES:
+        raise ValueError("mode has to be one of {}, but got {}"
+                         .format(sorted(_MODES), mode))
+    if per_sample_weights is not None:
+        if per_sample_weights.requires_grad:
+            raise ValueError("fused embedding_bag does not compute gradients "
+                             "for per_sample_weights")
+        if per_sample_weights.size() != input.size():
+            raise ValueError("embedding_bag: If per_sample_weights ({}) is not None, "
+                             "then it must have the same shape as the input ({})"
+                             .format(per_sample_weights.shape, input.shape))
+    if input.dim() == 2:
+        if offsets is not None:
+            raise ValueError("if input is 2D, then offsets has to be None")
+        offsets = torch.arange(0, input.numel(), input.size(1),
+                               dtype=torch.long, device=input.device)
+        input = input.reshape(-1)
+        if per_sample_weights is not None:
+            per_sample_weights = per_sample_weights.reshape(-1)
+    elif input.dim() == 1:
+        if offsets is None:
+            raise ValueError("offsets has to be a 1D Tensor but got None")
+        if offsets.dim() != 1:
+            raise ValueError("offsets has to be a 1D Tensor")
+    else:
+        raise ValueError("input has to be 1D or 2D Tensor, but got Tensor of dimension {}"
+                         .format(input.dim()))
+    return _FusedEmbeddingBag.apply(
+        weight, input.long(), offsets.long(), per_sample_weights,
+        _MODES[mode], include_last_offset, update)
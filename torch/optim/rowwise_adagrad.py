@@ -0,0 +1,142 @@
+import torch
+from .optimizer import Optimizer
+from ._fused_embedding_bag import fused_embedding_bag, _find_group
+
+
+class RowWiseAdagrad(Optimizer):
+    r"""Implements row-wise Adagrad algorithm.
+
+    A variant of Adagrad that keeps a single accumulator per row (slice along
+    the first dimension) of every parameter, updated with the mean of the
+    squared gradient over the row. It is meant for large embedding tables,
+    where it reduces the optimizer state from the size of the table to one
+    value per row.
+
+    Parameters receiving sparse gradients only have the rows present in the
+    gradient updated. Embedding tables can also be trained with
+    :meth:`embedding_bag`, which applies the update in the backward pass
+    without materializing a gradient.
+
+    Arguments:
+        params (iterable): iterable of parameters to optimize or dicts defining
+            parameter groups
+        lr (float, optional): learning rate (default: 1e-2)
+        weight_decay (float, optional): weight decay (L2 penalty) (default: 0)
+        eps (float, optional): term added to the denominator to improve
+            numerical stability (default: 1e-10)
+        momentum_dtype (torch.dtype, optional): dtype of the per-row
+            accumulators, one of ``torch.float``, ``torch.half`` and
+            ``torch.bfloat16`` (default: ``torch.float``)
+    """
+
+    def __init__(self, params, lr=1e-2, weight_decay=0, eps=1e-10, momentum_dtype=torch.float):
+        if not 0.0 <= lr:
+            raise ValueError("Invalid learning rate: {}".format(lr))
+        if not 0.0 <= weight_decay:
+            raise ValueError("Invalid weight_decay value: {}".format(weight_decay))
+        if not 0.0 <= eps:
+            raise ValueError("Invalid epsilon value: {}".format(eps))
+        if momentum_dtype not in (torch.float, torch.half, torch.bfloat16):
+            raise ValueError("Invalid momentum_dtype: {}".format(momentum_dtype))
+
+        defaults = dict(lr=lr, weight_decay=weight_decay, eps=eps)
+        super(RowWiseAdagrad, self).__init__(params, defaults)
+
+        for group in self.param_groups:
+            for p in group['params']:
+                if p.dim() == 0:
+                    raise ValueError("RowWiseAdagrad does not support 0-dim parameters")
+                state = self.state[p]
+                state['step'] = 0
+                state['momentum'] = torch.zeros(p.size(0), dtype=momentum_dtype, device=p.device)
+
+    def share_memory(self):
+        for group in self.param_groups:
+            for p in group['params']:
+                state = self.state[p]
+                state['momentum'].share_memory_()
+
+    @torch.no_grad()
+    def step(self, closure=None):
+        """Performs a single optimization step.
+
+        Arguments:
+            closure (callable, optional): A closure that reevaluates the model
+                and returns the loss.
+        """
+        loss = None
+        if closure is not None:
+            with torch.enable_grad():
+                loss = closure()
+
+        for group in self.param_groups:
+            for p in group['params']:
+                if p.grad is None:
+                    continue
+
+                grad = p.grad
+                state = self.state[p]
+                state['step'] += 1
+                momentum = state['momentum']
+
+                if grad.is_sparse:
+                    grad = grad.coalesce()  # the update is non-linear so indices must be unique
+                    rows = grad._indices()[0]
+                    grad_rows = grad._values().float().reshape(rows.numel(), -1)
+                    param_rows = p.index_select(0, rows).float().reshape(rows.numel(), -1)
+                else:
+                    rows = None
+                    grad_rows = grad.float().reshape(p.size(0), -1)
+                    param_rows = p.float().reshape(p.size(0), -1)
+
+                if group['weight_decay'] != 0:
+                    grad_rows = grad_rows.add(param_rows, alpha=group['weight_decay'])
+                row_momentum = momentum if rows is None else momentum.index_select(0, rows)
+                row_momentum = row_momentum.float() + grad_rows.pow(2).mean(1)
+                if rows is None:
+                    momentum.copy_(row_momentum)
+                else:
+                    momentum.index_copy_(0, rows, row_momentum.to(momentum.dtype))
+                std = row_momentum.sqrt_().add_(group['eps']).unsqueeze(1)
+                param_rows.addcdiv_(grad_rows, std, value=-group['lr'])
+                if rows is None:
+                    p.copy_(param_rows.view_as(p))
+                else:
+                    p.index_copy_(0, rows, param_rows.view((rows.numel(),) + p.shape[1:]).to(p.dtype))
+
+        return loss
+
+    def embedding_bag(self, weight, input, offsets=None, mode='sum', per_sample_weights=None,
+                      include_last_offset=False, stochastic_rounding=False):
+        r"""Computes :func:`torch.nn.functional.embedding_bag` of ``weight``
+        and applies the row-wise Adagrad update of the looked up rows in the
+        backward pass.
+
+        The gradient with respect to ``weight`` is not computed,
+        ``weight.grad`` stays ``None`` and :meth:`step` skips it. The update
+        runs on all CPU threads, one row at a time. ``weight`` can be stored in
+        ``torch.float``, ``torch.half`` or ``torch.bfloat16``, the output is
+        always computed in ``torch.float`` for the latter two.
+
+        Arguments:
+            weight (Tensor): a contiguous 2D CPU parameter of this optimizer
+            input, offsets, mode, per_sample_weights, include_last_offset:
+                see :func:`torch.nn.functional.embedding_bag`, only the
+                ``'sum'`` and ``'mean'`` modes are supported and no gradient is
+                computed for ``per_sample_weights``
+            stochastic_rounding (bool, optional): round updated ``torch.half``
+                and ``torch.bfloat16`` values stochastically instead of to the
+                nearest value (default: False)
+        """
+        group = _find_group(self, weight)
+        state = self.state[weight]
+
+        def update(grad, indices, offsets, mode, per_sample_weights, include_last_offset):
+            state['step'] += 1
+            torch._embedding_bag_rowwise_adagrad_update(
+                weight, state['momentum'], grad, indices, offsets, mode,
+                per_sample_weights, include_last_offset, group['lr'],
+                group['eps'], group['weight_decay'], stochastic_rounding)
+
+        return fused_embedding_bag(weight, input, offsets, mode, per_sample_weights,
+                                   include_last_offset, update)
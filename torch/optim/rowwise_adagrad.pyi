@@ -0,0 +1,8 @@
+from typing import Optional
+from torch import Tensor
+from .optimizer import _params_t, Optimizer
+from ..types import _dtype
+
+class RowWiseAdagrad(Optimizer):
+    def __init__(self, params: _params_t, lr: float=..., weight_decay: float=..., eps: float=..., momentum_dtype: _dtype=...) -> None: ...
+    def embedding_bag(self, weight: Tensor, input: Tensor, offsets: Optional[Tensor]=..., mode: str=..., per_sample_weights: Optional[Tensor]=..., include_last_offset: bool=..., stochastic_rounding: bool=...) -> Tensor: ...
@@ -1,5 +1,6 @@
 import torch
 from .optimizer import Optimizer, required
+from ._fused_embedding_bag import fused_embedding_bag, _find_group
 
 
 class SGD(Optimizer):
@@ -112,3 +113,26 @@ class SGD(Optimizer):
                 p.add_(d_p, alpha=-group['lr'])
 
         return loss
+
+    def embedding_bag(self, weight, input, offsets=None, mode='sum', per_sample_weights=None,
+                      include_last_offset=False, stochastic_rounding=False):
+        r"""Computes :func:`torch.nn.functional.embedding_bag` of ``weight``
+        and applies the SGD update of the looked up rows in the backward pass.
+
+        Only supported for parameter groups without momentum. The gradient
+        with respect to ``weight`` is not computed, ``weight.grad`` stays
+        ``None`` and :meth:`step` skips it. See
+        :meth:`torch.optim.RowWiseAdagrad.embedding_bag` for the arguments.
+        """
+        group = _find_group(self, weight)
+        if group['momentum'] != 0:
+            raise ValueError("SGD.embedding_bag does not support momentum")
+
+        def update(grad, indices, offsets, mode, per_sample_weights, include_last_offset):
+            torch._embedding_bag_sgd_update(
+                weight, grad, indices, offsets, mode, per_sample_weights,
+                include_last_offset, group['lr'], group['weight_decay'],
+                stochastic_rounding)
+
+        return fused_embedding_bag(weight, input, offsets, mode, per_sample_weights,
+                                   include_last_offset, update)
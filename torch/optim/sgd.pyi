@@ -1,4 +1,7 @@
+from typing import Optional
+from torch import Tensor
 from .optimizer import _params_t, Optimizer
 
 class SGD(Optimizer):
     def __init__(self, params: _params_t, lr: float, momentum: float=..., dampening: float=..., weight_decay:float=..., nesterov:bool=...) -> None: ...
+    def embedding_bag(self, weight: Tensor, input: Tensor, offsets: Optional[Tensor]=..., mode: str=..., per_sample_weights: Optional[Tensor]=..., include_last_offset: bool=..., stochastic_rounding: bool=...) -> Tensor: ...
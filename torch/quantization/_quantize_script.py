@@ -42,23 +42,27 @@ def prepare_script(model, qconfig_dict, inplace=False):
 def prepare_dynamic_script(model, qconfig_dict):
     return _prepare_script(model, qconfig_dict, is_dynamic=True)
 
-def _convert_script(model, is_dynamic, debug=False):
+def _convert_script(model, is_dynamic, debug=False, fuse_elementwise=False):
     _check_is_script_module(model)
     model.eval()
     model = wrap_cpp_module(torch._C._jit_pass_insert_quant_dequant(model._c, 'forward', False, is_dynamic))
     if not debug:
-        model = wrap_cpp_module(torch._C._jit_pass_quant_finalize(model._c, is_dynamic))
+        model = wrap_cpp_module(torch._C._jit_pass_quant_finalize(model._c, is_dynamic, fuse_elementwise))
     return model
 
-def convert_script(model, inplace=False, debug=False):
+def convert_script(model, inplace=False, debug=False, fuse_elementwise=False):
+    r"""fuse_elementwise fuses the chains of quantized elementwise ops, which
+    doesn't round the values between the ops to their quantization, so the
+    results may differ from the unfused model by rounding"""
     if not inplace:
         model = model.copy()
-    return _convert_script(model, is_dynamic=False, debug=debug)
+    return _convert_script(model, is_dynamic=False, debug=debug, fuse_elementwise=fuse_elementwise)
 
 def convert_dynamic_script(model, debug=False):
     return _convert_script(model, is_dynamic=True, debug=debug)
 
-def _quantize_script(model, qconfig_dict, run_fn=None, run_args=None, is_dynamic=False, debug=False):
+def _quantize_script(model, qconfig_dict, run_fn=None, run_args=None, is_dynamic=False, debug=False,
+                     fuse_elementwise=False):
     if is_dynamic:
         model = prepare_dynamic_script(model, qconfig_dict)
         model(*run_args)
@@ -66,15 +70,16 @@ def _quantize_script(model, qconfig_dict, run_fn=None, run_args=None, is_dynamic
     else:
         model = prepare_script(model, qconfig_dict, True)
         run_fn(model._c._get_method('forward'), *run_args)
-        model = convert_script(model, True, debug)
+        model = convert_script(model, True, debug, fuse_elementwise)
 
     return model
 
-def quantize_script(model, qconfig_dict, run_fn, run_args, inplace=False, debug=False):
+def quantize_script(model, qconfig_dict, run_fn, run_args, inplace=False, debug=False, fuse_elementwise=False):
     assert not inplace, "We don't support inplace right now"
     if not inplace:
         model = model.copy()
-    return _quantize_script(model, qconfig_dict, run_fn, run_args, is_dynamic=False, debug=debug)
+    return _quantize_script(model, qconfig_dict, run_fn, run_args, is_dynamic=False, debug=debug,
+                            fuse_elementwise=fuse_elementwise)
 
 def quantize_dynamic_script(model, qconfig_dict, sample_model_inputs, debug=False):
     return _quantize_script(model, qconfig_dict, run_args=sample_model_inputs, is_dynamic=True, debug=debug)
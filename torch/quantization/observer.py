@@ -954,6 +954,38 @@ class NoopObserver(ObserverBase):
         raise Exception("calculate_qparams should not be called for NoopObserver")
 
 
+class Int4GroupObserver(ObserverBase):
+    r"""
+    Observer that doesn't do anything and just passes the configuration of
+    4-bit weight quantization to the quantized module's ``.from_float()``.
+
+    The weights get a symmetric scale for each group of ``group_size``
+    consecutive input features of an output channel
+    (``torch.per_channel_group_symmetric``), which is computed when they are
+    packed. Only supported by dynamic quantized linear.
+
+    Args:
+        group_size: Number of consecutive input features that share a scale,
+            a multiple of 16 that divides the number of input features
+    """
+    def __init__(self, group_size=128):
+        super(Int4GroupObserver, self).__init__(dtype=torch.qint8)
+        self.qscheme = torch.per_channel_group_symmetric
+        self.group_size = group_size
+
+    def forward(self, x):
+        return x
+
+    @torch.jit.export
+    def calculate_qparams(self):
+        raise Exception("calculate_qparams should not be called for Int4GroupObserver, "
+                        "the 4-bit weights are quantized when they are packed")
+
+    @torch.jit.export
+    def extra_repr(self):
+        return "group_size={}".format(self.group_size)
+
+
 # Restrict activations to be in the range (0,127)
 default_observer = MinMaxObserver.with_args(reduce_range=True)
 default_debug_observer = RecordingObserver
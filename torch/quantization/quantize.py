@@ -198,6 +198,9 @@ def quantize_dynamic(model, qconfig_spec=None, dtype=torch.qint8,
     For simplest usage provide `dtype` argument that can be float16 or qint8. Weight-only quantization
     by default is performed for layers with large weights size - i.e. Linear and RNN variants.
 
+    Linear layers can also use 4-bit weights with a scale per group of input features by passing
+    `int4_dynamic_qconfig` in `qconfig_spec`, e.g. ``{nn.Linear: int4_dynamic_qconfig}``.
+
     Fine grained control is possible with `qconfig` and `mapping` that act similarly to `quantize()`.
     If `qconfig` is provided, the `dtype` argument is ignored.
 
@@ -124,6 +124,9 @@ class _StorageBase(object):
             pass  # CUDA doesn't use POSIX shared memory
         elif get_sharing_strategy() == 'file_system':
             self._share_filename_()
+        elif get_sharing_strategy() == 'file_system_slab':
+            if self._share_slab_() is None:
+                self._share_filename_()
         else:
             self._share_fd_()
         return self
@@ -136,6 +139,8 @@ class _StorageBase(object):
             return cls(size)
         elif get_sharing_strategy() == 'file_system':
             return cls._new_using_filename(size)
+        elif get_sharing_strategy() == 'file_system_slab':
+            return cls._new_using_slab(size)
         else:
             return cls._new_using_fd(size)
 
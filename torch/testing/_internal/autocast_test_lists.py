@@ -187,3 +187,109 @@ class AutocastTestLists(object):
             ("binary_cross_entropy", (torch.rand((n, n), device=dev, dtype=torch.float32),
                                       torch.rand((n, n), device=dev, dtype=torch.float32)), torch._C._nn),
         ]
+
+
+class AutocastCPUTestLists(object):
+    # Supplies ops and arguments for test_autocast_* in test/test_autocast.py
+    def __init__(self, dev):
+        super().__init__()
+        n = 8
+        # Utility arguments, created as one-element tuples
+        pointwise0_bf16 = (torch.randn(n, dtype=torch.bfloat16, device=dev),)
+        pointwise1_bf16 = (torch.randn(n, dtype=torch.bfloat16, device=dev),)
+        mat0_bf16 = (torch.randn((n, n), dtype=torch.bfloat16, device=dev),)
+        mat1_bf16 = (torch.randn((n, n), dtype=torch.bfloat16, device=dev),)
+        mat2_bf16 = (torch.randn((n, n), dtype=torch.bfloat16, device=dev),)
+
+        dimsets = ((n, n, n), (n, n, n, n), (n, n, n, n, n))
+        conv_args_fp32 = [(torch.randn(dimset, dtype=torch.float32, device=dev),
+                           torch.randn(dimset, dtype=torch.float32, device=dev))
+                          for dimset in dimsets]
+        conv_args_bf16 = [tuple(arg.to(torch.bfloat16) for arg in args) for args in conv_args_fp32]
+        bias_fp32 = (torch.randn((n,), dtype=torch.float32, device=dev),)
+        pointwise0_fp32 = (torch.randn(n, dtype=torch.float32, device=dev),)
+        pointwise1_fp32 = (torch.randn(n, dtype=torch.float32, device=dev),)
+        mat0_fp32 = (torch.randn((n, n), dtype=torch.float32, device=dev),)
+        mat1_fp32 = (torch.randn((n, n), dtype=torch.float32, device=dev),)
+        mat2_fp32 = (torch.randn((n, n), dtype=torch.float32, device=dev),)
+        mat3_fp32 = (torch.randn((n, n), dtype=torch.float32, device=dev),)
+
+        # The lists below organize ops that autocast needs to test.
+        # self.list_name corresponds to test_autocast_list_name in test/test_autocast.py.
+        # Each op is associated with a tuple of valid arguments.
+        self.torch_bf16 = [
+            ("conv1d", conv_args_fp32[0]),
+            ("conv2d", conv_args_fp32[1]),
+            ("conv3d", conv_args_fp32[2]),
+            ("convolution", conv_args_fp32[1] + bias_fp32 + ((1, 1), (0, 0), (1, 1), False, (0, 0), 1)),
+            ("addmm", mat1_fp32 + mat2_fp32 + mat3_fp32),
+            ("matmul", mat0_fp32 + mat1_fp32),
+            ("mm", mat0_fp32 + mat1_fp32),
+            ("addbmm", mat0_fp32 + (torch.randn((n, n, n), device=dev, dtype=torch.float32),
+                                    torch.randn((n, n, n), device=dev, dtype=torch.float32))),
+            ("baddbmm", (torch.randn((n, n, n), device=dev, dtype=torch.float32),
+                         torch.randn((n, n, n), device=dev, dtype=torch.float32),
+                         torch.randn((n, n, n), device=dev, dtype=torch.float32))),
+            ("bmm", (torch.randn((n, n, n), device=dev, dtype=torch.float32),
+                     torch.randn((n, n, n), device=dev, dtype=torch.float32))),
+        ]
+        self.torch_fp32 = [
+            ("conv_transpose1d", conv_args_bf16[0]),
+            ("conv_transpose2d", conv_args_bf16[1]),
+            ("conv_transpose3d", conv_args_bf16[2]),
+            ("exp", pointwise0_bf16),
+            ("log", (pointwise0_bf16[0].clamp(0.1, 100.0),)),
+            ("rsqrt", (pointwise0_bf16[0].clamp(0.1, 100.0),)),
+            ("pow", ((pointwise0_bf16[0] + 1.).clamp(0.0, 100.0),) + pointwise1_bf16),
+            ("softmax", pointwise0_bf16 + (0,)),
+            ("log_softmax", pointwise0_bf16 + (0,)),
+            ("layer_norm", pointwise0_bf16 + ((pointwise0_bf16[0].numel(),),)),
+            ("group_norm", mat0_bf16 + (1,)),
+            ("batch_norm", mat0_bf16 + (torch.zeros(n, dtype=torch.bfloat16, device=dev),
+                                        torch.ones(n, dtype=torch.bfloat16, device=dev),
+                                        None, None, False, 0.1, 1e-5, False)),
+            ("norm", pointwise0_bf16),
+            ("norm", pointwise0_bf16, {"dim": 0}),
+            ("norm", pointwise0_bf16, {"p": 1}),
+            ("norm", pointwise0_bf16, {"p": 1, "dim": 0}),
+            ("cosine_similarity", mat0_bf16 + mat1_bf16),
+            ("kl_div", mat0_bf16 + (torch.rand((n, n), device=dev, dtype=torch.bfloat16),)),
+            ("triplet_margin_loss", mat0_bf16 + mat1_bf16 + mat2_bf16),
+            ("binary_cross_entropy_with_logits", mat0_bf16 + (torch.rand((n, n), device=dev, dtype=torch.bfloat16),)),
+            ("cumprod", pointwise0_bf16 + (0,)),
+            ("cumsum", pointwise0_bf16 + (0,)),
+            ("dist", pointwise0_bf16 + pointwise1_bf16),
+            ("cdist", mat0_bf16 + mat1_bf16),
+            ("prod", pointwise0_bf16),
+            ("prod", pointwise0_bf16 + (0,)),
+            ("sum", pointwise0_bf16),
+            ("sum", mat0_bf16 + (1,)),
+            ("mean", pointwise0_bf16),
+            ("mean", mat0_bf16 + (1,)),
+        ]
+        self.torch_need_autocast_promote = [
+            ("atan2", pointwise0_fp32 + (pointwise1_bf16[0].clamp(0.1, 100),)),
+            ("dot", pointwise0_bf16 + pointwise1_fp32),
+            ("cat", (pointwise0_bf16 + pointwise1_fp32,)),
+            ("stack", (pointwise0_bf16 + pointwise1_fp32,)),
+        ]
+        self.nn_bf16 = [
+            ("linear", mat0_fp32 + mat1_fp32 + mat2_fp32),
+        ]
+        self.nn_fp32 = [
+            ("softplus", pointwise0_bf16),
+            ("gelu", pointwise0_bf16),
+            ("binary_cross_entropy", (torch.rand((n, n), device=dev, dtype=torch.bfloat16),
+                                      torch.rand((n, n), device=dev, dtype=torch.bfloat16))),
+            ("nll_loss", (torch.rand((n, n), device=dev, dtype=torch.bfloat16),
+                          torch.zeros((n,), device=dev, dtype=torch.long))),
+            ("l1_loss", mat0_bf16 + mat1_bf16),
+            ("smooth_l1_loss", mat0_bf16 + mat1_bf16),
+            ("mse_loss", mat0_bf16 + mat1_bf16),
+        ]
+        self.methods_bf16 = [
+            ("__matmul__", mat0_fp32 + mat1_fp32)
+        ]
+        self.methods_fp32 = [
+            ("__pow__", (torch.rand(n, device=dev, dtype=torch.bfloat16), 1.5)),
+        ]
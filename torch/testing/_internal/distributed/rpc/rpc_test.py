@@ -9,6 +9,7 @@ from unittest import mock
 import torch
 import torch.distributed as dist
 import torch.distributed.rpc as rpc
+import torch.multiprocessing
 import torch.testing._internal.dist_utils as dist_utils
 from torch.distributed.rpc import RRef, _get_debug_info, _rref_context_get_debug_info
 from torch.distributed.rpc.api import _delete_all_user_rrefs, _use_rpc_pickler
@@ -2081,6 +2082,45 @@ class RpcTest(RpcAgentTestFixture):
         self.assertEqual(int(info["agent.thread_pool_size"]), NUM_THREADS)
         rpc.shutdown()
 
+    @dist_init(setup_rpc=False)
+    @requires_process_group_agent("PROCESS_GROUP rpc backend specific test, skip")
+    @_skip_if_tensorpipe_agent
+    def test_process_group_shm_transport(self):
+        rpc_backend_options = rpc.ProcessGroupRpcBackendOptions(
+            init_method=self.rpc_backend_options.init_method,
+            num_send_recv_threads=self.rpc_backend_options.num_send_recv_threads,
+            shm_transport=True
+        )
+        rpc.init_rpc(
+            name=worker_name(self.rank),
+            backend=self.rpc_backend,
+            rank=self.rank,
+            world_size=self.world_size,
+            rpc_backend_options=rpc_backend_options,
+        )
+
+        dst = worker_name((self.rank + 1) % self.world_size)
+        small = torch.ones(2, 2)
+        large = torch.rand(1024, 1024)
+        # Only storages in named shared memory files can be sent in place
+        sharing_strategy = torch.multiprocessing.get_sharing_strategy()
+        torch.multiprocessing.set_sharing_strategy('file_system')
+        try:
+            shared = torch.rand(1024, 1024).share_memory_()
+        finally:
+            torch.multiprocessing.set_sharing_strategy(sharing_strategy)
+        for _ in range(3):
+            self.assertEqual(rpc.rpc_sync(dst, torch.add, args=(small, 1)), small + 1)
+            self.assertEqual(rpc.rpc_sync(dst, torch.add, args=(large, 1)), large + 1)
+            self.assertEqual(rpc.rpc_sync(dst, torch.add, args=(shared, large)), shared + large)
+
+        info = rpc.api._get_current_rpc_agent().get_debug_info()
+        # Three large tensors are copied and three shared tensors sent in place
+        # by this worker, the results of the peer are copied too
+        self.assertGreaterEqual(int(info["agent.shm_tensors_copied"]), 3)
+        self.assertGreaterEqual(int(info["agent.shm_tensors_shared"]), 3)
+        rpc.shutdown()
+
     @dist_init(setup_rpc=False)
     @requires_process_group_agent("PROCESS_GROUP rpc backend specific test, skip")
     @_skip_if_tensorpipe_agent
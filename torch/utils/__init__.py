@@ -1,6 +1,6 @@
 from __future__ import absolute_import, division, print_function, unicode_literals
 
-from .throughput_benchmark import ThroughputBenchmark
+from .throughput_benchmark import ThroughputBenchmark, BatchingServer
 
 import os.path as _osp
 
@@ -33,6 +33,14 @@ class ExecutionStats(object):
     def latency_avg_ms(self):
         return self._c_stats.latency_avg_ms
 
+    @property
+    def latency_p50_ms(self):
+        return self._c_stats.latency_p50_ms
+
+    @property
+    def latency_p99_ms(self):
+        return self._c_stats.latency_p99_ms
+
     @property
     def num_iters(self):
         return self._c_stats.num_iters
@@ -53,12 +61,74 @@ class ExecutionStats(object):
     def __str__(self):
         return '\n'.join([
             "Average latency per example: " + format_time(time_ms=self.latency_avg_ms),
+            "P50 latency per example: " + format_time(time_ms=self.latency_p50_ms),
+            "P99 latency per example: " + format_time(time_ms=self.latency_p99_ms),
             "Total number of iterations: {}".format(self.num_iters),
             "Total number of iterations per second (across all threads): {:.2f}".format(self.iters_per_second),
             "Total time: " + format_time(time_s=self.total_time_seconds)
         ])
 
 
+class BatchingServer(object):
+    '''
+    This class is a wrapper around a c++ component serving::BatchingServer
+    which serves a ScriptModule to many calling threads. Individual requests
+    are queued and concatenated along their first dimension into batches of
+    up to ``max_batch_size`` rows. A partial batch is dispatched early enough
+    for its oldest request to finish within ``max_latency_ms``, using a running
+    estimate of the forward time. Batched forward calls run on a pool of
+    ``num_worker_threads`` threads without the GIL and with gradient recording
+    disabled. The result, a tensor or a tuple of tensors, is split back along
+    the first dimension.
+
+    A BatchingServer can be passed to ThroughputBenchmark, in which case
+    concurrent calls from the calling threads get batched together.
+
+    Example::
+
+        >>> server = BatchingServer(scripted_module, max_batch_size=64,
+                                    max_latency_ms=2)
+        >>> future = server.submit(torch.randn(1, 128))
+        >>> result = future.wait()
+        >>> stats = ThroughputBenchmark(server).benchmark(num_calling_threads=16)
+    '''
+
+    def __init__(
+            self,
+            module,
+            max_batch_size=32,
+            max_latency_ms=2.0,
+            num_worker_threads=1,
+            pin_worker_threads=False):
+        if not isinstance(module, torch.jit.ScriptModule):
+            raise ValueError("BatchingServer only supports ScriptModules")
+        config = torch._C.BatchingConfig()
+        config.max_batch_size = max_batch_size
+        config.max_latency_us = int(max_latency_ms * 1000)
+        config.num_worker_threads = num_worker_threads
+        config.pin_worker_threads = pin_worker_threads
+        self._server = torch._C.BatchingServer(module._c, config)
+
+    def submit(self, *args):
+        '''
+        Queues a request and returns a torch.jit.Future holding its result
+        '''
+        return self._server.submit(*args)
+
+    def run(self, *args):
+        '''
+        Queues a request and waits for its result
+        '''
+        return self._server.run(*args)
+
+    def stats(self):
+        '''
+        Returns number of requests and batches served so far, the average
+        number of rows per batch and the running estimate of the forward time
+        '''
+        return self._server.stats()
+
+
 class ThroughputBenchmark(object):
     '''
     This class is a wrapper around a c++ component throughput_benchmark::ThroughputBenchmark
@@ -74,6 +144,10 @@ class ThroughputBenchmark(object):
     model for inference deployment it is better to switch to using it in this
     benchmark.
 
+    A ``torch._C.StaticRuntime`` created with ``torch._C._jit_to_static_runtime``
+    from a ScriptModule can be passed in as well. In this case inputs can only
+    be provided as positional arguments.
+
     Example::
 
         >>> from torch.utils import ThroughputBenchmark
@@ -94,7 +168,9 @@ class ThroughputBenchmark(object):
     '''
 
     def __init__(self, module):
-        if isinstance(module, torch.jit.ScriptModule):
+        if isinstance(module, BatchingServer):
+            self._benchmark = torch._C.ThroughputBenchmark(module._server)
+        elif isinstance(module, torch.jit.ScriptModule):
             self._benchmark = torch._C.ThroughputBenchmark(module._c)
         else:
             self._benchmark = torch._C.ThroughputBenchmark(module)
@@ -144,9 +220,11 @@ class ThroughputBenchmark(object):
 
 
         This function returns BenchmarkExecutionStats object which is defined via pybind11.
-        It currently has two fields:
+        It currently has four fields:
             - num_iters - number of actual iterations the benchmark have made
             - avg_latency_ms - average time it took to infer on one input example in milliseconds
+            - latency_p50_ms, latency_p99_ms - median and 99th percentile of the
+              latency of a single call measured by the calling threads
         '''
         config = torch._C.BenchmarkConfig()
         config.num_calling_threads = num_calling_threads